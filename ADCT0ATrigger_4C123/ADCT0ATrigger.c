@@ -23,6 +23,7 @@
  */
 #include <stdint.h>
 #include "../inc/tm4c123gh6pm.h"
+#include "Latency.h"
 #define NVIC_EN0_INT17          0x00020000  // Interrupt 17 enable
 
 #define TIMER_CFG_16_BIT        0x00000004  // 16-bit timer configuration,
@@ -259,6 +260,8 @@ void ADC0_InitTimer0ATriggerSeq3PD3(uint32_t period){
 
 volatile uint32_t ADCvalue;
 void ADC0Seq3_Handler(void){
+  LATENCY_ENTER(LATENCY_ADC0SEQ3, TIMER0_TAILR_R-TIMER0_TAV_R); // time since the trigger
   ADC0_ISC_R = 0x08;          // acknowledge ADC sequence 3 completion
   ADCvalue = ADC0_SSFIFO3_R;  // 12-bit result
+  LATENCY_EXIT(LATENCY_ADC0SEQ3);
 }
@@ -82,7 +82,9 @@
 
 //******************************************************************
 
+#include <stdint.h>
 #include "LCDG.h"
+#include "Format.h"
 #include "../inc/tm4c123gh6pm.h"
 #include "SysTick.h"
 
@@ -606,48 +608,25 @@ void LCD_OutString(char *pt){
   }
 }
 
+// output len characters in pt right justified in a field of width
+void static outRight(char *pt, uint32_t len, uint32_t width){
+  while(len < width){
+    LCD_OutChar(' ');
+    len++;
+  }
+  LCD_OutString(pt);
+}
+
 //-----------------------LCD_OutDec-----------------------
 // Output a 16-bit number in unsigned decimal format
 // Input: 16-bit unsigned number
 // Output: none
 // fixed size 5 digits of output, right justified
-void LCD_OutDec(unsigned short n){
+void LCD_OutDec(unsigned short n){ char buf[FORMAT_SIZE];
   if(OpenFlag==0){
     return;  // not open
   }
-  if(n < 10){
-    LCD_OutString("    ");
-    LCD_OutChar(n+'0'); /* n is between 0 and 9 */
-  } else if(n<100){
-    LCD_OutString("   ");
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  } else if(n<1000){
-      LCD_OutString("  ");
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
-    else if(n<10000){
-      LCD_OutChar(' ');
-      LCD_OutChar(n/1000+'0'); /* thousands digit */
-      n = n%1000;
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
-    else {
-      LCD_OutChar(n/10000+'0'); /* ten-thousands digit */
-      n = n%10000;
-      LCD_OutChar(n/1000+'0'); /* thousands digit */
-      n = n%1000;
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
+  outRight(buf, Format_UDec(buf, n), 5);
 }
 
 //-----------------------LCD_OutSDec-----------------------
@@ -655,53 +634,16 @@ void LCD_OutDec(unsigned short n){
 // Input: 16-bit signed number
 // Output: none
 // fixed size 6 digits of output, right justified
-void LCD_OutSDec(short n){
-unsigned char sign=' ';
+void LCD_OutSDec(short n){ char buf[FORMAT_SIZE];
   if(OpenFlag==0){
     return;  // not open
   }
   if(n < 0){
-    n = -n;       // negative
-    sign = '-';
+    outRight(buf, Format_Dec(buf, n), 6);
+  } else{
+    buf[0] = ' ';   // in place of the sign
+    outRight(buf, 1+Format_UDec(buf+1, n), 6);
   }
-  if(n < 10){
-    LCD_OutString("    ");
-    LCD_OutChar(sign);
-    LCD_OutChar(n+'0'); /* n is between 0 and 9 */
-  } else if(n<100){
-    LCD_OutString("   ");
-    LCD_OutChar(sign);
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  } else if(n<1000){
-      LCD_OutString("  ");
-      LCD_OutChar(sign);
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
-    else if(n<10000){
-      LCD_OutChar(' ');
-      LCD_OutChar(sign);
-      LCD_OutChar(n/1000+'0'); /* thousands digit */
-      n = n%1000;
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
-    else {
-      LCD_OutChar(sign);
-      LCD_OutChar(n/10000+'0'); /* ten-thousands digit */
-      n = n%10000;
-      LCD_OutChar(n/1000+'0'); /* thousands digit */
-      n = n%1000;
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
 }
 
 //-----------------------LCD_OutFix1-----------------------
@@ -711,47 +653,11 @@ unsigned char sign=' ';
 // Output: none
 // fixed size is 6 characters of output, right justified
 // if input is 12345, then display is 1234.5
-void LCD_OutFix1(unsigned short n){
+void LCD_OutFix1(unsigned short n){ char buf[FORMAT_SIZE+1];
   if(OpenFlag==0){
     return;  // not open
   }
-  if(n < 10){
-    LCD_OutString("   0.");
-    LCD_OutChar(n+'0'); /* n is between 0 and 9 */
-  } else if(n<100){
-    LCD_OutString("   ");
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar('.');      /* decimal point */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  } else if(n<1000){
-      LCD_OutString("  ");
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar('.');      /* decimal point */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
-    else if(n<10000){
-      LCD_OutChar(' ');
-      LCD_OutChar(n/1000+'0'); /* thousands digit */
-      n = n%1000;
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar('.');      /* decimal point */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
-    else {
-      LCD_OutChar(n/10000+'0'); /* ten-thousands digit */
-      n = n%10000;
-      LCD_OutChar(n/1000+'0'); /* thousands digit */
-      n = n%1000;
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar('.');      /* decimal point */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
+  outRight(buf, Format_Fix(buf, n, 1), 6);
 }
 
 //-----------------------LCD_OutFix2-----------------------
@@ -761,46 +667,11 @@ void LCD_OutFix1(unsigned short n){
 // Output: none
 // fixed size is 6 characters of output, right justified
 // if input is 12345, then display is 123.45
-void LCD_OutFix2(unsigned short n){
+void LCD_OutFix2(unsigned short n){ char buf[FORMAT_SIZE+1];
   if(OpenFlag==0){
     return;  // not open
   }
-  if(n < 10){
-    LCD_OutString("  0.0");
-    LCD_OutChar(n+'0'); /* n is between 0 and 9 */
-  } else if(n<100){
-    LCD_OutString("  0.");
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  } else if(n<1000){
-    LCD_OutString("  ");
-    LCD_OutChar(n/100+'0'); /* hundreds digit */
-    n = n%100;
-    LCD_OutChar('.');      /* decimal point */
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  }
-  else if(n<10000){
-    LCD_OutChar(' ');
-    LCD_OutChar(n/1000+'0'); /* thousands digit */
-    n = n%1000;
-    LCD_OutChar(n/100+'0'); /* hundreds digit */
-    n = n%100;
-    LCD_OutChar('.');      /* decimal point */
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  }
-  else {
-    LCD_OutChar(n/10000+'0'); /* ten-thousands digit */
-    n = n%10000;
-    LCD_OutChar(n/1000+'0'); /* thousands digit */
-    n = n%1000;
-    LCD_OutChar(n/100+'0'); /* hundreds digit */
-    n = n%100;
-    LCD_OutChar('.');      /* decimal point */
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  }
+  outRight(buf, Format_Fix(buf, n, 2), 6);
 }
 
 //-----------------------LCD_OutFix2b-----------------------
@@ -810,38 +681,15 @@ void LCD_OutFix2(unsigned short n){
 // Output: none
 // fixed size is 5 characters of output, right justified
 // if input is 1234, then display is 12.34
-void LCD_OutFix2b(unsigned short n){
+void LCD_OutFix2b(unsigned short n){ char buf[FORMAT_SIZE+1];
   if(OpenFlag==0){
     return;  // not open
   }
-
-  if(n < 10){
-    LCD_OutString(" 0.0");
-    LCD_OutChar(n+'0'); /* n is between 0 and 9 */
-  } else if(n<100){
-    LCD_OutString(" 0.");
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  } else if(n<1000){
-    LCD_OutChar(' ');
-    LCD_OutChar(n/100+'0'); /* hundreds digit */
-    n = n%100;
-    LCD_OutChar('.');      /* decimal point */
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  }
-  else if(n<10000){
-    LCD_OutChar(n/1000+'0'); /* thousands digit */
-    n = n%1000;
-    LCD_OutChar(n/100+'0'); /* hundreds digit */
-    n = n%100;
-    LCD_OutChar('.');       /* decimal point */
-    LCD_OutChar(n/10+'0');  /* tens digit */
-    LCD_OutChar(n%10+'0');  /* ones digit */
-  }
-  else {
+  if(n > 9999){
     LCD_OutString("**.**");
+    return;
   }
+  outRight(buf, Format_Fix(buf, n, 2), 5);
 }
 
 //-----------------------LCD_OutFix3-----------------------
@@ -851,45 +699,11 @@ void LCD_OutFix2b(unsigned short n){
 // Output: none
 // fixed size is 6 characters of output, right justified
 // if input is 12345, then display is 12.345
-void LCD_OutFix3(unsigned short n){
+void LCD_OutFix3(unsigned short n){ char buf[FORMAT_SIZE+1];
   if(OpenFlag==0){
     return;  // not open
   }
-  if(n < 10){
-    LCD_OutString(" 0.00");
-    LCD_OutChar(n+'0');  /* n is between 0 and 9 */
-  } else if(n<100){
-    LCD_OutString(" 0.0");
-    LCD_OutChar(n/10+'0'); /* tens digit */
-    LCD_OutChar(n%10+'0'); /* ones digit */
-  } else if(n<1000){
-      LCD_OutString(" 0.");
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
-    else if(n<10000){
-      LCD_OutChar(' ');
-      LCD_OutChar(n/1000+'0'); /* thousands digit */
-      LCD_OutChar('.');      /* decimal point */
-      n = n%1000;
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
-    else {
-      LCD_OutChar(n/10000+'0'); /* ten-thousands digit */
-      n = n%10000;
-      LCD_OutChar(n/1000+'0'); /* thousands digit */
-      LCD_OutChar('.');      /* decimal point */
-      n = n%1000;
-      LCD_OutChar(n/100+'0'); /* hundreds digit */
-      n = n%100;
-      LCD_OutChar(n/10+'0'); /* tens digit */
-      LCD_OutChar(n%10+'0'); /* ones digit */
-    }
+  outRight(buf, Format_Fix(buf, n, 3), 6);
 }
 
 //-----------------------LCD_GoTo-----------------------
@@ -0,0 +1,28 @@
+// Baseline.h
+// Runs on LM4F120/TM4C123
+// Median times, in bus cycles at 80 MHz, that Benchmark.c compares
+// against.  To update, run Bench_Report(&UART_OutString, BENCH_BASELINE)
+// on the LaunchPad and paste its lines above the 0 entry.  Cases
+// not listed here are reported but not compared.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+const bench_baseline_t Baseline[] = {
+  {0, 0}                    // end of table
+};
@@ -0,0 +1,281 @@
+// Bench.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Run a list of benchmark cases the same way every time and report
+// the results in a form a program can read.
+// The times of the BENCH_REPS runs are sorted, which gives the
+// minimum, median and maximum directly.  An interrupt that lands in
+// a run makes that run slow, so it ends up in the trimmed tail
+// instead of moving the mean.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "Profiler.h"
+#include "Sort.h"
+#include "Bench.h"
+
+typedef struct bench_case {
+  const char *name;
+  void (*setup)(void);
+  void (*run)(void);
+  uint32_t n;
+} bench_case_t;
+
+bench_case_t Cases[BENCH_CASES];
+bench_result_t Results[BENCH_CASES];
+uint32_t NumCases;
+uint32_t Overhead;              // time of an empty case
+uint32_t Times[BENCH_REPS];     // global for easy visibility in debugger
+
+static void empty(void){
+}
+
+// one timed run, not counting the setup or the empty case time
+static uint32_t runOnce(const bench_case_t *c){ uint32_t time;
+  if(c->setup){
+    c->setup();
+  }
+  Profiler_Begin(BENCH_ZONE);
+  c->run();
+  time = Profiler_End(BENCH_ZONE);
+  return (time > Overhead) ? time-Overhead : 0;
+}
+
+static void measure(const bench_case_t *c, bench_result_t *r){
+  uint32_t i; uint64_t sum;
+  for(i=0; i<BENCH_WARMUP; i++){
+    runOnce(c);                // fill caches and prefetch buffers
+  }
+  for(i=0; i<BENCH_REPS; i++){
+    Times[i] = runOnce(c);
+  }
+  Sort_Insertion(Times, BENCH_REPS);
+  sum = 0;
+  for(i=BENCH_TRIM; i<BENCH_REPS-BENCH_TRIM; i++){
+    sum = sum+Times[i];
+  }
+  r->name = c->name;
+  r->n = c->n;
+  r->min = Times[0];
+  r->median = Times[BENCH_REPS/2];
+  r->mean = (uint32_t)(sum/(BENCH_REPS-2*BENCH_TRIM));
+  r->max = Times[BENCH_REPS-1];
+}
+
+//------------Bench_Init------------
+// Initialize the Profiler, remove every case, and measure the time
+// to run an empty case.
+// Input: none
+// Output: none
+void Bench_Init(void){ bench_case_t c; bench_result_t r;
+  Profiler_Init();
+  Profiler_Name(BENCH_ZONE, "bench");
+  NumCases = 0;
+  Overhead = 0;
+  c.name = "empty";
+  c.setup = 0;
+  c.run = &empty;
+  c.n = 1;
+  measure(&c, &r);
+  Overhead = r.median;
+}
+
+//------------Bench_Add------------
+// Add a case to the list.  setup runs untimed before every run, for
+// example to refill an array that run sorts in place.
+// Input: name   string that stays valid, not copied
+//        setup  function run before each run, 0 for none
+//        run    function to time
+//        n      number of elements each run processes
+// Output: 1 if added, 0 if the list is full
+int Bench_Add(const char *name, void (*setup)(void), void (*run)(void), uint32_t n){
+  if(NumCases >= BENCH_CASES){
+    return 0;
+  }
+  Cases[NumCases].name = name;
+  Cases[NumCases].setup = setup;
+  Cases[NumCases].run = run;
+  Cases[NumCases].n = n;
+  Results[NumCases].name = name;
+  Results[NumCases].n = n;
+  NumCases++;
+  return 1;
+}
+
+//------------Bench_RunAll------------
+// Run every case, in the order added.
+// Input: none
+// Output: none
+void Bench_RunAll(void){ uint32_t i;
+  for(i=0; i<NumCases; i++){
+    measure(&Cases[i], &Results[i]);
+  }
+}
+
+//------------Bench_Count------------
+// Input: none
+// Output: number of cases added
+uint32_t Bench_Count(void){
+  return NumCases;
+}
+
+//------------Bench_Result------------
+// Input: i  0 to Bench_Count()-1
+// Output: results of case i from the last Bench_RunAll
+bench_result_t Bench_Result(uint32_t i){
+  return Results[i];
+}
+
+//------------Bench_Overhead------------
+// Input: none
+// Output: median time of an empty case, subtracted from every run
+uint32_t Bench_Overhead(void){
+  return Overhead;
+}
+
+// copy a string, returns pointer to the next free character
+static char *str(char *pt, const char *s){
+  while(*s){
+    *pt = *s;
+    pt++; s++;
+  }
+  return pt;
+}
+
+// convert an unsigned number to decimal
+// returns pointer to the next free character
+static char *udec(char *pt, uint32_t n){ char digits[10]; int i;
+  i = 0;
+  do{
+    digits[i] = '0' + n%10;
+    n = n/10;
+    i++;
+  }while(n);
+  while(i){
+    i--;
+    *pt = digits[i];
+    pt++;
+  }
+  return pt;
+}
+
+#define NAMESIZE 32             // longer names are cut off
+#define LINESIZE (NAMESIZE+128)
+
+// copy a name, at most NAMESIZE characters
+static char *name(char *pt, const char *s){ uint32_t i;
+  for(i=0; (i<NAMESIZE) && s[i]; i++){
+    pt[i] = s[i];
+  }
+  return pt+i;
+}
+
+//------------Bench_Report------------
+// Output the results of every case.
+// Input: outString  function that outputs a string, e.g. UART_OutString
+//        format     BENCH_CSV, BENCH_JSON or BENCH_BASELINE
+// Output: none
+void Bench_Report(void (*outString)(char *), uint32_t format){
+  char line[LINESIZE]; char *pt; uint32_t i; bench_result_t *r;
+  if(format == BENCH_CSV){
+    outString("name,n,min,median,mean,max\r\n");
+  }
+  for(i=0; i<NumCases; i++){
+    r = &Results[i];
+    pt = line;
+    if(format == BENCH_JSON){
+      pt = str(pt, "{\"name\":\"");
+      pt = name(pt, r->name);
+      pt = str(pt, "\",\"n\":");       pt = udec(pt, r->n);
+      pt = str(pt, ",\"min\":");       pt = udec(pt, r->min);
+      pt = str(pt, ",\"median\":");    pt = udec(pt, r->median);
+      pt = str(pt, ",\"mean\":");      pt = udec(pt, r->mean);
+      pt = str(pt, ",\"max\":");       pt = udec(pt, r->max);
+      pt = str(pt, "}");
+    } else if(format == BENCH_BASELINE){
+      pt = str(pt, "  {\"");
+      pt = name(pt, r->name);
+      pt = str(pt, "\", ");
+      pt = udec(pt, r->median);
+      pt = str(pt, "},");
+    } else{
+      pt = name(pt, r->name);
+      *pt = ','; pt = udec(pt+1, r->n);
+      *pt = ','; pt = udec(pt+1, r->min);
+      *pt = ','; pt = udec(pt+1, r->median);
+      *pt = ','; pt = udec(pt+1, r->mean);
+      *pt = ','; pt = udec(pt+1, r->max);
+    }
+    pt = str(pt, "\r\n");
+    *pt = 0;
+    outString(line);
+  }
+}
+
+// 1 if the strings are equal
+static int same(const char *a, const char *b){
+  while(*a && (*a == *b)){
+    a++; b++;
+  }
+  return *a == *b;
+}
+
+//------------Bench_Compare------------
+// Compare the median of each case to a baseline with the same name.
+// Outputs one CSV line name,baseline,median,change% per case found
+// in the baseline, ending in ",REGRESSION" if the median grew by
+// more than percent.
+// Input: outString  function that outputs a string
+//        baseline   table that ends with a 0 name
+//        percent    allowed increase, e.g. 10 for 10%
+// Output: number of regressions
+uint32_t Bench_Compare(void (*outString)(char *), const bench_baseline_t *baseline, uint32_t percent){
+  char line[LINESIZE]; char *pt; const bench_baseline_t *b;
+  uint32_t i,regressions,base,now,change;
+  regressions = 0;
+  outString("name,baseline,median,change%\r\n");
+  for(i=0; i<NumCases; i++){
+    for(b=baseline; b->name && !same(b->name, Results[i].name); b++){
+    }
+    if(b->name == 0){
+      continue;                // new case, nothing to compare to
+    }
+    base = b->median;
+    now = Results[i].median;
+    pt = name(line, Results[i].name);
+    *pt = ','; pt = udec(pt+1, base);
+    *pt = ','; pt = udec(pt+1, now);
+    *pt = ','; pt++;
+    if(now >= base){           // change in percent, rounded
+      change = base ? (uint32_t)(((uint64_t)(now-base)*100 + base/2)/base) : 0;
+      *pt = '+';
+    } else{
+      change = (uint32_t)(((uint64_t)(base-now)*100 + base/2)/base);
+      *pt = '-';
+    }
+    pt = udec(pt+1, change);
+    if((uint64_t)now*100 > (uint64_t)base*(100+percent)){
+      pt = str(pt, ",REGRESSION");
+      regressions++;
+    }
+    pt = str(pt, "\r\n");
+    *pt = 0;
+    outString(line);
+  }
+  return regressions;
+}
@@ -0,0 +1,115 @@
+// Bench.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Run a list of benchmark cases the same way every time and report
+// the results in a form a program can read.
+// Each case is run BENCH_WARMUP times untimed, then BENCH_REPS times
+// timed with the Profiler.  The fastest and slowest BENCH_TRIM runs
+// are dropped from the mean.  The time to call an empty case is
+// measured by Bench_Init and subtracted, so no "- 4" style constants
+// are needed.  Times are in cycles on the target, ns on the host.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#define BENCH_CASES  24   // most cases that can be added
+#define BENCH_WARMUP 2    // untimed runs before measuring
+#define BENCH_REPS   21   // timed runs per case
+#define BENCH_TRIM   5    // fastest and slowest runs left out of the mean
+#define BENCH_ZONE   (PROFILER_ZONES-1) // Profiler zone used for timing
+
+// output formats for Bench_Report
+#define BENCH_CSV      0  // header line, then name,n,min,median,mean,max
+#define BENCH_JSON     1  // one JSON object per line
+#define BENCH_BASELINE 2  // {"name",median}, lines for a baseline table
+
+// results of one case
+typedef struct bench_result {
+  const char *name;
+  uint32_t n;             // elements processed per run, for time per element
+  uint32_t min;           // fastest run
+  uint32_t median;        // middle run, the number compared to a baseline
+  uint32_t mean;          // mean without the BENCH_TRIM fastest and slowest
+  uint32_t max;           // slowest run
+} bench_result_t;
+
+// stored result, a table of these ends with a 0 name
+typedef struct bench_baseline {
+  const char *name;
+  uint32_t median;
+} bench_baseline_t;
+
+//------------Bench_Init------------
+// Initialize the Profiler, remove every case, and measure the time
+// to run an empty case.
+// Input: none
+// Output: none
+void Bench_Init(void);
+
+//------------Bench_Add------------
+// Add a case to the list.  setup runs untimed before every run, for
+// example to refill an array that run sorts in place.
+// Input: name   string that stays valid, not copied
+//        setup  function run before each run, 0 for none
+//        run    function to time
+//        n      number of elements each run processes
+// Output: 1 if added, 0 if the list is full
+int Bench_Add(const char *name, void (*setup)(void), void (*run)(void), uint32_t n);
+
+//------------Bench_RunAll------------
+// Run every case, in the order added.
+// Input: none
+// Output: none
+void Bench_RunAll(void);
+
+//------------Bench_Count------------
+// Input: none
+// Output: number of cases added
+uint32_t Bench_Count(void);
+
+//------------Bench_Result------------
+// Input: i  0 to Bench_Count()-1
+// Output: results of case i from the last Bench_RunAll
+bench_result_t Bench_Result(uint32_t i);
+
+//------------Bench_Overhead------------
+// Input: none
+// Output: median time of an empty case, subtracted from every run
+uint32_t Bench_Overhead(void);
+
+//------------Bench_Report------------
+// Output the results of every case.
+// Input: outString  function that outputs a string, e.g. UART_OutString
+//        format     BENCH_CSV, BENCH_JSON or BENCH_BASELINE
+// Output: none
+void Bench_Report(void (*outString)(char *), uint32_t format);
+
+//------------Bench_Compare------------
+// Compare the median of each case to a baseline with the same name.
+// Outputs one CSV line name,baseline,median,change% per case found
+// in the baseline, ending in ",REGRESSION" if the median grew by
+// more than percent.
+// Input: outString  function that outputs a string
+//        baseline   table that ends with a 0 name
+//        percent    allowed increase, e.g. 10 for 10%
+// Output: number of regressions
+uint32_t Bench_Compare(void (*outString)(char *), const bench_baseline_t *baseline, uint32_t percent);
+
+#endif //  __BENCH_H__
@@ -0,0 +1,265 @@
+// Benchmark.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// One benchmark suite for the sort, square root, FFT, float,
+// interpolation and number formatting code used by ProfileSort,
+// ProfileSqrt, ProfileFFT, Performance, Math, LinearInterpolation
+// and the UART and LCD drivers.
+// On the LaunchPad the results go out UART0 at 115,200 bps as CSV,
+// then as JSON, then compared to the table in Baseline.h.
+// On a PC build with
+//   gcc -O2 Benchmark.c Bench.c Profiler.c Sort.c IntMath.c FFT.c FloatDSP.c Interp.c Format.c -o Benchmark
+// and run
+//   ./Benchmark csv > baseline.csv     save a baseline
+//   ./Benchmark json                   JSON results
+//   ./Benchmark baseline               lines for Baseline.h
+//   ./Benchmark compare baseline.csv 10
+// compare exits with 1 if any median grew by more than 10%.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "Profiler.h"
+#include "Bench.h"
+#include "Sort.h"
+#include "IntMath.h"
+#include "FFT.h"
+#include "FloatDSP.h"
+#include "Interp.h"
+#include "Format.h"
+#if PROFILER_BACKEND == PROFILER_HOST
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#else
+#include "PLL.h"
+#include "UART.h"
+#include "Baseline.h"
+#endif
+
+#define PERCENT 10          // allowed increase before a regression
+
+#define SIZE 1024
+uint32_t Data[SIZE],Temp[SIZE];
+Complex_t Buf[SIZE];
+uint32_t Mag[SIZE/2];
+float X[256],Y[256],H[32],FIRState[64],BQState[4];
+int32_t In[256],Out[256];
+volatile uint32_t Sink;     // results go here so they are not optimized away
+fdsp_fir_t FIR;
+fdsp_biquad_t BQ;
+const float BQCoef[10] = {  // two low pass sections
+  0.0675f, 0.1349f, 0.0675f, -1.1430f, 0.4128f,
+  0.0675f, 0.1349f, 0.0675f, -1.1430f, 0.4128f};
+const int32_t SquareY[17] = { // x*x/16 every 16, from 0 to 256
+  0, 16, 64, 144, 256, 400, 576, 784, 1024,
+  1296, 1600, 1936, 2304, 2704, 3136, 3600, 4096};
+const interp_table_t Square = {17, 0, SquareY, 0, 0, 4};
+char Text[64];
+uint32_t TextLen;
+
+// same numbers every run, so results can be compared
+uint32_t Seed;
+static uint32_t random32(void){
+  Seed = 1664525*Seed + 1013904223;
+  return Seed;
+}
+
+//**********setup functions, not timed***********
+static void randomData(void){ uint32_t i;
+  Seed = 12345;
+  for(i=0; i<SIZE; i++){
+    Data[i] = random32();
+  }
+}
+static void sortedData(void){ uint32_t i;
+  for(i=0; i<SIZE; i++){
+    Data[i] = i;
+  }
+}
+static void sineData(void){ uint32_t i;
+  Seed = 12345;
+  for(i=0; i<SIZE; i++){     // 3 sawtooth waves plus noise
+    Buf[i].real = (int16_t)(((3*i*32)&0x7FFF) - 16384 + (random32()>>24));
+    Buf[i].imag = 0;
+  }
+}
+static void floatData(void){ uint32_t i;
+  for(i=0; i<256; i++){
+    X[i] = 0.05f*i - 6.4f;   // -6.4 to +6.35
+    In[i] = i;
+  }
+  for(i=0; i<32; i++){
+    H[i] = 1.0f/32;
+  }
+  FDSP_FIRInit(&FIR, H, FIRState, 32);
+  FDSP_BiquadInit(&BQ, BQCoef, BQState, 2);
+}
+
+//**********cases, timed***********
+static void sortIntro(void){ Sort_Intro(Data, SIZE); }
+static void sortRadix(void){ Sort_Radix(Data, Temp, SIZE, 32); }
+static void sortSorted(void){ Sort(Data, SIZE); }
+static void median(void){ Sink = Sort_Median(Data, SIZE); }
+static void isqrt(void){ uint32_t i,sum;
+  sum = 0;
+  for(i=0; i<SIZE; i++){
+    sum += IntMath_Sqrt(Data[i]);
+  }
+  Sink = sum;
+}
+static void fftComplex(void){ Sink = FFT_Complex(Buf, SIZE); }
+static void fftReal(void){ Sink = FFT_Real(Buf, SIZE); }
+static void mag(void){ IntMath_MagArray((int16_t *)Buf, Mag, SIZE/2); }
+static void magApprox(void){ IntMath_MagApproxArray((int16_t *)Buf, Mag, SIZE/2); }
+static void dot(void){ Sink = (uint32_t)FDSP_Dot(X, X, 256); }
+static void fir(void){ FDSP_FIR(&FIR, X, Y, 256); }
+static void biquad(void){ FDSP_Biquad(&BQ, X, Y, 256); }
+static void fsin(void){ FDSP_Sin(X, Y, 256); }
+static void fexp(void){ FDSP_Exp(X, Y, 256); }
+static void interp(void){ Interp_Array(&Square, In, Out, 256); }
+// the recursive conversion UART_OutUDec used before Format.c
+static void recursiveUDec(uint32_t n){
+  if(n >= 10){
+    recursiveUDec(n/10);
+    n = n%10;
+  }
+  Text[TextLen++] = n+'0';
+}
+static void udecRecursive(void){ uint32_t i,len;
+  len = 0;
+  for(i=0; i<256; i++){
+    TextLen = 0;
+    recursiveUDec(Data[i]>>(i&31));
+    len += TextLen;
+  }
+  Sink = len;
+}
+static void udec(void){ uint32_t i,len;
+  len = 0;
+  for(i=0; i<256; i++){
+    len += Format_UDec(Text, Data[i]>>(i&31));
+  }
+  Sink = len;
+}
+static void fix2(void){ uint32_t i,len;
+  len = 0;
+  for(i=0; i<256; i++){
+    len += Format_Fix(Text, (int32_t)Data[i]>>(i&31), 2);
+  }
+  Sink = len;
+}
+static void snprintfLine(void){ uint32_t i,len;
+  len = 0;
+  for(i=0; i<64; i++){
+    len += Format_snprintf(Text, sizeof(Text), "t=%u x=%-6d %08X %s\r\n",
+                           Data[i], (int32_t)Data[i+1]>>16, Data[i+2], "ok");
+  }
+  Sink = len;
+}
+
+void Cases_Add(void){
+  Bench_Add("sort_intro_1024", &randomData, &sortIntro, SIZE);
+  Bench_Add("sort_radix_1024", &randomData, &sortRadix, SIZE);
+  Bench_Add("sort_sorted_1024", &sortedData, &sortSorted, SIZE);
+  Bench_Add("median_1024", &randomData, &median, SIZE);
+  Bench_Add("isqrt_1024", &randomData, &isqrt, SIZE);
+  Bench_Add("fft_complex_1024", &sineData, &fftComplex, SIZE);
+  Bench_Add("fft_real_1024", &sineData, &fftReal, SIZE);
+  Bench_Add("mag_512", 0, &mag, SIZE/2);
+  Bench_Add("mag_approx_512", 0, &magApprox, SIZE/2);
+  Bench_Add("fdsp_dot_256", 0, &dot, 256);
+  Bench_Add("fdsp_fir32_256", 0, &fir, 256);
+  Bench_Add("fdsp_biquad2_256", 0, &biquad, 256);
+  Bench_Add("fdsp_sin_256", 0, &fsin, 256);
+  Bench_Add("fdsp_exp_256", 0, &fexp, 256);
+  Bench_Add("interp_uniform_256", 0, &interp, 256);
+  Bench_Add("udec_recursive_256", &randomData, &udecRecursive, 256);
+  Bench_Add("format_udec_256", &randomData, &udec, 256);
+  Bench_Add("format_fix2_256", &randomData, &fix2, 256);
+  Bench_Add("format_snprintf_64", &randomData, &snprintfLine, 64);
+}
+
+#if PROFILER_BACKEND == PROFILER_HOST
+static void outString(char *pt){
+  fputs(pt, stdout);
+}
+
+// read a file saved from "Benchmark csv", name and median of each line
+#define MAXLINE 128
+bench_baseline_t Baseline[BENCH_CASES+1];
+char Names[BENCH_CASES][MAXLINE];
+static int readBaseline(const char *file){
+  FILE *f; char line[MAXLINE]; uint32_t i,n,min,med; char *comma;
+  f = fopen(file, "r");
+  if(f == 0){
+    return 0;
+  }
+  i = 0;
+  while((i < BENCH_CASES) && fgets(line, MAXLINE, f)){
+    comma = strchr(line, ',');
+    if((comma == 0) || (sscanf(comma, ",%u,%u,%u", &n, &min, &med) != 3)){
+      continue;                // header line
+    }
+    *comma = 0;
+    strcpy(Names[i], line);
+    Baseline[i].name = Names[i];
+    Baseline[i].median = med;
+    i++;
+  }
+  Baseline[i].name = 0;
+  fclose(f);
+  return 1;
+}
+
+int main(int argc, char **argv){ const char *mode;
+  mode = (argc > 1) ? argv[1] : "csv";
+  floatData();
+  Bench_Init();
+  Cases_Add();
+  Bench_RunAll();
+  if(strcmp(mode, "json") == 0){
+    Bench_Report(&outString, BENCH_JSON);
+  } else if(strcmp(mode, "baseline") == 0){
+    Bench_Report(&outString, BENCH_BASELINE);
+  } else if(strcmp(mode, "compare") == 0){
+    if((argc < 3) || !readBaseline(argv[2])){
+      fprintf(stderr, "usage: %s compare baseline.csv [percent]\n", argv[0]);
+      return 2;
+    }
+    return Bench_Compare(&outString, Baseline, (argc > 3) ? atoi(argv[3]) : PERCENT) ? 1 : 0;
+  } else{
+    Bench_Report(&outString, BENCH_CSV);
+  }
+  return 0;
+}
+#else
+uint32_t Regressions;       // global for easy visibility in debugger
+int main(void){
+  PLL_Init(Bus80MHz);       // bus clock at 80 MHz
+  UART_Init();              // 115,200 bps
+  floatData();
+  Bench_Init();
+  Cases_Add();
+  Bench_RunAll();
+  Bench_Report(&UART_OutString, BENCH_CSV);
+  Bench_Report(&UART_OutString, BENCH_JSON);
+  Regressions = Bench_Compare(&UART_OutString, Baseline, PERCENT);
+  while(1){
+  }
+}
+#endif
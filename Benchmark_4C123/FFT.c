@@ -0,0 +1 @@
+../ProfileFFT_4C123/FFT.c
\ No newline at end of file
@@ -0,0 +1 @@
+../LinearInterpolation_4C123/Interp.c
\ No newline at end of file
@@ -0,0 +1 @@
+../ESP8266_4C123/pll.c
\ No newline at end of file
@@ -0,0 +1,329 @@
+// Console.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Non-blocking command line for a serial terminal.  Each character
+// is handled as it arrives, so nothing waits for <enter>.  Command
+// names are found with a FNV-1a hash into a table of CONSOLE_HASH
+// slots with linear probing, built once by Console_Init, so the time
+// to find a command does not grow with the number of commands.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "Console.h"
+
+#define CR   0x0D
+#define LF   0x0A
+#define BS   0x08
+#define DEL  0x7F
+
+// private, so they do not clash with the user program
+static const console_cmd_t *Cmds;
+static uint32_t NumCmds;
+static uint8_t Slot[CONSOLE_HASH];    // command number+1, 0 if empty
+static char (*InChar)(void);
+static void (*OutChar)(char);
+static char CmdLine[CONSOLE_LINE+1];
+static uint32_t CmdLength;            // characters in CmdLine
+static int LastCR;                    // 1 if the last character was CR
+static console_arg_t CmdArgs[CONSOLE_ARGS];
+static uint32_t CmdErrors;
+
+// FNV-1a hash of a null terminated word
+static uint32_t hash(const char *pt){ uint32_t h;
+  h = 2166136261;
+  while(*pt){
+    h = (h^(uint8_t)*pt)*16777619;
+    pt++;
+  }
+  return h;
+}
+static int equal(const char *a, const char *b){
+  while(*a && (*a == *b)){
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
+// command with this name, 0 if none
+static const console_cmd_t *find(const char *name){ uint32_t i;
+  i = hash(name)&(CONSOLE_HASH-1);
+  while(Slot[i]){
+    if(equal(Cmds[Slot[i]-1].name, name)){
+      return &Cmds[Slot[i]-1];
+    }
+    i = (i+1)&(CONSOLE_HASH-1);
+  }
+  return 0;
+}
+
+//------------Console_OutString------------
+// Send a string with the outChar given to Console_Init
+// Input: pt  null terminated string
+// Output: none
+void Console_OutString(const char *pt){
+  while(*pt){
+    (*OutChar)(*pt);
+    pt++;
+  }
+}
+
+//------------Console_Init------------
+// Set up the command table and print the prompt.  A command named
+// help is built in unless the table has one.
+// Input: cmds     table of commands, must stay valid
+//        n        number of commands, less than CONSOLE_HASH
+//        inChar   returns the next character, 0 if none,
+//                 such as UART_InCharNonBlock
+//        outChar  sends one character, such as UART_OutChar
+// Output: 1 if successful, 0 if two commands have the same name
+int Console_Init(const console_cmd_t cmds[], uint32_t n,
+                 char (*inChar)(void), void (*outChar)(char)){
+  uint32_t i,j; int ok;
+  if(n >= CONSOLE_HASH){
+    n = CONSOLE_HASH-1;         // at least one slot stays empty
+  }
+  Cmds = cmds;
+  NumCmds = n;
+  InChar = inChar;
+  OutChar = outChar;
+  CmdLength = 0;
+  LastCR = 0;
+  CmdErrors = 0;
+  ok = 1;
+  for(i=0; i<CONSOLE_HASH; i++){
+    Slot[i] = 0;
+  }
+  for(i=0; i<n; i++){
+    if(find(cmds[i].name)){
+      ok = 0;                   // the first one is used
+      continue;
+    }
+    j = hash(cmds[i].name)&(CONSOLE_HASH-1);
+    while(Slot[j]){
+      j = (j+1)&(CONSOLE_HASH-1);
+    }
+    Slot[j] = i+1;
+  }
+  Console_OutString(CONSOLE_PROMPT);
+  return ok;
+}
+
+// convert one argument, type is u d x or s
+// returns 1 if successful, 0 if the word is not that type
+static int convert(char *pt, char type, console_arg_t *arg){
+  uint32_t n,digit,count,max; int negative;
+  if(type == 's'){
+    arg->s = pt;
+    return 1;
+  }
+  n = 0;
+  count = 0;
+  if(type == 'x'){
+    if((pt[0] == '0') && ((pt[1] == 'x') || (pt[1] == 'X'))){
+      pt = pt+2;
+    } else if(pt[0] == '$'){
+      pt++;
+    }
+    while(*pt){
+      if((*pt >= '0') && (*pt <= '9')){
+        digit = *pt-'0';
+      } else if((*pt >= 'A') && (*pt <= 'F')){
+        digit = *pt-'A'+10;
+      } else if((*pt >= 'a') && (*pt <= 'f')){
+        digit = *pt-'a'+10;
+      } else{
+        return 0;
+      }
+      if(count == 8){
+        return 0;               // more than 32 bits
+      }
+      n = n*16+digit;
+      count++;
+      pt++;
+    }
+    arg->u = n;
+    return count != 0;
+  }
+  negative = 0;
+  max = 4294967295u;
+  if(type == 'd'){
+    max = 2147483647;
+    if((*pt == '-') || (*pt == '+')){
+      negative = (*pt == '-');
+      max = max+negative;       // -2147483648 is allowed
+      pt++;
+    }
+  }
+  while(*pt){
+    if((*pt < '0') || (*pt > '9')){
+      return 0;
+    }
+    digit = *pt-'0';
+    if(n > (max-digit)/10){
+      return 0;                 // too big
+    }
+    n = n*10+digit;
+    count++;
+    pt++;
+  }
+  if(negative){
+    arg->d = (int32_t)(0u-n);
+  } else{
+    arg->u = n;
+  }
+  return count != 0;
+}
+
+static void error(const char *message, const char *word){
+  Console_OutString(message);
+  Console_OutString(word);
+  Console_OutString("\r\n");
+  CmdErrors++;
+}
+
+static void help(void){ uint32_t i;
+  for(i=0; i<NumCmds; i++){
+    Console_OutString(Cmds[i].name);
+    Console_OutString("  ");
+    Console_OutString(Cmds[i].help ? Cmds[i].help : "");
+    Console_OutString("\r\n");
+  }
+}
+
+// split the line into words, find the command and run it
+static void run(void){
+  char *word[CONSOLE_ARGS+1]; char *pt; uint32_t words,i; char type;
+  const console_cmd_t *cmd; const char *types;
+  CmdLine[CmdLength] = 0;
+  words = 0;
+  pt = CmdLine;
+  while(*pt){
+    while(*pt == ' '){
+      *pt = 0;
+      pt++;
+    }
+    if(*pt == 0){
+      break;
+    }
+    if(words > CONSOLE_ARGS){
+      error("? too many arguments: ", CmdLine);
+      return;
+    }
+    word[words] = pt;
+    words++;
+    while(*pt && (*pt != ' ')){
+      pt++;
+    }
+  }
+  if(words == 0){
+    return;                     // empty line
+  }
+  cmd = find(word[0]);
+  if(cmd == 0){
+    if(equal(word[0], "help")){
+      help();
+    } else{
+      error("? unknown command: ", word[0]);
+    }
+    return;
+  }
+  types = cmd->args ? cmd->args : "";
+  for(i=0; types[i] && (i < CONSOLE_ARGS); i++){
+    type = types[i];
+    if((type >= 'A') && (type <= 'Z')){
+      if(i+1 >= words){
+        break;                  // optional and left off
+      }
+      type = type+('a'-'A');
+    }
+    if(i+1 >= words){
+      error("? missing argument: ", cmd->name);
+      return;
+    }
+    if(!convert(word[i+1], type, &CmdArgs[i])){
+      error("? bad argument: ", word[i+1]);
+      return;
+    }
+  }
+  if(i+1 < words){
+    error("? too many arguments: ", cmd->name);
+    return;
+  }
+  (*cmd->handler)(words-1, CmdArgs);
+}
+
+//------------Console_Input------------
+// Handle one received character: echo it, or erase with backspace
+// or DEL, or run the command line on CR or LF.
+// Input: letter  ASCII character
+// Output: 1 if a command line was finished, 0 otherwise
+int Console_Input(char letter){ int lastCR;
+  lastCR = LastCR;
+  LastCR = (letter == CR);
+  if((letter == CR) || (letter == LF)){
+    if((letter == LF) && lastCR){
+      return 0;                 // second half of CR LF
+    }
+    Console_OutString("\r\n");
+    run();
+    CmdLength = 0;
+    Console_OutString(CONSOLE_PROMPT);
+    return 1;
+  }
+  if((letter == BS) || (letter == DEL)){
+    if(CmdLength){
+      CmdLength--;
+      Console_OutString("\b \b");
+    }
+    return 0;
+  }
+  if(letter == '\t'){
+    letter = ' ';
+  }
+  if((letter < ' ') || (CmdLength >= CONSOLE_LINE)){
+    return 0;                   // ignored, not echoed
+  }
+  CmdLine[CmdLength] = letter;
+  CmdLength++;
+  (*OutChar)(letter);
+  return 0;
+}
+
+//------------Console_Poll------------
+// Handle every character inChar has, call from the main loop.
+// Returns without waiting when no character is ready.
+// Input: none
+// Output: number of command lines finished
+uint32_t Console_Poll(void){ uint32_t count,lines; char letter;
+  lines = 0;
+  for(count=0; count<CONSOLE_LINE; count++){ // bounded time per call
+    letter = (*InChar)();
+    if(letter == 0){
+      break;
+    }
+    lines = lines+Console_Input(letter);
+  }
+  return lines;
+}
+
+//------------Console_Errors------------
+// Input: none
+// Output: number of lines with an unknown command or bad arguments
+uint32_t Console_Errors(void){
+  return CmdErrors;
+}
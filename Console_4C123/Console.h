@@ -0,0 +1,90 @@
+// Console.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Non-blocking command line for a serial terminal.  Characters are
+// given to the console one at a time as they arrive, so the main
+// program never waits for a person to finish typing.  The console
+// echoes, handles backspace, and when <enter> is typed finds the
+// command in a hash table, converts its arguments and calls it.
+// UART_InUDec, UART_InUHex and UART_InString still work, but they
+// spin in UART_InChar until <enter>.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __CONSOLE_H__
+#define __CONSOLE_H__
+
+#define CONSOLE_LINE  64      // longest command line, characters
+#define CONSOLE_ARGS  8       // most arguments to one command
+#define CONSOLE_HASH  64      // hash table size, power of 2, more than the commands
+#define CONSOLE_PROMPT "> "
+
+// one converted argument, which member depends on its type
+typedef union console_arg{
+  uint32_t u;        // 'u' unsigned decimal or 'x' hexadecimal
+  int32_t d;         // 'd' signed decimal
+  char *s;           // 's' word, points into the line
+} console_arg_t;
+
+typedef struct console_cmd{
+  const char *name;  // word typed to run it
+  // called with the number of arguments typed and their values
+  void (*handler)(uint32_t argc, const console_arg_t argv[]);
+  const char *args;  // one letter per argument: u d x s, upper case
+                     // U D X S for arguments that may be left off
+  const char *help;  // one line for the help command
+} console_cmd_t;
+
+//------------Console_Init------------
+// Set up the command table and print the prompt.  A command named
+// help is built in unless the table has one.
+// Input: cmds     table of commands, must stay valid
+//        n        number of commands, less than CONSOLE_HASH
+//        inChar   returns the next character, 0 if none,
+//                 such as UART_InCharNonBlock
+//        outChar  sends one character, such as UART_OutChar
+// Output: 1 if successful, 0 if two commands have the same name
+int Console_Init(const console_cmd_t cmds[], uint32_t n,
+                 char (*inChar)(void), void (*outChar)(char));
+
+//------------Console_Input------------
+// Handle one received character: echo it, or erase with backspace
+// or DEL, or run the command line on CR or LF.
+// Input: letter  ASCII character
+// Output: 1 if a command line was finished, 0 otherwise
+int Console_Input(char letter);
+
+//------------Console_Poll------------
+// Handle every character inChar has, call from the main loop.
+// Returns without waiting when no character is ready.
+// Input: none
+// Output: number of command lines finished
+uint32_t Console_Poll(void);
+
+//------------Console_OutString------------
+// Send a string with the outChar given to Console_Init
+// Input: pt  null terminated string
+// Output: none
+void Console_OutString(const char *pt);
+
+//------------Console_Errors------------
+// Input: none
+// Output: number of lines with an unknown command or bad arguments
+uint32_t Console_Errors(void);
+
+#endif //  __CONSOLE_H__
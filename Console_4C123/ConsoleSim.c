@@ -0,0 +1,166 @@
+// ConsoleSim.c
+// Runs on a PC, not on the LaunchPad
+// Type command lines into Console.c at 10 characters per second,
+// one simulated ms at a time, and compare two main loops that each
+// run Control once per ms:
+//   blocking  when a character arrives, read the whole line the way
+//             UART_InString does, then run it
+//   console   call Console_Poll, which never waits
+// Reports the longest time between two runs of Control for each,
+// checks the results of the commands, and prints the transcript.
+//   gcc ConsoleSim.c Console.c -o ConsoleSim
+//   ./ConsoleSim
+// Exits with 1 if a command did not do what was typed.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "Console.h"
+
+#define CHARTIME 100          // ms between typed characters
+
+// what is typed, including mistakes, backspaces and CR LF
+const char Script[] =
+  "led 4\r"
+  "blink 250\r\n"
+  "addd\b -7 12\r"
+  "add 2147483647\r"
+  "frob\r"                    // unknown command
+  "blink 0x10\r"              // bad argument
+  "led\r"                     // missing argument
+  "add 1 2 3\r"               // too many arguments
+  "  add   -2147483648   5 \r"
+  "help\r"
+  "led\t0xA\r";
+
+uint32_t Now;                 // simulated ms
+uint32_t Next;                // index of the next character in Script
+int Blocking;                 // 1 while a line is read the old way
+int Quiet;                    // 1 to not print the transcript
+uint32_t Runs,Worst,LastRun;
+uint32_t Color,Period;
+int32_t Sums[8];
+uint32_t NumSums;
+
+// the control loop
+void Control(void){
+  if(Now-LastRun > Worst){
+    Worst = Now-LastRun;
+  }
+  LastRun = Now;
+  Runs++;
+}
+
+// next typed character, 0 if the person has not typed it yet
+char inChar(void){
+  if((Script[Next] == 0) || (Now < (Next+1)*CHARTIME)){
+    return 0;
+  }
+  Next++;
+  return Script[Next-1];
+}
+void outChar(char letter){
+  if(!Quiet){
+    putchar(letter);
+  }
+}
+
+void Led(uint32_t argc, const console_arg_t argv[]){ (void)argc; Color = argv[0].u; }
+void Blink(uint32_t argc, const console_arg_t argv[]){ (void)argc; Period = argv[0].u; }
+void Add(uint32_t argc, const console_arg_t argv[]){ int32_t sum;
+  sum = argv[0].d;
+  if(argc > 1){
+    sum = sum+argv[1].d;
+  }
+  if(NumSums < 8){
+    Sums[NumSums++] = sum;
+  }
+}
+const console_cmd_t Commands[3]={
+  {"led",   &Led,   "x",  "led <hex>"},
+  {"blink", &Blink, "u",  "blink <ms>"},
+  {"add",   &Add,   "dD", "add <n> [m]"}
+};
+
+// like UART_InString, spins until <enter>, time keeps going
+void readLine(char first){ char letter;
+  letter = first;
+  for(;;){
+    Console_Input(letter);
+    if((letter == '\r') || (letter == '\n')){
+      return;
+    }
+    do{
+      Now++;                  // stuck waiting, Control does not run
+      letter = inChar();
+    } while(letter == 0);
+  }
+}
+
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+// run the whole script, returns the worst time between Control runs
+uint32_t simulate(int blocking, double *pollTime){
+  char letter; double start,t;
+  Now = Next = 0;
+  Runs = Worst = LastRun = 0;
+  Color = Period = 0;
+  NumSums = 0;
+  *pollTime = 0;
+  Console_Init(Commands, 3, &inChar, &outChar);
+  while(Script[Next] || (Now < (Next+1)*CHARTIME)){
+    Control();
+    if(blocking){
+      letter = inChar();
+      if(letter){
+        readLine(letter);
+      }
+    } else{
+      start = seconds();
+      Console_Poll();
+      t = seconds()-start;
+      if(t > *pollTime){
+        *pollTime = t;
+      }
+    }
+    Now++;
+  }
+  return Worst;
+}
+
+int main(void){ uint32_t worstBlocking,worstConsole; double pollTime; int ok;
+  Quiet = 1;
+  worstBlocking = simulate(1, &pollTime);
+  Quiet = 0;
+  worstConsole = simulate(0, &pollTime);
+  printf("\n\n%u characters typed at %u ms each\n", (uint32_t)strlen(Script), CHARTIME);
+  printf("blocking: longest time between Control runs %u ms\n", worstBlocking);
+  printf("console:  longest time between Control runs %u ms, "
+         "longest Console_Poll %.1f us on this PC\n", worstConsole, 1e6*pollTime);
+  ok = (Color == 0xA) && (Period == 250) && (NumSums == 3) &&
+       (Sums[0] == 5) && (Sums[1] == 2147483647) && (Sums[2] == -2147483643) &&
+       (Console_Errors() == 4);
+  printf("commands %s, %u errors reported\n", ok ? "correct" : "WRONG", Console_Errors());
+  return ok ? 0 : 1;
+}
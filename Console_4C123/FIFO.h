@@ -0,0 +1 @@
+../ESP8266_4C123/FIFO.h
\ No newline at end of file
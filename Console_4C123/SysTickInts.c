@@ -0,0 +1 @@
+../PeriodicSysTickInts_4C123/SysTickInts.c
\ No newline at end of file
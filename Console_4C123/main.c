@@ -0,0 +1,125 @@
+// main.c
+// Runs on LM4F120/TM4C123
+// Command line on UART0 that does not stop the main loop.  SysTick
+// interrupts every 1 ms and the main loop runs Control once per
+// tick, blinking the LaunchPad LED.  In between it calls
+// Console_Poll, which handles whatever characters have arrived and
+// returns.  With UART_InUDec the loop would stop for as long as it
+// takes to type a number; stats shows the longest time between two
+// runs of Control.
+// Connect a terminal to UART0 at 115,200 bps and type help.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "../inc/tm4c123gh6pm.h"
+#include "PLL.h"
+#include "UART.h"
+#include "SysTickInts.h"
+#include "Console.h"
+
+#define LEDS (*((volatile uint32_t *)0x40025038))  // PF3-1
+#define RED       0x02
+#define BLUE      0x04
+#define GREEN     0x08
+
+void EnableInterrupts(void);  // Enable interrupts
+
+volatile uint32_t Ticks;      // ms since reset
+uint32_t Color = GREEN;       // LED when on
+uint32_t Period = 500;        // ms between LED toggles
+uint32_t Count;               // ms since the last toggle
+uint32_t Runs;                // times Control has run
+uint32_t Worst;               // most ms between two runs of Control
+
+void SysTick_Handler(void){
+  Ticks++;
+}
+
+// the control loop, run once per ms
+void Control(void){
+  Count++;
+  if(Count >= Period){
+    Count = 0;
+    LEDS = LEDS^Color;
+  }
+  Runs++;
+}
+
+//**********commands***********
+void Led(uint32_t argc, const console_arg_t argv[]){
+  LEDS = 0;
+  Color = argv[0].u&(RED|BLUE|GREEN);
+}
+void Blink(uint32_t argc, const console_arg_t argv[]){
+  if(argv[0].u){
+    Period = argv[0].u;
+  }
+}
+void Add(uint32_t argc, const console_arg_t argv[]){ int32_t sum;
+  sum = argv[0].d;
+  if(argc > 1){
+    sum = sum+argv[1].d;
+  }
+  UART_Printf("%d\r\n", sum);
+}
+void Stats(uint32_t argc, const console_arg_t argv[]){
+  UART_Printf("ms=%u runs=%u worst=%u ms errors=%u\r\n",
+              Ticks, Runs, Worst, Console_Errors());
+}
+void Clear(uint32_t argc, const console_arg_t argv[]){
+  Worst = 0;
+}
+const console_cmd_t Commands[5]={
+//  name     handler  args  help
+  {"led",    &Led,    "x",  "led <hex>  2=red 4=blue 8=green"},
+  {"blink",  &Blink,  "u",  "blink <ms>  time between toggles"},
+  {"add",    &Add,    "dD", "add <n> [m]  signed sum"},
+  {"stats",  &Stats,  "",   "stats  control loop timing"},
+  {"clear",  &Clear,  "",   "clear  reset worst time"}
+};
+
+int main(void){ uint32_t last,now; volatile uint32_t delay;
+  PLL_Init(Bus80MHz);         // bus clock at 80 MHz
+  UART_Init();                // 115,200 bps
+  SYSCTL_RCGCGPIO_R |= 0x20;  // activate port F
+  delay = SYSCTL_RCGCGPIO_R;  // allow time to finish
+  GPIO_PORTF_DIR_R |= 0x0E;   // make PF3-1 output (PF3-1 built-in LEDs)
+  GPIO_PORTF_AFSEL_R &= ~0x0E;// disable alt funct on PF3-1
+  GPIO_PORTF_DEN_R |= 0x0E;   // enable digital I/O on PF3-1
+                              // configure PF3-1 as GPIO
+  GPIO_PORTF_PCTL_R = (GPIO_PORTF_PCTL_R&0xFFFF000F)+0x00000000;
+  GPIO_PORTF_AMSEL_R &= ~0x0E;// disable analog functionality on PF3-1
+  LEDS = 0;
+  SysTick_Init(80000);        // 1 ms
+  EnableInterrupts();
+  UART_OutString("Console, type help\r\n");
+  Console_Init(Commands, 5, &UART_InCharNonBlock, &UART_OutChar);
+  last = Ticks;
+  while(1){
+    now = Ticks;
+    if(now != last){
+      if(now-last > Worst){
+        Worst = now-last;     // 1 unless the loop was held up
+      }
+      last = now;
+      Control();
+    }
+    Console_Poll();           // never waits
+  }
+}
@@ -0,0 +1,207 @@
+// ATParse.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Streaming parser for ESP8266 responses, see ATParse.h.  All of the
+// responses are found in one pass with an Aho-Corasick automaton.
+// The responses are put in a trie, each state gets a failure link to
+// the longest suffix that is also in the trie, and then the links are
+// followed ahead of time to fill a complete next-state table.  So
+// each received character costs two table lookups, with no backing
+// up, and a response that starts inside another, like the ready in
+// rready, is still found, which a single index that starts over on
+// a mismatch misses.  Characters are put in classes first, one class
+// for each letter in the responses and one for everything else, so
+// the table is states by classes, not states by 256.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2016
+
+ Copyright 2016 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "ATParse.h"
+
+#define AT_STATES  64         // more than the letters in all responses
+#define AT_CLASSES 32         // more than the different letters
+#define MATCH   0             // modes
+#define LENGTH  1
+#define DATA    2
+#define MAXLENGTH 0x00FFFFFF  // longer +IPD lengths are garbage
+
+typedef struct at_response{
+  const char *text;           // lower case
+  uint32_t id;
+} at_response_t;
+const at_response_t ATResponses[8]={
+  {"ok\r\n",      AT_OK},
+  {"error",       AT_ERROR},
+  {"fail",        AT_FAIL},
+  {"ready",       AT_READY},
+  {"no change",   AT_NOCHANGE},
+  {"send ok",     AT_SENDOK},
+  {"closed",      AT_CLOSED},
+  {"+ipd,",       AT_IPD}
+};
+
+uint8_t ATClass[256];                 // class of each character
+uint8_t ATNext[AT_STATES][AT_CLASSES];// next state, 0 is the start
+uint8_t ATOut[AT_STATES];             // responses that end in this state
+int ATBuilt;                          // 1 after the tables are made
+
+// make the tables, once
+static void build(void){
+  uint8_t fail[AT_STATES],queue[AT_STATES];
+  uint32_t i,c,s,r,states,classes,head,tail; const char *pt;
+  for(c=0; c<256; c++){
+    ATClass[c] = 0;
+  }
+  classes = 1;
+  states = 1;
+  for(i=0; i<8; i++){         // the trie
+    s = 0;
+    for(pt=ATResponses[i].text; *pt; pt++){
+      c = (uint8_t)*pt;
+      if(ATClass[c] == 0){
+        ATClass[c] = classes;
+        if((c >= 'a') && (c <= 'z')){
+          ATClass[c-0x20] = classes;  // upper case too
+        }
+        classes++;
+      }
+      if(ATNext[s][ATClass[c]] == 0){
+        ATNext[s][ATClass[c]] = states;
+        states++;
+      }
+      s = ATNext[s][ATClass[c]];
+    }
+    ATOut[s] |= ATResponses[i].id;
+  }
+  head = tail = 0;            // breadth first, shorter states first
+  for(c=0; c<classes; c++){
+    s = ATNext[0][c];
+    if(s){
+      fail[s] = 0;
+      queue[tail] = s;
+      tail++;
+    }
+  }
+  while(head < tail){
+    r = queue[head];
+    head++;
+    ATOut[r] |= ATOut[fail[r]];       // responses that end inside this one
+    for(c=0; c<classes; c++){
+      s = ATNext[r][c];
+      if(s){
+        fail[s] = ATNext[fail[r]][c];
+        queue[tail] = s;
+        tail++;
+      } else{
+        ATNext[r][c] = ATNext[fail[r]][c];
+      }
+    }
+  }
+  ATBuilt = 1;
+}
+
+//------------ATParse_Init------------
+// Start looking for responses
+// Input: p      parser state
+//        buf    place for the data after +IPD
+//        size   bytes in buf, longer data is counted but not kept
+//        event  called with each response found, from the context
+//               that calls ATParse_Input
+// Output: none
+void ATParse_Init(at_parser_t *p, char *buf, uint32_t size,
+                  void (*event)(const at_event_t *e)){
+  if(!ATBuilt){
+    build();
+  }
+  p->state = 0;
+  p->mode = MATCH;
+  p->length = 0;
+  p->count = 0;
+  p->buf = buf;
+  p->size = size;
+  p->event = event;
+}
+
+static void send(at_parser_t *p, uint32_t id){ at_event_t e;
+  e.id = id;
+  e.data = 0;
+  e.len = e.total = 0;
+  if(id == AT_IPD){
+    e.data = p->buf;
+    e.total = p->length;
+    e.len = (p->length < p->size) ? p->length : p->size;
+  }
+  if(p->event){
+    (*p->event)(&e);
+  }
+}
+
+//------------ATParse_Input------------
+// Handle one received character, no loops or searches, so it can
+// run in the UART receive interrupt
+// Input: p       parser state
+//        letter  received character
+// Output: AT_OK to AT_IPD for the responses that ended with this
+//         character, 0 if none
+uint32_t ATParse_Input(at_parser_t *p, char letter){ uint32_t found,id;
+  if(p->mode == DATA){
+    if(p->count < p->size){
+      p->buf[p->count] = letter;
+    }
+    p->count++;
+    if(p->count < p->length){
+      return 0;
+    }
+    p->mode = MATCH;
+    p->state = 0;
+    send(p, AT_IPD);
+    return AT_IPD;
+  }
+  if(p->mode == LENGTH){
+    if((letter >= '0') && (letter <= '9') && (p->length < MAXLENGTH/10)){
+      p->length = p->length*10+(letter-'0');
+      return 0;
+    }
+    if(letter == ','){
+      p->length = 0;          // that was the link number
+      return 0;
+    }
+    if((letter == ':') && p->length){
+      p->mode = DATA;
+      p->count = 0;
+      return 0;
+    }
+    p->mode = MATCH;          // not +IPD after all, look at letter again
+    p->state = 0;
+  }
+  p->state = ATNext[p->state][ATClass[(uint8_t)letter]];
+  found = ATOut[p->state];
+  if(found == 0){
+    return 0;
+  }
+  if(found&AT_IPD){
+    p->mode = LENGTH;         // the event comes after the data
+    p->length = 0;
+    found &= ~AT_IPD;
+  }
+  for(id=AT_OK; id<AT_IPD; id=id<<1){
+    if(found&id){
+      send(p, id);
+    }
+  }
+  return found;
+}
@@ -0,0 +1,86 @@
+// ATParse.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Streaming parser for the responses of an ESP8266 AT command modem.
+// Every received character is given to ATParse_Input once, and all
+// of the responses below are looked for at the same time, upper or
+// lower case.  Each one found is handed back as an event.  After
+// +IPD, the length and the data are collected, and the data is
+// handed back with the event, not searched for responses.
+//   AT_OK        OK<CR><LF>, also the end of SEND OK
+//   AT_ERROR     ERROR
+//   AT_FAIL      FAIL
+//   AT_READY     ready
+//   AT_NOCHANGE  no change
+//   AT_SENDOK    SEND OK
+//   AT_CLOSED    CLOSED
+//   AT_IPD       +IPD,<length>:<data> or +IPD,<link>,<length>:<data>
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2016
+
+ Copyright 2016 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __ATPARSE_H__
+#define __ATPARSE_H__
+
+// events, one bit each so a set of them fits in one number
+#define AT_OK        0x01
+#define AT_ERROR     0x02
+#define AT_FAIL      0x04
+#define AT_READY     0x08
+#define AT_NOCHANGE  0x10
+#define AT_SENDOK    0x20
+#define AT_CLOSED    0x40
+#define AT_IPD       0x80
+
+typedef struct at_event{
+  uint32_t id;       // AT_OK to AT_IPD
+  const char *data;  // AT_IPD data, 0 for the others
+  uint32_t len;      // bytes at data, at most the buffer size
+  uint32_t total;    // AT_IPD length sent by the modem, can be more than len
+} at_event_t;
+
+typedef struct at_parser{
+  uint8_t state;     // matching state
+  uint8_t mode;      // looking for responses, reading a length, or data
+  uint32_t length;   // +IPD length
+  uint32_t count;    // +IPD data bytes received
+  char *buf;         // +IPD data goes here
+  uint32_t size;     // bytes in buf
+  void (*event)(const at_event_t *e);
+} at_parser_t;
+
+//------------ATParse_Init------------
+// Start looking for responses
+// Input: p      parser state
+//        buf    place for the data after +IPD
+//        size   bytes in buf, longer data is counted but not kept
+//        event  called with each response found, from the context
+//               that calls ATParse_Input
+// Output: none
+void ATParse_Init(at_parser_t *p, char *buf, uint32_t size,
+                  void (*event)(const at_event_t *e));
+
+//------------ATParse_Input------------
+// Handle one received character, no loops or searches, so it can
+// run in the UART receive interrupt
+// Input: p       parser state
+//        letter  received character
+// Output: AT_OK to AT_IPD for the responses that ended with this
+//         character, 0 if none
+uint32_t ATParse_Input(at_parser_t *p, char letter);
+
+#endif //  __ATPARSE_H__
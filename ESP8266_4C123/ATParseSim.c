@@ -0,0 +1,336 @@
+// ATParseSim.c
+// Runs on a PC, not on the LaunchPad
+// Checks ATParse.c against the obvious method: at each character,
+// compare every response that could end there.  The two must find
+// the same responses at the same characters, with the same +IPD
+// data, on
+//   1) the sample ESP8266 transcripts below, and on capture files
+//      given on the command line (bytes saved from the serial port)
+//   2) random streams made of responses, parts of responses, +IPD
+//      packets with good and bad lengths, and random bytes
+// Also counts what the old single-index SearchCheck finds in the
+// transcripts, which starts over on a mismatch and misses
+// responses that start inside another.
+//   gcc ATParseSim.c ATParse.c -o ATParseSim
+//   ./ATParseSim [capture files]
+// Exits with 1 if the two methods ever disagree.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2016
+
+ Copyright 2016 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ATParse.h"
+
+#define MAXEVENTS 8192
+#define STREAMSIZE 65536
+#define STREAMS 20000         // random streams
+
+// the same responses as ATParse.c, in the same order
+const char *Text[8]={"ok\r\n","error","fail","ready","no change","send ok","closed","+ipd,"};
+
+// sample sessions, the modem echoes each command
+const char Boot[]=
+  "AT+RST\r\r\n\r\nOK\r\n"
+  "\x02\x8c\xe4r\x9c\x0c\x8cl\x9c\x04rrl\x8c\xe4n\x0c\x0cr"  // 74880 bps boot text
+  "ready\r\n"
+  "AT+CWMODE=1\r\r\nno change\r\n"
+  "AT+CWJAP=\"ValvanoAP\",\"12345678\"\r\r\n\r\nOK\r\n"
+  "AT+CIFSR\r\r\n192.168.1.117\r\n\r\nOK\r\n"
+  "AT+CWLAP\r\r\n+CWLAP:(3,\"ValvanoAP\",-52,\"1a:fe:34:a0:b1:c2\",6)\r\n"
+  "+CWLAP:(4,\"Brook\",-80,\"00:24:a5:10:22:3b\",11)\r\n\r\nOK\r\n"
+  "AT+CIPMODE=0\r\r\n\r\nOK\r\n";
+const char Fetch[]=
+  "AT+CIPSTATUS\r\r\nSTATUS:5\r\n\r\nOK\r\n"
+  "AT+CIPSTART=\"TCP\",\"api.openweathermap.org\",80\r\r\n\r\nOK\r\nLinked\r\n"
+  "AT+CIPSEND=118\r\r\n> GET /data/2.5/weather?q=Austin%20Texas HTTP/1.1\r\n"
+  "Host:api.openweathermap.org\r\n\r\n\r\nSEND OK\r\n"
+  "\r\n+IPD,159:HTTP/1.1 200 OK\r\nServer: openresty\r\nContent-Length: 82\r\n"
+  "Connection: close\r\n\r\n{\"weather\":[{\"main\":\"Clouds\"}],\"cod\":200,"
+  "\"message\":\"ERROR free, no change, ready\"}\r\nOK\r\n"
+  "\r\nOK\r\nUnlink\r\n"
+  "AT+CIPCLOSE\r\r\nlink is not\r\nERROR\r\n";
+const char Server[]=
+  "AT+CIPMUX=1\r\r\n\r\nOK\r\n"
+  "AT+CIPSERVER=1,80\r\r\n\r\nOK\r\n"
+  "Link\r\n\r\n+IPD,0,37:GET /?message=ok+send+ok HTTP/1.1\r\n\r\nOK\r\n"
+  "+IPD,1,5:hello\r\nOK\r\n"
+  "++IPD,0,3:abc"             // starts over inside a response
+  "+IPD,x:busy p...\r\n"      // bad length
+  "0,CLOSED\r\n1,CLOSED\r\n"
+  "AT+CIPSEND=0,12\r\r\n> FAIL\r\nERROR\r\n";
+
+typedef struct result{
+  uint32_t id,pos;            // response and character where it ended
+  uint32_t len,total;         // +IPD data kept and sent
+  uint32_t hash;              // of the data kept
+} result_t;
+result_t Found[MAXEVENTS],Expect[MAXEVENTS];
+uint32_t NumFound,NumExpect;
+uint32_t Pos;                 // character being parsed
+char Stream[STREAMSIZE];
+char Data[2048];
+
+uint32_t fnv(const char *pt, uint32_t len){ uint32_t h;
+  h = 2166136261u;
+  while(len){
+    h = (h^(uint8_t)*pt)*16777619u;
+    pt++;
+    len--;
+  }
+  return h;
+}
+
+void add(result_t *list, uint32_t *num, uint32_t id, uint32_t pos,
+         const char *data, uint32_t len, uint32_t total){
+  if(*num < MAXEVENTS){
+    list[*num].id = id;
+    list[*num].pos = pos;
+    list[*num].len = len;
+    list[*num].total = total;
+    list[*num].hash = fnv(data, len);
+    (*num)++;
+  }
+}
+
+void event(const at_event_t *e){
+  add(Found, &NumFound, e->id, Pos, e->data, e->len, e->total);
+}
+
+// run ATParse over a stream
+void parse(const char *s, uint32_t n, uint32_t size){ at_parser_t p;
+  NumFound = 0;
+  ATParse_Init(&p, Data, size, &event);
+  for(Pos=0; Pos<n; Pos++){
+    ATParse_Input(&p, s[Pos]);
+  }
+}
+
+static int endsWith(const char *s, uint32_t start, uint32_t end, const char *text){
+  uint32_t len,k; char c;
+  len = strlen(text);
+  if(end-start < len){
+    return 0;
+  }
+  for(k=0; k<len; k++){
+    c = s[end-len+k];
+    if((c >= 'A') && (c <= 'Z')){
+      c = c+0x20;
+    }
+    if(c != text[k]){
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// the obvious method, the responses are looked for from start on
+void reference(const char *s, uint32_t n, uint32_t size){
+  uint32_t i,j,r,start,length,ipd;
+  NumExpect = 0;
+  start = 0;
+  i = 0;
+  while(i < n){
+    ipd = 0;
+    for(r=0; r<8; r++){
+      if(endsWith(s, start, i+1, Text[r])){
+        if(r == 7){
+          ipd = 1;
+        } else{
+          add(Expect, &NumExpect, 1<<r, i, 0, 0, 0);
+        }
+      }
+    }
+    if(!ipd){
+      i++;
+      continue;
+    }
+    length = 0;               // +IPD,[link,]length:data
+    for(j=i+1; j<n; j++){
+      if((s[j] >= '0') && (s[j] <= '9') && (length < 0x00FFFFFF/10)){
+        length = length*10+(s[j]-'0');
+      } else if(s[j] == ','){
+        length = 0;
+      } else{
+        break;
+      }
+    }
+    if(j >= n){
+      return;                 // stream ended in the length
+    }
+    if((s[j] != ':') || (length == 0)){
+      start = i = j;          // look at s[j] again
+      continue;
+    }
+    if(j+length >= n){
+      return;                 // stream ended in the data
+    }
+    add(Expect, &NumExpect, 1<<7, j+length, &s[j+1],
+        length < size ? length : size, length);
+    start = i = j+length+1;
+  }
+}
+
+// 1 if the two lists are the same
+int compare(const char *name){ uint32_t i;
+  if(NumFound != NumExpect){
+    printf("%s: ATParse found %u responses, expected %u\n", name, NumFound, NumExpect);
+    return 0;
+  }
+  for(i=0; i<NumFound; i++){
+    if(memcmp(&Found[i], &Expect[i], sizeof(result_t))){
+      printf("%s: response %u is %02X at %u, expected %02X at %u\n", name, i,
+             Found[i].id, Found[i].pos, Expect[i].id, Expect[i].pos);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// how many times the old SearchCheck finds text, started again after each find
+uint32_t oldSearch(const char *s, uint32_t n, const char *text){
+  uint32_t i,index,count; char c;
+  index = count = 0;
+  for(i=0; i<n; i++){
+    c = s[i];
+    if((c >= 'A') && (c <= 'Z')){
+      c = c+0x20;
+    }
+    if(text[index] == c){
+      index++;
+      if(text[index] == 0){
+        count++;
+        index = 0;
+      }
+    } else{
+      index = 0;              // start over
+    }
+  }
+  return count;
+}
+
+uint32_t count(uint32_t id){ uint32_t i,n;
+  n = 0;
+  for(i=0; i<NumFound; i++){
+    if(Found[i].id == id){
+      n++;
+    }
+  }
+  return n;
+}
+
+// check one stream, with a big +IPD buffer and with a small one
+int check(const char *name, const char *s, uint32_t n){
+  parse(s, n, sizeof(Data));
+  reference(s, n, sizeof(Data));
+  if(!compare(name)){
+    return 0;
+  }
+  parse(s, n, 16);
+  reference(s, n, 16);
+  return compare(name);
+}
+
+int transcript(const char *name, const char *s, uint32_t n){ int ok;
+  ok = check(name, s, n);
+  parse(s, n, sizeof(Data));
+  printf("%-8s %5u bytes  OK %u ERROR %u ready %u +IPD %u CLOSED %u   "
+         "old search: ready %u +ipd, %u\n", name, n,
+         count(AT_OK), count(AT_ERROR), count(AT_READY), count(AT_IPD), count(AT_CLOSED),
+         oldSearch(s, n, "ready"), oldSearch(s, n, "+ipd,"));
+  return ok;
+}
+
+// random stream made of pieces that are likely to confuse a matcher
+uint32_t randomStream(char *s){ uint32_t n,pieces,k,len,j; const char *t;
+  n = 0;
+  pieces = 1+rand()%200;
+  for(k=0; (k<pieces) && (n < STREAMSIZE-1200); k++){
+    t = Text[rand()%8];
+    len = strlen(t);
+    switch(rand()%6){
+      case 0:                 // whole response, random case
+      case 1:
+        for(j=0; j<len; j++){
+          s[n++] = (rand()%2 && (t[j] >= 'a')) ? t[j]-0x20 : t[j];
+        }
+        break;
+      case 2:                 // start of a response
+        len = rand()%len;
+        memcpy(&s[n], t, len);
+        n = n+len;
+        break;
+      case 3:                 // letters from the responses
+        len = 1+rand()%8;
+        for(j=0; j<len; j++){
+          t = Text[rand()%8];
+          s[n++] = t[rand()%strlen(t)];
+        }
+        break;
+      case 4:                 // +IPD packet, sometimes broken
+        n = n+sprintf(&s[n], rand()%2 ? "+IPD," : "+ipd,%u,", rand()%5);
+        len = rand()%4 ? rand()%40 : rand()%1000;
+        n = n+sprintf(&s[n], rand()%8 ? "%u" : "%uz", len);
+        if(rand()%8){
+          s[n++] = ':';
+        }
+        for(j=0; j<len; j++){
+          s[n++] = rand()%2 ? "OK\r\n+IPD,1:"[rand()%11] : (char)rand();
+        }
+        break;
+      default:                // any bytes
+        len = 1+rand()%4;
+        for(j=0; j<len; j++){
+          s[n++] = (char)rand();
+        }
+        break;
+    }
+  }
+  return n;
+}
+
+int main(int argc, char *argv[]){
+  FILE *in; uint32_t n,events; int i,ok;
+  ok = transcript("boot", Boot, strlen(Boot));
+  ok = transcript("fetch", Fetch, strlen(Fetch)) && ok;
+  ok = transcript("server", Server, strlen(Server)) && ok;
+  for(i=1; i<argc; i++){
+    in = fopen(argv[i], "rb");
+    if(in == 0){
+      perror(argv[i]);
+      return 1;
+    }
+    n = fread(Stream, 1, STREAMSIZE, in);
+    fclose(in);
+    ok = transcript(argv[i], Stream, n) && ok;
+  }
+  srand(1);
+  events = 0;
+  for(i=0; i<STREAMS; i++){
+    n = randomStream(Stream);
+    if(!check("random", Stream, n)){
+      ok = 0;
+      break;
+    }
+    events = events+NumFound;
+  }
+  printf("%d random streams, %u responses found\n", i, events);
+  printf("ATParse and the obvious method %s\n", ok ? "agree" : "DISAGREE");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,305 @@
+// Format.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Number to ASCII conversion shared by the UART and LCD drivers.
+// The number of digits is found first, then the digits are written
+// from the right two at a time.  q = n/100 is ((uint64_t)n*0x51EB851F)>>37,
+// one UMULL on the Cortex M4, exact for every 32-bit n, and the
+// remainder n-100*q is the index into a table of "00" to "99".
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdarg.h>
+#include "Format.h"
+
+#define DIV100(n) ((uint32_t)(((uint64_t)(n)*0x51EB851F)>>37))
+
+static const char DigitPairs[201] =
+  "00010203040506070809101112131415161718192021222324"
+  "25262728293031323334353637383940414243444546474849"
+  "50515253545556575859606162636465666768697071727374"
+  "75767778798081828384858687888990919293949596979899";
+static const uint32_t Powers[9] = {
+  10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+static const char Upper[16] = "0123456789ABCDEF";
+static const char Lower[16] = "0123456789abcdef";
+
+//------------Format_UDec------------
+// Unsigned decimal, 1 to 10 digits with no spaces
+// Input: pt  buffer of at least FORMAT_SIZE characters
+//        n   0 to 4294967295
+// Output: number of characters, the string is null terminated
+uint32_t Format_UDec(char *pt, uint32_t n){ uint32_t len,q,r;
+  len = 1;
+  while((len < 10) && (n >= Powers[len-1])){
+    len++;
+  }
+  pt = pt+len;
+  *pt = 0;
+  while(n >= 100){
+    q = DIV100(n);
+    r = 2*(n - 100*q);
+    pt = pt-2;
+    pt[0] = DigitPairs[r];
+    pt[1] = DigitPairs[r+1];
+    n = q;
+  }
+  if(n >= 10){
+    pt[-2] = DigitPairs[2*n];
+    pt[-1] = DigitPairs[2*n+1];
+  } else{
+    pt[-1] = n+'0';
+  }
+  return len;
+}
+
+//------------Format_Dec------------
+// Signed decimal, '-' in front if negative
+// Input: pt  buffer of at least FORMAT_SIZE characters
+//        n   -2147483648 to 2147483647
+// Output: number of characters, the string is null terminated
+uint32_t Format_Dec(char *pt, int32_t n){
+  if(n < 0){
+    *pt = '-';
+    return 1+Format_UDec(pt+1, 0u-(uint32_t)n);
+  }
+  return Format_UDec(pt, n);
+}
+
+// base 2^shift digits, 1 to 32 of them
+static uint32_t power2(char *pt, uint32_t n, uint32_t shift, const char *digit){
+  uint32_t len,mask;
+  mask = (1<<shift)-1;
+  len = 1;
+  while((len*shift < 32) && (n>>(len*shift))){
+    len++;
+  }
+  pt = pt+len;
+  *pt = 0;
+  do{
+    pt--;
+    *pt = digit[n&mask];
+    n = n>>shift;
+  } while(n);
+  return len;
+}
+
+//------------Format_UHex------------
+// Unsigned hexadecimal, 1 to 8 digits 0-9 and A-F
+// Input: pt  buffer of at least FORMAT_SIZE characters
+//        n   0 to 0xFFFFFFFF
+// Output: number of characters, the string is null terminated
+uint32_t Format_UHex(char *pt, uint32_t n){
+  return power2(pt, n, 4, Upper);
+}
+
+//------------Format_Fix------------
+// Signed decimal fixed-point with resolution 10^-places,
+// at least one digit before the point
+// if n is 12345 and places is 2, then the string is 123.45
+// if n is -5 and places is 3, then the string is -0.005
+// Input: pt      buffer of at least FORMAT_SIZE+1 characters
+//        n       integer part of the fixed-point number
+//        places  digits after the decimal point, 0 to 9
+// Output: number of characters, the string is null terminated
+uint32_t Format_Fix(char *pt, int32_t n, uint32_t places){
+  char digits[FORMAT_SIZE]; uint32_t i,len,d,zeros,whole;
+  len = 0;
+  if(n < 0){
+    pt[len++] = '-';
+    d = Format_UDec(digits, 0u-(uint32_t)n);
+  } else{
+    d = Format_UDec(digits, n);
+  }
+  zeros = (d <= places) ? places+1-d : 0; // as in 0.05
+  whole = d+zeros-places;
+  for(i=0; i<d+zeros; i++){
+    if(i == whole){
+      pt[len++] = '.';
+    }
+    pt[len++] = (i < zeros) ? '0' : digits[i-zeros];
+  }
+  pt[len] = 0;
+  return len;
+}
+
+// add one character if it fits, count it either way
+#define PUT(c) { if(len+1 < size){ pt[len] = (c); } len++; }
+
+//------------Format_vsnprintf------------
+// Small printf into a buffer, with no floating point.
+// Conversions %d %i %u %x %X %b %c %s %%, flags - and 0, a width,
+// and for %s a precision, either as digits or *.  l and h are
+// accepted and ignored, numbers are 32 bits.
+// Input: pt    buffer
+//        size  size of the buffer, output past size-1 is dropped
+//        fmt   format string
+//        ap    arguments
+// Output: length of the whole string, even if it did not fit;
+//         the string is null terminated if size is at least 1
+uint32_t Format_vsnprintf(char *pt, uint32_t size, const char *fmt, va_list ap){
+  char num[34]; const char *s; uint32_t len,n,i,width,precision,sign;
+  int left,zero,longArg; int32_t w;
+  len = 0;
+  while(*fmt){
+    if(*fmt != '%'){
+      PUT(*fmt);
+      fmt++;
+      continue;
+    }
+    fmt++;
+    left = zero = 0;
+    while((*fmt == '-') || (*fmt == '0')){
+      if(*fmt == '-'){
+        left = 1;
+      } else{
+        zero = 1;
+      }
+      fmt++;
+    }
+    width = 0;
+    if(*fmt == '*'){
+      w = va_arg(ap, int);
+      if(w < 0){               // as if - came first
+        left = 1;
+        w = -w;
+      }
+      width = w;
+      fmt++;
+    } else{
+      while((*fmt >= '0') && (*fmt <= '9')){
+        width = 10*width + (*fmt-'0');
+        fmt++;
+      }
+    }
+    precision = 0xFFFFFFFF;    // none
+    if(*fmt == '.'){
+      fmt++;
+      precision = 0;
+      if(*fmt == '*'){
+        w = va_arg(ap, int);
+        precision = (w < 0) ? 0xFFFFFFFF : (uint32_t)w;
+        fmt++;
+      } else{
+        while((*fmt >= '0') && (*fmt <= '9')){
+          precision = 10*precision + (*fmt-'0');
+          fmt++;
+        }
+      }
+    }
+    longArg = 0;
+    while((*fmt == 'l') || (*fmt == 'h')){
+      if(*fmt == 'l'){
+        longArg = 1;           // same as int on the LaunchPad
+      }
+      fmt++;
+    }
+    s = num;
+    sign = 0;
+    switch(*fmt){
+      case 'd': case 'i':
+        w = longArg ? (int32_t)va_arg(ap, long) : va_arg(ap, int);
+        if(w < 0){
+          sign = '-';
+          n = Format_UDec(num, 0u-(uint32_t)w);
+        } else{
+          n = Format_UDec(num, w);
+        }
+        break;
+      case 'u':
+        n = Format_UDec(num, longArg ? (uint32_t)va_arg(ap, unsigned long) : va_arg(ap, unsigned int));
+        break;
+      case 'x':
+        n = power2(num, longArg ? (uint32_t)va_arg(ap, unsigned long) : va_arg(ap, unsigned int), 4, Lower);
+        break;
+      case 'X':
+        n = power2(num, longArg ? (uint32_t)va_arg(ap, unsigned long) : va_arg(ap, unsigned int), 4, Upper);
+        break;
+      case 'b':
+        n = power2(num, longArg ? (uint32_t)va_arg(ap, unsigned long) : va_arg(ap, unsigned int), 1, Lower);
+        break;
+      case 'c':
+        num[0] = va_arg(ap, int);
+        n = 1;
+        zero = 0;
+        break;
+      case 's':
+        s = va_arg(ap, const char *);
+        if(s == 0){
+          s = "(null)";
+        }
+        for(n=0; (n < precision) && s[n]; n++){};
+        zero = 0;
+        break;
+      case 0:                  // % at the end
+        continue;
+      default:                 // %% and unknown conversions print the character
+        num[0] = *fmt;
+        n = 1;
+        zero = 0;
+        break;
+    }
+    fmt++;
+    i = n + (sign ? 1 : 0);    // characters before padding
+    if(left){
+      zero = 0;
+    }
+    if(!left && !zero){
+      while(i < width){
+        PUT(' ');
+        i++;
+      }
+    }
+    if(sign){
+      PUT(sign);
+    }
+    if(zero){
+      while(i < width){
+        PUT('0');
+        i++;
+      }
+    }
+    while(n){
+      PUT(*s);
+      s++;
+      n--;
+    }
+    while(i < width){          // left justified
+      PUT(' ');
+      i++;
+    }
+  }
+  if(size){
+    pt[(len < size) ? len : size-1] = 0;
+  }
+  return len;
+}
+
+//------------Format_snprintf------------
+// Format_vsnprintf with the arguments in the call
+// Input: pt    buffer
+//        size  size of the buffer
+//        fmt   format string, followed by the arguments
+// Output: length of the whole string, even if it did not fit
+uint32_t Format_snprintf(char *pt, uint32_t size, const char *fmt, ...){
+  va_list ap; uint32_t len;
+  va_start(ap, fmt);
+  len = Format_vsnprintf(pt, size, fmt, ap);
+  va_end(ap);
+  return len;
+}
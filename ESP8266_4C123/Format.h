@@ -0,0 +1,86 @@
+// Format.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Number to ASCII conversion shared by the UART and LCD drivers.
+// Decimal digits are found two at a time from a table of "00" to
+// "99", and n/100 is a multiply by the reciprocal, so there are no
+// divides and no recursion.  Format_snprintf renders a string into a
+// buffer so a driver can send it with one call.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __FORMAT_H__
+#define __FORMAT_H__
+#include <stdarg.h>
+
+#define FORMAT_SIZE 12        // buffer big enough for any one number
+
+//------------Format_UDec------------
+// Unsigned decimal, 1 to 10 digits with no spaces
+// Input: pt  buffer of at least FORMAT_SIZE characters
+//        n   0 to 4294967295
+// Output: number of characters, the string is null terminated
+uint32_t Format_UDec(char *pt, uint32_t n);
+
+//------------Format_Dec------------
+// Signed decimal, '-' in front if negative
+// Input: pt  buffer of at least FORMAT_SIZE characters
+//        n   -2147483648 to 2147483647
+// Output: number of characters, the string is null terminated
+uint32_t Format_Dec(char *pt, int32_t n);
+
+//------------Format_UHex------------
+// Unsigned hexadecimal, 1 to 8 digits 0-9 and A-F
+// Input: pt  buffer of at least FORMAT_SIZE characters
+//        n   0 to 0xFFFFFFFF
+// Output: number of characters, the string is null terminated
+uint32_t Format_UHex(char *pt, uint32_t n);
+
+//------------Format_Fix------------
+// Signed decimal fixed-point with resolution 10^-places,
+// at least one digit before the point
+// if n is 12345 and places is 2, then the string is 123.45
+// if n is -5 and places is 3, then the string is -0.005
+// Input: pt      buffer of at least FORMAT_SIZE+1 characters
+//        n       integer part of the fixed-point number
+//        places  digits after the decimal point, 0 to 9
+// Output: number of characters, the string is null terminated
+uint32_t Format_Fix(char *pt, int32_t n, uint32_t places);
+
+//------------Format_vsnprintf------------
+// Small printf into a buffer, with no floating point.
+// Conversions %d %i %u %x %X %b %c %s %%, flags - and 0, a width,
+// and for %s a precision, either as digits or *.  l and h are
+// accepted and ignored, numbers are 32 bits.
+// Input: pt    buffer
+//        size  size of the buffer, output past size-1 is dropped
+//        fmt   format string
+//        ap    arguments
+// Output: length of the whole string, even if it did not fit;
+//         the string is null terminated if size is at least 1
+uint32_t Format_vsnprintf(char *pt, uint32_t size, const char *fmt, va_list ap);
+
+//------------Format_snprintf------------
+// Format_vsnprintf with the arguments in the call
+// Input: pt    buffer
+//        size  size of the buffer
+//        fmt   format string, followed by the arguments
+// Output: length of the whole string, even if it did not fit
+uint32_t Format_snprintf(char *pt, uint32_t size, const char *fmt, ...);
+
+#endif //  __FORMAT_H__
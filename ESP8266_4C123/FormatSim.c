@@ -0,0 +1,240 @@
+// FormatSim.c
+// Runs on a PC, not on the LaunchPad
+// Checks Format.c against glibc's printf.  Format.c is included here
+// so DIV100 can be checked by itself.
+//   DIV100      the reciprocal multiply is n/100 for all 2^32 inputs
+//   UDec        every n below 1,000,000, every n next to a power of 2
+//               or 10, and every 127th n up to 2^32-1, against %u
+//   Dec UHex    the same values as signed against %d, and against %X
+//   Fix         against the whole and fraction parts printed with
+//               64-bit arithmetic, for 0 to 9 places
+//   snprintf    fixed cases of each conversion, flag, width and %s
+//               precision, then 2,000,000 random formats and buffer
+//               sizes, comparing the string, the returned length and
+//               the bytes after the buffer, which must not change
+// Precision only applies to %s, so numbers are given none.  h is
+// ignored, so %hd only gets a value that fits in a short.
+// The benchmark is ns per call against sprintf.
+//   gcc -O2 FormatSim.c -o FormatSim
+//   ./FormatSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#pragma GCC diagnostic ignored "-Wformat" // %b is checked against glibc too
+#include "Format.c"
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+volatile uint32_t Sink;       // keeps the benchmark results
+
+int Shown;                    // failures printed in full
+void same(const char *got, const char *want, const char *what){
+  if(strcmp(got, want)){
+    if(Shown < 10){
+      printf("  %s: \"%s\" should be \"%s\"\n", what, got, want);
+      Shown++;
+    }
+    check(0, what);
+  }
+}
+
+void testDiv100(void){ uint32_t n; long bad;
+  bad = 0;
+  n = 0;
+  do{
+    if(DIV100(n) != n/100){
+      bad++;
+    }
+    n++;
+  } while(n);
+  check(bad == 0, "DIV100");
+}
+
+// n, signed and unsigned, against glibc
+void number(uint32_t n){ char got[FORMAT_SIZE],want[FORMAT_SIZE];
+  check(Format_UDec(got, n) == (uint32_t)sprintf(want, "%u", n), "UDec length");
+  same(got, want, "UDec");
+  check(Format_Dec(got, (int32_t)n) == (uint32_t)sprintf(want, "%d", (int32_t)n), "Dec length");
+  same(got, want, "Dec");
+  check(Format_UHex(got, n) == (uint32_t)sprintf(want, "%X", n), "UHex length");
+  same(got, want, "UHex");
+}
+void testNumbers(void){ uint32_t n,p; int d;
+  for(n=0; n<1000000; n++){
+    number(n);
+  }
+  for(p=1; p; p=p*2){
+    for(d=-2; d<=2; d++){
+      number(p+d);
+    }
+  }
+  for(p=10; p<1000000000; p=p*10){
+    for(d=-2; d<=2; d++){
+      number(p+d);
+      number(p*10+d);         // up to 10^9, then 10^10 wraps
+    }
+  }
+  for(n=0; n<=0xFFFFFFFF-127; n=n+127){
+    number(n);
+  }
+  number(0xFFFFFFFF);
+  number(0x80000000);
+}
+
+const int32_t FixValues[] = {0,1,-1,5,-5,9,-9,10,-10,99,100,-100,12345,-12345,
+  999999999,1000000000,-1000000000,2147483647,-2147483647,-2147483647-1};
+void testFix(void){ char got[FORMAT_SIZE+1],want[32]; uint32_t places,i; int64_t a,scale;
+  int32_t n;
+  for(i=0; i<sizeof(FixValues)/sizeof(FixValues[0])+100000; i++){
+    n = (i < sizeof(FixValues)/sizeof(FixValues[0])) ? FixValues[i] : (int32_t)(rand()^(rand()<<16));
+    for(places=0; places<=9; places++){
+      a = (n < 0) ? -(int64_t)n : n;
+      if(places == 0){
+        sprintf(want, "%s%lld", (n < 0) ? "-" : "", (long long)a);
+      } else{
+        for(scale=1; scale<(int64_t)Powers[places-1]; scale=scale*10){};
+        sprintf(want, "%s%lld.%0*lld", (n < 0) ? "-" : "", (long long)(a/scale),
+                (int)places, (long long)(a%scale));
+      }
+      check(Format_Fix(got, n, places) == strlen(want), "Fix length");
+      same(got, want, "Fix");
+    }
+  }
+}
+
+// one format with one argument, into a buffer of size
+// star is 1 if the format has a * and w is its argument
+#define GUARD 8
+void one(uint32_t size, const char *fmt, int star, int w, uint32_t arg, const char *str){
+  char got[64+GUARD],want[64+GUARD]; uint32_t n,m;
+  memset(got, 0x55, sizeof(got));
+  memset(want, 0x55, sizeof(want));
+  if(str){
+    n = star ? Format_snprintf(got, size, fmt, w, str) : Format_snprintf(got, size, fmt, str);
+    m = star ? snprintf(want, size, fmt, w, str) : snprintf(want, size, fmt, str);
+  } else{
+    n = star ? Format_snprintf(got, size, fmt, w, arg) : Format_snprintf(got, size, fmt, arg);
+    m = star ? snprintf(want, size, fmt, w, arg) : snprintf(want, size, fmt, arg);
+  }
+  check(n == m, fmt);
+  check(memcmp(got, want, sizeof(got)) == 0, fmt);
+  if(size){
+    same(got, want, fmt);
+  }
+}
+const char *Fixed[] = {"%d","%i","%u","%x","%X","%b","%c","%5d","%-5d|","%05d","%-05d|",
+  "%012u","%08x","%-8X|","%3b","%1d","x%%y%d","%%","ab%dcd"};
+const char *Strings[] = {"%s","%10s","%-10s|","%.3s","%8.3s","%-8.3s|","%.0s","%.*s","%*s"};
+const uint32_t Args[] = {0,1,7,9,10,65,255,12345,0x7FFFFFFF,0x80000000,0xFFFFFFFF,0xFFFFFFF6};
+void testPrintf(void){ uint32_t i,j,k,size; char fmt[16],text1[32],text2[32]; const char *text;
+  static const char *flags[] = {"","-","0","-0","0-"};
+  static const char conv[] = "diuxXbc";
+  static const char *words[] = {"","a","hello","a longer string of text"};
+  for(i=0; i<sizeof(Fixed)/sizeof(Fixed[0]); i++){
+    for(j=0; j<sizeof(Args)/sizeof(Args[0]); j++){
+      one(64, Fixed[i], 0, 0, Args[j], 0);
+    }
+  }
+  for(i=0; i<sizeof(Strings)/sizeof(Strings[0]); i++){
+    for(j=0; j<sizeof(words)/sizeof(words[0]); j++){
+      one(64, Strings[i], strchr(Strings[i], '*') != 0, 5, 0, words[j]);
+      one(64, Strings[i], strchr(Strings[i], '*') != 0, -5, 0, words[j]);
+    }
+  }
+  for(k=0; k<2000000; k++){
+    i = rand()%7;
+    j = rand()%12;
+    size = rand()%20;
+    text = words[rand()%4];
+    if(j == 11){
+      sprintf(fmt, "<%s*%c>", flags[rand()%5], conv[i]);
+      one(size, fmt, 1, rand()%41-20, rand()^(rand()<<16), 0);
+    } else if(i == 6 && (rand()&1)){
+      sprintf(fmt, "<%s%u.%us>", flags[rand()%2], j, rand()%6);
+      one(size, fmt, 0, 0, 0, text);
+    } else{
+      sprintf(fmt, "<%s%u%c>", flags[rand()%5], j ? j+rand()%10 : 0, conv[i]);
+      one(size, fmt, 0, 0, (rand()&1) ? rand()%1000 : rand()^(rand()<<16), 0);
+    }
+  }
+  Format_snprintf(text1, sizeof(text1), "%ld %lu %lx %hd", -5L, 4000000000UL, 0xABCDUL, 7);
+  snprintf(text2, sizeof(text2), "%ld %lu %lx %hd", -5L, 4000000000UL, 0xABCDUL, 7);
+  same(text1, text2, "l and h");
+}
+
+//************benchmark*************
+#define N 2000000
+void benchmark(void){ uint32_t i,n; char buf[64]; double t0,t1;
+  printf("benchmark, ns per call\n");
+  n = 0;
+  t0 = seconds();
+  for(i=0; i<N; i++){
+    n += Format_UDec(buf, i*2654435761u);
+  }
+  t1 = seconds();
+  printf("  Format_UDec     %6.1f\n", 1e9*(t1-t0)/N);
+  t0 = seconds();
+  for(i=0; i<N; i++){
+    n += sprintf(buf, "%u", i*2654435761u);
+  }
+  t1 = seconds();
+  printf("  sprintf %%u      %6.1f\n", 1e9*(t1-t0)/N);
+  t0 = seconds();
+  for(i=0; i<N; i++){
+    n += Format_snprintf(buf, sizeof(buf), "x=%5d y=%-4x %s", (int)i-1000, i, "ok");
+  }
+  t1 = seconds();
+  printf("  Format_snprintf %6.1f\n", 1e9*(t1-t0)/N);
+  t0 = seconds();
+  for(i=0; i<N; i++){
+    n += snprintf(buf, sizeof(buf), "x=%5d y=%-4x %s", (int)i-1000, i, "ok");
+  }
+  t1 = seconds();
+  printf("  snprintf        %6.1f\n", 1e9*(t1-t0)/N);
+  Sink = n;
+}
+
+int main(void){
+  srand(1);
+  testDiv100();
+  testNumbers();
+  testFix();
+  testPrintf();
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
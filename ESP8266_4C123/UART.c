@@ -28,10 +28,14 @@
 // U0Rx (VCP receive) connected to PA0
 // U0Tx (VCP transmit) connected to PA1
 #include <stdint.h>
+#ifndef UARTSIM
 #include "../inc/tm4c123gh6pm.h"
+#endif
 #include <stdio.h>
+#include <stdarg.h>
 #include "FIFO.h"
 #include "UART.h"
+#include "Format.h"
 
 #define NVIC_EN0_INT5           0x00000020  // Interrupt 5 enable
 
@@ -43,6 +47,7 @@
 #define UART_CTL_UARTEN         0x00000001  // UART Enable
 #define UART_IFLS_RX1_8         0x00000000  // RX FIFO >= 1/8 full
 #define UART_IFLS_TX1_8         0x00000000  // TX FIFO <= 1/8 full
+#define UART_IFLS_RX4_8         0x00000010  // RX FIFO >= 1/2 full
 #define UART_IM_RTIM            0x00000040  // UART Receive Time-Out Interrupt
                                             // Mask
 #define UART_IM_TXIM            0x00000020  // UART Transmit Interrupt Mask
@@ -56,6 +61,8 @@
 #define UART_ICR_RTIC           0x00000040  // Receive Time-Out Interrupt Clear
 #define UART_ICR_TXIC           0x00000020  // Transmit Interrupt Clear
 #define UART_ICR_RXIC           0x00000010  // Receive Interrupt Clear
+#define UART_DMACTL_TXDMAE      0x00000002  // Transmit DMA Enable
+#define UART_DMACTL_RXDMAE      0x00000001  // Receive DMA Enable
 
 
 
@@ -71,6 +78,177 @@ void WaitForInterrupt(void);  // low power mode
 AddIndexFifo(Rx, FIFOSIZE, char, FIFOSUCCESS, FIFOFAIL)
 AddIndexFifo(Tx, 1024, char, FIFOSUCCESS, FIFOFAIL)
 
+#if UART_DMA
+// The control table used by the uDMA controller.  This table must be aligned to a 1024 byte boundary.
+uint32_t static ControlTable[256] __attribute__ ((aligned(1024)));
+// UART0 RX uses uDMA channel 8 encoding 0, UART0 TX uses channel 9 encoding 0
+#define CH8 (8*4)
+#define CH9 (9*4)
+#define ALT 128                // alternate control structures
+#define BIT8 0x00000100
+#define BIT9 0x00000200
+// the 32-bit address the uDMA uses for pt, UARTSim.c replaces it
+#ifndef DMAADDR
+#define DMAADDR(pt) ((uint32_t)(pt))
+#endif
+/* DMACHCTL          Bits    RX     TX
+   DSTINC            31:30   0      3     8-bit increment, no increment
+   DSTSIZE           29:28   0      0     8-bit destination data size
+   SRCINC            27:26   3      0     no increment, 8-bit increment
+   SRCSIZE           25:24   0      0     8-bit source data size
+   ARBSIZE           17:14   2      2     arbitrates after 4, 4 transfers
+   XFERSIZE          13:4  count-1        transfer count items
+   NXTUSEBURST       3       0      0     N/A for these transfer types
+   XFERMODE          2:0     3      1     ping-pong, basic */
+#define RXCTL 0x0C008003
+#define TXCTL 0xC0008001
+char static RxBlock[UART_DMABLOCKS][UART_DMABLOCK];
+// shared with the interrupt, volatile so UART_InChar sees new blocks
+volatile uint8_t static RxFull[UART_DMABLOCKS];  // blocks with data, oldest first
+volatile uint16_t static RxLen[UART_DMABLOCKS];  // characters in each of them
+volatile uint32_t static RxFullPut,RxFullGet;    // free running, interrupt puts
+volatile uint8_t static RxFree[UART_DMABLOCKS];  // blocks not in use
+volatile uint32_t static RxFreePut,RxFreeGet;    // free running, interrupt gets
+uint8_t static RxArmed[2];               // blocks in the primary and alternate
+uint32_t static RxNext;                  // 0 if primary finishes next, 1 if alternate
+uint32_t static RxOffset;                // characters already read from the oldest block
+volatile uint32_t static RxLostCount;
+const char static *TxPt;                 // next character for the uDMA to send
+uint32_t static TxLeft;                  // characters not yet given to the uDMA
+void static (*TxCallback)(void);
+volatile int static TxBusy;              // 1 while UART_WriteBuffer is sending
+
+// point the primary (s=0) or alternate (s=1) structure at a whole block
+void static rxArm(uint32_t s, uint32_t block){ uint32_t base;
+  base = s ? ALT+CH8 : CH8;
+  RxArmed[s] = block;
+  ControlTable[base]   = DMAADDR(&UART0_DR_R);                       // source, fixed
+  ControlTable[base+1] = DMAADDR(&RxBlock[block][UART_DMABLOCK-1]);  // last address
+  ControlTable[base+2] = RXCTL+((UART_DMABLOCK-1)<<4);
+}
+// give len characters in structure s to the program, then re-arm s
+// with a free block, or with the same block if none are free
+void static rxComplete(uint32_t s, uint32_t len){ uint32_t block;
+  block = RxArmed[s];
+  if(RxFreeGet != RxFreePut){
+    RxFull[RxFullPut&(UART_DMABLOCKS-1)] = block;
+    RxLen[RxFullPut&(UART_DMABLOCKS-1)] = len;
+    RxFullPut++;
+    block = RxFree[RxFreeGet&(UART_DMABLOCKS-1)];
+    RxFreeGet++;
+  } else{
+    RxLostCount += len;
+  }
+  rxArm(s, block);
+}
+// give out every block the uDMA has filled, oldest first
+void static rxCollect(void){
+  while((ControlTable[(RxNext ? ALT+CH8 : CH8)+2]&0x07) == 0){
+    rxComplete(RxNext, UART_DMABLOCK);
+    RxNext = RxNext^1;
+  }
+}
+// continue with the structure that finishes next
+void static rxRestart(void){
+  if(RxNext){
+    UDMA_ALTSET_R = BIT8;
+  } else{
+    UDMA_ALTCLR_R = BIT8;
+  }
+  UDMA_ENASET_R = BIT8;
+}
+// the uDMA filled a block
+void static rxDone(void){
+  rxCollect();
+  if((UDMA_ENASET_R&BIT8) == 0){        // both finished, so it stopped
+    rxRestart();
+  }
+}
+// receiver timed out: give out the partly full block
+// the time out only happens with characters in the hardware FIFO, so
+// the uDMA moves bursts of 4 when there are 8, leaving 4 to 7 there
+// to be read here; bursts of 8 would empty the FIFO after 8, 16, ...
+// characters and the rest of the block would wait for more data
+void static rxFlush(void){ uint32_t base,filled; char *pt;
+  UDMA_ENACLR_R = BIT8;                 // stop it, a burst in progress finishes
+  rxCollect();
+  base = RxNext ? ALT+CH8 : CH8;
+  filled = UART_DMABLOCK - (((ControlTable[base+2]>>4)&0x3FF)+1);
+  pt = &RxBlock[RxArmed[RxNext]][filled];
+  while(((UART0_FR_R&UART_FR_RXFE) == 0) && (filled < UART_DMABLOCK)){
+    *pt = UART0_DR_R;
+    pt++;
+    filled++;
+  }
+  if(filled){
+    if((RxFreeGet != RxFreePut) || (filled == UART_DMABLOCK)){
+      rxComplete(RxNext, filled);       // still the active structure
+    } else{                             // keep the data, the uDMA continues after it
+      ControlTable[base+2] = RXCTL+((UART_DMABLOCK-filled-1)<<4);
+    }
+  }
+  rxRestart();
+}
+// give the uDMA up to 1024 more characters
+void static txStart(void){ uint32_t n;
+  n = TxLeft;
+  if(n > 1024){
+    n = 1024;
+  }
+  ControlTable[CH9]   = DMAADDR(TxPt+n-1);             // last address
+  ControlTable[CH9+1] = DMAADDR(&UART0_DR_R);          // destination, fixed
+  ControlTable[CH9+2] = TXCTL+((n-1)<<4);
+  TxPt = TxPt+n;
+  TxLeft = TxLeft-n;
+  UDMA_ENASET_R = BIT9;
+}
+void static copySoftwareToHardware(void);
+void static txDone(void){
+  if(TxLeft){
+    txStart();
+    return;
+  }
+  TxBusy = 0;
+  if(TxFifo_Size()){                    // UART_OutChar waited for us
+    copySoftwareToHardware();
+    UART0_IM_R |= UART_IM_TXIM;
+  }
+  if(TxCallback){
+    (*TxCallback)();
+  }
+}
+// initialize the uDMA for UART0 and start receiving
+void static dmaInit(void){ int i;
+  for(i=0; i<256; i++){
+    ControlTable[i] = 0;
+  }
+  RxFullPut = RxFullGet = 0;
+  RxFreePut = RxFreeGet = 0;
+  for(i=2; i<UART_DMABLOCKS; i++){      // blocks 0 and 1 start in the uDMA
+    RxFree[RxFreePut&(UART_DMABLOCKS-1)] = i;
+    RxFreePut++;
+  }
+  RxOffset = 0;
+  RxLostCount = 0;
+  RxNext = 0;
+  TxBusy = 0;
+  SYSCTL_RCGCDMA_R |= 0x01;   // uDMA Module Run Mode Clock Gating Control
+  while((SYSCTL_PRUDMA_R&0x01) == 0){}; // allow time to finish
+  UDMA_CFG_R = 0x01;          // MASTEN Controller Master Enable
+  UDMA_CTLBASE_R = DMAADDR(ControlTable);
+  UDMA_CHMAP1_R = UDMA_CHMAP1_R&0xFFFFFF00; // UART0 RX and TX
+  UDMA_PRIOCLR_R = BIT8|BIT9; // default, not high priority
+  UDMA_ALTCLR_R = BIT8|BIT9;  // start with primary control
+  UDMA_USEBURSTSET_R = BIT8;  // RX only in bursts of 4, the rest by time out
+  UDMA_USEBURSTCLR_R = BIT9;  // TX responds to both burst and single requests
+  UDMA_REQMASKCLR_R = BIT8|BIT9; // allow the uDMA controller to recognize requests
+  rxArm(0, 0);
+  rxArm(1, 1);
+  UDMA_ENASET_R = BIT8;       // receive, TX is enabled by UART_WriteBuffer
+  UART0_DMACTL_R = UART_DMACTL_RXDMAE|UART_DMACTL_TXDMAE;
+}
+#endif
+
 // Initialize UART0
 // Baud rate is 115200 bits/sec
 void UART_Init(void){
@@ -86,9 +264,17 @@ void UART_Init(void){
   UART0_IFLS_R &= ~0x3F;                // clear TX and RX interrupt FIFO level fields
                                         // configure interrupt for TX FIFO <= 1/8 full
                                         // configure interrupt for RX FIFO >= 1/8 full
+#if UART_DMA
+                                        // RX burst request for uDMA at RX FIFO >= 1/2 full
+  UART0_IFLS_R += (UART_IFLS_TX1_8|UART_IFLS_RX4_8);
+  dmaInit();
+                                        // enable TX FIFO interrupt and RX time-out interrupt
+  UART0_IM_R |= (UART_IM_TXIM|UART_IM_RTIM);
+#else
   UART0_IFLS_R += (UART_IFLS_TX1_8|UART_IFLS_RX1_8);
                                         // enable TX and RX FIFO interrupts and RX time-out interrupt
   UART0_IM_R |= (UART_IM_RXIM|UART_IM_TXIM|UART_IM_RTIM);
+#endif
   UART0_CTL_R |= 0x301;                 // enable UART
   GPIO_PORTA_AFSEL_R |= 0x03;           // enable alt funct on PA1-0
   GPIO_PORTA_DEN_R |= 0x03;             // enable digital I/O on PA1-0
@@ -99,6 +285,7 @@ void UART_Init(void){
   NVIC_PRI1_R = (NVIC_PRI1_R&0xFFFF00FF)|0x00004000; // bits 13-15
   NVIC_EN0_R = NVIC_EN0_INT5;           // enable interrupt 5 in NVIC
 }
+#if UART_DMA == 0
 // copy from hardware RX FIFO to software RX FIFO
 // stop when hardware RX FIFO is empty or software RX FIFO is full
 void static copyHardwareToSoftware(void){
@@ -108,20 +295,109 @@ void static copyHardwareToSoftware(void){
     RxFifo_Put(letter);
   }
 }
+#endif
 // copy from software TX FIFO to hardware TX FIFO
 // stop when software TX FIFO is empty or hardware TX FIFO is full
 void static copySoftwareToHardware(void){
   char letter;
-  while(((UART0_FR_R&UART_FR_TXFF) == 0) && (TxFifo_Size() > 0)){
-    TxFifo_Get(&letter);
+  while(((UART0_FR_R&UART_FR_TXFF) == 0) && (TxFifo_Get(&letter) == FIFOSUCCESS)){
     UART0_DR_R = letter;
   }
 }
+#if UART_DMA
+//------------UART_ReadBuffer------------
+// Find the oldest received characters without copying them.  A buffer
+// is given out when it is full, or partly full after the line has been
+// idle for 32 bit times.
+// Input: pt  pointer to where the address of the characters is returned
+// Output: number of characters, 0 if none have been received
+uint32_t UART_ReadBuffer(char **pt){ uint32_t i;
+  if(RxFullGet == RxFullPut){
+    return 0;
+  }
+  i = RxFullGet&(UART_DMABLOCKS-1);
+  *pt = &RxBlock[RxFull[i]][RxOffset];
+  return RxLen[i] - RxOffset;
+}
+
+//------------UART_ReleaseBuffer------------
+// Give the buffer from UART_ReadBuffer back to the uDMA.
+// Input: none
+// Output: none
+void UART_ReleaseBuffer(void){
+  if(RxFullGet == RxFullPut){
+    return;
+  }
+  RxFree[RxFreePut&(UART_DMABLOCKS-1)] = RxFull[RxFullGet&(UART_DMABLOCKS-1)];
+  RxFreePut++;
+  RxFullGet++;
+  RxOffset = 0;
+}
+
+//------------UART_RxLost------------
+// Input: none
+// Output: number of characters lost because no buffer was free
+uint32_t UART_RxLost(void){
+  return RxLostCount;
+}
+
+// take one character from the receive buffers
+int static getChar(char *letter){ char *pt;
+  if(UART_ReadBuffer(&pt) == 0){
+    return FIFOFAIL;
+  }
+  *letter = *pt;
+  RxOffset++;
+  if(UART_ReadBuffer(&pt) == 0){        // used it all
+    UART_ReleaseBuffer();
+  }
+  return FIFOSUCCESS;
+}
+
+//------------UART_WriteBuffer------------
+// Start sending a buffer with the uDMA, without copying it.  The
+// buffer must not change until the callback runs.  Fails if a buffer
+// is still being sent or characters from UART_OutChar are waiting.
+// Input: pt        first character
+//        len       number of characters, at least 1
+//        callback  called from the UART interrupt when the last
+//                  character is in the UART, 0 for none
+// Output: 1 if started, 0 if busy
+int UART_WriteBuffer(const char *pt, uint32_t len, void (*callback)(void)){ long sr;
+  if(len == 0){
+    return 0;
+  }
+  sr = StartCritical();
+  if(TxBusy || TxFifo_Size()){
+    EndCritical(sr);
+    return 0;
+  }
+  TxBusy = 1;
+  UART0_IM_R &= ~UART_IM_TXIM;          // the TxFifo waits until the uDMA is done
+  TxPt = pt;
+  TxLeft = len;
+  TxCallback = callback;
+  txStart();
+  EndCritical(sr);
+  return 1;
+}
+
+//------------UART_WriteBusy------------
+// Input: none
+// Output: 1 while UART_WriteBuffer is sending, 0 when done
+int UART_WriteBusy(void){
+  return TxBusy;
+}
+#else
+#define getChar(pt) RxFifo_Get(pt)
+#define TxBusy 0
+#endif
+
 // input ASCII character from UART
 // spin if RxFifo is empty
 char UART_InChar(void){
   char letter;
-  while(RxFifo_Get(&letter) == FIFOFAIL){};
+  while(getChar(&letter) == FIFOFAIL){};
   return(letter);
 }
 
@@ -131,7 +407,7 @@ char UART_InChar(void){
 //         character if
 char UART_InCharNonBlock(void){
   char letter;
-  if(RxFifo_Get(&letter) == FIFOFAIL){
+  if(getChar(&letter) == FIFOFAIL){
     return 0;  // empty
   };
   return(letter);
@@ -144,6 +420,7 @@ char UART_InCharNonBlock(void){
 // spin if TxFifo full
 void UART_OutChar(char data){
   while(TxFifo_Put(data) == FIFOFAIL){};
+  if(TxBusy) return;                    // sent after the uDMA finishes
   UART0_IM_R &= ~UART_IM_TXIM;          // disable TX FIFO interrupt
   copySoftwareToHardware();
   UART0_IM_R |= UART_IM_TXIM;           // enable TX FIFO interrupt
@@ -155,6 +432,7 @@ void UART_OutChar(char data){
 // Error: return with lost data if TxFifo is full
 void UART_OutCharNonBlock(char data){
   if(TxFifo_Put(data) == FIFOFAIL) return; // lost data
+  if(TxBusy) return;                    // sent after the uDMA finishes
   UART0_IM_R &= ~UART_IM_TXIM;          // disable TX FIFO interrupt
   copySoftwareToHardware();
   UART0_IM_R |= UART_IM_TXIM;           // enable TX FIFO interrupt
@@ -163,8 +441,23 @@ void UART_OutCharNonBlock(char data){
 // hardware TX FIFO goes from 3 to 2 or less items
 // hardware RX FIFO goes from 1 to 2 or more items
 // UART receiver has timed out
+// with UART_DMA, also a uDMA receive buffer is full or a transmit is done
 void UART0_Handler(void){
-  if(UART0_RIS_R&UART_RIS_TXRIS){       // hardware TX FIFO <= 2 items
+#if UART_DMA
+  if(UDMA_CHIS_R&BIT8){                 // uDMA filled a receive buffer
+    UDMA_CHIS_R = BIT8;                 // acknowledge
+    rxDone();
+  }
+  if(UDMA_CHIS_R&BIT9){                 // uDMA sent the last character
+    UDMA_CHIS_R = BIT9;                 // acknowledge
+    txDone();
+  }
+  if(UART0_RIS_R&UART_RIS_RTRIS){       // receiver timed out
+    UART0_ICR_R = UART_ICR_RTIC;        // acknowledge receiver time out
+    rxFlush();
+  }
+#endif
+  if((UART0_RIS_R&UART_RIS_TXRIS) && (TxBusy == 0)){ // hardware TX FIFO <= 2 items
     UART0_ICR_R = UART_ICR_TXIC;        // acknowledge TX FIFO
     // copy from software TX FIFO to hardware TX FIFO
     copySoftwareToHardware();
@@ -172,6 +465,7 @@ void UART0_Handler(void){
       UART0_IM_R &= ~UART_IM_TXIM;      // disable TX FIFO interrupt
     }
   }
+#if UART_DMA == 0
   if(UART0_RIS_R&UART_RIS_RXRIS){       // hardware RX FIFO >= 2 items
     UART0_ICR_R = UART_ICR_RXIC;        // acknowledge RX FIFO
     // copy from hardware RX FIFO to software RX FIFO
@@ -182,17 +476,56 @@ void UART0_Handler(void){
     // copy from hardware RX FIFO to software RX FIFO
     copyHardwareToSoftware();
   }
+#endif
 }
 
 //------------UART_OutString------------
 // Output String (NULL termination)
 // Input: pointer to a NULL-terminated string to be transferred
 // Output: none
-void UART_OutString(char *pt){
-  while(*pt){
-    UART_OutChar(*pt);
-    pt++;
+void UART_OutString(char *pt){ uint32_t len;
+  len = 0;
+  while(pt[len]){
+    len++;
   }
+  UART_OutChars(pt, len);
+}
+
+//------------UART_OutChars------------
+// Output a buffer of characters.  They go into the TxFifo as a
+// group, and the transmit interrupt is disabled once per group
+// rather than once per character.
+// Input: pt   first character
+//        len  number of characters
+// Output: none
+void UART_OutChars(const char *pt, uint32_t len){
+  while(len){
+    while(len && (TxFifo_Put(*pt) == FIFOSUCCESS)){
+      pt++;
+      len--;
+    }
+    if(TxBusy) continue;                // sent after the uDMA finishes
+    UART0_IM_R &= ~UART_IM_TXIM;        // disable TX FIFO interrupt
+    copySoftwareToHardware();
+    UART0_IM_R |= UART_IM_TXIM;         // enable TX FIFO interrupt
+  }
+}
+
+//------------UART_Printf------------
+// printf to the UART, formatted by Format_vsnprintf into a buffer
+// and sent with one call to UART_OutChars
+// Input: fmt  format string, followed by the arguments
+// Output: none
+// Error: output past UART_PRINTFSIZE-1 characters is dropped
+void UART_Printf(const char *fmt, ...){
+  char buf[UART_PRINTFSIZE]; va_list ap; uint32_t len;
+  va_start(ap, fmt);
+  len = Format_vsnprintf(buf, UART_PRINTFSIZE, fmt, ap);
+  va_end(ap);
+  if(len >= UART_PRINTFSIZE){
+    len = UART_PRINTFSIZE-1;
+  }
+  UART_OutChars(buf, len);
 }
 
 //------------UART_InUDec------------
@@ -232,14 +565,8 @@ char character;
 // Input: 32-bit number to be transferred
 // Output: none
 // Variable format 1-10 digits with no space before or after
-void UART_OutUDec(uint32_t n){
-// This function uses recursion to convert decimal number
-//   of unspecified length as an ASCII string
-  if(n >= 10){
-    UART_OutUDec(n/10);
-    n = n%10;
-  }
-  UART_OutChar(n+'0'); /* n is between 0 and 9 */
+void UART_OutUDec(uint32_t n){ char buf[FORMAT_SIZE];
+  UART_OutChars(buf, Format_UDec(buf, n));
 }
 
 //---------------------UART_InUHex----------------------------------------
@@ -289,21 +616,8 @@ char character;
 // Input: 32-bit number to be transferred
 // Output: none
 // Variable format 1 to 8 digits with no space before or after
-void UART_OutUHex(uint32_t number){
-// This function uses recursion to convert the number of
-//   unspecified length as an ASCII string
-  if(number >= 0x10){
-    UART_OutUHex(number/0x10);
-    UART_OutUHex(number%0x10);
-  }
-  else{
-    if(number < 0xA){
-      UART_OutChar(number+'0');
-     }
-    else{
-      UART_OutChar((number-0x0A)+'A');
-    }
-  }
+void UART_OutUHex(uint32_t number){ char buf[FORMAT_SIZE];
+  UART_OutChars(buf, Format_UHex(buf, number));
 }
 
 //------------UART_InString------------
@@ -343,6 +657,7 @@ char character;
 
 
 // this is used for printf to output to the usb uart
+// one character at a time, UART_Printf sends the whole string at once
 int fputc(int ch, FILE *f){
   UART_OutChar(ch);
   return 1;
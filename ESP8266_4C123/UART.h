@@ -27,6 +27,12 @@
 // U0Tx (VCP transmit) connected to PA1
 #ifndef UART_H
 #define UART_H
+#ifndef UART_DMA
+#define UART_DMA 0            // 1 to move the data with the uDMA
+#endif
+#define UART_DMABLOCK  64     // bytes in each receive buffer, multiple of 8
+#define UART_DMABLOCKS 4      // number of receive buffers, power of 2, at least 4
+#define UART_PRINTFSIZE 128   // longest UART_Printf output, plus 1
 // standard ASCII symbols
 #define CR   0x0D
 #define LF   0x0A
@@ -73,6 +79,24 @@ void UART_OutCharNonBlock(char data);
 // Output: none
 void UART_OutString(char *pt);
 
+//------------UART_OutChars------------
+// Output a buffer of characters.  They go into the TxFifo as a
+// group, and the transmit interrupt is disabled once per group
+// rather than once per character.
+// Input: pt   first character
+//        len  number of characters
+// Output: none
+void UART_OutChars(const char *pt, uint32_t len);
+
+//------------UART_Printf------------
+// printf to the UART, formatted by Format_vsnprintf into a buffer
+// and sent with one call to UART_OutChars
+// Conversions %d %i %u %x %X %b %c %s %%, no floating point
+// Input: fmt  format string, followed by the arguments
+// Output: none
+// Error: output past UART_PRINTFSIZE-1 characters is dropped
+void UART_Printf(const char *fmt, ...);
+
 //------------UART_InUDec------------
 // InUDec accepts ASCII input in unsigned decimal format
 //     and converts to a 32-bit unsigned number
@@ -130,4 +154,48 @@ void UART_InString(char *bufPt, uint16_t max);
 // Output: none
 void Output_Init(void);
 
+// The rest only exist with UART_DMA 1.  The uDMA moves received data
+// into UART_DMABLOCKS buffers, two at a time in ping-pong mode, and
+// the UART interrupt only runs when a buffer is full or the line has
+// been idle for 32 bit times.  UART_InChar and the other input
+// functions read from these buffers.  UART_WriteBuffer sends from the
+// caller's memory, and UART_OutChar still uses the TxFifo.
+// The uDMA uses channel 8 for receive and channel 9 for transmit, so
+// it can not be used with DMATimer.c or DMASoftware.c.
+
+//------------UART_WriteBuffer------------
+// Start sending a buffer with the uDMA, without copying it.  The
+// buffer must not change until the callback runs.  Fails if a buffer
+// is still being sent or characters from UART_OutChar are waiting.
+// Input: pt        first character
+//        len       number of characters, at least 1
+//        callback  called from the UART interrupt when the last
+//                  character is in the UART, 0 for none
+// Output: 1 if started, 0 if busy
+int UART_WriteBuffer(const char *pt, uint32_t len, void (*callback)(void));
+
+//------------UART_WriteBusy------------
+// Input: none
+// Output: 1 while UART_WriteBuffer is sending, 0 when done
+int UART_WriteBusy(void);
+
+//------------UART_ReadBuffer------------
+// Find the oldest received characters without copying them.  A buffer
+// is given out when it is full, or partly full after the line has been
+// idle for 32 bit times.
+// Input: pt  pointer to where the address of the characters is returned
+// Output: number of characters, 0 if none have been received
+uint32_t UART_ReadBuffer(char **pt);
+
+//------------UART_ReleaseBuffer------------
+// Give the buffer from UART_ReadBuffer back to the uDMA.
+// Input: none
+// Output: none
+void UART_ReleaseBuffer(void);
+
+//------------UART_RxLost------------
+// Input: none
+// Output: number of characters lost because no buffer was free
+uint32_t UART_RxLost(void);
+
 #endif
@@ -0,0 +1,486 @@
+// UARTSim.c
+// Runs on a PC, not on the LaunchPad
+// Run the UART0 driver in UART.c on a PC, with a model of the UART
+// FIFOs, the receive time out and uDMA channels 8 and 9.  UART.c is
+// included here with UARTSIM defined.  The registers with side
+// effects are (*SimReg(kind)): reading DR takes a character out of
+// the RX FIFO, writing DR puts one in the TX FIFO, and ENASET, ENACLR,
+// ALTSET, ALTCLR, CHIS and ICR set and clear bits.  SimReg returns a
+// word holding what a read gives, with SIMREAD set in it, and the
+// access is finished at the next SimReg or SimDone: if the word still
+// has SIMREAD it was a read, otherwise it was a write of that value.
+// UART.c never writes SIMREAD, and only tests the bits it uses.
+// DMAADDR makes 32-bit uDMA addresses from offsets to SimOrigin, and
+// drops the read of DR in &UART0_DR_R.
+// Time goes by one character (10 bit times) at a time.  In each one,
+// a character may arrive, one leaves the TX FIFO, the uDMA runs and
+// then UART0_Handler runs until nothing is pending.
+//   UART      16 character FIFOs, RXRIS at the IFLS level, TXRIS at
+//             2 or fewer, RTRIS once the line has been idle for 32 bit
+//             times with characters in the RX FIFO
+//   uDMA      the UART asks for a burst at the IFLS level and a single
+//             transfer when the RX FIFO is not empty; USEBURST ignores
+//             the single requests.  Each request moves up to ARBSIZE
+//             items, ping-pong swaps structures and sets CHIS at the
+//             end of each one, and the channel stops when the next
+//             structure is stopped
+// The tests check
+//   messages  2000 messages of 1 to 300 random characters with gaps
+//             between them, all of them read in order, none lost.
+//             Reports interrupts, characters moved by the processor,
+//             register accesses and time in UART0_Handler per KB
+//   multiples messages of 8, 16, ... 256 characters, each followed
+//             by an idle line, all of them handed out by the time out.
+//             With UART_DMA, again with bursts of 8, the ARBSIZE
+//             UART.c used before, which empties the RX FIFO so there
+//             is no time out and the end of the message waits in
+//             RxBlock for more data
+//   transmit  3000 characters, with UART_WriteBuffer and a callback,
+//             or with UART_OutChar, then UART_OutString
+//   gcc -O2 UARTSim.c Format.c -o UARTSim
+//   gcc -O2 -DUART_DMA=0 UARTSim.c Format.c -o UARTSim0
+//   ./UARTSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// the simulated UART and uDMA
+enum{ENASET,ENACLR,ALTSET,ALTCLR,CHIS,DR,FR,RIS,ICR,BURSTSET,BURSTCLR,NONE};
+#define SIMREAD 0x5A5A0000    // in every word SimReg gives out
+uint32_t SimEna;              // UDMA_ENASET_R
+uint32_t SimAlt;              // UDMA_ALTSET_R
+uint32_t SimChis;             // UDMA_CHIS_R
+uint32_t SimBurst;            // UDMA_USEBURSTSET_R
+uint32_t SimTimeOut;          // RTRIS
+uint32_t SimIdle;             // bit times since the last character came in
+uint8_t SimRx[16],SimTx[16];  // hardware FIFOs
+int SimRxN,SimTxN;
+uint32_t SimArb;              // 0 for the ARBSIZE in the control word, else items per request
+long SimAccesses;             // register reads and writes
+long SimCpuChars;             // characters the processor moved through DR
+long SimOverruns;             // characters that came in to a full RX FIFO
+uint32_t SimWord;             // the register access in progress
+int SimKind = NONE;
+uint32_t *SimReg(int kind);
+uint32_t *SimPlain(uint32_t *reg);
+uint32_t SimAddr(const volatile void *pt);
+uint32_t GPIO_PORTA_AFSEL,GPIO_PORTA_AMSEL,GPIO_PORTA_DEN,GPIO_PORTA_PCTL;
+uint32_t NVIC_EN0,NVIC_PRI1,SYSCTL_RCGCDMA,SYSCTL_RCGCGPIO,SYSCTL_RCGCUART;
+uint32_t SYSCTL_PRUDMA = 0x01;  // always ready
+uint32_t UART0_CTL,UART0_DMACTL,UART0_FBRD,UART0_IBRD,UART0_IFLS,UART0_IM,UART0_LCRH;
+uint32_t UDMA_CFG,UDMA_CHMAP1,UDMA_CTLBASE,UDMA_PRIOCLR,UDMA_REQMASKCLR;
+#define GPIO_PORTA_AFSEL_R      (*SimPlain(&GPIO_PORTA_AFSEL))
+#define GPIO_PORTA_AMSEL_R      (*SimPlain(&GPIO_PORTA_AMSEL))
+#define GPIO_PORTA_DEN_R        (*SimPlain(&GPIO_PORTA_DEN))
+#define GPIO_PORTA_PCTL_R       (*SimPlain(&GPIO_PORTA_PCTL))
+#define NVIC_EN0_R              (*SimPlain(&NVIC_EN0))
+#define NVIC_PRI1_R             (*SimPlain(&NVIC_PRI1))
+#define SYSCTL_RCGCDMA_R        (*SimPlain(&SYSCTL_RCGCDMA))
+#define SYSCTL_RCGCGPIO_R       (*SimPlain(&SYSCTL_RCGCGPIO))
+#define SYSCTL_RCGCUART_R       (*SimPlain(&SYSCTL_RCGCUART))
+#define SYSCTL_PRUDMA_R         (*SimPlain(&SYSCTL_PRUDMA))
+#define UART0_CTL_R             (*SimPlain(&UART0_CTL))
+#define UART0_DMACTL_R          (*SimPlain(&UART0_DMACTL))
+#define UART0_FBRD_R            (*SimPlain(&UART0_FBRD))
+#define UART0_IBRD_R            (*SimPlain(&UART0_IBRD))
+#define UART0_IFLS_R            (*SimPlain(&UART0_IFLS))
+#define UART0_IM_R              (*SimPlain(&UART0_IM))
+#define UART0_LCRH_R            (*SimPlain(&UART0_LCRH))
+#define UART0_DR_R              (*SimReg(DR))
+#define UART0_FR_R              (*SimReg(FR))
+#define UART0_RIS_R             (*SimReg(RIS))
+#define UART0_ICR_R             (*SimReg(ICR))
+#define UDMA_CFG_R              (*SimPlain(&UDMA_CFG))
+#define UDMA_CHMAP1_R           (*SimPlain(&UDMA_CHMAP1))
+#define UDMA_CTLBASE_R          (*SimPlain(&UDMA_CTLBASE))
+#define UDMA_PRIOCLR_R          (*SimPlain(&UDMA_PRIOCLR))
+#define UDMA_REQMASKCLR_R       (*SimPlain(&UDMA_REQMASKCLR))
+#define UDMA_ENASET_R           (*SimReg(ENASET))
+#define UDMA_ENACLR_R           (*SimReg(ENACLR))
+#define UDMA_ALTSET_R           (*SimReg(ALTSET))
+#define UDMA_ALTCLR_R           (*SimReg(ALTCLR))
+#define UDMA_CHIS_R             (*SimReg(CHIS))
+#define UDMA_USEBURSTSET_R      (*SimReg(BURSTSET))
+#define UDMA_USEBURSTCLR_R      (*SimReg(BURSTCLR))
+#define DMAADDR(pt) SimAddr(pt)
+long StartCritical(void){ return 0; }
+void EndCritical(long sr){ (void)sr; }
+void DisableInterrupts(void){}
+void EnableInterrupts(void){}
+void WaitForInterrupt(void){}
+
+// UART.c uses these instead of the LaunchPad registers
+#define UARTSIM
+#ifndef UART_DMA
+#define UART_DMA 1
+#endif
+#include "UART.c"
+
+// the IFLS RX level, in characters
+int rxLevel(void){
+  static const int level[5] = {2,4,8,12,14};
+  return level[((UART0_IFLS>>3)&0x07)%5];
+}
+uint32_t ris(void){
+  return (SimTimeOut ? UART_RIS_RTRIS : 0)|(SimTxN <= 2 ? UART_RIS_TXRIS : 0)
+        |(SimRxN >= rxLevel() ? UART_RIS_RXRIS : 0);
+}
+uint8_t rxTake(void){ uint8_t c;
+  c = SimRx[0];
+  SimRxN--;
+  memmove(SimRx, SimRx+1, SimRxN);
+  return c;
+}
+// finish the register access in progress
+void SimDone(void){ uint32_t x;
+  x = SimWord;
+  if((x&0xFFFF0000) == SIMREAD){
+    if((SimKind == DR) && SimRxN){
+      rxTake();               // it was read
+      SimCpuChars++;
+    }
+    SimKind = NONE;
+    return;
+  }
+  switch(SimKind){            // it was written with x
+    case ENASET: SimEna |= x; break;
+    case ENACLR: SimEna &= ~x; break;
+    case ALTSET: SimAlt |= x; break;
+    case ALTCLR: SimAlt &= ~x; break;
+    case CHIS: SimChis &= ~x; break;
+    case BURSTSET: SimBurst |= x; break;
+    case BURSTCLR: SimBurst &= ~x; break;
+    case ICR:
+      if(x&UART_ICR_RTIC){
+        SimTimeOut = 0;
+      }
+      break;
+    case DR:
+      if(SimTxN < 16){
+        SimTx[SimTxN++] = x;
+      }
+      SimCpuChars++;
+      break;
+  }
+  SimKind = NONE;
+}
+uint32_t *SimReg(int kind){ uint32_t x;
+  SimDone();
+  SimAccesses++;
+  switch(kind){
+    case ENASET: x = SimEna; break;
+    case ALTSET: x = SimAlt; break;
+    case CHIS: x = SimChis; break;
+    case BURSTSET: x = SimBurst; break;
+    case DR: x = SimRxN ? SimRx[0] : 0; break;
+    case FR: x = (SimRxN == 0 ? UART_FR_RXFE : 0)|(SimRxN == 16 ? UART_FR_RXFF : 0)
+                |(SimTxN == 16 ? UART_FR_TXFF : 0); break;
+    case RIS: x = ris(); break;
+    default: x = 0;
+  }
+  SimWord = SIMREAD|x;
+  SimKind = kind;
+  return &SimWord;
+}
+uint32_t *SimPlain(uint32_t *reg){
+  SimDone();
+  SimAccesses++;
+  return reg;
+}
+// offsets from here fit in 32 bits, static data is all near it
+uint8_t SimOrigin;
+uint32_t SimAddr(const volatile void *pt){
+  if(pt == &SimWord){         // &UART0_DR_R, which is not a read
+    SimKind = NONE;
+    SimAccesses--;
+  }
+  return (uint32_t)((uintptr_t)pt - (uintptr_t)&SimOrigin);
+}
+uint8_t *simPt(uint32_t addr){
+  return (uint8_t *)((uintptr_t)&SimOrigin + (int32_t)addr);
+}
+
+#if UART_DMA
+// one transfer with the structure at c, 1 when it is the last one
+int dmaMove(uint32_t *c, uint8_t *from, uint8_t *to){ uint32_t n;
+  n = ((c[2]>>4)&0x3FF)+1;    // items left, the addresses are the last ones
+  if(from == 0){
+    from = simPt(c[0]-(n-1));
+  }
+  if(to == 0){
+    to = simPt(c[1]-(n-1));
+  }
+  *to = *from;
+  if(n == 1){
+    c[2] &= ~0x3FF7;          // stopped, XFERSIZE 0
+    return 1;
+  }
+  c[2] -= 0x10;
+  return 0;
+}
+// the uDMA answers every request it can
+void dma(void){ uint32_t *c,*other,n,k; int s,burst; uint8_t letter;
+  SimDone();
+  if(UART0_DMACTL&UART_DMACTL_RXDMAE){
+    while(SimEna&BIT8){
+      burst = (SimRxN >= rxLevel());
+      if(!burst && ((SimBurst&BIT8) || (SimRxN == 0))){
+        break;
+      }
+      s = (SimAlt&BIT8) ? 1 : 0;
+      c = &ControlTable[(s ? ALT : 0)+CH8];
+      other = &ControlTable[(s ? 0 : ALT)+CH8];
+      if((c[2]&0x07) == 0){   // a stopped structure is an error
+        SimEna &= ~BIT8;
+        break;
+      }
+      n = burst ? (SimArb ? SimArb : 1u<<((c[2]>>14)&0x0F)) : 1;
+      for(k=0; (k<n) && SimRxN; k++){
+        letter = rxTake();
+        if(dmaMove(c, &letter, 0)){
+          SimChis |= BIT8;
+          if((other[2]&0x07) == 0){
+            SimEna &= ~BIT8;
+          } else{
+            SimAlt ^= BIT8;
+          }
+          break;
+        }
+      }
+    }
+  }
+  if(UART0_DMACTL&UART_DMACTL_TXDMAE){
+    c = &ControlTable[CH9];
+    while((SimEna&BIT9) && (SimTxN < 16)){
+      if(dmaMove(c, 0, &SimTx[SimTxN++])){
+        SimChis |= BIT9;
+        SimEna &= ~BIT9;
+      }
+    }
+  }
+}
+#else
+void dma(void){
+  SimDone();
+}
+#endif
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+long Ints;                    // times UART0_Handler ran
+double HandlerTime;           // seconds in it
+int Stuck;                    // 1 if an interrupt never went away
+uint8_t Line[8192];           // characters sent out of the TX FIFO
+int LineN;
+void simReset(void){
+  SimEna = SimAlt = SimChis = SimBurst = SimTimeOut = SimIdle = 0;
+  SimRxN = SimTxN = 0;
+  SimArb = 0;
+  Ints = 0;
+  HandlerTime = 0;
+  LineN = 0;
+  UART_Init();
+  SimDone();
+  SimAccesses = SimCpuChars = SimOverruns = 0;
+}
+int pending(void){
+  SimDone();
+  return (ris()&UART0_IM) || SimChis;
+}
+// one character time, letter is -1 for an idle line
+void step(int letter){ int n; double t;
+  SimDone();
+  if(letter >= 0){
+    if(SimRxN < 16){
+      SimRx[SimRxN++] = letter;
+    } else{
+      SimOverruns++;
+    }
+    SimIdle = 0;
+  } else{
+    SimIdle = SimIdle+10;
+    if((SimIdle >= 32) && (SimIdle < 42) && SimRxN){
+      SimTimeOut = 1;         // once for each idle line
+    }
+  }
+  if(SimTxN){
+    if(LineN < (int)sizeof(Line)){
+      Line[LineN] = SimTx[0];
+    }
+    LineN++;
+    SimTxN--;
+    memmove(SimTx, SimTx+1, SimTxN);
+  }
+  dma();
+  for(n=0; pending(); n++){
+    if(n == 100){
+      Stuck = 1;
+      return;
+    }
+    Ints++;
+    t = seconds();
+    UART0_Handler();
+    HandlerTime += seconds()-t;
+    dma();
+  }
+}
+
+uint8_t Sent[1<<20],Got[1<<20];
+long SentN,GotN;
+void readAll(void){ char letter;
+  while((letter = UART_InCharNonBlock()) != 0){
+    if(GotN < (long)sizeof(Got)){
+      Got[GotN] = letter;
+    }
+    GotN++;
+  }
+}
+void send(int len){ int i,c;
+  for(i=0; i<len; i++){
+    c = 1+rand()%255;         // 0 means empty to UART_InCharNonBlock
+    Sent[SentN++] = c;
+    step(c);
+    readAll();
+  }
+}
+void idle(int n){
+  while(n--){
+    step(-1);
+    readAll();
+  }
+}
+
+void testMessages(void){ int m; double kb;
+  simReset();
+  srand(1);
+  SentN = GotN = 0;
+  for(m=0; m<2000; m++){
+    send(1+rand()%300);
+    idle(5);
+  }
+  check(GotN == SentN, "messages: every character read");
+  check(memcmp(Got, Sent, SentN) == 0, "messages: in order");
+  check(SimOverruns == 0, "messages: no hardware overrun");
+  check(Stuck == 0, "messages: interrupts acknowledged");
+#if UART_DMA
+  check(UART_RxLost() == 0, "messages: nothing lost");
+#endif
+  kb = SentN/1024.0;
+  printf("%ld characters, per KB: %.1f interrupts, %.1f moved by the processor,\n"
+         "  %.0f register accesses, %.0f ns in UART0_Handler on this PC,\n"
+         "  at least %.0f bus cycles (24 to enter and leave, 2 a register access)\n",
+         SentN, Ints/kb, SimCpuChars/kb, SimAccesses/kb, 1e9*HandlerTime/kb,
+         (24.0*Ints+2.0*SimAccesses)/kb);
+}
+
+// messages of 8, 16, ... 256, returns the characters still waiting after the idle line
+int Late;                     // messages that had characters waiting
+long multiples(uint32_t arb){ int len; long waiting;
+  simReset();
+  SimArb = arb;
+  srand(2);
+  SentN = GotN = 0;
+  waiting = 0;
+  Late = 0;
+  for(len=8; len<=256; len=len+8){
+    send(len);
+    idle(10);
+    waiting += SentN-GotN;
+    if(GotN < SentN){
+      Late++;
+      send(1);                // the next message pushes it out
+      idle(10);
+    }
+  }
+  check(memcmp(Got, Sent, SentN) == 0, "multiples: in order");
+  return waiting;
+}
+void testMultiples(void){ long waiting;
+  waiting = multiples(0);
+  check(waiting == 0, "multiples: the time out hands out every character");
+#if UART_DMA
+  waiting = multiples(8);
+  printf("with bursts of 8, %d of 32 messages left %ld characters in RxBlock\n", Late, waiting);
+  check(waiting > 0, "multiples: the model shows the old problem");
+#endif
+}
+
+int Done;
+void callback(void){
+  Done++;
+}
+void testTransmit(void){ static char buf[3000]; int i;
+  simReset();
+  for(i=0; i<3000; i++){
+    buf[i] = 'A'+i%26;
+  }
+#if UART_DMA
+  Done = 0;
+  check(UART_WriteBuffer(buf, 3000, &callback) == 1, "transmit: started");
+  check(UART_WriteBuffer(buf, 10, 0) == 0, "transmit: busy while sending");
+  check(UART_WriteBusy() == 1, "transmit: UART_WriteBusy");
+#else
+  for(i=0; i<3000; i++){
+    while(TxFifo_Size() >= 1023){
+      step(-1);
+    }
+    UART_OutChar(buf[i]);
+  }
+#endif
+  UART_OutString("tail");
+  for(i=0; (i<5000) && (LineN<3004); i++){
+    step(-1);
+  }
+  check(LineN == 3004, "transmit: every character sent");
+  check(memcmp(Line, buf, 3000) == 0, "transmit: the buffer");
+  check(memcmp(Line+3000, "tail", 4) == 0, "transmit: UART_OutString after it");
+#if UART_DMA
+  check(Done == 1, "transmit: callback once");
+  check(UART_WriteBusy() == 0, "transmit: done");
+#endif
+  printf("3000 characters sent with %ld interrupts, the processor moved %ld\n", Ints, SimCpuChars);
+}
+
+int main(void){
+  printf("UART_DMA %d\n", UART_DMA);
+  testMessages();
+  testMultiples();
+  testTransmit();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
@@ -55,6 +55,7 @@ ESP8266    TM4C123
 #include <stdlib.h>
 #include "../inc/tm4c123gh6pm.h"
 #include "esp8266.h"
+#include "ATParse.h"
 #include "UART.h"
 // Access point parameters
 #define SSID_NAME  "ValvanoAP"
@@ -88,10 +89,7 @@ void ESP8266FIFOtoBuffer(void);
 =============================================================
 */
 
-uint32_t RXBufferIndex = 0;
-uint32_t LastReturnIndex = 0;
-uint32_t CurrentReturnIndex = 0;
-char RXBuffer[BUFFER_SIZE];
+char RXBuffer[BUFFER_SIZE];   // data after +IPD, from the parser
 char TXBuffer[BUFFER_SIZE];
 #define SERVER_RESPONSE_SIZE 1024
 char ServerResponseBuffer[SERVER_RESPONSE_SIZE]; // characters after +IPD,
@@ -111,89 +109,50 @@ volatile bool ESP8266_PageRequested = false;
 ==========              search FUNCTIONS                     ==========
 =======================================================================
 */
-char SearchString[32];
+at_parser_t Parser;           // finds OK, ERROR, ready, +IPD... in one pass
+volatile uint32_t SearchEvents = 0;  // responses that end the search
 volatile bool SearchLooking = false;
 volatile bool SearchFound = false;
-volatile uint32_t SearchIndex = 0;
-char lc(char letter){
-  if((letter>='A')&&(letter<='Z')) letter |= 0x20;
-  return letter;
-}
 //-------------------SearchStart -------------------
-// - start looking for string in received data stream
-// Inputs: none
+// - start looking for responses in received data stream
+// Inputs: events, such as AT_OK or AT_OK|AT_NOCHANGE
 // Outputs: none
-void SearchStart(char *pt){
-  strcpy(SearchString,pt);
-  SearchIndex = 0;
+void SearchStart(uint32_t events){
+  SearchEvents = events;
   SearchFound = false;
   SearchLooking = true;
 }
-//-------------------SearchCheck -------------------
-// - start looking for string in received data stream
-// Inputs: none
-// Outputs: none
-void SearchCheck(char letter){
-  if(SearchLooking){
-    if(SearchString[SearchIndex] == lc(letter)){ // match letter?
-      SearchIndex++;
-      if(SearchString[SearchIndex] == 0){ // match string?
-        SearchFound = true;
-        SearchLooking = false;  
-      }        
-    }else{
-      SearchIndex = 0; // start over
-    }
-  }
-}
 
-char ServerResponseSearchString[16]="+ipd,";
 volatile uint32_t ServerResponseSearchFinished = false;
-volatile uint32_t ServerResponseSearchIndex = 0;
 volatile uint32_t ServerResponseSearchLooking = 0;
 
 //-------------------ServerResponseSearchStart -------------------
-// - start looking for server response string in received data stream
+// - start collecting the data after +IPD into ServerResponseBuffer
 // Inputs: none
 // Outputs: none
 void ServerResponseSearchStart(void){
-  strcpy(ServerResponseSearchString,"+ipd,");
-  ServerResponseSearchIndex = 0;
-  ServerResponseSearchLooking = 1; // means look for "+IPD"
-  ServerResponseSearchFinished = 0;
   ServerResponseIndex = 0;
+  ServerResponseSearchFinished = 0;
+  ServerResponseSearchLooking = 1; // means look for "+IPD"
 }
 
-//-------------------ServerResponseSearchCheck -------------------
-// - start looking for string in received data stream
-// Inputs: none
+//-------------------ESP8266Response -------------------
+// - called by the parser with each response, in the UART1 ISR
+// Inputs: response and the data after +IPD
 // Outputs: none
-void ServerResponseSearchCheck(char letter){
-  if(ServerResponseSearchLooking==1){
-    if(ServerResponseSearchString[ServerResponseSearchIndex] == lc(letter)){ // match letter?
-      ServerResponseSearchIndex++;
-      if(ServerResponseSearchString[ServerResponseSearchIndex] == 0){ // match string?
-        ServerResponseSearchLooking = 2; 
-        strcpy(ServerResponseSearchString,"\r\nok\r\n"); 
-        ServerResponseSearchIndex = 0;        
-      }        
-    }else{
-      ServerResponseSearchIndex = 0; // start over
-    }
-  }else if(ServerResponseSearchLooking==2){
-    if(ServerResponseIndex < SERVER_RESPONSE_SIZE){
-      ServerResponseBuffer[ServerResponseIndex] = lc(letter); // copy data from "+IPD," to "OK"
-      ServerResponseIndex++;
-    }
-    if(ServerResponseSearchString[ServerResponseSearchIndex] == lc(letter)){ // match letter?
-      ServerResponseSearchIndex++;
-      if(ServerResponseSearchString[ServerResponseSearchIndex] == 0){   // match OK string?
-        ServerResponseSearchFinished = 1;
-        ServerResponseSearchLooking = 0;    
-      }        
-    }else{
-      ServerResponseSearchIndex = 0; // start over
+void ESP8266Response(const at_event_t *e){ uint32_t n;
+  if(SearchLooking && (e->id&SearchEvents)){
+    SearchFound = true;
+    SearchLooking = false;
+  }
+  if((e->id == AT_IPD) && ServerResponseSearchLooking){
+    n = e->len;
+    if(n > SERVER_RESPONSE_SIZE-ServerResponseIndex){
+      n = SERVER_RESPONSE_SIZE-ServerResponseIndex; // keep what fits
     }
+    memcpy(&ServerResponseBuffer[ServerResponseIndex], e->data, n);
+    ServerResponseIndex += n;
+    ServerResponseSearchFinished = 1; // later +IPD packets are added on
   }
 }
 /*
@@ -210,6 +169,7 @@ void ServerResponseSearchCheck(char letter){
 // Outputs: none
 void ESP8266_InitUART(uint32_t baud, int echo){ volatile int delay;
   ESP8266_EchoResponse = echo;
+  ATParse_Init(&Parser, RXBuffer, BUFFER_SIZE, &ESP8266Response);
   SYSCTL_RCGCUART_R |= 0x02; // Enable UART1
   while((SYSCTL_PRUART_R&0x02)==0){};
   SYSCTL_RCGCGPIO_R |= 0x02; // Enable PORT B clock gating
@@ -271,9 +231,9 @@ void ESP8266_PrintChar(char input){
 //  UART_OutChar(input); // echo debugging
 }
 //----------ESP8266FIFOtoBuffer----------
-// - copies uart fifo to RXBuffer, using a circular MACQ to store the last data
-// - NOTE: would probably be better to use a software defined FIFO here
-// - LastReturnIndex is index to previous \n
+// - gives each character in the uart fifo to the response parser,
+//   which calls ESP8266Response for each response it finds and
+//   puts the data after +IPD in RXBuffer
 // Inputs: none
 // Outputs:none
 void ESP8266FIFOtoBuffer(void){
@@ -283,17 +243,7 @@ void ESP8266FIFOtoBuffer(void){
     if(ESP8266_EchoResponse){
       UART_OutCharNonBlock(letter); // echo
     }
-    if(RXBufferIndex >= BUFFER_SIZE){
-      RXBufferIndex = 0; // store last BUFFER_SIZE received
-    }
-    RXBuffer[RXBufferIndex] = letter; // put char into buffer
-    RXBufferIndex++; // increment buffer index 
-    SearchCheck(letter);               // check for end of command
-    ServerResponseSearchCheck(letter); // check for server response
-    if(letter == '\n'){
-      LastReturnIndex = CurrentReturnIndex;
-      CurrentReturnIndex = RXBufferIndex;
-    }    
+    ATParse_Input(&Parser, letter);
   }
 }
 
@@ -396,7 +346,7 @@ void ESP8266_Init(uint32_t baud){
 // input:  none
 // output: 1 if success, 0 if fail
 int ESP8266_Reset(){int try=MAXTRY;
-  SearchStart("ready");
+  SearchStart(AT_READY);
   while(try){
     GPIO_PORTB_DATA_R &= ~0x20; // reset low
     DelayMs(10);
@@ -411,13 +361,13 @@ int ESP8266_Reset(){int try=MAXTRY;
 
 //---------ESP8266_SetWifiMode----------
 // configures the esp8266 to operate as a wifi client, access point, or both
-// since it searches for "no change" it will execute twice when changing modes
+// done when it says "no change", or OK after changing modes
 // Input: mode accepts ESP8266_WIFI_MODE constants
 // output: 1 if success, 0 if fail 
 int ESP8266_SetWifiMode(uint8_t mode){
   int try=MAXTRY;
   if(mode > ESP8266_WIFI_MODE_AP_AND_CLIENT)return 0; // fail
-  SearchStart("no change");
+  SearchStart(AT_OK|AT_NOCHANGE);
   while(try){
     sprintf((char*)TXBuffer, "AT+CWMODE=%d\r\n", mode);
     ESP8266SendCommand((const char*)TXBuffer);
@@ -434,7 +384,7 @@ int ESP8266_SetWifiMode(uint8_t mode){
 // output: 1 if success, 0 if fail 
 int ESP8266_SetConnectionMux(uint8_t enabled){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     sprintf((char*)TXBuffer, "AT+CIPMUX=%d\r\n", enabled);
     ESP8266SendCommand((const char*)TXBuffer);
@@ -451,7 +401,7 @@ int ESP8266_SetConnectionMux(uint8_t enabled){
 // output: 1 if success, 0 if fail
 int ESP8266_JoinAccessPoint(const char* ssid, const char* password){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     sprintf((char*)TXBuffer, "AT+CWJAP=\"%s\",\"%s\"\r\n", ssid, password);
     ESP8266SendCommand((const char*)TXBuffer);
@@ -468,7 +418,7 @@ int ESP8266_JoinAccessPoint(const char* ssid, const char* password){
 // output: 1 if success, 0 if fail 
 int ESP8266_ListAccessPoints(void){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     ESP8266SendCommand("AT+CWLAP\r\n");
     DelayMsSearching(8000);
@@ -484,7 +434,7 @@ int ESP8266_ListAccessPoints(void){
 // Outputs: 1 if success, 0 if fail 
 int ESP8266_QuitAccessPoint(void){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     ESP8266SendCommand("AT+CWQAP\r\n");
     DelayMsSearching(8000);
@@ -501,7 +451,7 @@ int ESP8266_QuitAccessPoint(void){
 // output: 1 if success, 0 if fail
 int ESP8266_ConfigureAccessPoint(const char* ssid, const char* password, uint8_t channel, uint8_t encryptMode){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     sprintf((char*)TXBuffer, "AT+CWSAP=\"%s\",\"%s\",%d,%d\r\n", ssid, password, channel, encryptMode);
     ESP8266SendCommand((const char*)TXBuffer);
@@ -518,7 +468,7 @@ int ESP8266_ConfigureAccessPoint(const char* ssid, const char* password, uint8_t
 // output: 1 if success, 0 if fail 
 int ESP8266_GetIPAddress(void){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     ESP8266SendCommand("AT+CIFSR\r\n");   
     DelayMsSearching(5000);
@@ -534,7 +484,7 @@ int ESP8266_GetIPAddress(void){
 // output: 1 if success, 0 if fail 
 int ESP8266_MakeTCPConnection(char *IPaddress){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     sprintf((char*)TXBuffer, "AT+CIPSTART=\"TCP\",\"%s\",80\r\n", IPaddress);
     ESP8266SendCommand(TXBuffer);   // open and connect to a socket
@@ -574,7 +524,7 @@ int ESP8266_SendTCP(char* fetch){
 // output: 1 if success, 0 if fail 
 int ESP8266_CloseTCPConnection(void){
   int try=1;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     ESP8266SendCommand("AT+CIPCLOSE\r\n");   
     DelayMsSearching(4000);
@@ -589,7 +539,7 @@ int ESP8266_CloseTCPConnection(void){
 // output: 1 if success, 0 if fail 
 int ESP8266_SetDataTransmissionMode(uint8_t mode){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     sprintf((char*)TXBuffer, "AT+CIPMODE=%d\r\n", mode);
     ESP8266SendCommand((const char*)TXBuffer);
@@ -606,7 +556,7 @@ int ESP8266_SetDataTransmissionMode(uint8_t mode){
 // output: 1 if success, 0 if fail 
 int ESP8266_GetStatus(void){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     ESP8266SendCommand("AT+CIPSTATUS\r\n");
     DelayMsSearching(5000);
@@ -622,7 +572,7 @@ int ESP8266_GetStatus(void){
 // output: 1 if success, 0 if fail 
 int ESP8266_GetVersionNumber(void){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     ESP8266SendCommand("AT+GMR\r\n");
     DelayMsSearching(500);
@@ -689,7 +639,7 @@ void ESP8266_EnableServer(uint16_t port){
 // output: 1 if success, 0 if fail 
 int ESP8266_DisableServer(void){
   int try=MAXTRY;
-  SearchStart("ok");
+  SearchStart(AT_OK);
   while(try){
     sprintf((char*)TXBuffer, "AT+CIPSERVER=0,%d\r\n", ESP8266_ServerPort);
     ESP8266SendCommand((const char*)TXBuffer); 
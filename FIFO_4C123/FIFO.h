@@ -28,6 +28,8 @@
 #ifndef __FIFO_H__
 #define __FIFO_H__
 
+#include <string.h>
+
 long StartCritical (void);    // previous I bit, disable interrupts
 void EndCritical(long sr);    // restore I bit to previous value
 
@@ -150,4 +152,214 @@ unsigned short NAME ## Fifo_Size (void){\
 // SIZE can be any size
 // creates RxFifo_Init() RxFifo_Get() and RxFifo_Put()
 
+// memory barriers, so the other side never sees an index before the
+// data it covers, and never reuses a slot before it has been read
+// FIFO_RELEASE goes before writing an index: accesses before it finish first
+// FIFO_ACQUIRE goes after reading the other side's index: accesses after
+// it wait for the read
+// both are DMB on the Cortex M; on a host PC with GCC they only stop the
+// compiler and the processor from moving accesses across them, which on
+// x86 costs no instruction at all
+#if defined(__ARMCC_VERSION)
+#define FIFO_RELEASE() __dmb(0xF)
+#define FIFO_ACQUIRE() __dmb(0xF)
+#elif defined(__TI_COMPILER_VERSION__)
+#define FIFO_RELEASE() __asm(" DMB")
+#define FIFO_ACQUIRE() __asm(" DMB")
+#elif defined(__GNUC__)
+#define FIFO_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#define FIFO_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+#error "FIFO.h needs memory barriers for this compiler"
+#endif
+
+// macro to create a lock-free single producer single consumer FIFO
+// exactly one thread or ISR may call Put, PutBulk, PutPeek and PutCommit
+// exactly one thread or ISR may call Get, GetBulk, GetPeek and GetCommit
+// no critical sections: the producer only writes PutI, the consumer
+// only writes GetI, and barriers order the data and the indexes
+// Bulk functions move up to n elements with at most two memcpy calls
+// and return how many were moved
+// Peek returns a pointer to the contiguous free space (Put side) or
+// data (Get side) and its length, Commit then adds or removes n of them
+#define AddSpscFifo(NAME,SIZE,TYPE,SUCCESS,FAIL) \
+uint32_t volatile NAME ## PutI;         \
+uint32_t volatile NAME ## GetI;         \
+TYPE static NAME ## Fifo [SIZE];        \
+void NAME ## Fifo_Init(void){           \
+  NAME ## PutI = NAME ## GetI = 0;      \
+}                                       \
+int NAME ## Fifo_Put (TYPE data){       \
+  uint32_t putI = NAME ## PutI;         \
+  if(( putI - NAME ## GetI ) & ~(SIZE-1)){ \
+    return(FAIL);                       \
+  }                                     \
+  FIFO_ACQUIRE();                       \
+  NAME ## Fifo[ putI &(SIZE-1)] = data; \
+  FIFO_RELEASE();                       \
+  NAME ## PutI = putI + 1;              \
+  return(SUCCESS);                      \
+}                                       \
+int NAME ## Fifo_Get (TYPE *datapt){    \
+  uint32_t getI = NAME ## GetI;         \
+  if( NAME ## PutI == getI ){           \
+    return(FAIL);                       \
+  }                                     \
+  FIFO_ACQUIRE();                       \
+  *datapt = NAME ## Fifo[ getI &(SIZE-1)]; \
+  FIFO_RELEASE();                       \
+  NAME ## GetI = getI + 1;              \
+  return(SUCCESS);                      \
+}                                       \
+uint32_t NAME ## Fifo_Size (void){      \
+  return ((uint32_t)( NAME ## PutI - NAME ## GetI )); \
+}                                       \
+TYPE * NAME ## Fifo_PutPeek (uint32_t *np){ \
+  uint32_t putI = NAME ## PutI;         \
+  uint32_t room = SIZE - (putI - NAME ## GetI); \
+  uint32_t toEnd = SIZE - (putI&(SIZE-1)); \
+  FIFO_ACQUIRE();                       \
+  *np = (room < toEnd) ? room : toEnd;  \
+  return &NAME ## Fifo[putI&(SIZE-1)];  \
+}                                       \
+void NAME ## Fifo_PutCommit (uint32_t n){ \
+  FIFO_RELEASE();                       \
+  NAME ## PutI = NAME ## PutI + n;      \
+}                                       \
+const TYPE * NAME ## Fifo_GetPeek (uint32_t *np){ \
+  uint32_t getI = NAME ## GetI;         \
+  uint32_t count = NAME ## PutI - getI; \
+  uint32_t toEnd = SIZE - (getI&(SIZE-1)); \
+  FIFO_ACQUIRE();                       \
+  *np = (count < toEnd) ? count : toEnd; \
+  return &NAME ## Fifo[getI&(SIZE-1)];  \
+}                                       \
+void NAME ## Fifo_GetCommit (uint32_t n){ \
+  FIFO_RELEASE();                       \
+  NAME ## GetI = NAME ## GetI + n;      \
+}                                       \
+uint32_t NAME ## Fifo_PutBulk (const TYPE *src, uint32_t n){ \
+  uint32_t putI = NAME ## PutI;         \
+  uint32_t room = SIZE - (putI - NAME ## GetI); \
+  uint32_t first = SIZE - (putI&(SIZE-1)); \
+  if(n > room){                         \
+    n = room;                           \
+  }                                     \
+  if(first > n){                        \
+    first = n;                          \
+  }                                     \
+  FIFO_ACQUIRE();                       \
+  memcpy(&NAME ## Fifo[putI&(SIZE-1)], src, first*sizeof(TYPE)); \
+  memcpy(&NAME ## Fifo[0], src+first, (n-first)*sizeof(TYPE)); \
+  FIFO_RELEASE();                       \
+  NAME ## PutI = putI + n;              \
+  return n;                             \
+}                                       \
+uint32_t NAME ## Fifo_GetBulk (TYPE *dst, uint32_t n){ \
+  uint32_t getI = NAME ## GetI;         \
+  uint32_t count = NAME ## PutI - getI; \
+  uint32_t first = SIZE - (getI&(SIZE-1)); \
+  if(n > count){                        \
+    n = count;                          \
+  }                                     \
+  if(first > n){                        \
+    first = n;                          \
+  }                                     \
+  FIFO_ACQUIRE();                       \
+  memcpy(dst, &NAME ## Fifo[getI&(SIZE-1)], first*sizeof(TYPE)); \
+  memcpy(dst+first, &NAME ## Fifo[0], (n-first)*sizeof(TYPE)); \
+  FIFO_RELEASE();                       \
+  NAME ## GetI = getI + n;              \
+  return n;                             \
+}
+// e.g.,
+// AddSpscFifo(Rx,256,char, 1,0)
+// SIZE must be a power of two, can hold 0 to SIZE elements
+// creates RxFifo_Init() RxFifo_Get() RxFifo_Put() RxFifo_Size()
+// RxFifo_PutBulk() RxFifo_GetBulk() RxFifo_PutPeek() RxFifo_PutCommit()
+// RxFifo_GetPeek() and RxFifo_GetCommit()
+
+// compare and swap, atomically set *addr to new if it still equals old
+// returns 1 if the swap happened, 0 if some other producer got there first
+// LDREX/STREX on the Cortex M, C11 atomics on a host PC
+// interrupts are never disabled, an ISR that interrupts between the
+// LDREX and STREX makes the STREX fail and the caller tries again
+#if defined(__ARMCC_VERSION) || defined(__TI_COMPILER_VERSION__)
+static __inline int FIFO_CAS(uint32_t volatile *addr, uint32_t old, uint32_t new){
+  if(__ldrex(addr) != old){
+    __clrex();
+    return 0;
+  }
+  return (__strex(new, addr) == 0);
+}
+#elif defined(__GNUC__) && defined(__arm__)
+static __inline int FIFO_CAS(uint32_t volatile *addr, uint32_t old, uint32_t new){
+  return __atomic_compare_exchange_n(addr, &old, new, 0,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#else
+#include <stdatomic.h>
+static inline int FIFO_CAS(uint32_t volatile *addr, uint32_t old, uint32_t new){
+  return atomic_compare_exchange_strong((_Atomic uint32_t *)addr, &old, new);
+}
+#endif
+
+// macro to create a multiple producer single consumer FIFO
+// any number of threads and ISRs, at any priority, may call Put
+// exactly one thread or ISR may call Get
+// a producer reserves a slot by advancing PutI with FIFO_CAS, writes
+// its data, then marks the slot full in Seq; the consumer only takes a
+// slot that is marked full, so a producer that was interrupted after
+// reserving never lets the consumer read a half written element
+// Seq[i] is p when the slot is free for put number p, p+1 when full
+#define AddMpscFifo(NAME,SIZE,TYPE,SUCCESS,FAIL) \
+uint32_t volatile NAME ## PutI;         \
+uint32_t volatile NAME ## GetI;         \
+uint32_t volatile NAME ## Seq [SIZE];   \
+TYPE static NAME ## Fifo [SIZE];        \
+void NAME ## Fifo_Init(void){ uint32_t i; \
+  NAME ## PutI = NAME ## GetI = 0;      \
+  for(i=0; i<SIZE; i=i+1){              \
+    NAME ## Seq[i] = i;                 \
+  }                                     \
+}                                       \
+int NAME ## Fifo_Put (TYPE data){       \
+  uint32_t putI; int32_t diff;          \
+  for(;;){                              \
+    putI = NAME ## PutI;                \
+    diff = (int32_t)(NAME ## Seq[putI&(SIZE-1)] - putI); \
+    if(diff < 0){                       \
+      return(FAIL);                     \
+    }                                   \
+    if((diff == 0) && FIFO_CAS(&NAME ## PutI, putI, putI+1)){ \
+      break;                            \
+    }                                   \
+  }                                     \
+  FIFO_ACQUIRE();                       \
+  NAME ## Fifo[putI&(SIZE-1)] = data;   \
+  FIFO_RELEASE();                       \
+  NAME ## Seq[putI&(SIZE-1)] = putI+1;  \
+  return(SUCCESS);                      \
+}                                       \
+int NAME ## Fifo_Get (TYPE *datapt){    \
+  uint32_t getI = NAME ## GetI;         \
+  if( NAME ## Seq[getI&(SIZE-1)] != getI+1 ){ \
+    return(FAIL);                       \
+  }                                     \
+  FIFO_ACQUIRE();                       \
+  *datapt = NAME ## Fifo[getI&(SIZE-1)]; \
+  FIFO_RELEASE();                       \
+  NAME ## Seq[getI&(SIZE-1)] = getI+SIZE; \
+  NAME ## GetI = getI+1;                \
+  return(SUCCESS);                      \
+}                                       \
+uint32_t NAME ## Fifo_Size (void){      \
+  return ((uint32_t)( NAME ## PutI - NAME ## GetI )); \
+}
+// e.g.,
+// AddMpscFifo(Log,64,uint32_t, 1,0)
+// SIZE must be a power of two, can hold 0 to SIZE elements
+// Size counts slots that are reserved but not yet written
+// creates LogFifo_Init() LogFifo_Get() LogFifo_Put() and LogFifo_Size()
+
 #endif //  __FIFO_H__
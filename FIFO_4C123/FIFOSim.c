@@ -0,0 +1,287 @@
+// FIFOSim.c
+// Runs on a PC, not on the LaunchPad
+// Test the lock-free FIFOs of FIFO.h with real threads, and compare
+// their speed with the FIFOs in FIFO.c.
+//   stress     one producer thread and one consumer thread move
+//              5,000,000 numbers through a 64-element AddSpscFifo,
+//              using Put, PutBulk and PutPeek/PutCommit on one side
+//              and Get, GetBulk and GetPeek/GetCommit on the other,
+//              and check that every number arrives once, in order
+//   benchmark  ns per byte for RxFifo_Put/RxFifo_Get in FIFO.c, and
+//              for AddSpscFifo one byte at a time and in blocks, all
+//              16 bytes deep in one thread, then MB/s from one thread
+//              to another through a 256-byte AddSpscFifo
+//   mpsc       1, 2, 4 and 8 producer threads put tagged numbers into
+//              one 64-element AddMpscFifo while one consumer thread
+//              takes them out, checks that nothing is lost or
+//              duplicated and that each producer's numbers stay in
+//              order, and reports puts per second
+// StartCritical and EndCritical do nothing here, so RxFifo is faster
+// than on the LaunchPad, where each call disables interrupts.  On an
+// x86 PC FIFO_RELEASE and FIFO_ACQUIRE cost no instructions, where
+// on the M4 each is a DMB, so one byte at a time the two are close
+// here; the blocks show the cost per byte when the barriers are paid
+// once per block.
+//   gcc -O2 FIFOSim.c FIFO.c -o FIFOSim -lpthread
+//   ./FIFOSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "FIFO.h"
+
+long StartCritical(void){ return 0; }
+void EndCritical(long sr){ (void)sr; }
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+//************stress*************
+#define NUMBERS 5000000
+AddSpscFifo(Stress,64,uint32_t, 1,0)
+void *producer(void *arg){ uint32_t v,n,i,buf[7]; uint32_t *pt;
+  v = 0;
+  while(v < NUMBERS){
+    switch(v%3){
+      case 0:                 // one at a time
+        n = StressFifo_Put(v);
+        break;
+      case 1:                 // up to 7 with two memcpy
+        n = (NUMBERS-v < 7) ? NUMBERS-v : 7;
+        for(i=0; i<n; i++){
+          buf[i] = v+i;
+        }
+        n = StressFifo_PutBulk(buf, n);
+        break;
+      default:                // written in place
+        pt = StressFifo_PutPeek(&n);
+        if(n > 3){
+          n = 3;
+        }
+        if(n > NUMBERS-v){
+          n = NUMBERS-v;
+        }
+        for(i=0; i<n; i++){
+          pt[i] = v+i;
+        }
+        StressFifo_PutCommit(n);
+    }
+    v = v+n;
+    if(n == 0){
+      sched_yield();          // full
+    }
+  }
+  return arg;
+}
+void stress(void){ pthread_t thread; uint32_t expect,n,i,data,bad,most,buf[11];
+  const uint32_t *pt;
+  printf("stress, %u numbers through a 64-element AddSpscFifo\n", NUMBERS);
+  StressFifo_Init();
+  pthread_create(&thread, 0, &producer, 0);
+  expect = bad = most = 0;
+  while(expect < NUMBERS){
+    n = StressFifo_Size();
+    if(n > most){
+      most = n;
+    }
+    switch(expect%3){
+      case 0:
+        n = StressFifo_GetBulk(buf, 11);
+        for(i=0; i<n; i++){
+          bad = bad+(buf[i] != expect);
+          expect++;
+        }
+        break;
+      case 1:
+        n = StressFifo_Get(&data);
+        if(n){
+          bad = bad+(data != expect);
+          expect++;
+        }
+        break;
+      default:
+        pt = StressFifo_GetPeek(&n);
+        for(i=0; i<n; i++){
+          bad = bad+(pt[i] != expect);
+          expect++;
+        }
+        StressFifo_GetCommit(n);
+    }
+    if(n == 0){
+      sched_yield();          // empty
+    }
+  }
+  pthread_join(thread, 0);
+  printf("  %u out of order or wrong, most in the FIFO %u\n", bad, most);
+  check(bad == 0, "every number once, in order");
+  check(most <= 64, "Size never more than SIZE");
+  check(StressFifo_Size() == 0, "empty at the end");
+}
+
+//************benchmark*************
+#define BYTES 50000000
+AddSpscFifo(Byte,16,char, 1,0)
+AddSpscFifo(Stream,256,char, 1,0)
+volatile char Sink;
+void *streamer(void *arg){ uint32_t n,m; char buf[64];
+  n = 0;
+  while(n < BYTES){
+    m = StreamFifo_PutBulk(buf, (BYTES-n < 64) ? BYTES-n : 64);
+    if(m == 0){
+      sched_yield();          // full
+    }
+    n = n+m;
+  }
+  return arg;
+}
+void benchmark(void){ uint32_t n,i; double t0,t1; char data,buf[16];
+  pthread_t thread;
+  printf("benchmark, %u bytes\n", BYTES);
+  RxFifo_Init();
+  t0 = seconds();
+  for(n=0; n<BYTES; n=n+15){  // RxFifo holds 15
+    for(i=0; i<15; i++){
+      RxFifo_Put(i);
+    }
+    for(i=0; i<15; i++){
+      RxFifo_Get(&data);
+      Sink = data;
+    }
+  }
+  t1 = seconds();
+  printf("  RxFifo_Put/Get, one byte        %6.2f ns per byte\n", 1e9*(t1-t0)/n);
+  ByteFifo_Init();
+  t0 = seconds();
+  for(n=0; n<BYTES; n=n+16){
+    for(i=0; i<16; i++){
+      ByteFifo_Put(i);
+    }
+    for(i=0; i<16; i++){
+      ByteFifo_Get(&data);
+      Sink = data;
+    }
+  }
+  t1 = seconds();
+  printf("  AddSpscFifo Put/Get, one byte   %6.2f ns per byte\n", 1e9*(t1-t0)/n);
+  t0 = seconds();
+  for(n=0; n<BYTES; n=n+16){
+    ByteFifo_PutBulk(buf, 16);
+    ByteFifo_GetBulk(buf, 16);
+    Sink = buf[5];
+  }
+  t1 = seconds();
+  printf("  AddSpscFifo PutBulk/GetBulk, 16 %6.2f ns per byte\n", 1e9*(t1-t0)/n);
+  check(ByteFifo_Size() == 0, "benchmark FIFO empty");
+
+  StreamFifo_Init();
+  t0 = seconds();
+  pthread_create(&thread, 0, &streamer, 0);
+  n = 0;
+  while(n < BYTES){
+    i = StreamFifo_GetBulk(buf, 16);
+    if(i == 0){
+      sched_yield();          // empty
+    }
+    n = n+i;
+  }
+  pthread_join(thread, 0);
+  t1 = seconds();
+  printf("  thread to thread, 256-byte AddSpscFifo, bulk  %.0f MB/s\n", 1e-6*n/(t1-t0));
+}
+
+//************multiple producers*************
+#define PUTS 1000000          // numbers from each producer
+#define MAXPRODUCERS 8
+AddMpscFifo(Multi,64,uint32_t, 1,0)
+void *multiProducer(void *arg){ uint32_t id,n;
+  id = (uint32_t)(uintptr_t)arg;
+  n = 0;
+  while(n < PUTS){
+    if(MultiFifo_Put((id<<24)|n)){ // producer in the top byte
+      n++;
+    } else{
+      sched_yield();          // full
+    }
+  }
+  return arg;
+}
+void mpsc(void){ pthread_t thread[MAXPRODUCERS]; uint32_t next[MAXPRODUCERS];
+  uint32_t producers,i,id,data,got,bad; double t0,t1;
+  printf("mpsc, %u numbers from each producer, 64-element AddMpscFifo\n", PUTS);
+  for(producers=1; producers<=MAXPRODUCERS; producers=producers*2){
+    MultiFifo_Init();
+    for(i=0; i<producers; i++){
+      next[i] = 0;
+    }
+    got = bad = 0;
+    t0 = seconds();
+    for(i=0; i<producers; i++){
+      pthread_create(&thread[i], 0, &multiProducer, (void *)(uintptr_t)i);
+    }
+    while(got < producers*PUTS){
+      if(MultiFifo_Get(&data)){
+        id = data>>24;
+        if((id >= producers)||((data&0xFFFFFF) != next[id])){
+          bad++;              // lost, duplicated, out of order or garbage
+        } else{
+          next[id]++;
+        }
+        got++;
+      } else{
+        sched_yield();        // empty
+      }
+    }
+    t1 = seconds();
+    for(i=0; i<producers; i++){
+      pthread_join(thread[i], 0);
+    }
+    for(i=0; i<producers; i++){
+      bad = bad+(next[i] != PUTS);
+    }
+    printf("  %u producers  %4.1f million puts per second  %u errors\n",
+           producers, 1e-6*got/(t1-t0), bad);
+    check(bad == 0, "no puts lost or duplicated");
+    check(MultiFifo_Size() == 0, "empty at the end");
+  }
+}
+
+int main(void){
+  stress();
+  benchmark();
+  mpsc();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
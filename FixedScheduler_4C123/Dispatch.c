@@ -0,0 +1,319 @@
+// Dispatch.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Run to completion scheduler.  Each task has a FIFO queue of events,
+// and each event holds the time it was posted, so its deadline is
+// known.  Every task runs on the one main stack, so unlike the
+// threads in FixedScheduler.c there is no stack per task and no
+// context switch, but a long task delays every other task.
+// Dispatch_Tick and Dispatch_Post run in interrupts, Dispatch_Once
+// in the main program, so the queues are changed with interrupts
+// disabled.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "Dispatch.h"
+
+void DisableInterrupts(void); // Disable interrupts
+void EnableInterrupts(void);  // Enable interrupts
+long StartCritical (void);    // previous I bit, disable interrupts
+void EndCritical(long sr);    // restore I bit to previous value
+void WaitForInterrupt(void);  // low power mode
+
+// private, so they do not clash with the task table or the user program
+static const dispatch_task_t *Tasks;
+static uint32_t NumTasks;
+static uint32_t Deadline[DISPATCH_TASKS];     // relative deadline of each task
+static uint32_t Order[DISPATCH_TASKS];        // tasks by priority, shortest deadline first
+static uint32_t Countdown[DISPATCH_TASKS];    // ticks until the next periodic post
+static uint32_t QueueData[DISPATCH_TASKS][DISPATCH_QUEUE];
+static uint32_t QueueTime[DISPATCH_TASKS][DISPATCH_QUEUE]; // time of each post
+static uint32_t PutI[DISPATCH_TASKS];         // free running, index is PutI&(DISPATCH_QUEUE-1)
+static uint32_t GetI[DISPATCH_TASKS];
+static uint32_t Misses[DISPATCH_TASKS];
+static uint32_t Lost[DISPATCH_TASKS];
+static uint32_t Runs[DISPATCH_TASKS];
+static uint32_t Worst[DISPATCH_TASKS];        // longest post to finish time
+static volatile uint32_t Ticks;               // time since Dispatch_Init
+static volatile uint32_t Pending;             // events in all queues
+
+//------------Dispatch_Init------------
+// Set up the tasks and empty every queue.  Task numbers are the
+// index into the table.  Periodic tasks are first posted one period
+// after the first Dispatch_Tick.
+// Input: tasks  table of tasks, must stay valid
+//        n      number of tasks, up to DISPATCH_TASKS
+// Output: none
+void Dispatch_Init(const dispatch_task_t tasks[], uint32_t n){ uint32_t i,j;
+  if(n > DISPATCH_TASKS){
+    n = DISPATCH_TASKS;
+  }
+  Tasks = tasks;
+  NumTasks = n;
+  for(i=0; i<n; i++){
+    Deadline[i] = tasks[i].deadline ? tasks[i].deadline : tasks[i].period;
+    Countdown[i] = tasks[i].period;
+    PutI[i] = GetI[i] = 0;
+    Misses[i] = Lost[i] = Runs[i] = Worst[i] = 0;
+    j = i;                        // insertion sort by deadline, stable
+    while((j > 0) && (Deadline[Order[j-1]] > Deadline[i])){
+      Order[j] = Order[j-1];
+      j--;
+    }
+    Order[j] = i;
+  }
+  Ticks = 0;
+  Pending = 0;
+}
+
+// add an event, called with interrupts disabled
+static int post(uint32_t id, uint32_t data){
+  if(PutI[id] - GetI[id] >= DISPATCH_QUEUE){
+    Lost[id]++;
+    return 0;
+  }
+  QueueData[id][PutI[id]&(DISPATCH_QUEUE-1)] = data;
+  QueueTime[id][PutI[id]&(DISPATCH_QUEUE-1)] = Ticks;
+  PutI[id]++;
+  Pending++;
+  return 1;
+}
+
+//------------Dispatch_Tick------------
+// Count time and post the periodic tasks, call from a periodic interrupt.
+// Input: none
+// Output: none
+void Dispatch_Tick(void){ uint32_t i; long sr;
+  sr = StartCritical();       // a higher priority interrupt may post
+  Ticks++;
+  for(i=0; i<NumTasks; i++){
+    if(Countdown[i]){
+      Countdown[i]--;
+      if(Countdown[i] == 0){
+        Countdown[i] = Tasks[i].period;
+        post(i, Ticks);
+      }
+    }
+  }
+  EndCritical(sr);
+}
+
+//------------Dispatch_Time------------
+// Input: none
+// Output: number of ticks since Dispatch_Init
+uint32_t Dispatch_Time(void){
+  return Ticks;
+}
+
+//------------Dispatch_Post------------
+// Add an event to a task's queue, may be called from an interrupt or
+// from a task.  The deadline is counted from now.
+// Input: id    task number
+//        data  passed to the task when it runs
+// Output: 1 if successful, 0 if the queue was full and the event lost
+int Dispatch_Post(uint32_t id, uint32_t data){ int ok; long sr;
+  if(id >= NumTasks){
+    return 0;
+  }
+  sr = StartCritical();
+  ok = post(id, data);
+  EndCritical(sr);
+  return ok;
+}
+
+//------------Dispatch_Once------------
+// Run the most urgent pending event to completion.
+// Input: none
+// Output: 1 if a task ran, 0 if nothing was pending
+int Dispatch_Once(void){
+  uint32_t i,id,best,data,posted,now; long sr;
+  sr = StartCritical();
+  best = DISPATCH_TASKS;      // none yet
+  for(i=0; i<NumTasks; i++){
+    id = Order[i];
+    if(PutI[id] != GetI[id]){
+#if DISPATCH_EDF
+      if((best == DISPATCH_TASKS) ||    // deadlines may wrap
+         ((int32_t)(QueueTime[id][GetI[id]&(DISPATCH_QUEUE-1)] + Deadline[id]
+                   - QueueTime[best][GetI[best]&(DISPATCH_QUEUE-1)] - Deadline[best]) < 0)){
+        best = id;
+      }
+#else
+      best = id;              // first ready in priority order
+      break;
+#endif
+    }
+  }
+  if(best == DISPATCH_TASKS){
+    EndCritical(sr);
+    return 0;
+  }
+  data = QueueData[best][GetI[best]&(DISPATCH_QUEUE-1)];
+  posted = QueueTime[best][GetI[best]&(DISPATCH_QUEUE-1)];
+  GetI[best]++;
+  Pending--;
+  EndCritical(sr);
+  Tasks[best].task(data);     // runs with interrupts enabled
+  now = Ticks;
+  Runs[best]++;
+  if(now - posted > Worst[best]){
+    Worst[best] = now - posted;
+  }
+  if(now - posted > Deadline[best]){
+    Misses[best]++;
+  }
+  return 1;
+}
+
+//------------Dispatch_Run------------
+// Run events forever, sleeping with WaitForInterrupt when none are
+// pending.  Interrupts must be enabled.  Does not return.
+// Input: none
+// Output: none
+void Dispatch_Run(void){
+  for(;;){
+    DisableInterrupts();
+    if(Pending == 0){
+      WaitForInterrupt();     // wakes up even though I=1
+    }
+    EnableInterrupts();       // the waking interrupt runs now
+    Dispatch_Once();
+  }
+}
+
+//------------Dispatch_Misses------------
+// Input: id  task number
+// Output: number of times the task finished after its deadline
+uint32_t Dispatch_Misses(uint32_t id){
+  return Misses[id];
+}
+
+//------------Dispatch_Lost------------
+// Input: id  task number
+// Output: number of events lost because the task's queue was full
+uint32_t Dispatch_Lost(uint32_t id){
+  return Lost[id];
+}
+
+//------------Dispatch_Runs------------
+// Input: id  task number
+// Output: number of times the task has run
+uint32_t Dispatch_Runs(uint32_t id){
+  return Runs[id];
+}
+
+//------------Dispatch_Worst------------
+// Input: id  task number
+// Output: longest time in ticks from a post to the end of its run
+uint32_t Dispatch_Worst(uint32_t id){
+  return Worst[id];
+}
+
+//------------Dispatch_Schedulable------------
+// Check that every task meets its deadline when each task is posted
+// at most once per period, or once per deadline if its period is 0,
+// and runs no longer than its wcet.  Since tasks are not preempted,
+// a task can also be blocked by one run of a less urgent task that
+// has already started.
+// With DISPATCH_EDF the test is sufficient, not exact: for each task
+// the sum of wcet/deadline plus its blocking must be at most 1, and
+// the response time given is the deadline.  With fixed priority the
+// worst case response time of each task is found.
+// Input: tasks     table of tasks
+//        n         number of tasks
+//        load      pointer to where the utilization is returned, in
+//                  tenths of a percent
+//        response  array of n worst response times in ticks, 0 to skip
+// Output: 1 if every deadline is met, 0 if some deadline may be missed
+int Dispatch_Schedulable(const dispatch_task_t tasks[], uint32_t n,
+                         uint32_t *load, uint32_t response[]){
+  uint32_t i,j,period[DISPATCH_TASKS],deadline[DISPATCH_TASKS];
+  uint32_t u,blocking,ok;
+#if DISPATCH_EDF
+  uint32_t density;
+#else
+  uint32_t w,next;
+#endif
+  if(n > DISPATCH_TASKS){
+    n = DISPATCH_TASKS;
+  }
+  u = 0;
+  for(i=0; i<n; i++){
+    deadline[i] = tasks[i].deadline ? tasks[i].deadline : tasks[i].period;
+    period[i] = tasks[i].period ? tasks[i].period : deadline[i];
+    if(deadline[i] == 0){
+      return 0;               // neither a period nor a deadline
+    }
+    u = u + (tasks[i].wcet*1000 + period[i] - 1)/period[i];
+  }
+  *load = u;
+  ok = (u <= 1000);
+#if DISPATCH_EDF
+  density = 0;                // parts per million
+  for(i=0; i<n; i++){
+    density = density + (tasks[i].wcet*1000000 + deadline[i] - 1)/deadline[i];
+  }
+  for(i=0; i<n; i++){
+    blocking = 0;             // longest task with a later deadline
+    for(j=0; j<n; j++){
+      if((deadline[j] > deadline[i]) && (tasks[j].wcet > blocking)){
+        blocking = tasks[j].wcet;
+      }
+    }
+    if(density + (blocking*1000000 + deadline[i] - 1)/deadline[i] > 1000000){
+      ok = 0;
+    }
+    if(response){
+      response[i] = deadline[i];
+    }
+  }
+#else
+  // priority order is shorter deadline first, then lower task number
+  for(i=0; i<n; i++){
+    blocking = 0;             // longest lower priority task
+    for(j=0; j<n; j++){
+      if(((deadline[j] > deadline[i]) || ((deadline[j] == deadline[i]) && (j > i)))
+         && (tasks[j].wcet > blocking)){
+        blocking = tasks[j].wcet;
+      }
+    }
+    // w is the longest wait before task i starts: blocking plus every
+    // higher priority post up to and including the time it starts
+    w = blocking;
+    for(;;){
+      next = blocking;
+      for(j=0; j<n; j++){
+        if((deadline[j] < deadline[i]) || ((deadline[j] == deadline[i]) && (j < i))){
+          next = next + (w/period[j] + 1)*tasks[j].wcet;
+        }
+      }
+      if((next == w) || (next + tasks[i].wcet > deadline[i])){
+        break;
+      }
+      w = next;
+    }
+    if(next + tasks[i].wcet > deadline[i]){
+      ok = 0;
+    }
+    if(response){
+      response[i] = next + tasks[i].wcet;
+    }
+  }
+#endif
+  return ok;
+}
@@ -0,0 +1,128 @@
+// Dispatch.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Run to completion scheduler, an alternative to the fixed schedule
+// in FixedScheduler.c.  Interrupts post events to a queue for each
+// task, and the main program runs one task at a time to completion,
+// choosing the pending event with the earliest deadline, or with
+// DISPATCH_EDF 0 the task with the shortest relative deadline.  A
+// task runs only when it has work, and when nothing is pending the
+// processor sleeps until the next interrupt.
+// Time is counted in ticks of Dispatch_Tick, for example a 50 us
+// SysTick interrupt.  Dispatch_Tick also posts the periodic tasks.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __DISPATCH_H__
+#define __DISPATCH_H__
+
+#ifndef DISPATCH_EDF
+#define DISPATCH_EDF   1      // 1 for earliest deadline first, 0 for fixed priority
+#endif
+#define DISPATCH_TASKS 8      // maximum number of tasks
+#define DISPATCH_QUEUE 8      // events each task can have waiting, power of 2
+
+typedef struct dispatch_task{
+  void (*task)(uint32_t data); // runs to completion, data is from the post
+  uint32_t period;   // ticks between automatic posts, 0 if only posted
+  uint32_t deadline; // ticks from post to finish, 0 means the period
+  uint32_t wcet;     // worst case execution time in ticks, only used
+                     // by Dispatch_Schedulable
+} dispatch_task_t;
+
+//------------Dispatch_Init------------
+// Set up the tasks and empty every queue.  Task numbers are the
+// index into the table.  Periodic tasks are first posted one period
+// after the first Dispatch_Tick.
+// Input: tasks  table of tasks, must stay valid
+//        n      number of tasks, up to DISPATCH_TASKS
+// Output: none
+void Dispatch_Init(const dispatch_task_t tasks[], uint32_t n);
+
+//------------Dispatch_Tick------------
+// Count time and post the periodic tasks, call from a periodic interrupt.
+// Input: none
+// Output: none
+void Dispatch_Tick(void);
+
+//------------Dispatch_Time------------
+// Input: none
+// Output: number of ticks since Dispatch_Init
+uint32_t Dispatch_Time(void);
+
+//------------Dispatch_Post------------
+// Add an event to a task's queue, may be called from an interrupt or
+// from a task.  The deadline is counted from now.
+// Input: id    task number
+//        data  passed to the task when it runs
+// Output: 1 if successful, 0 if the queue was full and the event lost
+int Dispatch_Post(uint32_t id, uint32_t data);
+
+//------------Dispatch_Once------------
+// Run the most urgent pending event to completion.
+// Input: none
+// Output: 1 if a task ran, 0 if nothing was pending
+int Dispatch_Once(void);
+
+//------------Dispatch_Run------------
+// Run events forever, sleeping with WaitForInterrupt when none are
+// pending.  Interrupts must be enabled.  Does not return.
+// Input: none
+// Output: none
+void Dispatch_Run(void);
+
+//------------Dispatch_Misses------------
+// Input: id  task number
+// Output: number of times the task finished after its deadline
+uint32_t Dispatch_Misses(uint32_t id);
+
+//------------Dispatch_Lost------------
+// Input: id  task number
+// Output: number of events lost because the task's queue was full
+uint32_t Dispatch_Lost(uint32_t id);
+
+//------------Dispatch_Runs------------
+// Input: id  task number
+// Output: number of times the task has run
+uint32_t Dispatch_Runs(uint32_t id);
+
+//------------Dispatch_Worst------------
+// Input: id  task number
+// Output: longest time in ticks from a post to the end of its run
+uint32_t Dispatch_Worst(uint32_t id);
+
+//------------Dispatch_Schedulable------------
+// Check that every task meets its deadline when each task is posted
+// at most once per period, or once per deadline if its period is 0,
+// and runs no longer than its wcet.  Since tasks are not preempted,
+// a task can also be blocked by one run of a less urgent task that
+// has already started.
+// With DISPATCH_EDF the test is sufficient, not exact: for each task
+// the sum of wcet/deadline plus its blocking must be at most 1, and
+// the response time given is the deadline.  With fixed priority the
+// worst case response time of each task is found.
+// Input: tasks     table of tasks
+//        n         number of tasks
+//        load      pointer to where the utilization is returned, in
+//                  tenths of a percent
+//        response  array of n worst response times in ticks, 0 to skip
+// Output: 1 if every deadline is met, 0 if some deadline may be missed
+int Dispatch_Schedulable(const dispatch_task_t tasks[], uint32_t n,
+                         uint32_t *load, uint32_t response[]);
+
+#endif //  __DISPATCH_H__
@@ -0,0 +1,106 @@
+// DispatchSim.c
+// Runs on a PC, not on the LaunchPad
+// Simulate the run to completion scheduler in Dispatch.c with the
+// four tasks of FixedScheduler.c, and report deadline misses and
+// processor load.  One tick is 50 us.  The execution times are the
+// time slices FixedScheduler.c gives each task:
+//   PID every 1 ms for 300 us, DAS every 1.5 ms for 50 us,
+//   FSM every 2 ms for 100 us, PAN every 10 ms for 500 us
+// Each simulated task calls Dispatch_Tick once for each tick it
+// runs, the way the SysTick interrupt would while it runs.
+//   gcc DispatchSim.c Dispatch.c -o DispatchSim
+//   gcc -DDISPATCH_EDF=0 DispatchSim.c Dispatch.c -o DispatchSim
+//   ./DispatchSim [percent]
+// percent scales every execution time, e.g. 250 to see an overload.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Dispatch.h"
+
+#define SIMTICKS 200000       // 10 seconds of 50 us ticks
+#define NUMTASKS 4
+
+// the processor, interrupts are simulated by calling Dispatch_Tick
+void DisableInterrupts(void){}
+void EnableInterrupts(void){}
+long StartCritical(void){ return 0; }
+void EndCritical(long sr){ (void)sr; }
+void WaitForInterrupt(void){}
+
+uint32_t Busy;                // ticks spent running tasks
+uint32_t Exec[NUMTASKS];      // execution time of each task, in ticks
+
+// run for n ticks, then return
+void run(uint32_t n){
+  while(n){
+    Dispatch_Tick();
+    Busy++;
+    n--;
+  }
+}
+void PID(uint32_t data){ (void)data; run(Exec[0]); }
+void DAS(uint32_t data){ (void)data; run(Exec[1]); }
+void FSM(uint32_t data){ (void)data; run(Exec[2]); }
+void PAN(uint32_t data){ (void)data; run(Exec[3]); }
+
+dispatch_task_t TaskSet[NUMTASKS]={
+//  task period deadline wcet
+  { &PID,  20,    0,      6},  // 1 ms, 300 us
+  { &DAS,  30,    0,      1},  // 1.5 ms, 50 us
+  { &FSM,  40,    0,      2},  // 2 ms, 100 us
+  { &PAN, 200,    0,     10}   // 10 ms, 500 us
+};
+const char *Names[NUMTASKS]={"PID", "DAS", "FSM", "PAN"};
+
+int main(int argc, char **argv){
+  uint32_t i,percent,load,response[NUMTASKS],idle; int ok;
+  percent = (argc > 1) ? atoi(argv[1]) : 100;
+  for(i=0; i<NUMTASKS; i++){
+    TaskSet[i].wcet = (TaskSet[i].wcet*percent + 50)/100;
+    if(TaskSet[i].wcet == 0){
+      TaskSet[i].wcet = 1;
+    }
+    Exec[i] = TaskSet[i].wcet;
+  }
+  ok = Dispatch_Schedulable(TaskSet, NUMTASKS, &load, response);
+  printf("%s, execution times at %u%%\n",
+         DISPATCH_EDF ? "earliest deadline first" : "fixed priority", percent);
+  printf("analysis: load %u.%u%%, %s\n", load/10, load%10,
+         ok ? "every deadline met" : "deadlines may be missed");
+  Dispatch_Init(TaskSet, NUMTASKS);
+  Busy = 0;
+  idle = 0;
+  while(Dispatch_Time() < SIMTICKS){
+    if(Dispatch_Once() == 0){
+      Dispatch_Tick();        // nothing to do, sleep one tick
+      idle++;
+    }
+  }
+  printf("task  period  wcet  bound   runs  worst  misses  lost\n");
+  for(i=0; i<NUMTASKS; i++){
+    printf("%-4s %7u %5u %6u %6u %6u %7u %5u\n", Names[i], TaskSet[i].period,
+           TaskSet[i].wcet, response[i], Dispatch_Runs(i), Dispatch_Worst(i),
+           Dispatch_Misses(i), Dispatch_Lost(i));
+  }
+  printf("simulated load %.1f%%, idle %.1f%%\n",
+         100.0*Busy/Dispatch_Time(), 100.0*idle/Dispatch_Time());
+  return 0;
+}
@@ -0,0 +1,164 @@
+// EventScheduler.c
+// Runs on LM4F120/TM4C123
+// The four tasks of FixedScheduler.c run by the run to completion
+// scheduler in Dispatch.c instead of a fixed table of time slices.
+// A 50 us SysTick interrupt posts PID every 1 ms, DAS every 1.5 ms,
+// FSM every 2 ms and PAN every 10 ms.  Each task does one step and
+// returns, and the processor sleeps when no task has work.
+// Build with this file, Dispatch.c and PLL.c, in place of
+// FixedScheduler.c and osasm.s.  DispatchSim.c runs the same task
+// set on a PC and reports deadline misses and load.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to Arm Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+// logic analyzer connected to PB3,PB2,PB1,PB0 for profiling
+#include <stdint.h>
+#include "PLL.h"
+#include "Dispatch.h"
+#include "../inc/tm4c123gh6pm.h"
+#define PB3        (*((volatile uint32_t *)0x40005020))
+#define PB2        (*((volatile uint32_t *)0x40005010))
+#define PB1        (*((volatile uint32_t *)0x40005008))
+#define PB0        (*((volatile uint32_t *)0x40005004))
+#define TICK       4000       // 50 us at 80 MHz
+
+void DisableInterrupts(void); // Disable interrupts
+void EnableInterrupts(void);  // Enable interrupts
+//******************FSM**************************
+struct State{
+  uint32_t Out;                 // Output to Port xxx
+  const struct State *Next[4];  // Next state if input=0,1,2,3
+};
+typedef const struct State StateType;
+typedef StateType *	StatePtr;
+
+#define SA &fsm[0]
+#define SB &fsm[1]
+#define SC &fsm[2]
+#define SD &fsm[3]
+#define SE &fsm[4]
+#define SF &fsm[5]
+StateType fsm[6]={
+	{0x01,{SB,SC,SD,SE}},  // SA,SB alternate toggle
+	{0x02,{SA,SC,SD,SE}},  // SB
+	{0x03,{SA,SC,SD,SE}},  // SC both on
+	{0x00,{SA,SC,SD,SE}},  // SD both off
+	{0x00,{SA,SC,SD,SF}},  // SE,SF together toggle
+	{0x03,{SA,SC,SD,SE}}   // SF
+};
+void Port_Out(uint32_t data){
+}
+uint32_t Port_In(void){
+  return 0;
+}
+StatePtr Pt = SA;          // Initial State
+void FSM(uint32_t data){ uint8_t in;
+  PB0 ^= 0x01;             // profile
+  Port_Out(Pt->Out);       // Output depends on the current state
+  in = Port_In();
+  Pt = Pt->Next[in];       // Next state depends on the input
+}
+
+//******************PID**************************
+void PID_Init(void){
+}
+uint8_t PID_In(void){
+  return 0;
+}
+uint8_t PID_Calc(uint8_t speed){
+  return speed;
+}
+void PID_Out(uint8_t speed){
+}
+void PID(uint32_t data){ uint8_t speed,power;
+  PB1 ^= 0x02;             // profile
+  speed = PID_In();        // read tachometer
+  power = PID_Calc(speed);
+  PID_Out(power);          // adjust power to motor
+}
+//******************DAS**************************
+void DAS_Init(void){
+}
+uint8_t DAS_In(void){
+  return 0;
+}
+uint8_t DAS_Calc(uint8_t speed){
+  return speed;
+}
+uint8_t Result;
+void DAS(uint32_t data){ uint8_t raw;
+  PB2 ^= 0x04;             // profile
+  raw = DAS_In();          // read ADC
+  Result = DAS_Calc(raw);
+}
+//******************PAN**************************
+void PAN_Init(void){
+}
+uint8_t PAN_In(void){
+  return 0;
+}
+void PAN_Out(uint8_t speed){
+}
+void PAN(uint32_t data){ uint8_t input;
+  PB3 ^= 0x08;             // profile
+  input = PAN_In();        // front panel input
+  if(input){
+    PAN_Out(input);        // process
+  }
+}
+
+// periods and deadlines in 50 us ticks, wcet from the time slices
+// of FixedScheduler.c
+const dispatch_task_t Tasks[4]={
+//  task period deadline wcet
+  { &PID,  20,    0,      6},  // 1 ms, 300 us
+  { &DAS,  30,    0,      1},  // 1.5 ms, 50 us
+  { &FSM,  40,    0,      2},  // 2 ms, 100 us
+  { &PAN, 200,    0,     10}   // 10 ms, 500 us
+};
+uint32_t Load;             // utilization in tenths of a percent
+int Schedulable;           // 1 if every deadline is met
+
+void SysTick_Handler(void){
+  Dispatch_Tick();         // posts the tasks whose period is up
+}
+
+int main(void){
+  PLL_Init(Bus80MHz);         // bus clock at 80 MHz
+  SYSCTL_RCGCGPIO_R |= 0x02;  // activate port B
+  Schedulable = Dispatch_Schedulable(Tasks, 4, &Load, 0);
+  GPIO_PORTB_DIR_R |= 0x0F;   // make PB3-0 output
+  GPIO_PORTB_AFSEL_R &= ~0x0F;// disable alt funct on PB3-0
+  GPIO_PORTB_DEN_R |= 0x0F;   // enable digital I/O on PB3-0
+                              // configure PB3-0 as GPIO
+  GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R&0xFFFF0000)+0x00000000;
+  GPIO_PORTB_AMSEL_R &= ~0x0F;    // disable analog functionality on PB3-0
+  PID_Init();
+  DAS_Init();
+  PAN_Init();
+  Dispatch_Init(Tasks, 4);
+  NVIC_ST_CTRL_R = 0;         // disable SysTick during setup
+  NVIC_ST_RELOAD_R = TICK-1;  // reload value
+  NVIC_ST_CURRENT_R = 0;      // any write to current clears it
+  NVIC_SYS_PRI3_R = (NVIC_SYS_PRI3_R&0x00FFFFFF)|0x40000000; // priority 2
+                              // enable SysTick with core clock and interrupts
+  NVIC_ST_CTRL_R = NVIC_ST_CTRL_ENABLE+NVIC_ST_CTRL_CLK_SRC+NVIC_ST_CTRL_INTEN;
+  EnableInterrupts();
+  Dispatch_Run();             // does not return
+}
@@ -0,0 +1,186 @@
+// Pool.c
+// Runs on any computer
+// A set of fixed-block memory managers, one pool per block size.
+// Each pool is the same as the one in Heap.c: the first 32-bit word
+// of each free block links to the next free block.  The links are
+// block numbers instead of pointers, so that the head of the list
+// fits in 16 bits.  The other 16 bits of the head are a tag that
+// changes on every push and pop.  The head is updated with a compare
+// and swap, so a pop that is interrupted by a pop and push of the
+// same block sees a different tag and tries again (the ABA problem).
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+   ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+*/
+#include <stdint.h>
+#include "Pool.h"
+#define NULL 0  // definition of empty pointer
+#define LAST 0xFFFF      // block number that ends a free list
+#define TAG  0x00010000  // added to the head on every change
+
+// compare and swap, atomically set *addr to new if it still equals old
+// returns 1 if the swap happened, 0 if it has to be tried again
+// LDREX/STREX on the Cortex M, C11 atomics on a host PC
+#if defined(__ARMCC_VERSION) || defined(__TI_COMPILER_VERSION__)
+static __inline int CAS(uint32_t volatile *addr, uint32_t old, uint32_t new){
+  if(__ldrex(addr) != old){
+    __clrex();
+    return 0;
+  }
+  return (__strex(new, addr) == 0);
+}
+#elif defined(__GNUC__) && defined(__arm__)
+static __inline int CAS(uint32_t volatile *addr, uint32_t old, uint32_t new){
+  return __atomic_compare_exchange_n(addr, &old, new, 0,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#else
+#include <stdatomic.h>
+static inline int CAS(uint32_t volatile *addr, uint32_t old, uint32_t new){
+  return atomic_compare_exchange_strong((_Atomic uint32_t *)addr, &old, new);
+}
+#endif
+
+int32_t Pool0[POOL0_SIZE/4*POOL0_NUM];
+int32_t Pool1[POOL1_SIZE/4*POOL1_NUM];
+int32_t Pool2[POOL2_SIZE/4*POOL2_NUM];
+
+// fixed description of each pool
+struct pool{
+  int32_t *Start;        // first block
+  uint32_t Words;        // number of 32-bit words in each block
+  uint32_t Num;          // number of blocks
+};
+const struct pool Pools[POOL_NUM]={
+  {Pool0, POOL0_SIZE/4, POOL0_NUM},
+  {Pool1, POOL1_SIZE/4, POOL1_NUM},
+  {Pool2, POOL2_SIZE/4, POOL2_NUM}
+};
+
+// changing state of each pool
+uint32_t volatile FreeHead[POOL_NUM];  // tag in bits 31-16, block in 15-0
+uint32_t volatile BlocksUsed[POOL_NUM];
+uint32_t volatile HighWater[POOL_NUM];
+uint32_t volatile Failures[POOL_NUM];
+
+// atomically add n to *addr, return the new value
+static uint32_t AtomicAdd(uint32_t volatile *addr, int32_t n){
+  uint32_t old;
+  do{
+    old = *addr;
+  }while(CAS(addr, old, old+n) == 0);
+  return old+n;
+}
+
+//------------Pool_Init------------
+// Initialize every pool, linking all of its blocks into its free list.
+// Call once before interrupts that use the pools are enabled.
+// Input: none
+// Output: none
+void Pool_Init(void){ uint32_t p,i;
+  for(p=0; p<POOL_NUM; p++){
+    for(i=0; i<Pools[p].Num-1; i++){
+      Pools[p].Start[i*Pools[p].Words] = i+1; // block i links to block i+1
+    }
+    Pools[p].Start[i*Pools[p].Words] = LAST;  // the last free block
+    FreeHead[p] = 0;          // block 0 is first, tag 0
+    BlocksUsed[p] = 0;
+    HighWater[p] = 0;
+    Failures[p] = 0;
+  }
+}
+
+// pop a block off the free list of one pool
+static int32_t *Pop(uint32_t p){ uint32_t head,block,next,used,high;
+  do{
+    head = FreeHead[p];
+    block = head&0xFFFF;
+    if(block == LAST){
+      return NULL;            // pool is empty
+    }
+    next = Pools[p].Start[block*Pools[p].Words]&0xFFFF;
+  }while(CAS(&FreeHead[p], head, ((head+TAG)&0xFFFF0000)|next) == 0);
+  used = AtomicAdd(&BlocksUsed[p], 1);
+  do{
+    high = HighWater[p];
+  }while((used > high) && (CAS(&HighWater[p], high, used) == 0));
+  return &Pools[p].Start[block*Pools[p].Words];
+}
+
+// push a block onto the free list of one pool
+static void Push(uint32_t p, uint32_t block){ uint32_t head;
+  AtomicAdd(&BlocksUsed[p], -1); // before the block can be popped again
+  do{
+    head = FreeHead[p];
+    Pools[p].Start[block*Pools[p].Words] = head&0xFFFF; // link to old first
+  }while(CAS(&FreeHead[p], head, ((head+TAG)&0xFFFF0000)|block) == 0);
+}
+
+//------------Pool_Alloc------------
+// Allocate a block from the smallest pool whose blocks hold the
+// request.  If that pool is empty the next larger pool is tried.
+// Safe to call from an interrupt service routine.
+// Input: bytes  number of bytes needed
+// Output: pointer to a block or NULL if no pool can satisfy the request
+void *Pool_Alloc(uint32_t bytes){ uint32_t p; int32_t *pt;
+  for(p=0; p<POOL_NUM; p++){
+    if(bytes <= 4*Pools[p].Words){
+      pt = Pop(p);
+      if(pt != NULL){
+        return pt;
+      }
+      AtomicAdd(&Failures[p], 1);  // full, try a bigger block
+    }
+  }
+  return NULL;
+}
+
+//------------Pool_Free------------
+// Return a block to the pool it came from.
+// Safe to call from an interrupt service routine.
+// The pointer is checked to be the start of a block in one of the
+// pools, but freeing the same block twice is not detected.
+// Input: pt  pointer returned by Pool_Alloc
+// Output: POOL_OK, POOL_ERROR_POINTER_OUT_OF_RANGE if pt is not in any
+//         pool, or POOL_ERROR_MISALIGNED if pt is not the start of a block
+int32_t Pool_Free(void *pt){ uint32_t p,offset;
+  for(p=0; p<POOL_NUM; p++){
+    if(((int32_t *)pt >= Pools[p].Start) &&
+       ((int32_t *)pt < Pools[p].Start + Pools[p].Words*Pools[p].Num)){
+      offset = (int32_t *)pt - Pools[p].Start; // in words
+      if(offset%Pools[p].Words){
+        return POOL_ERROR_MISALIGNED;
+      }
+      Push(p, offset/Pools[p].Words);
+      return POOL_OK;
+    }
+  }
+  return POOL_ERROR_POINTER_OUT_OF_RANGE;
+}
+
+//------------Pool_Stats------------
+// Report the usage of one pool.
+// Input: pool  0 to POOL_NUM-1
+// Output: statistics for that pool
+pool_stats_t Pool_Stats(uint32_t pool){ pool_stats_t stats;
+  stats.blockBytes = 4*Pools[pool].Words;
+  stats.numBlocks = Pools[pool].Num;
+  stats.blocksUsed = BlocksUsed[pool];
+  stats.highWater = HighWater[pool];
+  stats.failures = Failures[pool];
+  return stats;
+}
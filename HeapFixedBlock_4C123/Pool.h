@@ -0,0 +1,84 @@
+// Pool.h
+// Runs on any computer
+// A set of fixed-block memory managers, one pool per block size.
+// Pool_Alloc picks the smallest block that fits the request.
+// Allocate and free are lock-free, so they may be called from
+// threads and from interrupt service routines at any priority.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+   ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+*/
+
+#ifndef __POOL_H__
+#define __POOL_H__
+#include <stdint.h>
+
+// pools must be listed smallest block first
+// block sizes are in bytes and must be multiples of 4
+#define POOL_NUM    3     // number of pools
+#define POOL0_SIZE  16    // small blocks
+#define POOL0_NUM   32
+#define POOL1_SIZE  64    // medium blocks
+#define POOL1_NUM   16
+#define POOL2_SIZE  256   // packet buffers
+#define POOL2_NUM   8
+
+#define POOL_OK                       0
+#define POOL_ERROR_POINTER_OUT_OF_RANGE 1
+#define POOL_ERROR_MISALIGNED         2
+
+// statistics for one pool
+typedef struct pool_stats {
+  uint32_t blockBytes;    // size of each block
+  uint32_t numBlocks;     // number of blocks in the pool
+  uint32_t blocksUsed;    // number of blocks allocated now
+  uint32_t highWater;     // most blocks ever allocated at once
+  uint32_t failures;      // Pool_Alloc calls that found this pool empty
+} pool_stats_t;
+
+//------------Pool_Init------------
+// Initialize every pool, linking all of its blocks into its free list.
+// Call once before interrupts that use the pools are enabled.
+// Input: none
+// Output: none
+void Pool_Init(void);
+
+//------------Pool_Alloc------------
+// Allocate a block from the smallest pool whose blocks hold the
+// request.  If that pool is empty the next larger pool is tried.
+// Safe to call from an interrupt service routine.
+// Input: bytes  number of bytes needed
+// Output: pointer to a block or NULL if no pool can satisfy the request
+void *Pool_Alloc(uint32_t bytes);
+
+//------------Pool_Free------------
+// Return a block to the pool it came from.
+// Safe to call from an interrupt service routine.
+// The pointer is checked to be the start of a block in one of the
+// pools, but freeing the same block twice is not detected.
+// Input: pt  pointer returned by Pool_Alloc
+// Output: POOL_OK, POOL_ERROR_POINTER_OUT_OF_RANGE if pt is not in any
+//         pool, or POOL_ERROR_MISALIGNED if pt is not the start of a block
+int32_t Pool_Free(void *pt);
+
+//------------Pool_Stats------------
+// Report the usage of one pool.
+// Input: pool  0 to POOL_NUM-1
+// Output: statistics for that pool
+pool_stats_t Pool_Stats(uint32_t pool);
+
+#endif //  __POOL_H__
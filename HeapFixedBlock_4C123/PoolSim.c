@@ -0,0 +1,247 @@
+// PoolSim.c
+// Runs on a PC, not on the LaunchPad
+// Test the pools of Pool.c, and compare their speed and failures with
+// Heap_Malloc/Heap_Free of Heap_4C123/heap.c given the same memory.
+//   test       each pool hands out each of its blocks once, a request
+//              spills into the next larger pool when its own is empty,
+//              and Pool_Free rejects pointers that are not blocks
+//   stress     4 threads allocate, fill, check and free blocks of 0 to
+//              299 bytes at the same time, so the compare and swap
+//              loops really are interrupted
+//   benchmark  the same trace of 2,000,000 random allocate and free
+//              calls on Pool and on heap.c, 24 blocks live at most,
+//              most of them small, some packet buffers, reporting ns
+//              per call, calls that failed, and bytes set aside for
+//              each byte asked for
+// The heap gets the 3584 bytes the three pools use.  Build again with
+// -DHEAP_SEGREGATED=0 to compare with first fit.
+//   gcc -O2 -DHEAP_SIZE_BYTES=3584 -I../Heap_4C123 PoolSim.c Pool.c ../Heap_4C123/heap.c -o PoolSim -lpthread
+//   ./PoolSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+   ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "Pool.h"
+#include "heap.h"
+
+#define POOL_BYTES (POOL0_SIZE*POOL0_NUM+POOL1_SIZE*POOL1_NUM+POOL2_SIZE*POOL2_NUM)
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+//************test*************
+void test(void){ void *pt[POOL0_NUM+POOL1_NUM+POOL2_NUM+1]; uint32_t n,i;
+  pool_stats_t s;
+  printf("test\n");
+  Pool_Init();
+  n = 0;
+  while((pt[n] = Pool_Alloc(1)) != NULL){
+    for(i=0; i<n; i++){
+      check(pt[i] != pt[n], "no block handed out twice");
+    }
+    n++;
+  }
+  check(n == POOL0_NUM+POOL1_NUM+POOL2_NUM, "small requests spill into every pool");
+  s = Pool_Stats(0);
+  check((s.blocksUsed == POOL0_NUM)&&(s.highWater == POOL0_NUM), "pool 0 used");
+  check(s.failures == POOL1_NUM+POOL2_NUM+1, "pool 0 failures counted");
+  check(Pool_Alloc(POOL2_SIZE) == NULL, "NULL when every pool is empty");
+  check(Pool_Free((char *)pt[0]+4) == POOL_ERROR_MISALIGNED, "misaligned");
+  check(Pool_Free(&Errors) == POOL_ERROR_POINTER_OUT_OF_RANGE, "out of range");
+  for(i=0; i<n; i++){
+    check(Pool_Free(pt[i]) == POOL_OK, "free every block");
+  }
+  for(i=0; i<POOL_NUM; i++){
+    check(Pool_Stats(i).blocksUsed == 0, "all free at the end");
+  }
+  check(Pool_Alloc(POOL2_SIZE+1) == NULL, "too big for any pool");
+  pt[0] = Pool_Alloc(POOL0_SIZE+1);
+  check(Pool_Stats(1).blocksUsed == 1, "17 bytes from pool 1");
+  Pool_Free(pt[0]);
+}
+
+//************stress*************
+#define ROUNDS 200000
+#define THREADS 4
+int volatile Bad;
+void *worker(void *arg){ uint8_t *pt[10]; int id,round,k; uint32_t bytes,j;
+  id = (int)(intptr_t)arg;
+  for(round=0; round<ROUNDS; round++){
+    for(k=0; k<10; k++){
+      bytes = (round+k*37)%300;
+      pt[k] = Pool_Alloc(bytes);
+      if(pt[k]){
+        memset(pt[k], id, bytes);
+      }
+    }
+    for(k=0; k<10; k++){
+      if(pt[k]){
+        bytes = (round+k*37)%300;
+        for(j=0; j<bytes; j++){
+          if(pt[k][j] != id){
+            Bad++;            // another thread has the same block
+            break;
+          }
+        }
+        if(Pool_Free(pt[k]) != POOL_OK){
+          Bad++;
+        }
+      }
+    }
+    if((round%64) == 0){
+      sched_yield();          // let the other threads in
+    }
+  }
+  return arg;
+}
+void stress(void){ pthread_t thread[THREADS]; int i; pool_stats_t s;
+  printf("stress, %d threads, %d rounds of 10 blocks each\n", THREADS, ROUNDS);
+  Pool_Init();
+  for(i=0; i<THREADS; i++){
+    pthread_create(&thread[i], 0, &worker, (void *)(intptr_t)(i+1));
+  }
+  for(i=0; i<THREADS; i++){
+    pthread_join(thread[i], 0);
+  }
+  for(i=0; i<POOL_NUM; i++){
+    s = Pool_Stats(i);
+    printf("  %3u-byte pool  high water %2u of %2u  failures %u\n",
+           s.blockBytes, s.highWater, s.numBlocks, s.failures);
+    check(s.blocksUsed == 0, "all free at the end");
+    check(s.highWater <= s.numBlocks, "high water within the pool");
+  }
+  printf("  %d blocks shared or not freed\n", Bad);
+  check(Bad == 0, "no block given to two threads");
+}
+
+//************benchmark*************
+#define CALLS 2000000
+#define SLOTS 24
+uint32_t Bytes[CALLS];        // 0 for a free call
+uint8_t Slot[CALLS];
+void *Live[SLOTS];
+uint32_t Asked[SLOTS];
+// most requests are small, a few are packet buffers
+uint32_t randomBytes(void){ int r;
+  r = rand()%100;
+  if(r < 60){
+    return 1+rand()%16;
+  }
+  if(r < 90){
+    return 17+rand()%48;
+  }
+  return 65+rand()%192;
+}
+void makeTrace(void){ uint32_t n; int s; uint8_t live[SLOTS];
+  srand(8);
+  memset(live, 0, sizeof(live));
+  for(n=0; n<CALLS; n++){
+    s = rand()%SLOTS;
+    Slot[n] = s;
+    Bytes[n] = live[s] ? 0 : randomBytes();
+    live[s] = !live[s];
+  }
+}
+// bytes a block really takes, including rounding and heap overhead
+uint32_t poolCost(uint32_t bytes){
+  if(bytes <= POOL0_SIZE) return POOL0_SIZE;
+  if(bytes <= POOL1_SIZE) return POOL1_SIZE;
+  return POOL2_SIZE;
+}
+uint32_t heapCost(uint32_t bytes){
+  return 4*((bytes+3)/4)+8;   // header and trailer words
+}
+void run(const char *name, int heap){ uint32_t n,failed,calls; int s;
+  double t0,t1,asked,used;
+  if(heap){
+    Heap_Init();
+  } else{
+    Pool_Init();
+  }
+  memset(Live, 0, sizeof(Live));
+  failed = calls = 0;
+  asked = used = 0;
+  t0 = seconds();
+  for(n=0; n<CALLS; n++){
+    s = Slot[n];
+    if(Bytes[n] == 0){
+      if(Live[s]){            // 0 if its allocate failed
+        if(heap){
+          Heap_Free(Live[s]);
+        } else{
+          Pool_Free(Live[s]);
+        }
+        Live[s] = NULL;
+        calls++;
+      }
+    } else{
+      Live[s] = heap ? Heap_Malloc(Bytes[n]) : Pool_Alloc(Bytes[n]);
+      calls++;
+      if(Live[s] == NULL){
+        failed++;
+      }
+    }
+  }
+  t1 = seconds();
+  for(n=0; n<CALLS; n++){     // memory cost, not timed
+    if(Bytes[n]){
+      asked = asked+Bytes[n];
+      used = used+(heap ? heapCost(Bytes[n]) : poolCost(Bytes[n]));
+    }
+  }
+  printf("  %-12s %6.1f ns per call  %6u failed  %4.2f bytes per byte\n",
+         name, 1e9*(t1-t0)/calls, failed, used/asked);
+  if(heap){
+    check(Heap_Test() == HEAP_OK, "heap not damaged");
+  }
+}
+void benchmark(void){
+  printf("benchmark, %d calls, %d bytes for each allocator\n", CALLS, POOL_BYTES);
+  check(HEAP_SIZE_BYTES == POOL_BYTES, "heap the same size as the pools");
+  makeTrace();
+  run("Pool", 0);
+  run(HEAP_SEGREGATED ? "heap, lists" : "heap, first", 1);
+}
+
+int main(void){
+  test();
+  stress();
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
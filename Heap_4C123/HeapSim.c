@@ -0,0 +1,380 @@
+// HeapSim.c
+// Runs on a PC, not on the LaunchPad
+// Replay allocation traces on heap.c and count the words Heap_Realloc
+// copies, compared with the way Heap_Realloc used to work: Heap_Malloc
+// a new block, copy the smaller of the two sizes, Heap_Free the old
+// block.  Every block is filled with a pattern that is checked after
+// each call, and Heap_Test runs after each call.
+//   grow     three buffers grow 4 bytes at a time to 64, then shrink,
+//            like strings being built up and trimmed
+//   shrink   buffers made big, then trimmed to a random smaller size
+//   random   random Heap_Malloc, Heap_Realloc and Heap_Free calls
+// Then random Heap_Malloc and Heap_Free traces are timed, giving the
+// mean and worst ns per call, and the largest unused block and the
+// total unused words left at the end of each trace.
+//   small    up to 256 blocks live, 1 to HEAP_SIZE_BYTES/512+8 bytes
+//   mixed    the same, but one call in 8 asks for a block up to 16
+//            times as big
+//   refill   256 small blocks, free every other one, then ask for
+//            blocks two to three times as big, so the holes left
+//            behind are too small
+// Calls are timed with the x86 time stamp counter, or clock_gettime
+// on other PCs.  Each trace is replayed 5 times and each call keeps
+// its fastest time, so the worst case is the allocator's and not the
+// PC's.  Build once with each policy, with a heap big enough to show
+// the first fit scan:
+//   gcc -O2 HeapSim.c heap.c -o HeapSim
+//   ./HeapSim
+//   gcc -O2 -DHEAP_SIZE_BYTES=32768 -DHEAP_SEGREGATED=0 HeapSim.c heap.c -o HeapSim0
+//   gcc -O2 -DHEAP_SIZE_BYTES=32768 -DHEAP_SEGREGATED=1 HeapSim.c heap.c -o HeapSim1
+// Exits with 1 if data or the heap is damaged.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "heap.h"
+
+#define SLOTS 8               // blocks the trace can hold at once
+uint8_t *Block[SLOTS];
+int32_t Size[SLOTS];          // bytes asked for
+int32_t Copied;               // words copied by oldRealloc
+int32_t Calls,Failed;         // realloc calls, and those that returned 0
+int Damaged;
+
+// Heap_Realloc before it grew and shrank in place
+void *oldRealloc(void *oldBlock, int32_t oldBytes, int32_t desiredBytes){
+  int32_t *oldPt,*newPt; int32_t words,i;
+  newPt = Heap_Malloc(desiredBytes);
+  if(newPt == 0){
+    return 0;
+  }
+  oldPt = oldBlock;
+  words = (oldBytes < desiredBytes) ? oldBytes : desiredBytes;
+  words = (words+3)/4;
+  for(i=0; i<words; i++){
+    newPt[i] = oldPt[i];
+  }
+  Copied = Copied+words;
+  Heap_Free(oldPt);
+  return newPt;
+}
+
+void fill(int s, int32_t from){ int32_t i;
+  for(i=from; i<Size[s]; i++){
+    Block[s][i] = (uint8_t)(s*37+i);
+  }
+}
+void verify(void){ int s; int32_t i;
+  for(s=0; s<SLOTS; s++){
+    for(i=0; Block[s] && (i<Size[s]); i++){
+      if(Block[s][i] != (uint8_t)(s*37+i)){
+        Damaged++;
+        return;
+      }
+    }
+  }
+  if(Heap_Test() != HEAP_OK){
+    Damaged++;
+  }
+}
+void doMalloc(int s, int32_t bytes){
+  Block[s] = Heap_Malloc(bytes);
+  if(Block[s]){
+    Size[s] = bytes;
+    fill(s, 0);
+  }
+  verify();
+}
+void doFree(int s){
+  Heap_Free(Block[s]);
+  Block[s] = 0;
+  verify();
+}
+void doRealloc(int s, int32_t bytes, int old){ uint8_t *pt; int32_t from;
+  Calls++;
+  if(old){
+    pt = oldRealloc(Block[s], Size[s], bytes);
+  } else{
+    pt = Heap_Realloc(Block[s], bytes);
+  }
+  if(pt == 0){
+    Failed++;                 // the old block is still there
+  } else{
+    Block[s] = pt;
+    if(bytes > Size[s]){
+      verify();               // the part that was kept
+      from = Size[s];
+      Size[s] = bytes;
+      fill(s, from);
+    } else{
+      Size[s] = bytes;
+    }
+  }
+  verify();
+}
+
+void grow(int old){ int s,round; int32_t bytes;
+  for(round=0; round<100; round++){
+    for(s=0; s<3; s++){
+      doMalloc(s, 4);
+    }
+    for(bytes=8; bytes<=64; bytes=bytes+4){
+      for(s=0; s<3; s++){
+        if(Block[s]){
+          doRealloc(s, bytes, old);
+        }
+      }
+    }
+    for(bytes=60; bytes>=4; bytes=bytes-8){
+      for(s=0; s<3; s++){
+        if(Block[s]){
+          doRealloc(s, bytes, old);
+        }
+      }
+    }
+    for(s=0; s<3; s++){
+      if(Block[s]){
+        doFree(s);
+      }
+    }
+  }
+}
+void shrink(int old){ int s,round;
+  srand(3);
+  for(round=0; round<2000; round++){
+    for(s=0; s<3; s++){
+      doMalloc(s, 40+rand()%30);
+    }
+    for(s=0; s<3; s++){
+      if(Block[s]){
+        doRealloc(s, 1+rand()%Size[s], old);
+      }
+    }
+    for(s=0; s<3; s++){
+      if(Block[s]){
+        doFree(s);
+      }
+    }
+  }
+}
+void randomTrace(int old){ int s,op,n;
+  srand(2);
+  for(n=0; n<200000; n++){
+    s = rand()%SLOTS;
+    op = rand()%3;
+    if(Block[s] == 0){
+      doMalloc(s, 1+rand()%40);
+    } else if(op == 0){
+      doFree(s);
+    } else{
+      doRealloc(s, 1+rand()%((op == 1) ? 60 : 20), old);
+    }
+  }
+}
+
+void run(const char *name, void (*trace)(int)){ int old,s;
+  int32_t copied[2],calls[2],failed[2],inPlace; heap_stats_t stats;
+  inPlace = 0;
+  for(old=1; old>=0; old--){
+    Heap_Init();
+    for(s=0; s<SLOTS; s++){
+      Block[s] = 0;
+    }
+    Copied = Calls = Failed = 0;
+    (*trace)(old);
+    stats = Heap_Stats();
+    copied[old] = old ? Copied : stats.wordsCopied;
+    calls[old] = Calls;
+    failed[old] = Failed;
+    if(!old){
+      inPlace = stats.reallocInPlace;
+    }
+  }
+  printf("  %-7s %7d %12d %8d %11d %8d %9d\n", name, calls[0], copied[1],
+         failed[1], copied[0], failed[0], inPlace);
+}
+
+//************benchmark*************
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+#if defined(__x86_64__) || defined(__i386__)
+#define ticks() __rdtsc()
+#else
+#define ticks() ((uint64_t)(1e9*seconds()))
+#endif
+#define LIVE 256              // blocks a timed trace can hold at once
+#define CALLS 100000          // Heap_Malloc and Heap_Free calls per trace
+#define REPEATS 5
+#define SMALL (HEAP_SIZE_BYTES/512+8)
+int32_t TraceLength;          // calls in the trace
+int32_t TraceSlot[CALLS];     // the block each call works on
+int32_t TraceBytes[CALLS];    // bytes to Heap_Malloc, 0 to Heap_Free
+uint64_t Fastest[CALLS];      // ticks, fastest of the replays
+uint8_t *Live[LIVE];
+double NsPerTick;
+uint64_t Overhead;            // ticks taken by ticks() itself
+void calibrate(void){ double t0; uint64_t k0,k1; int n;
+  t0 = seconds();
+  k0 = ticks();
+  while(seconds()-t0 < 0.05){};
+  NsPerTick = 1e9*(seconds()-t0)/(ticks()-k0);
+  Overhead = 1000000;
+  for(n=0; n<1000; n++){
+    k0 = ticks();
+    k1 = ticks();
+    if(k1-k0 < Overhead){
+      Overhead = k1-k0;
+    }
+  }
+}
+
+// random calls on random slots, a full slot is freed
+void makeRandom(int bigEvery){ int32_t n,s; int full[LIVE];
+  for(s=0; s<LIVE; s++){
+    full[s] = 0;
+  }
+  for(n=0; n<CALLS; n++){
+    s = rand()%LIVE;
+    TraceSlot[n] = s;
+    if(full[s]){
+      TraceBytes[n] = 0;
+    } else if(bigEvery && (rand()%bigEvery == 0)){
+      TraceBytes[n] = 1+rand()%(16*SMALL);
+    } else{
+      TraceBytes[n] = 1+rand()%SMALL;
+    }
+    full[s] = !full[s];
+  }
+  TraceLength = CALLS;
+}
+// free them all, fill, free every other block, ask for bigger blocks
+void makeRefill(void){ int32_t n,s;
+  n = 0;
+  while(n <= CALLS-3*LIVE){
+    for(s=0; n && s<LIVE; s++){
+      TraceSlot[n] = s; TraceBytes[n++] = 0;
+    }
+    for(s=0; s<LIVE; s++){
+      TraceSlot[n] = s; TraceBytes[n++] = 1+rand()%SMALL;
+    }
+    for(s=0; s<LIVE; s=s+2){
+      TraceSlot[n] = s; TraceBytes[n++] = 0;
+    }
+    for(s=0; s<LIVE; s=s+2){
+      TraceSlot[n] = s; TraceBytes[n++] = 2*SMALL+1+rand()%SMALL;
+    }
+  }
+  TraceLength = n;
+}
+
+// one timed replay, returns the calls Heap_Malloc could not do
+int32_t replay(void){ int32_t n,s,failed; uint64_t t0,t1;
+  for(s=0; s<LIVE; s++){
+    Live[s] = 0;
+  }
+  Heap_Init();
+  failed = 0;
+  for(n=0; n<TraceLength; n++){
+    s = TraceSlot[n];
+    if(TraceBytes[n]){
+      t0 = ticks();
+      Live[s] = Heap_Malloc(TraceBytes[n]);
+      t1 = ticks();
+      if(Live[s] == 0){
+        failed++;
+      }
+    } else{
+      t0 = ticks();
+      if(Live[s]){
+        Heap_Free(Live[s]);
+      }
+      t1 = ticks();
+      Live[s] = 0;
+    }
+    if(t1-t0 < Fastest[n]){
+      Fastest[n] = t1-t0;
+    }
+  }
+  return failed;
+}
+
+void timed(const char *name){ int32_t n,r,failed,calls[2]; heap_stats_t stats;
+  double sum[2],worst[2],ns; int f;
+  for(n=0; n<TraceLength; n++){
+    Fastest[n] = UINT64_MAX;
+  }
+  failed = 0;
+  for(r=0; r<REPEATS; r++){
+    failed = replay();
+  }
+  stats = Heap_Stats();       // what the last replay left
+  if(Heap_Test() != HEAP_OK){
+    Damaged++;
+  }
+  for(f=0; f<2; f++){
+    sum[f] = worst[f] = 0;
+    calls[f] = 0;
+  }
+  for(n=0; n<TraceLength; n++){
+    f = TraceBytes[n] ? 0 : 1;
+    ns = (Fastest[n] > Overhead) ? NsPerTick*(Fastest[n]-Overhead) : 0;
+    sum[f] = sum[f]+ns;
+    calls[f]++;
+    if(ns > worst[f]){
+      worst[f] = ns;
+    }
+  }
+  printf("  %-7s %7.1f %7.1f %7.1f %7.1f %7d %8d %8d\n", name,
+         sum[0]/calls[0], worst[0], sum[1]/calls[1], worst[1], failed,
+         stats.wordsLargestUnused, stats.wordsAvailable);
+}
+
+int main(void){
+  printf("%d-byte heap, words copied by Heap_Realloc\n", HEAP_SIZE_BYTES);
+  printf("  %-7s %7s %12s %8s %11s %8s %9s\n", "trace", "calls",
+         "old copied", "failed", "new copied", "failed", "in place");
+  run("grow", &grow);
+  run("shrink", &shrink);
+  run("random", &randomTrace);
+  printf("%s, ns per call, unused words at the end\n",
+         HEAP_SEGREGATED ? "segregated free lists" : "first fit");
+  printf("  %-7s %7s %7s %7s %7s %7s %8s %8s\n", "trace", "malloc",
+         "worst", "free", "worst", "failed", "largest", "total");
+  calibrate();
+  srand(4);
+  makeRandom(0);
+  timed("small");
+  makeRandom(8);
+  timed("mixed");
+  makeRefill();
+  timed("refill");
+  if(Damaged){
+    printf("data or heap damaged %d times\n", Damaged);
+    return 1;
+  }
+  printf("no damage\n");
+  return 0;
+}
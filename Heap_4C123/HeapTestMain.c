@@ -98,8 +98,8 @@ int main(void){
   status = Heap_Test();
   stats = Heap_Stats();
 
-  //q1 should point to freed space
-  status = Heap_Free(q1);
+  //q1 was grown in place, so q6 is the same block
+  //freeing q1 here would unallocate q6
   status = Heap_Test();
 
   for(i = 0; i < 6; i++){
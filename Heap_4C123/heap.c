@@ -32,6 +32,12 @@
 // If the block is used, the meta-sections record the room as a positive
 // number.  If the block is unused, the meta-sections record the room as a
 // negative number.
+// With HEAP_SEGREGATED the room of each unused block also holds the
+// word index of the next and previous unused blocks of the same size
+// class.  Class c holds rooms 2^c to 2^(c+1)-1, and bit c of FreeBits
+// is set when class c is not empty.  Heap_Malloc takes the first block
+// of the request's own class if it fits, otherwise the first block of
+// the next larger non-empty class, which always fits.
 #include <stdint.h>
 #include "heap.h"
 
@@ -41,6 +47,34 @@
 //The actual heap is just a big array.
 static int32_t Heap[HEAP_SIZE_WORDS];
 
+#if HEAP_SEGREGATED
+#define HEAP_MIN_ROOM 2       // room for the next and previous indices
+#define HEAP_CLASSES 32       // one per bit of a room
+#define HEAP_NONE (-1)        // end of a free list
+// count leading zeros, a single CLZ instruction on the Cortex M4
+#if defined(__ARMCC_VERSION)
+#define HEAP_CLZ(x) __clz(x)
+#elif defined(__TI_COMPILER_VERSION__)
+#define HEAP_CLZ(x) ((uint32_t)_norm(x))
+#elif defined(__GNUC__)
+#define HEAP_CLZ(x) ((uint32_t)__builtin_clz(x))
+#endif
+static int32_t FreeList[HEAP_CLASSES]; // index of first unused block
+static uint32_t FreeBits;              // bit c set if class c not empty
+static uint32_t sizeClass(int32_t room);
+static void freeListInsert(int32_t* blockStart);
+static void freeListRemove(int32_t* blockStart);
+#else
+#define HEAP_MIN_ROOM 1
+#define freeListInsert(blockStart)  // first fit keeps no lists
+#define freeListRemove(blockStart)
+#endif
+
+// realloc statistics, cleared by Heap_Init
+static int32_t ReallocInPlace;  // number of times the block did not move
+static int32_t ReallocMoved;    // number of times the block moved
+static int32_t WordsCopied;     // number of words moved by Heap_Realloc
+
 static int32_t inHeapRange(int32_t* address);
 static int32_t blockUsed(int32_t* block);
 static int32_t blockUnused(int32_t* block);
@@ -54,6 +88,7 @@ static int32_t markBlockUsed(int32_t* blockStart);
 static int32_t markBlockUnused(int32_t* blockStart);
 static int32_t splitAndMarkBlockUsed(int32_t* upperBlockStart, int32_t desiredRoom);
 static void mergeBlockWithBelow(int32_t* upperBlockStart);
+static void shrinkBlock(int32_t* blockStart, int32_t desiredRoom);
 //static int32_t byteIndex(int32_t* ptr);
 
 //******** Heap_Init *************** 
@@ -67,6 +102,18 @@ int32_t Heap_Init(void){
   int32_t* blockEnd = (HEAP_START + HEAP_SIZE_WORDS - 1);
   *blockStart = -(int32_t)(HEAP_SIZE_WORDS - 2);  
   *blockEnd = -(int32_t)(HEAP_SIZE_WORDS - 2);
+#if HEAP_SEGREGATED
+  {int32_t c;
+    for(c = 0; c < HEAP_CLASSES; c++){
+      FreeList[c] = HEAP_NONE;
+    }
+    FreeBits = 0;
+  }
+  freeListInsert(blockStart);
+#endif
+  ReallocInPlace = 0;
+  ReallocMoved = 0;
+  WordsCopied = 0;
   return HEAP_OK;
 }
 
@@ -79,6 +126,35 @@ int32_t Heap_Init(void){
 //   if there isn't sufficient space to satisfy allocation request
 void* Heap_Malloc(int32_t desiredBytes){
   int32_t desiredWords = (desiredBytes + sizeof(int32_t) - 1) / sizeof(int32_t);
+#if HEAP_SEGREGATED
+  int32_t* blockStart;
+  uint32_t c, larger;
+  if(desiredWords <= 0){
+    return 0; //NULL
+  }
+  if(desiredWords < HEAP_MIN_ROOM){
+    desiredWords = HEAP_MIN_ROOM; // so it can hold links when freed
+  }
+  c = sizeClass(desiredWords);
+  // the first block in our own class may or may not be big enough
+  if(FreeList[c] != HEAP_NONE && blockRoom(HEAP_START + FreeList[c]) >= desiredWords){
+    blockStart = HEAP_START + FreeList[c];
+  }
+  else{
+    // every block in a larger class is big enough
+    larger = FreeBits & ~((2u << c) - 1);
+    if(larger == 0){
+      return 0; //NULL
+    }
+    c = 31 - HEAP_CLZ(larger & (0 - larger)); // lowest set bit
+    blockStart = HEAP_START + FreeList[c];
+  }
+  freeListRemove(blockStart);
+  if(splitAndMarkBlockUsed(blockStart, desiredWords)){
+    return 0; //NULL
+  }
+  return blockStart + 1;
+#else
   int32_t* blockStart = HEAP_START;  // implements first fit
   if(desiredWords <= 0){
     return 0; //NULL
@@ -95,6 +171,7 @@ void* Heap_Malloc(int32_t desiredBytes){
     blockStart = nextBlockHeader(blockStart);
   }
   return 0; //NULL
+#endif
 }
 
 
@@ -133,12 +210,17 @@ void* Heap_Calloc(int32_t desiredBytes){
 //    where the contents of the old block will be copied to
 // output: void* pointing to the new block or will return NULL
 //   if there is any reason the reallocation can't be completed
-// notes: the given block will be unallocated after its contents
-//   are copied to the new block
+// notes: a smaller block is split in place, a larger block first tries
+//   to grow into an unused block below it, then to slide up into an
+//   unused block above it; only if neither fits is a new block
+//   allocated, the contents copied, and the old block unallocated
 void* Heap_Realloc(void* oldBlock, int32_t desiredBytes){
   int32_t* oldBlockPtr;
   int32_t* oldBlockStart;
   int32_t* newBlockPtr;
+  int32_t* nextBlockStart;
+  int32_t* previousBlockStart;
+  int32_t desiredWords;
   int32_t oldBlockRoom;
   int32_t newBlockRoom;
   int32_t wordsToCopy;
@@ -152,6 +234,51 @@ void* Heap_Realloc(void* oldBlock, int32_t desiredBytes){
   if(!inHeapRange(oldBlockStart) || blockUnused(oldBlockStart)){
     return 0; // NULL
   }
+  desiredWords = (desiredBytes + sizeof(int32_t) - 1) / sizeof(int32_t);
+  if(desiredWords <= 0){
+    return 0; // NULL
+  }
+  if(desiredWords < HEAP_MIN_ROOM){
+    desiredWords = HEAP_MIN_ROOM;
+  }
+  oldBlockRoom = blockRoom(oldBlockStart);
+
+  // grow into the unused block below, nothing moves
+  if(desiredWords > oldBlockRoom){
+    nextBlockStart = nextBlockHeader(oldBlockStart);
+    if(inHeapRange(nextBlockStart) && blockUnused(nextBlockStart) &&
+       oldBlockRoom + 2 + blockRoom(nextBlockStart) >= desiredWords){
+      freeListRemove(nextBlockStart);
+      mergeBlockWithBelow(oldBlockStart); // merged block is marked unused
+      markBlockUsed(oldBlockStart);
+      oldBlockRoom = blockRoom(oldBlockStart);
+    }
+  }
+  if(desiredWords <= oldBlockRoom){
+    shrinkBlock(oldBlockStart, desiredWords);
+    ReallocInPlace++;
+    return oldBlockPtr;
+  }
+
+  // slide up into the unused block above, copying toward lower addresses
+  if(oldBlockStart > HEAP_START){
+    previousBlockStart = previousBlockHeader(oldBlockStart);
+    if(blockUnused(previousBlockStart) &&
+       blockRoom(previousBlockStart) + 2 + oldBlockRoom >= desiredWords){
+      freeListRemove(previousBlockStart);
+      markBlockUnused(oldBlockStart);
+      mergeBlockWithBelow(previousBlockStart);
+      newBlockPtr = previousBlockStart + 1;
+      for(i = 0; i < oldBlockRoom; i++){
+        newBlockPtr[i] = oldBlockPtr[i]; // safe, newBlockPtr < oldBlockPtr
+      }
+      markBlockUsed(previousBlockStart);
+      shrinkBlock(previousBlockStart, desiredWords);
+      ReallocMoved++;
+      WordsCopied += oldBlockRoom;
+      return newBlockPtr;
+    }
+  }
 
   newBlockPtr = Heap_Malloc(desiredBytes);
   // did Malloc fail?
@@ -159,7 +286,6 @@ void* Heap_Realloc(void* oldBlock, int32_t desiredBytes){
     return 0; // NULL
   }
   
-  oldBlockRoom = blockRoom(oldBlockStart);
   newBlockRoom = blockRoom(newBlockPtr - 1);
   if(oldBlockRoom < newBlockRoom){
     wordsToCopy = oldBlockRoom;
@@ -173,6 +299,8 @@ void* Heap_Realloc(void* oldBlock, int32_t desiredBytes){
   if(Heap_Free(oldBlockPtr)){
     return 0; // NULL Free failed
   }
+  ReallocMoved++;
+  WordsCopied += wordsToCopy;
   return newBlockPtr;
 }
 
@@ -214,6 +342,7 @@ int32_t Heap_Free(void* pointer){
     int32_t* previousBlockStart = previousBlockHeader(blockStart);
     // second, make sure we only merge with an unused block
     if(blockUnused(previousBlockStart)){
+      freeListRemove(previousBlockStart);
       mergeBlockWithBelow(previousBlockStart);
       blockStart = previousBlockStart; // start of block has moved
     }
@@ -222,8 +351,10 @@ int32_t Heap_Free(void* pointer){
   // possibly merge with block below
   nextBlockStart = nextBlockHeader(blockStart);
   if(inHeapRange(nextBlockStart) && blockUnused(nextBlockStart)){
+    freeListRemove(nextBlockStart);
     mergeBlockWithBelow(blockStart);
   }
+  freeListInsert(blockStart);
   return HEAP_OK;
 }
 
@@ -274,6 +405,7 @@ heap_stats_t Heap_Stats(void){
   stats.wordsAvailable = 0;
   stats.blocksUsed = 0;
   stats.blocksUnused = 0;
+  stats.wordsLargestUnused = 0;
 
   //just go through each block to get stats on heap usage
   blockStart = HEAP_START;
@@ -285,10 +417,16 @@ heap_stats_t Heap_Stats(void){
     else{
       stats.wordsAvailable += blockRoom(blockStart);
       stats.blocksUnused++;
+      if(blockRoom(blockStart) > stats.wordsLargestUnused){
+        stats.wordsLargestUnused = blockRoom(blockStart);
+      }
     }
     blockStart = nextBlockHeader(blockStart);
   }
   stats.wordsOverhead = HEAP_SIZE_WORDS - stats.wordsAllocated - stats.wordsAvailable;
+  stats.reallocInPlace = ReallocInPlace;
+  stats.reallocMoved = ReallocMoved;
+  stats.wordsCopied = WordsCopied;
   return stats;
 }
 
@@ -419,7 +557,7 @@ static int32_t markBlockUnused(int32_t* blockStart){
 static int32_t splitAndMarkBlockUsed(int32_t* upperBlockStart, int32_t desiredRoom){
   int32_t leftoverRoom = blockRoom(upperBlockStart) - desiredRoom - 2;
   // only split block if leftovers could actually make another useful block
-  if(leftoverRoom > 0){
+  if(leftoverRoom >= HEAP_MIN_ROOM){
     int32_t* upperBlockEnd = upperBlockStart + desiredRoom + 1;
     int32_t* lowerBlockStart = upperBlockEnd + 1;
     int32_t* lowerBlockEnd = blockTrailer(upperBlockStart);
@@ -427,6 +565,7 @@ static int32_t splitAndMarkBlockUsed(int32_t* upperBlockStart, int32_t desiredRo
     *upperBlockEnd = desiredRoom;
     *lowerBlockStart = -leftoverRoom; // marked unused
     *lowerBlockEnd = -leftoverRoom;
+    freeListInsert(lowerBlockStart);
   }
   // can't split block - just mark it at used
   else{
@@ -455,3 +594,85 @@ static void mergeBlockWithBelow(int32_t* upperBlockStart){
 }
 
 
+
+// shrinkBlock
+// input: 
+//  blockStart: header of a used block
+//  desiredRoom: new room, no more than the current room
+// output: none
+// notes: splits the end off the block as a new unused block, merged with
+//  the block below if that one is unused.  Will not split a block if the
+//  leftover room is insufficient to make another useful block.
+static void shrinkBlock(int32_t* blockStart, int32_t desiredRoom){
+  int32_t leftoverRoom = blockRoom(blockStart) - desiredRoom - 2;
+  int32_t* blockEnd;
+  int32_t* lowerBlockStart;
+  int32_t* lowerBlockEnd;
+  int32_t* nextBlockStart;
+  if(leftoverRoom < HEAP_MIN_ROOM){
+    return;
+  }
+  lowerBlockEnd = blockTrailer(blockStart);
+  blockEnd = blockStart + desiredRoom + 1;
+  lowerBlockStart = blockEnd + 1;
+  *blockStart = desiredRoom;        // still marked used
+  *blockEnd = desiredRoom;
+  *lowerBlockStart = -leftoverRoom; // marked unused
+  *lowerBlockEnd = -leftoverRoom;
+  nextBlockStart = lowerBlockEnd + 1;
+  if(inHeapRange(nextBlockStart) && blockUnused(nextBlockStart)){
+    freeListRemove(nextBlockStart);
+    mergeBlockWithBelow(lowerBlockStart);
+  }
+  freeListInsert(lowerBlockStart);
+}
+
+
+#if HEAP_SEGREGATED
+// sizeClass
+// input: room of a block in words, at least 1
+// output: size class, the position of the most significant 1 in room
+static uint32_t sizeClass(int32_t room){
+  return 31 - HEAP_CLZ((uint32_t)room);
+}
+
+
+// freeListInsert
+// input: pointer to the header of an unused block
+// output: none
+// notes: puts the block at the front of the list for its size class
+static void freeListInsert(int32_t* blockStart){
+  uint32_t c = sizeClass(blockRoom(blockStart));
+  int32_t index = blockStart - HEAP_START;
+  blockStart[1] = FreeList[c];       // next
+  blockStart[2] = HEAP_NONE;         // previous
+  if(FreeList[c] != HEAP_NONE){
+    HEAP_START[FreeList[c] + 2] = index;
+  }
+  FreeList[c] = index;
+  FreeBits |= 1u << c;
+}
+
+
+// freeListRemove
+// input: pointer to the header of an unused block
+// output: none
+// notes: takes the block out of the list for its size class
+static void freeListRemove(int32_t* blockStart){
+  uint32_t c = sizeClass(blockRoom(blockStart));
+  int32_t next = blockStart[1];
+  int32_t previous = blockStart[2];
+  if(previous != HEAP_NONE){
+    HEAP_START[previous + 1] = next;
+  }
+  else{
+    FreeList[c] = next;
+    if(next == HEAP_NONE){
+      FreeBits &= ~(1u << c);
+    }
+  }
+  if(next != HEAP_NONE){
+    HEAP_START[next + 2] = previous;
+  }
+}
+#endif
@@ -30,9 +30,20 @@
 
 // feel free to change HEAP_SIZE_BYTES to however
 // big you want the heap to be
+#ifndef HEAP_SIZE_BYTES
 #define HEAP_SIZE_BYTES (256)
+#endif
 #define HEAP_SIZE_WORDS (HEAP_SIZE_BYTES / sizeof(int32_t))
 
+// allocation policy
+// 0 for first fit, Heap_Malloc scans the blocks from the start of the heap
+// 1 for segregated free lists, unused blocks are kept in one list per
+//   power of two size class, so Heap_Malloc and Heap_Free take constant
+//   time no matter how many blocks are in the heap
+#ifndef HEAP_SEGREGATED
+#define HEAP_SEGREGATED 1
+#endif
+
 #define HEAP_OK 0
 #define HEAP_ERROR_CORRUPTED_HEAP 1
 #define HEAP_ERROR_POINTER_OUT_OF_RANGE 2
@@ -44,6 +55,10 @@ typedef struct heap_stats {
   int32_t wordsOverhead;
   int32_t blocksUsed;
   int32_t blocksUnused;
+  int32_t wordsLargestUnused; // room of the biggest unused block
+  int32_t reallocInPlace;  // Heap_Realloc calls that kept the same block
+  int32_t reallocMoved;    // Heap_Realloc calls that moved the data
+  int32_t wordsCopied;     // total words moved by Heap_Realloc
 } heap_stats_t;
 
 //******** Heap_Init *************** 
@@ -82,8 +97,9 @@ void* Heap_Calloc(int32_t desiredBytes);
 //    where the contents of the old block will be copied to
 // output: void* pointing to the new block or will return NULL
 //   if there is any reason the reallocation can't be completed
-// notes: the given block will be unallocated after its contents
-//   are copied to the new block
+// notes: shrinks in place, grows in place into an unused block below
+//   it if possible; otherwise the contents are copied to a new block
+//   and the given block is unallocated
 void* Heap_Realloc(void* oldBlock, int32_t desiredBytes);
 
 
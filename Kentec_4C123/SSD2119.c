@@ -38,8 +38,11 @@
 //  ------------------- 
 //
 //  XP->XN = 651
+#include <stdint.h>
+#include <stdarg.h>
 #include "../inc/tm4c123gh6pm.h"
 #include "SSD2119.h"
+#include "Format.h"
 
   
 // 4 bit Color 	 red,green,blue to 16 bit color 
@@ -480,41 +483,26 @@ void LCD_SetTextColor(unsigned char r, unsigned char g, unsigned char b){
 // ********************************************************
 void printf(char fmt[], ...) {
 	unsigned char k = 0;
-	void* next_arg = &fmt + 1;
+	va_list ap;
+	va_start(ap, fmt);
 	while (fmt[k] != 0) {
 		if (fmt[k] == '%') {                    // Special escape, look for next arg
 			if (fmt[k+1] == 'd') {              // Display integer
-				long* p = (long*) next_arg;
-				long x = *p;
-				next_arg = p + 1;
-				LCD_PrintInteger(x);
+				LCD_PrintInteger(va_arg(ap, long));
 			} else if (fmt[k+1] == 'c') {       // Display character
-				long* p = (long*) next_arg;
-				char x = *p;
-				next_arg = p + 1;
-				LCD_PrintChar(x);
+				LCD_PrintChar(va_arg(ap, int));
 			} else if (fmt[k+1] == 's') {       // Display string
-				char** p = (char**) next_arg;
-				char* x = *p;
-				next_arg = p + 1;
-				LCD_PrintString(x);
+				LCD_PrintString(va_arg(ap, char *));
  			} else if (fmt[k+1] == 'f') {       // Display float (not yet working)
- 				float* p = (float*) next_arg;
- 				float x = *p;
- 				next_arg = p + 1;
- 				LCD_PrintFloat(x);
+ 				LCD_PrintFloat(va_arg(ap, double));
 			} else if (fmt[k+1] == 'x') {       // Display hexadecimal
-				long* p = (long*) next_arg;
-				long x = *p;
-				next_arg = p + 1;
-				LCD_PrintHex(x);
+				LCD_PrintHex(va_arg(ap, unsigned long));
 			} else if (fmt[k+1] == 'b') {       // Display binary
-				long* p = (long*) next_arg;
-				long x = *p;
-				next_arg = p + 1;
-				LCD_PrintBinary(x);
+				LCD_PrintBinary(va_arg(ap, unsigned long));
 			} else if (fmt[k+1] == '%') {       // Display '%'
 				LCD_PrintChar('%');
+			} else if (fmt[k+1] == 0) {         // '%' at the end
+				break;
 			} else {
 				// Otherwise, just ignore the unrecognized escape
 			}
@@ -524,45 +512,18 @@ void printf(char fmt[], ...) {
 			k = k + 1;
 		}
 	}
+	va_end(ap);
 }
 
 // ************** LCD_PrintInteger ************************
 // - Prints a signed integer to the screen
 // ********************************************************
 void LCD_PrintInteger(long n){
-    unsigned char i = 0;
-    unsigned char sign = ' ';
-    unsigned char tempString[16];
+    char tempString[FORMAT_SIZE];
 
-    // If our number is 0, print 0
-    if (n == 0) {
-        LCD_PrintChar('0');
-        return;
-    }
-    
-    // If our number is negative, remember and unsign it
-    if(n < 0){
-        n = -n;
-        sign = '-';
-    }
-    
-    // Build our number string via repeated division
-    while (n > 0){
-        tempString[i] = (n % 10) + 48;
-        n = n / 10;
-        i += 1;
-    }
-
-    // Apply our sign if necessary
-    if (sign == '-'){
-        LCD_PrintChar('-');
-    }
-    
-    // Print out our string in reverse order
-    while (i){
-        LCD_PrintChar(tempString[i-1]);
-        i -= 1;
-    }
+    // Build our number string without divides, sign included
+    Format_Dec(tempString, n);
+    LCD_PrintString(tempString);
 }
 
 // ************** LCD_PrintHex ****************************
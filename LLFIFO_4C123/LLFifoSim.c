@@ -0,0 +1,205 @@
+// LLFifoSim.c
+// Runs on a PC, not on the LaunchPad
+// Test ULLFifo.c and LLFifo.c against a plain array, then compare the
+// memory they need and the time they take per element.
+//   test       a random mix of Put, Get, PutBulk and GetBulk, each
+//              result checked against an array that holds the same
+//              numbers; both FIFOs fill the heap exactly
+//   benchmark  20,000,000 elements through each FIFO, put up to as
+//              many as fit at a time and then gotten, reporting ns
+//              and heap calls per element
+// heap.c keeps pointers in int32_t, so build without PIE to keep the
+// addresses below 2 GB.  Pointers are 8 bytes on a PC, so a 4-word
+// block holds 2 elements here and 3 on the LaunchPad.  The --wrap
+// options count the calls to heap.c.
+//   gcc -O2 -no-pie -Wl,--wrap=Heap_Allocate,--wrap=Heap_Release LLFifoSim.c LLFifo.c ULLFifo.c heap.c -o LLFifoSim
+//   ./LLFifoSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+   ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "heap.h"
+#include "LLFifo.h"
+#include "ULLFifo.h"
+
+#define NUM 5                 // blocks in heap.c
+#define NODEDATA ((HEAP_BLOCKWORDS*sizeof(int32_t)-sizeof(void *))/sizeof(int32_t))
+
+// count the calls LLFifo.c and ULLFifo.c make to heap.c
+uint32_t HeapCalls;
+int32_t *__real_Heap_Allocate(void);
+void __real_Heap_Release(int32_t *pt);
+int32_t *__wrap_Heap_Allocate(void){
+  HeapCalls++;
+  return __real_Heap_Allocate();
+}
+void __wrap_Heap_Release(int32_t *pt){
+  HeapCalls++;
+  __real_Heap_Release(pt);
+}
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+//************test*************
+#define OPS 1000000
+int32_t Expect[OPS*8];        // every number put, in order
+uint32_t Head,Tail;           // next to get, next to put
+void test(int bulk){ uint32_t op,i,n,m,bad; int32_t next,data,buf[8];
+  printf("test, %s\n", bulk ? "ULLFifo" : "LLFifo");
+  if(bulk){
+    ULLFifo_Init();
+  } else{
+    Fifo_Init();
+  }
+  srand(9);
+  Head = Tail = 0;
+  next = bad = 0;
+  for(op=0; op<OPS; op++){
+    switch(rand()%(bulk ? 4 : 2)){
+      case 0:
+        if(bulk ? ULLFifo_Put(next) : Fifo_Put(next)){
+          Expect[Tail++] = next;
+        }
+        next++;
+        break;
+      case 1:
+        n = bulk ? ULLFifo_Get(&data) : Fifo_Get(&data);
+        bad = bad+(n != (Head < Tail));
+        if(n){
+          bad = bad+(data != Expect[Head++]);
+        }
+        break;
+      case 2:
+        n = rand()%8;
+        for(i=0; i<n; i++){
+          buf[i] = next+i;
+        }
+        m = ULLFifo_PutBulk(buf, n);
+        for(i=0; i<m; i++){
+          Expect[Tail++] = buf[i];
+        }
+        if(m < n){            // short only if the heap is full
+          bad = bad+ULLFifo_Put(-1);
+        }
+        next = next+n;
+        break;
+      default:
+        n = rand()%8;
+        m = ULLFifo_GetBulk(buf, n);
+        bad = bad+(m != ((Tail-Head < n) ? Tail-Head : n));
+        for(i=0; i<m; i++){
+          bad = bad+(buf[i] != Expect[Head++]);
+        }
+    }
+  }
+  printf("  %u wrong\n", bad);
+  check(bad == 0, "same numbers as the array, in order");
+  while(bulk ? ULLFifo_Get(&data) : Fifo_Get(&data)){
+    check(data == Expect[Head++], "emptied in order");
+  }
+  check(Head == Tail, "emptied completely");
+  n = 0;
+  while(bulk ? ULLFifo_Put(n) : Fifo_Put(n)){
+    n++;
+  }
+  printf("  holds %u elements in %d blocks\n", n, NUM);
+  check(n == (bulk ? NUM*NODEDATA : NUM), "fills the heap");
+}
+
+//************benchmark*************
+#define ELEMENTS 20000000
+volatile int32_t Sink;
+void run(int which){ static const char *name[3] = {"Fifo_Put/Get",
+  "ULLFifo_Put/Get", "ULLFifo_PutBulk/GetBulk"};
+  uint32_t n,i,depth,capacity; int32_t data,buf[16]; double t0,t1;
+  if(which){
+    ULLFifo_Init();
+    capacity = NUM*NODEDATA;
+  } else{
+    Fifo_Init();
+    capacity = NUM;
+  }
+  HeapCalls = 0;
+  depth = 1;
+  t0 = seconds();
+  for(n=0; n<ELEMENTS; n=n+depth){
+    depth = 1+n%capacity;     // 1 to capacity deep
+    switch(which){
+      case 0:
+        for(i=0; i<depth; i++){
+          Fifo_Put(i);
+        }
+        for(i=0; i<depth; i++){
+          Fifo_Get(&data);
+          Sink = data;
+        }
+        break;
+      case 1:
+        for(i=0; i<depth; i++){
+          ULLFifo_Put(i);
+        }
+        for(i=0; i<depth; i++){
+          ULLFifo_Get(&data);
+          Sink = data;
+        }
+        break;
+      default:
+        ULLFifo_PutBulk(buf, depth);
+        ULLFifo_GetBulk(buf, depth);
+        Sink = buf[0];
+    }
+  }
+  t1 = seconds();
+  printf("  %-24s %6.2f ns  %5.2f heap calls per element\n", name[which],
+         1e9*(t1-t0)/n, (double)HeapCalls/n);
+}
+void benchmark(void){
+  printf("benchmark, %d elements\n", ELEMENTS);
+  printf("  %d-word blocks, data bytes per block: LLFifo %u, ULLFifo %u here, %u on the LaunchPad\n",
+         HEAP_BLOCKWORDS, (unsigned)sizeof(int32_t), (unsigned)(NODEDATA*sizeof(int32_t)),
+         (unsigned)(HEAP_BLOCKWORDS*4-4));
+  run(0);
+  run(1);
+  run(2);
+}
+
+int main(void){
+  test(0);
+  test(1);
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
@@ -0,0 +1,147 @@
+// ULLFifo.c
+// Runs on any computer
+// unrolled linked list FIFO
+// LLFifo.c uses one heap block per element, holding a Next pointer
+// and one int32_t.  Here each block holds a Next pointer and as many
+// elements as fit (three with 4-word blocks and 32-bit pointers), so
+// the heap is called once per block and the pointer is shared.
+// Elements are put at PutI in the last block and gotten from GetI in
+// the first block.  A block is released once all its elements are gotten.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+   ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <string.h>
+#include "heap.h"
+#include "ULLFifo.h"
+
+// number of elements that fit in a heap block after the Next pointer
+#define NODEDATA ((HEAP_BLOCKWORDS*sizeof(int32_t)-sizeof(void *))/sizeof(int32_t))
+
+struct UNode{
+  struct UNode *Next;
+  int32_t Data[NODEDATA];
+};
+
+typedef struct UNode UNodeType;
+UNodeType *UPutPt;   // last block
+UNodeType *UGetPt;   // first block
+uint32_t UPutI;      // place to put in the last block
+uint32_t UGetI;      // place to get in the first block
+
+void ULLFifo_Init(void){
+  UGetPt = NULL;     // Empty when null
+  UPutPt = NULL;
+  UPutI = NODEDATA;  // no room, the first put allocates
+  UGetI = 0;
+  Heap_Init();
+}
+
+// make sure there is room in the last block
+// return 1 if there is room, 0 if the heap is full
+static int Room(void){
+UNodeType *pt;
+  if(UPutI < NODEDATA){
+    return(1);
+  }
+  pt = (UNodeType*)Heap_Allocate();
+  if(!pt){           // check for NULL pointer if heap full
+    return(0);       // full
+  }
+  pt->Next = NULL;
+  if(UPutPt){
+    UPutPt->Next = pt; // Link
+  }
+  else{
+    UGetPt = pt;     // first one
+    UGetI = 0;
+  }
+  UPutPt = pt;
+  UPutI = 0;
+  return(1);
+}
+
+// called after elements are gotten from the first block
+// releases the first block when all its elements have been gotten
+static void Used(void){
+UNodeType *pt;
+  if((UGetPt == UPutPt) && (UGetI == UPutI)){
+    UGetI = UPutI = 0;   // empty, reuse the block from the start
+  }
+  else if(UGetI == NODEDATA){
+    pt = UGetPt;
+    UGetPt = UGetPt->Next;
+    UGetI = 0;
+    Heap_Release((int32_t*)pt);
+  }
+}
+
+int ULLFifo_Put(int32_t theData){
+  if(!Room()){
+    return(0);       // full
+  }
+  UPutPt->Data[UPutI] = theData; // store
+  UPutI++;
+  return(1);         // successful
+}
+
+int ULLFifo_Get(int32_t *datapt){
+  if(!UGetPt || ((UGetPt == UPutPt) && (UGetI == UPutI))){
+    return(0);       // empty
+  }
+  *datapt = UGetPt->Data[UGetI];
+  UGetI++;
+  Used();
+  return(1);         // success
+}
+
+uint32_t ULLFifo_PutBulk(const int32_t *src, uint32_t n){
+uint32_t count,done;
+  done = 0;
+  while((done < n) && Room()){
+    count = NODEDATA - UPutI;  // room left in the last block
+    if(count > n - done){
+      count = n - done;
+    }
+    memcpy(&UPutPt->Data[UPutI], &src[done], count*sizeof(int32_t));
+    UPutI += count;
+    done += count;
+  }
+  return(done);
+}
+
+uint32_t ULLFifo_GetBulk(int32_t *dst, uint32_t n){
+uint32_t count,done;
+  done = 0;
+  while((done < n) && UGetPt && !((UGetPt == UPutPt) && (UGetI == UPutI))){
+    if(UGetPt == UPutPt){
+      count = UPutI - UGetI;   // data left in the only block
+    }
+    else{
+      count = NODEDATA - UGetI; // data left in the first block
+    }
+    if(count > n - done){
+      count = n - done;
+    }
+    memcpy(&dst[done], &UGetPt->Data[UGetI], count*sizeof(int32_t));
+    UGetI += count;
+    done += count;
+    Used();
+  }
+  return(done);
+}
@@ -0,0 +1,42 @@
+// ULLFifo.h
+// Runs on any computer
+// unrolled linked list FIFO
+// Each heap block holds a Next pointer and several data elements,
+// so the heap is called once per block instead of once per element.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+   ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+// initialize the FIFO and the heap it allocates from
+void ULLFifo_Init(void);
+
+// add one element to the end of the FIFO
+// return 1 if successful, 0 if the heap is full
+int ULLFifo_Put(int32_t theData);
+
+// remove one element from the front of the FIFO
+// return 1 if successful, 0 if the FIFO is empty
+int ULLFifo_Get(int32_t *datapt);
+
+// add up to n elements to the end of the FIFO
+// return the number added, less than n if the heap filled up
+uint32_t ULLFifo_PutBulk(const int32_t *src, uint32_t n);
+
+// remove up to n elements from the front of the FIFO
+// return the number removed, less than n if the FIFO emptied
+uint32_t ULLFifo_GetBulk(int32_t *dst, uint32_t n);
@@ -21,7 +21,8 @@
  http://users.ece.utexas.edu/~valvano/
 */
 #include <stdint.h>
-#define SIZE 4  // number of 32-bit words in each block
+#include "heap.h"
+#define SIZE HEAP_BLOCKWORDS  // number of 32-bit words in each block
 #define NUM 5   // number of blocks
 #define NULL 0  // definition of empty pointer
 int32_t *FreePt;   // points to the first free block
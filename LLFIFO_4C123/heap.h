@@ -21,6 +21,8 @@
  http://users.ece.utexas.edu/~valvano/
 */
 
+#define HEAP_BLOCKWORDS 4  // number of 32-bit words in each block
+
 //------------Heap_Init------------
 // Initialize the heap and pointer to the first free block.  Free
 // blocks are linked together with a linear linked list
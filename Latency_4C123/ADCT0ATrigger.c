@@ -0,0 +1 @@
+../ADCT0ATrigger_4C123/ADCT0ATrigger.c
\ No newline at end of file
@@ -0,0 +1 @@
+../ESP8266_4C123/Format.c
\ No newline at end of file
@@ -0,0 +1,295 @@
+// Latency.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Measure interrupt latency, period jitter and execution time of
+// periodic interrupt service routines.
+// Latency_Enter and Latency_Exit only do arithmetic on the numbers
+// they are given, so they can be tested on a PC by feeding them
+// made up time stamps.  On the LaunchPad the LATENCY_ENTER and
+// LATENCY_EXIT macros pass them the DWT cycle counter.
+// The interrupts write the statistics and the main program reads
+// them, so Latency_Clear only asks each channel to clear itself the
+// next time its interrupt runs, and Latency_Report may show a
+// channel part way through an update.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "Latency.h"
+
+#if defined(__ARMCC_VERSION) || defined(__TI_COMPILER_VERSION__) || defined(__arm__)
+#define NVIC_DBG_DEMCR_R        (*((volatile uint32_t *)0xE000EDFC))
+#define DWT_CTRL_R              (*((volatile uint32_t *)0xE0001000))
+#define NVIC_DBG_DEMCR_TRCENA   0x01000000  // enable DWT and ITM
+#define DWT_CTRL_CYCCNTENA      0x00000001  // enable cycle counter
+#endif
+
+#define LINESIZE 160
+
+// private, so they do not clash with the user program, read them with Latency_Stats
+static latency_stats_t Stats[LATENCY_CHANNELS];
+static uint64_t LatTotal[LATENCY_CHANNELS];   // sum of latencies
+static uint64_t ExecTotal[LATENCY_CHANNELS];  // sum of execution times
+static uint32_t ExecCount[LATENCY_CHANNELS];  // number of exits
+static uint32_t EnterTime[LATENCY_CHANNELS];  // time of the most recent entry
+static uint8_t Running[LATENCY_CHANNELS];     // 1 between entry and exit
+static uint8_t ClearRequest[LATENCY_CHANNELS];// 1 to clear on the next entry
+
+// number of bits needed to hold n, the histogram bin
+static uint32_t bin(uint32_t n){ uint32_t b;
+  b = 0;
+  while((b < LATENCY_BINS-1) && (n>>b)){
+    b++;
+  }
+  return b;
+}
+
+// clear one channel, keeping its name and period
+static void clear(uint32_t ch){ latency_stats_t *s; uint32_t b;
+  s = &Stats[ch];
+  s->count = 0;
+  s->latMin = 0xFFFFFFFF; s->latMax = 0; s->latMean = 0;
+  s->jitMin = 0x7FFFFFFF; s->jitMax = -0x7FFFFFFF-1;
+  s->execMin = 0xFFFFFFFF; s->execMax = 0; s->execMean = 0;
+  for(b=0; b<LATENCY_BINS; b++){
+    s->latHist[b] = 0;
+    s->jitHist[b] = 0;
+  }
+  LatTotal[ch] = 0;
+  ExecTotal[ch] = 0;
+  ExecCount[ch] = 0;
+  Running[ch] = 0;
+  ClearRequest[ch] = 0;
+}
+
+//------------Latency_Init------------
+// Start the DWT cycle counter and clear every channel.
+// Input: none
+// Output: none
+void Latency_Init(void){ uint32_t ch;
+#ifdef DWT_CTRL_R
+  NVIC_DBG_DEMCR_R |= NVIC_DBG_DEMCR_TRCENA;
+  DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;  // free running, never cleared
+#endif
+  for(ch=0; ch<LATENCY_CHANNELS; ch++){
+    Stats[ch].name = 0;
+    Stats[ch].period = 0;
+    clear(ch);
+  }
+}
+
+//------------Latency_Channel------------
+// Name a channel and give its expected period.
+// Input: ch      0 to LATENCY_CHANNELS-1
+//        name    string that stays valid, not copied
+//        period  expected time between entries in bus cycles,
+//                0 to not measure jitter
+// Output: none
+void Latency_Channel(uint32_t ch, const char *name, uint32_t period){
+  if(ch < LATENCY_CHANNELS){
+    Stats[ch].name = name;
+    Stats[ch].period = period;
+  }
+}
+
+//------------Latency_Enter------------
+// Record the start of an ISR, called by LATENCY_ENTER.
+// Input: ch       0 to LATENCY_CHANNELS-1
+//        now      32-bit free running cycle count
+//        latency  cycles from the event to now, 0 if not known
+// Output: none
+void Latency_Enter(uint32_t ch, uint32_t now, uint32_t latency){
+  latency_stats_t *s; int32_t jitter;
+  if(ch >= LATENCY_CHANNELS){
+    return;
+  }
+  s = &Stats[ch];
+  if(ClearRequest[ch]){
+    clear(ch);
+  }
+  if(s->count && s->period){   // needs a previous entry
+    jitter = (int32_t)(now - EnterTime[ch] - s->period);
+    if(jitter < s->jitMin) s->jitMin = jitter;
+    if(jitter > s->jitMax) s->jitMax = jitter;
+    if(jitter < 0){
+      s->jitHist[bin(-(uint32_t)jitter)]++;
+    } else{
+      s->jitHist[bin(jitter)]++;
+    }
+  }
+  EnterTime[ch] = now;
+  Running[ch] = 1;
+  s->count++;
+  LatTotal[ch] += latency;
+  if(latency < s->latMin) s->latMin = latency;
+  if(latency > s->latMax) s->latMax = latency;
+  s->latHist[bin(latency)]++;
+}
+
+//------------Latency_Exit------------
+// Record the end of an ISR, called by LATENCY_EXIT.
+// Input: ch   0 to LATENCY_CHANNELS-1
+//        now  32-bit free running cycle count
+// Output: none
+void Latency_Exit(uint32_t ch, uint32_t now){
+  latency_stats_t *s; uint32_t elapsed;
+  if((ch >= LATENCY_CHANNELS) || (Running[ch] == 0) || ClearRequest[ch]){
+    return;                    // no matching entry
+  }
+  s = &Stats[ch];
+  Running[ch] = 0;
+  elapsed = now - EnterTime[ch];
+  ExecCount[ch]++;
+  ExecTotal[ch] += elapsed;
+  if(elapsed < s->execMin) s->execMin = elapsed;
+  if(elapsed > s->execMax) s->execMax = elapsed;
+}
+
+//------------Latency_Clear------------
+// Clear the statistics of every channel.  Each channel clears itself
+// on its next entry, so this is safe while the ISRs are running.
+// Input: none
+// Output: none
+void Latency_Clear(void){ uint32_t ch;
+  for(ch=0; ch<LATENCY_CHANNELS; ch++){
+    ClearRequest[ch] = 1;
+  }
+}
+
+//------------Latency_Stats------------
+// Input: ch  0 to LATENCY_CHANNELS-1
+// Output: statistics for that channel
+latency_stats_t Latency_Stats(uint32_t ch){ latency_stats_t s; uint32_t b;
+  if(ch >= LATENCY_CHANNELS){
+    ch = 0;
+  }
+  s = Stats[ch];
+  if(ClearRequest[ch] || (s.count == 0)){
+    s.count = 0;               // cleared, or never ran
+    s.latMin = s.latMax = s.latMean = 0;
+    s.jitMin = s.jitMax = 0;
+    s.execMin = s.execMax = s.execMean = 0;
+    for(b=0; b<LATENCY_BINS; b++){
+      s.latHist[b] = 0;
+      s.jitHist[b] = 0;
+    }
+    return s;
+  }
+  s.latMean = (uint32_t)(LatTotal[ch]/s.count);
+  if((s.count < 2) || (s.period == 0)){
+    s.jitMin = s.jitMax = 0;
+  }
+  if(ExecCount[ch]){
+    s.execMean = (uint32_t)(ExecTotal[ch]/ExecCount[ch]);
+  } else{
+    s.execMin = 0;
+  }
+  return s;
+}
+
+// copy a string, returns pointer to the next free character
+static char *str(char *pt, const char *s){
+  while(*s){
+    *pt = *s;
+    pt++; s++;
+  }
+  return pt;
+}
+
+// convert an unsigned number to decimal, followed by a space
+// returns pointer to the next free character
+static char *udec(char *pt, uint32_t n){ char digits[10]; int i;
+  i = 0;
+  do{
+    digits[i] = '0' + n%10;
+    n = n/10;
+    i++;
+  }while(n);
+  while(i){
+    i--;
+    *pt = digits[i];
+    pt++;
+  }
+  *pt = ' ';
+  return pt+1;
+}
+
+// convert a signed number to decimal, followed by a space
+static char *sdec(char *pt, int32_t n){
+  if(n < 0){
+    *pt = '-';
+    return udec(pt+1, -(uint32_t)n);
+  }
+  return udec(pt, n);
+}
+
+// output the nonzero bins of one histogram, one per line
+static void histogram(void (*outString)(char *), const char *label, const uint32_t *hist){
+  char line[LINESIZE]; char *pt; uint32_t b;
+  for(b=0; b<LATENCY_BINS; b++){
+    if(hist[b]){
+      pt = str(line, label);
+      if(b == LATENCY_BINS-1){ // last bin holds everything larger
+        pt = udec(str(pt, ">="), (uint32_t)1<<(b-1));
+      } else{
+        pt = udec(str(pt, "<"), (uint32_t)1<<b);
+      }
+      pt = udec(pt, hist[b]);
+      pt[-1] = '\r'; pt[0] = '\n'; pt[1] = 0;
+      outString(line);
+    }
+  }
+}
+
+//------------Latency_Report------------
+// Output one line per channel that has run: name, count, latency
+// min max mean, jitter min max, execution min max mean, followed
+// by lines with the nonzero latency and jitter histogram bins.
+// Input: outString  function that outputs a string, e.g. UART_OutString
+// Output: none
+void Latency_Report(void (*outString)(char *)){
+  char line[LINESIZE]; char *pt; uint32_t ch; latency_stats_t s;
+  for(ch=0; ch<LATENCY_CHANNELS; ch++){
+    s = Latency_Stats(ch);
+    if(s.count == 0){
+      continue;
+    }
+    if(s.name){
+      pt = str(line, s.name);
+      *pt = ' ';
+      pt++;
+    } else{
+      pt = udec(str(line, "ch"), ch);
+    }
+    pt = udec(str(pt, "n="), s.count);
+    pt = str(pt, "lat ");
+    pt = udec(pt, s.latMin);
+    pt = udec(pt, s.latMax);
+    pt = udec(pt, s.latMean);
+    pt = str(pt, "jit ");
+    pt = sdec(pt, s.jitMin);
+    pt = sdec(pt, s.jitMax);
+    pt = str(pt, "exec ");
+    pt = udec(pt, s.execMin);
+    pt = udec(pt, s.execMax);
+    pt = udec(pt, s.execMean);
+    pt[-1] = '\r'; pt[0] = '\n'; pt[1] = 0;
+    outString(line);
+    histogram(outString, "  lat ", s.latHist);
+    histogram(outString, "  jit ", s.jitHist);
+  }
+}
@@ -0,0 +1,121 @@
+// Latency.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Measure interrupt latency, period jitter and execution time of
+// periodic interrupt service routines.
+// Each ISR calls LATENCY_ENTER first and LATENCY_EXIT last.  The
+// latency is read from the timer that caused the interrupt: a
+// periodic down counter has counted (reload - current) cycles since
+// it timed out.  Entry and exit are time stamped with the 32-bit
+// DWT cycle counter, which gives the period and execution time.
+// The hooks in Timer0A.c-Timer3.c, ADCT0ATrigger.c and the
+// SysTick handler compile to nothing unless LATENCY is defined as
+// 1 in the project options, so other projects need not link Latency.c.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __LATENCY_H__
+#define __LATENCY_H__
+
+#ifndef LATENCY
+#define LATENCY 0         // 1 to measure, 0 for no hooks and no overhead
+#endif
+
+#define LATENCY_CHANNELS 8 // number of ISRs that can be measured
+#define LATENCY_BINS     17 // histogram bin b counts values from 2^(b-1) to 2^b-1
+
+// channels used by the hooks in the drivers, 6 and 7 are free
+#define LATENCY_SYSTICK   0
+#define LATENCY_TIMER0A   1
+#define LATENCY_TIMER1A   2
+#define LATENCY_TIMER2A   3
+#define LATENCY_TIMER3A   4
+#define LATENCY_ADC0SEQ3  5 // latency is from the Timer0A trigger, includes conversion
+
+#define DWT_CYCCNT_R            (*((volatile uint32_t *)0xE0001004))
+#if LATENCY
+#define LATENCY_ENTER(ch,latency) Latency_Enter(ch, DWT_CYCCNT_R, latency)
+#define LATENCY_EXIT(ch)          Latency_Exit(ch, DWT_CYCCNT_R)
+#else
+#define LATENCY_ENTER(ch,latency)
+#define LATENCY_EXIT(ch)
+#endif
+
+// statistics for one channel, times are in bus cycles
+typedef struct latency_stats {
+  const char *name;       // set by Latency_Channel, 0 if not set
+  uint32_t period;        // expected period, 0 if jitter is not measured
+  uint32_t count;         // number of entries
+  uint32_t latMin,latMax,latMean;    // entry latency
+  int32_t jitMin,jitMax;  // measured period minus expected period
+  uint32_t execMin,execMax,execMean; // entry to exit
+  uint32_t latHist[LATENCY_BINS];    // latency
+  uint32_t jitHist[LATENCY_BINS];    // size of the jitter, either sign
+} latency_stats_t;
+
+//------------Latency_Init------------
+// Start the DWT cycle counter and clear every channel.
+// Input: none
+// Output: none
+void Latency_Init(void);
+
+//------------Latency_Channel------------
+// Name a channel and give its expected period.
+// Input: ch      0 to LATENCY_CHANNELS-1
+//        name    string that stays valid, not copied
+//        period  expected time between entries in bus cycles,
+//                0 to not measure jitter
+// Output: none
+void Latency_Channel(uint32_t ch, const char *name, uint32_t period);
+
+//------------Latency_Enter------------
+// Record the start of an ISR, called by LATENCY_ENTER.
+// Input: ch       0 to LATENCY_CHANNELS-1
+//        now      32-bit free running cycle count
+//        latency  cycles from the event to now, 0 if not known
+// Output: none
+void Latency_Enter(uint32_t ch, uint32_t now, uint32_t latency);
+
+//------------Latency_Exit------------
+// Record the end of an ISR, called by LATENCY_EXIT.
+// Input: ch   0 to LATENCY_CHANNELS-1
+//        now  32-bit free running cycle count
+// Output: none
+void Latency_Exit(uint32_t ch, uint32_t now);
+
+//------------Latency_Clear------------
+// Clear the statistics of every channel.  Each channel clears itself
+// on its next entry, so this is safe while the ISRs are running.
+// Input: none
+// Output: none
+void Latency_Clear(void);
+
+//------------Latency_Stats------------
+// Input: ch  0 to LATENCY_CHANNELS-1
+// Output: statistics for that channel
+latency_stats_t Latency_Stats(uint32_t ch);
+
+//------------Latency_Report------------
+// Output one line per channel that has run: name, count, latency
+// min max mean, jitter min max, execution min max mean, followed
+// by lines with the nonzero latency and jitter histogram bins.
+// Input: outString  function that outputs a string, e.g. UART_OutString
+// Output: none
+void Latency_Report(void (*outString)(char *));
+
+#endif //  __LATENCY_H__
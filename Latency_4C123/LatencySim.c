@@ -0,0 +1,224 @@
+// LatencySim.c
+// Runs on a PC, not on the LaunchPad
+// Feed Latency.c made up time stamps and check its statistics against
+// the same numbers kept here in 64-bit arithmetic.
+//   random     1,000,000 entries of a 1 ms ISR at 80 MHz with random
+//              latency, jitter and execution time, the cycle counter
+//              starting just before it rolls over 2^32, checked for
+//              count, min, max, mean and both histograms
+//   nesting    a fast ISR preempting a slow one, the slow one's
+//              execution time includes the fast one
+//   clear      Latency_Clear while an ISR is between entry and exit,
+//              an exit with no entry, channels out of range
+//   report     the text Latency_Report writes for one channel
+//   benchmark  ns per Latency_Enter and Latency_Exit pair
+//   gcc -O2 LatencySim.c Latency.c -o LatencySim
+//   ./LatencySim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Latency.h"
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+// histogram bin of n, the number of bits needed to hold it
+uint32_t bin(uint64_t n){ uint32_t b;
+  for(b=0; (b < LATENCY_BINS-1)&&(n >= ((uint64_t)1<<b)); b++){
+  }
+  return b;
+}
+
+//************random*************
+#define PERIOD 80000          // 1 ms at 80 MHz
+#define ENTRIES 1000000
+void testRandom(void){ uint64_t t,last,latSum,execSum; uint32_t i,lat,exec,b,wrong;
+  uint32_t latMin,latMax,execMin,execMax,latHist[LATENCY_BINS],jitHist[LATENCY_BINS];
+  int64_t jit,jitMin,jitMax;
+  latency_stats_t s;
+  printf("random, %d entries every %d cycles\n", ENTRIES, PERIOD);
+  Latency_Init();
+  Latency_Channel(2, "Timer1A", PERIOD);
+  srand(18);
+  latSum = execSum = 0;
+  latMin = execMin = 0xFFFFFFFF;
+  latMax = execMax = 0;
+  jitMin = INT64_MAX; jitMax = INT64_MIN;
+  memset(latHist, 0, sizeof(latHist));
+  memset(jitHist, 0, sizeof(jitHist));
+  t = 0xFFFFFFFF-10*PERIOD;   // DWT_CYCCNT rolls over after 10 entries
+  last = 0;
+  for(i=0; i<ENTRIES; i++){
+    lat = 12+rand()%200;
+    if(rand()%1000 == 0){
+      lat = lat+rand()%70000;   // now and then a long critical section
+    }
+    exec = 50+rand()%3000;
+    Latency_Enter(2, (uint32_t)(t+lat), lat);
+    Latency_Exit(2, (uint32_t)(t+lat+exec));
+    if(i){
+      jit = (int64_t)(t+lat-last)-PERIOD;
+      if(jit < jitMin) jitMin = jit;
+      if(jit > jitMax) jitMax = jit;
+      jitHist[bin((jit < 0) ? -jit : jit)]++;
+    }
+    last = t+lat;
+    latSum = latSum+lat;
+    execSum = execSum+exec;
+    if(lat < latMin) latMin = lat;
+    if(lat > latMax) latMax = lat;
+    if(exec < execMin) execMin = exec;
+    if(exec > execMax) execMax = exec;
+    latHist[bin(lat)]++;
+    t = t+PERIOD;
+  }
+  s = Latency_Stats(2);
+  printf("  lat %u %u %u, jit %d %d, exec %u %u %u\n", s.latMin, s.latMax, s.latMean,
+         s.jitMin, s.jitMax, s.execMin, s.execMax, s.execMean);
+  check((s.count == ENTRIES)&&(strcmp(s.name, "Timer1A") == 0)&&(s.period == PERIOD), "count and name");
+  check((s.latMin == latMin)&&(s.latMax == latMax)&&(s.latMean == latSum/ENTRIES), "latency");
+  check((s.jitMin == jitMin)&&(s.jitMax == jitMax), "jitter across the rollover");
+  check((s.execMin == execMin)&&(s.execMax == execMax)&&(s.execMean == execSum/ENTRIES), "execution time");
+  wrong = 0;
+  for(b=0; b<LATENCY_BINS; b++){
+    wrong = wrong+(s.latHist[b] != latHist[b])+(s.jitHist[b] != jitHist[b]);
+  }
+  check(wrong == 0, "histograms");
+  s = Latency_Stats(3);
+  check((s.count == 0)&&(s.latMin == 0)&&(s.execMin == 0), "channel that never ran");
+}
+
+//************nesting*************
+void testNesting(void){ latency_stats_t slow,fast;
+  printf("nesting\n");
+  Latency_Init();
+  Latency_Channel(0, "SysTick", 1000);
+  Latency_Channel(1, "Timer0A", 0);
+  Latency_Enter(1, 100, 10);
+  Latency_Enter(0, 150, 5);   // preempts Timer0A
+  Latency_Exit(0, 170);
+  Latency_Enter(0, 1150, 5);
+  Latency_Exit(0, 1180);
+  Latency_Exit(1, 1300);
+  slow = Latency_Stats(1);
+  fast = Latency_Stats(0);
+  check((slow.count == 1)&&(slow.execMax == 1200), "preempted ISR includes the other one");
+  check((slow.jitMin == 0)&&(slow.jitMax == 0), "no jitter without a period");
+  check((fast.count == 2)&&(fast.execMin == 20)&&(fast.execMax == 30)&&(fast.execMean == 25), "preempting ISR");
+  check((fast.jitMin == 0)&&(fast.jitMax == 0), "on time");
+}
+
+//************clear*************
+void testClear(void){ latency_stats_t s;
+  printf("clear\n");
+  Latency_Init();
+  Latency_Channel(4, "Timer3A", 500);
+  Latency_Exit(4, 10);        // exit with no entry
+  s = Latency_Stats(4);
+  check(s.count == 0, "exit with no entry ignored");
+  Latency_Enter(4, 1000, 7);
+  Latency_Exit(4, 1100);
+  Latency_Enter(4, 1500, 9);
+  Latency_Clear();            // main clears while the ISR runs
+  check(Latency_Stats(4).count == 0, "cleared at once as seen by main");
+  Latency_Exit(4, 1550);      // belongs to the entry before the clear
+  Latency_Enter(4, 2000, 3);
+  Latency_Exit(4, 2040);
+  s = Latency_Stats(4);
+  check((s.count == 1)&&(s.latMax == 3)&&(s.execMax == 40)&&(s.execMin == 40), "only the entry after the clear");
+  check((s.jitMin == 0)&&(s.jitMax == 0), "no jitter from one entry");
+  check((strcmp(s.name, "Timer3A") == 0)&&(s.period == 500), "name and period kept");
+  Latency_Enter(LATENCY_CHANNELS, 1, 1);
+  Latency_Exit(LATENCY_CHANNELS, 2);
+  Latency_Channel(LATENCY_CHANNELS, "none", 1);
+  check(Latency_Stats(0).count == 0, "channels out of range ignored");
+}
+
+//************report*************
+char Text[2000];
+void out(char *s){
+  if(strlen(Text)+strlen(s) < sizeof(Text)){
+    strcat(Text, s);
+  }
+}
+void testReport(void){
+  printf("report\n");
+  Latency_Init();
+  Latency_Channel(5, "ADC", 8000);
+  Latency_Enter(5, 1000, 40);
+  Latency_Exit(5, 1300);
+  Latency_Enter(5, 8990, 30);
+  Latency_Exit(5, 9090);
+  Latency_Enter(6, 20, 0);    // no name, no period
+  Text[0] = 0;
+  Latency_Report(&out);
+  printf("%s", Text);
+  check(strcmp(Text,
+    "ADC n=2 lat 30 40 35 jit -10 -10 exec 100 300 200\r\n"
+    "  lat <32 1\r\n"
+    "  lat <64 1\r\n"
+    "  jit <16 1\r\n"
+    "ch6 n=1 lat 0 0 0 jit 0 0 exec 0 0 0\r\n"
+    "  lat <1 1\r\n") == 0, "report text");
+}
+
+//************benchmark*************
+#define PAIRS 20000000
+void benchmark(void){ uint32_t i,t; double t0,t1;
+  printf("benchmark\n");
+  Latency_Init();
+  Latency_Channel(0, "SysTick", PERIOD);
+  t = 0;
+  t0 = seconds();
+  for(i=0; i<PAIRS; i++){
+    Latency_Enter(0, t+(i&0xFF), i&0xFF);
+    Latency_Exit(0, t+300+(i&0x3FF));
+    t = t+PERIOD;
+  }
+  t1 = seconds();
+  printf("  %.2f ns per Latency_Enter and Latency_Exit pair\n", 1e9*(t1-t0)/PAIRS);
+}
+
+int main(void){
+  testRandom();
+  testNesting();
+  testClear();
+  testReport();
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
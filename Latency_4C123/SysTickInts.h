@@ -0,0 +1 @@
+../PeriodicSysTickInts_4C123/SysTickInts.h
\ No newline at end of file
@@ -0,0 +1,102 @@
+// main.c
+// Runs on LM4F120/TM4C123
+// Measure the latency, jitter and execution time of three periodic
+// interrupts running at once: SysTick at 10 kHz (priority 2), the
+// ADC sampling at 2 kHz triggered by Timer0A (priority 2), and
+// Timer1A at 1 kHz (priority 4).
+// Define LATENCY=1 in the project options (C/C++ tab, Define) so the
+// hooks in Timer1.c and ADCT0ATrigger.c are compiled in.
+// Connect a terminal to UART0 at 115,200 bps and type
+//   r  report the statistics
+//   c  clear the statistics
+//   d  toggle a disturbance: the main program disables interrupts
+//      for a random 0 to 255 cycles, which shows up as latency
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "../inc/tm4c123gh6pm.h"
+#include "PLL.h"
+#include "UART.h"
+#include "SysTickInts.h"
+#include "Timer1.h"
+#include "ADCT0ATrigger.h"
+#include "Latency.h"
+
+#if LATENCY == 0
+#error "define LATENCY=1 in the project options"
+#endif
+
+#define SYSTICKPERIOD 8000    // 10 kHz at 80 MHz
+#define ADCPERIOD     40000   // 2 kHz
+#define TIMER1PERIOD  80000   // 1 kHz
+
+void DisableInterrupts(void); // Disable interrupts
+void EnableInterrupts(void);  // Enable interrupts
+
+volatile uint32_t SysTickCount, Timer1Count;
+
+void SysTick_Handler(void){
+  LATENCY_ENTER(LATENCY_SYSTICK, NVIC_ST_RELOAD_R-NVIC_ST_CURRENT_R);
+  SysTickCount++;
+  LATENCY_EXIT(LATENCY_SYSTICK);
+}
+
+void UserTask(void){
+  Timer1Count++;
+}
+
+uint32_t Random = 1;
+// disable interrupts for 0 to 255 loops of about 4 cycles each
+void Disturb(void){ volatile uint32_t n;
+  Random = 1664525*Random + 1013904223;
+  n = Random>>24;
+  DisableInterrupts();
+  while(n){
+    n--;
+  }
+  EnableInterrupts();
+}
+
+int main(void){ char ch; int disturb;
+  PLL_Init(Bus80MHz);         // bus clock at 80 MHz
+  UART_Init();                // 115,200 bps
+  Latency_Init();
+  Latency_Channel(LATENCY_SYSTICK, "SysTick", SYSTICKPERIOD);
+  Latency_Channel(LATENCY_ADC0SEQ3, "ADC0Seq3", ADCPERIOD);
+  Latency_Channel(LATENCY_TIMER1A, "Timer1A", TIMER1PERIOD);
+  SysTick_Init(SYSTICKPERIOD);
+  ADC0_InitTimer0ATriggerSeq3(0, ADCPERIOD); // PE3/AIN0
+  Timer1_Init(&UserTask, TIMER1PERIOD);
+  EnableInterrupts();
+  UART_OutString("Latency in bus cycles: r=report, c=clear, d=disturb\r\n");
+  disturb = 0;
+  while(1){
+    ch = UART_InCharNonBlock();
+    if(ch == 'r'){
+      Latency_Report(&UART_OutString);
+    } else if(ch == 'c'){
+      Latency_Clear();
+    } else if(ch == 'd'){
+      disturb = !disturb;
+    }
+    if(disturb){
+      Disturb();
+    }
+  }
+}
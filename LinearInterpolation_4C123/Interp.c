@@ -0,0 +1,118 @@
+// Interp.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Piecewise linear table lookup for any function.
+// Sin() in Sine.c searches the table from the start and divides on
+// every call.  A uniform table finds the segment with a shift, and
+// since the segment width is 2^Shift the divide is a shift too.  A
+// non-uniform table finds the segment with a binary search, and
+// multiplies by a slope that was computed when the table was built.
+// agent
+// October 17, 2026
+
+//  This example accompanies the book
+//  "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+//  ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+//
+//Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+//   You may use, edit, run or distribute this file
+//   as long as the above copyright notice remains
+//THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+//OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+//MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+//VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+//OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+//For more information about my classes, my research, and my books, see
+//http://users.ece.utexas.edu/~valvano/
+#include <stdint.h>
+#include "Interp.h"
+
+// uniform table, dx is x-X0, 0 <= dx < (N-1)*2^Shift
+static int32_t uniform(const int32_t *y, uint32_t shift, int32_t dx){
+  int32_t i,f;
+  i = dx>>shift;               // segment
+  f = dx-(i<<shift);           // 0 <= f < 2^Shift
+  if(shift == 0){
+    return y[i];
+  }
+  return y[i] + (((y[i+1]-y[i])*f + (1<<(shift-1)))>>shift);
+}
+
+//------------Interp------------
+// Look up one value.  x below the first breakpoint gives the first
+// y value, x at or above the last breakpoint gives the last y value.
+// The result is rounded to the nearest integer.
+// Uniform tables need |(Y[i+1]-Y[i])*2^Shift| < 2^31, and
+// non-uniform tables need |Slope[i]*(X[i+1]-X[i])| < 2^31.
+// Input: table  uniform or non-uniform table
+//        x      input value
+// Output: y value interpolated between the two nearest breakpoints
+int32_t Interp(const interp_table_t *table, int32_t x){
+  const int32_t *X,*Y;
+  uint32_t lo,hi,mid;
+  Y = table->Y;
+  if(table->X == 0){           // uniform
+    x = x-table->X0;
+    if(x <= 0){
+      return Y[0];
+    }
+    if(x >= (int32_t)((table->N-1)<<table->Shift)){
+      return Y[table->N-1];
+    }
+    return uniform(Y, table->Shift, x);
+  }
+  X = table->X;                // non-uniform
+  if(x <= X[0]){
+    return Y[0];
+  }
+  if(x >= X[table->N-1]){
+    return Y[table->N-1];
+  }
+  lo = 0;                      // X[lo] <= x < X[hi]
+  hi = table->N-1;
+  while(hi-lo > 1){
+    mid = (lo+hi)/2;
+    if(x < X[mid]){
+      hi = mid;
+    } else{
+      lo = mid;
+    }
+  }
+  if(table->Slope){
+    return Y[lo] + ((table->Slope[lo]*(x-X[lo]) + (1<<(INTERP_FRAC-1)))>>INTERP_FRAC);
+  }
+  return Y[lo] + ((Y[hi]-Y[lo])*(x-X[lo]))/(X[hi]-X[lo]);
+}
+
+//------------Interp_Array------------
+// Look up n values, same as calling Interp n times.  For uniform
+// tables the table fields are loaded once instead of once per value.
+// Input: table  uniform or non-uniform table
+//        x      array of n input values
+//        y      array of n results, may be the same array as x
+//        n      number of values
+// Output: none
+void Interp_Array(const interp_table_t *table, const int32_t *x, int32_t *y, uint32_t n){
+  const int32_t *Y; int32_t x0,last,dx; uint32_t shift;
+  if(table->X){
+    while(n){
+      *y = Interp(table, *x);
+      x++; y++; n--;
+    }
+    return;
+  }
+  Y = table->Y;
+  x0 = table->X0;
+  shift = table->Shift;
+  last = (table->N-1)<<shift;
+  while(n){
+    dx = *x-x0;
+    if(dx <= 0){
+      *y = Y[0];
+    } else if(dx >= last){
+      *y = Y[table->N-1];
+    } else{
+      *y = uniform(Y, shift, dx);
+    }
+    x++; y++; n--;
+  }
+}
@@ -0,0 +1,65 @@
+// Interp.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Piecewise linear table lookup for any function.
+// A table is a list of breakpoints (x,y); between breakpoints the
+// function is assumed to be linear, as in Sin() in Sine.c.
+// Uniform tables have breakpoints every 2^Shift, so the segment is
+// found with a shift and the interpolation needs no divide.
+// Non-uniform tables put more breakpoints where the function bends;
+// the segment is found with a binary search.
+// InterpGen.c runs on a PC and builds either kind of table.
+// agent
+// October 17, 2026
+
+//  This example accompanies the book
+//  "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+//  ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+//
+//Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+//   You may use, edit, run or distribute this file
+//   as long as the above copyright notice remains
+//THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+//OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+//MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+//VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+//OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+//For more information about my classes, my research, and my books, see
+//http://users.ece.utexas.edu/~valvano/
+
+#ifndef __INTERP_H__
+#define __INTERP_H__
+
+#define INTERP_FRAC 16    // Slope entries are fixed point with 16 fraction bits
+
+typedef struct interp_table {
+  uint32_t N;             // number of breakpoints, at least 2
+  const int32_t *X;       // N increasing x values, 0 for a uniform table
+  const int32_t *Y;       // N y values
+  const int32_t *Slope;   // N-1 slopes (Y[i+1]-Y[i])*2^16/(X[i+1]-X[i]),
+                          // 0 to divide instead, not used if uniform
+  int32_t X0;             // uniform table: x of the first breakpoint
+  uint32_t Shift;         // uniform table: breakpoints are 2^Shift apart
+} interp_table_t;
+
+//------------Interp------------
+// Look up one value.  x below the first breakpoint gives the first
+// y value, x at or above the last breakpoint gives the last y value.
+// The result is rounded to the nearest integer.
+// Uniform tables need |(Y[i+1]-Y[i])*2^Shift| < 2^31, and
+// non-uniform tables need |Slope[i]*(X[i+1]-X[i])| < 2^31.
+// Input: table  uniform or non-uniform table
+//        x      input value
+// Output: y value interpolated between the two nearest breakpoints
+int32_t Interp(const interp_table_t *table, int32_t x);
+
+//------------Interp_Array------------
+// Look up n values, same as calling Interp n times.  For uniform
+// tables the table fields are loaded once instead of once per value.
+// Input: table  uniform or non-uniform table
+//        x      array of n input values
+//        y      array of n results, may be the same array as x
+//        n      number of values
+// Output: none
+void Interp_Array(const interp_table_t *table, const int32_t *x, int32_t *y, uint32_t n);
+
+#endif //  __INTERP_H__
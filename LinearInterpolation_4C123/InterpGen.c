@@ -0,0 +1,128 @@
+// InterpGen.c
+// Runs on a PC, not on the LaunchPad
+// Build interpolation tables for Interp.c and print them as C source.
+// Edit f(), XMIN and XMAX for the function to be tabulated, then
+//   gcc InterpGen.c Interp.c -lm -o InterpGen
+//   ./InterpGen 1.0
+// where 1.0 is the largest error allowed, in output units, over
+// every integer x from XMIN to XMAX.  Two tables are printed:
+// a uniform table using the largest spacing 2^Shift that meets the
+// error, and a non-uniform table.  The non-uniform table is built
+// from the left, making each segment as long as possible, which
+// gives the fewest breakpoints for breakpoints on the rounded f(x).
+// agent
+// October 17, 2026
+
+//  This example accompanies the book
+//  "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+//  ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+//
+//Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+//   You may use, edit, run or distribute this file
+//   as long as the above copyright notice remains
+//THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+//OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+//MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+//VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+//OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+//For more information about my classes, my research, and my books, see
+//http://users.ece.utexas.edu/~valvano/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Interp.h"
+
+// function to tabulate, here the one in Sine.c
+// x is 0 to 256 in units of pi/128, f(x) is in units of 1/127
+#define XMIN 0
+#define XMAX 256
+double f(int32_t x){
+  return 127.0*sin(2.0*3.14159265358979*x/256.0);
+}
+
+#define MAXN (XMAX-XMIN+1)
+int32_t X[MAXN],Y[MAXN],Slope[MAXN];
+
+// largest error of a table over every integer x from XMIN to XMAX
+double maxError(const interp_table_t *table){
+  int32_t x; double err,max;
+  max = 0;
+  for(x=XMIN; x<=XMAX; x++){
+    err = fabs(Interp(table, x) - f(x));
+    if(err > max) max = err;
+  }
+  return max;
+}
+
+// slope between breakpoints i and i+1, rounded
+int32_t slope(int32_t i){
+  return (int32_t)floor((double)(Y[i+1]-Y[i])*(1<<INTERP_FRAC)/(X[i+1]-X[i]) + 0.5);
+}
+
+void printArray(const char *name, const int32_t *data, uint32_t n){
+  uint32_t i;
+  printf("const int32_t %s[%u] = {", name, n);
+  for(i=0; i<n; i++){
+    printf((i%10 == 0) ? "\n  " : " ");
+    printf("%d%s", data[i], (i<n-1) ? "," : "");
+  }
+  printf("};\n");
+}
+
+int main(int argc, char **argv){
+  interp_table_t table; double target,err;
+  uint32_t shift,best,n,i; int32_t x0,x1,good;
+  target = (argc > 1) ? atof(argv[1]) : 1.0;
+  // uniform, the widest spacing that meets the target
+  best = 0;
+  for(shift=1; (1<<shift) <= XMAX-XMIN; shift++){
+    n = (XMAX-XMIN+(1<<shift)-1)/(1<<shift)+1; // last breakpoint >= XMAX
+    for(i=0; i<n; i++){
+      Y[i] = (int32_t)floor(f(XMIN+(i<<shift))+0.5);
+    }
+    table.N = n; table.X = 0; table.Y = Y; table.Slope = 0;
+    table.X0 = XMIN; table.Shift = shift;
+    if(maxError(&table) <= target){
+      best = shift;
+    }
+  }
+  n = (XMAX-XMIN+(1<<best)-1)/(1<<best)+1;
+  for(i=0; i<n; i++){
+    Y[i] = (int32_t)floor(f(XMIN+(i<<best))+0.5);
+  }
+  table.N = n; table.X = 0; table.Y = Y; table.Slope = 0;
+  table.X0 = XMIN; table.Shift = best;
+  printf("// uniform, %u breakpoints, Shift %u, max error %.3f\n", n, best, maxError(&table));
+  printArray("UniformY", Y, n);
+  // non-uniform, each segment as long as possible
+  n = 0;
+  x0 = XMIN;
+  X[0] = x0; Y[0] = (int32_t)floor(f(x0)+0.5);
+  while(x0 < XMAX){
+    good = x0+1;               // a one step segment is always allowed
+    for(x1=x0+2; x1<=XMAX; x1++){
+      X[n+1] = x1; Y[n+1] = (int32_t)floor(f(x1)+0.5);
+      Slope[n] = slope(n);
+      table.N = 2; table.X = &X[n]; table.Y = &Y[n]; table.Slope = &Slope[n];
+      err = 0;
+      for(i=x0; i<=(uint32_t)x1; i++){
+        if(fabs(Interp(&table, i) - f(i)) > err) err = fabs(Interp(&table, i) - f(i));
+      }
+      if(err <= target){
+        good = x1;
+      }
+    }
+    n++;
+    X[n] = good; Y[n] = (int32_t)floor(f(good)+0.5);
+    Slope[n-1] = slope(n-1);
+    x0 = good;
+  }
+  n++;
+  table.N = n; table.X = X; table.Y = Y; table.Slope = Slope;
+  printf("// non-uniform, %u breakpoints, max error %.3f\n", n, maxError(&table));
+  printArray("TableX", X, n);
+  printArray("TableY", Y, n);
+  printArray("TableSlope", Slope, n-1);
+  return 0;
+}
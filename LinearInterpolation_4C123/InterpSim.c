@@ -0,0 +1,145 @@
+// InterpSim.c
+// Runs on a PC, not on the LaunchPad
+// Check the sine tables in Sine.c against the C library, then time
+// Interp.c next to the original Sin().
+//   accuracy   Sin, SinUniform, SinBinary and Interp_Array on every
+//              angle 0 to 255, each result compared with
+//              127*sin(pi*x/128) rounded; the tables were built for
+//              an error of 1.5, so no result may be off by more than 1
+//   edges      x below the first and past the last breakpoint
+//   benchmark  ns per value for 1,000,000 random angles through each
+//              method, and through the C library sin
+//   gcc -O2 InterpSim.c Interp.c Sine.c -o InterpSim -lm
+//   ./InterpSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+//  This example accompanies the book
+//  "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+//  ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+//
+//Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+//   You may use, edit, run or distribute this file
+//   as long as the above copyright notice remains
+//THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+//OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+//MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+//VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+//OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+//For more information about my classes, my research, and my books, see
+//http://users.ece.utexas.edu/~valvano/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "Interp.h"
+#include "sine.h"
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+// the value Sin(x) should have
+int32_t exact(int32_t x){
+  return (int32_t)lround(127*sin(M_PI*x/128));
+}
+
+//************accuracy*************
+#define METHODS 5
+const char *Name[METHODS] = {"Sin", "SinUniform", "SinBinary",
+  "Interp_Array uniform", "Interp_Array binary"};
+int32_t Angles[256],Uniform[256],Binary[256];
+int32_t result(int m, int32_t x){
+  switch(m){
+    case 0: return Sin(x);
+    case 1: return SinUniform(x);
+    case 2: return SinBinary(x);
+    case 3: return Uniform[x];
+    default: return Binary[x];
+  }
+}
+void accuracy(void){ int32_t x,e; int m; uint32_t off[METHODS][3];
+  printf("accuracy, against 127*sin(pi*x/128) rounded\n");
+  for(x=0; x<256; x++){
+    Angles[x] = x;
+  }
+  Interp_Array(&SinUniformTable, Angles, Uniform, 256);
+  Interp_Array(&SinBinaryTable, Angles, Binary, 256);
+  printf("  %-20s %5s %5s %5s\n", "", "exact", "off 1", "more");
+  for(m=0; m<METHODS; m++){
+    off[m][0] = off[m][1] = off[m][2] = 0;
+    for(x=0; x<256; x++){
+      e = abs(result(m, x)-exact(x));
+      off[m][(e > 2) ? 2 : e]++;
+    }
+    printf("  %-20s %5u %5u %5u\n", Name[m], off[m][0], off[m][1], off[m][2]);
+  }
+  for(m=1; m<METHODS; m++){
+    check(off[m][2] == 0, Name[m]);
+  }
+  for(x=0; x<256; x++){
+    if((Uniform[x] != SinUniform(x))||(Binary[x] != SinBinary(x))){
+      break;
+    }
+  }
+  check(x == 256, "Interp_Array same as Interp");
+}
+
+//************edges*************
+void edges(void){
+  printf("edges\n");
+  check(SinUniform(-100) == 0, "uniform below the first breakpoint");
+  check(SinBinary(-100) == 0, "binary below the first breakpoint");
+  check(SinUniform(256) == 0, "uniform at the last breakpoint");
+  check(SinBinary(100000) == 0, "binary past the last breakpoint");
+  check((SinUniform(64) == 127)&&(SinUniform(192) == -127), "uniform peaks");
+}
+
+//************benchmark*************
+#define CALLS 1000000
+int32_t In[CALLS],Out[CALLS];
+volatile int32_t Sink;
+void benchmark(void){ uint32_t i; int m; int32_t sum; double t0,t1;
+  printf("benchmark, ns per value\n");
+  for(i=0; i<CALLS; i++){
+    In[i] = rand()&0xFF;
+  }
+  for(m=0; m<METHODS+1; m++){
+    sum = 0;
+    t0 = seconds();
+    switch(m){
+      case 0: for(i=0; i<CALLS; i++) sum = sum+Sin(In[i]); break;
+      case 1: for(i=0; i<CALLS; i++) sum = sum+SinUniform(In[i]); break;
+      case 2: for(i=0; i<CALLS; i++) sum = sum+SinBinary(In[i]); break;
+      case 3: Interp_Array(&SinUniformTable, In, Out, CALLS); sum = Out[5]; break;
+      case 4: Interp_Array(&SinBinaryTable, In, Out, CALLS); sum = Out[5]; break;
+      default: for(i=0; i<CALLS; i++) sum = sum+exact(In[i]);
+    }
+    t1 = seconds();
+    Sink = sum;
+    printf("  %-20s %6.2f\n", (m < METHODS) ? Name[m] : "libm sin, rounded",
+           1e9*(t1-t0)/CALLS);
+  }
+}
+
+int main(void){
+  accuracy();
+  edges();
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
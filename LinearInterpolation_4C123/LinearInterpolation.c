@@ -2,7 +2,9 @@
 // Runs on LM4F120/TM4C123
 // Test the Sine() function by testing numbers from 0 to 255 and comparing
 // the result of the linear interpolation function to pre-calculated sine
-// values.
+// values.  SinUniform() and SinBinary() use tables from InterpGen.c
+// and are checked the same way, with the errors counted in
+// UniformErrors[] and BinaryErrors[].
 // Daniel Valvano
 // September 11, 2013
 
@@ -22,6 +24,7 @@
 //For more information about my classes, my research, and my books, see
 //http://users.ece.utexas.edu/~valvano/
 #include <stdint.h>
+#include "Interp.h"
 #include "sine.h"
 
 const int16_t Expected[256] = {
@@ -52,6 +55,24 @@ int16_t OffByTwo = 0;  // (2 <= error < 3) or (-3 < error <= -2)
 int16_t OffByThree = 0;// (3 <= error < 4) or (-4 < error <= -3)
 int16_t OffByFour = 0; // (4 <= error < 5) or (-5 < error <= -4)
 int16_t OffByFiveOrMore = 0;// (error >= 5) or (error <= -5)
+// index 0 is correct, 1 to 4 are off by 1 to 4, 5 is off by 5 or more
+int16_t UniformErrors[6];  // SinUniform, one call per angle
+int16_t BinaryErrors[6];   // SinBinary, one call per angle
+int16_t ArrayErrors[6];    // all 256 angles in one Interp_Array call
+int32_t Angles[256];
+
+// add the error of result for angle i to the counts
+void Count(int16_t errors[6], int32_t i, int32_t result){
+  int32_t error;
+  error = result - Expected[i];
+  if(error < 0){
+    error = -error;
+  }
+  if(error > 5){
+    error = 5;
+  }
+  errors[error] = errors[error] + 1;
+}
 
 int main(void){
   for(i=0; i<256; i=i+1){
@@ -70,5 +91,14 @@ int main(void){
       OffByFiveOrMore = OffByFiveOrMore + 1;
     }
   }
+  for(i=0; i<256; i=i+1){
+    Count(UniformErrors, i, SinUniform(i));
+    Count(BinaryErrors, i, SinBinary(i));
+    Angles[i] = i;
+  }
+  Interp_Array(&SinUniformTable, Angles, Angles, 256);
+  for(i=0; i<256; i=i+1){
+    Count(ArrayErrors, i, Angles[i]);
+  }
   while(1){};
 }
@@ -27,6 +27,8 @@
 //For more information about my classes, my research, and my books, see
 //http://users.ece.utexas.edu/~valvano/
 #include <stdint.h>
+#include "Interp.h"
+#include "sine.h"
 const int32_t IxTab[22] = {
   0, 13, 26, 38, 51, 64, 77, 90,
   102, 115, 128, 141, 154, 166, 179,
@@ -53,3 +55,47 @@ int32_t Sin(int32_t Ix){ int32_t x1,x2,y1,y2;
   y2 = IyTab[i+1];
   return ((y2-y1)*(Ix-x1))/(x2-x1)+y1;
 }
+
+// tables below were printed by InterpGen.c with a maximum error of 1.5
+// uniform, 33 breakpoints every 8 (Shift 3), max error 1.004
+const int32_t SinUniformY[33] = {
+  0, 25, 49, 71, 90, 106, 117, 125, 127, 125,
+  117, 106, 90, 71, 49, 25, 0, -25, -49, -71,
+  -90, -106, -117, -125, -127, -125, -117, -106, -90, -71,
+  -49, -25, 0};
+const interp_table_t SinUniformTable = {
+  33, 0, SinUniformY, 0, 0, 3
+};
+
+//------------SinUniform------------
+// Same as Sin, using breakpoints every 8 input units, so the
+// segment is Ix>>3 and there is no search and no divide.
+// Input: Ix  8-bit unsigned angle 0 to 255 (units of pi/128)
+// Output: Iy 8-bit signed result -127 to +127 (units of 1/127)
+int32_t SinUniform(int32_t Ix){
+  return Interp(&SinUniformTable, Ix);
+}
+
+// non-uniform, 20 breakpoints, max error 1.490
+const int32_t SinX[20] = {
+  0, 21, 35, 46, 58, 70, 81, 91, 104, 123,
+  144, 159, 172, 183, 194, 206, 217, 230, 249, 256};
+const int32_t SinY[20] = {
+  0, 63, 96, 115, 126, 126, 116, 100, 71, 16,
+  -49, -88, -112, -124, -127, -120, -104, -76, -22, 0};
+const int32_t SinSlope[19] = {
+  196608, 154478, 113199, 60075, 0, -59578, -104858, -146196, -189709, -202850,
+  -170394, -120990, -71494, -17873, 38229, 95325, 141154, 186260, 205970};
+const interp_table_t SinBinaryTable = {
+  20, SinX, SinY, SinSlope, 0, 0
+};
+
+//------------SinBinary------------
+// Same as Sin, using breakpoints placed by InterpGen.c, closer
+// together where the sine bends the most.  The segment is found
+// with a binary search and the slope is in the table.
+// Input: Ix  8-bit unsigned angle 0 to 255 (units of pi/128)
+// Output: Iy 8-bit signed result -127 to +127 (units of 1/127)
+int32_t SinBinary(int32_t Ix){
+  return Interp(&SinBinaryTable, Ix);
+}
@@ -33,3 +33,22 @@
 // Input: Ix  8-bit unsigned angle 0 to 255 (units of pi/128)
 // Output: Iy 8-bit signed result -127 to +127 (units of 1/127)
 int32_t Sin(int32_t Ix);
+
+// tables used by SinUniform and SinBinary, include Interp.h first
+extern const interp_table_t SinUniformTable;
+extern const interp_table_t SinBinaryTable;
+
+//------------SinUniform------------
+// Same as Sin, using breakpoints every 8 input units, so the
+// segment is Ix>>3 and there is no search and no divide.
+// Input: Ix  8-bit unsigned angle 0 to 255 (units of pi/128)
+// Output: Iy 8-bit signed result -127 to +127 (units of 1/127)
+int32_t SinUniform(int32_t Ix);
+
+//------------SinBinary------------
+// Same as Sin, using breakpoints placed by InterpGen.c, closer
+// together where the sine bends the most.  The segment is found
+// with a binary search and the slope is in the table.
+// Input: Ix  8-bit unsigned angle 0 to 255 (units of pi/128)
+// Output: Iy 8-bit signed result -127 to +127 (units of 1/127)
+int32_t SinBinary(int32_t Ix);
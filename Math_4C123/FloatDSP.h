@@ -0,0 +1,167 @@
+// FloatDSP.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Single precision signal processing on arrays: dot product, FIR
+// filter, biquad cascade, scale and add, and fast sin, cos, exp and
+// log.  Loops are unrolled by 4 with separate sums, so one multiply
+// does not wait for the add before it to finish.
+// floatdsp.s (Keil) and floatdsp.asm (CCS) have hand written
+// versions of FDSP_Dot and FDSP_Scale for the M4F floating point
+// unit.  Set FDSP_ASM to 1 to have the FIR filter use them.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+   ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+*/
+
+#ifndef __FLOATDSP_H__
+#define __FLOATDSP_H__
+
+#ifndef FDSP_ASM
+#define FDSP_ASM 0        // 1 if floatdsp.s or floatdsp.asm is in the project
+#endif
+
+//------------FDSP_Dot------------
+// Dot product, a[0]*b[0]+a[1]*b[1]+...+a[n-1]*b[n-1].
+// Four partial sums are added at the end, so the result may differ
+// in the last bits from a sum taken in order.
+// Input: a,b  arrays of n numbers
+//        n    number of elements
+// Output: dot product
+float FDSP_Dot(const float *a, const float *b, uint32_t n);
+
+//------------FDSP_Scale------------
+// y[i] = k*x[i]
+// Input: x  array of n numbers
+//        k  gain
+//        y  array of n results, may be the same array as x
+//        n  number of elements
+// Output: none
+void FDSP_Scale(const float *x, float k, float *y, uint32_t n);
+
+//------------FDSP_Add------------
+// y[i] = a[i]+b[i]
+// Input: a,b  arrays of n numbers
+//        y    array of n results, may be the same array as a or b
+//        n    number of elements
+// Output: none
+void FDSP_Add(const float *a, const float *b, float *y, uint32_t n);
+
+//------------FDSP_MulAdd------------
+// y[i] = y[i]+k*x[i]
+// Input: x  array of n numbers
+//        k  gain
+//        y  array of n numbers, added to in place
+//        n  number of elements
+// Output: none
+void FDSP_MulAdd(const float *x, float k, float *y, uint32_t n);
+
+// assembly versions in floatdsp.s and floatdsp.asm, target only,
+// same operations in the same order as FDSP_Dot and FDSP_Scale
+float FDSP_DotAsm(const float *a, const float *b, uint32_t n);
+void FDSP_ScaleAsm(const float *x, float k, float *y, uint32_t n);
+
+// FIR filter y(n) = h[0]*x(n)+h[1]*x(n-1)+...+h[Taps-1]*x(n-Taps+1)
+// The delay line is stored twice, so the last Taps inputs are always
+// in one piece of the array and each output is one FDSP_Dot.
+typedef struct fdsp_fir {
+  uint32_t Taps;          // number of coefficients
+  const float *H;         // Taps coefficients
+  float *State;           // 2*Taps numbers, last inputs stored twice
+  uint32_t Index;         // newest input is State[Index]
+} fdsp_fir_t;
+
+//------------FDSP_FIRInit------------
+// Initialize a FIR filter with all past inputs zero.
+// Input: fir    filter to initialize
+//        h      taps coefficients, h[0] multiplies the newest input
+//        state  array of 2*taps numbers, used only by this filter
+//        taps   number of coefficients, at least 1
+// Output: none
+void FDSP_FIRInit(fdsp_fir_t *fir, const float *h, float *state, uint32_t taps);
+
+//------------FDSP_FIR------------
+// Filter n inputs.  The filter state carries over to the next call.
+// Input: fir  initialized filter
+//        x    array of n inputs
+//        y    array of n outputs, may be the same array as x
+//        n    number of elements
+// Output: none
+void FDSP_FIR(fdsp_fir_t *fir, const float *x, float *y, uint32_t n);
+
+// cascade of second order sections, transposed direct form II
+// each section is y = b0*x+s1, s1 = b1*x-a1*y+s2, s2 = b2*x-a2*y
+typedef struct fdsp_biquad {
+  uint32_t Stages;        // number of second order sections
+  const float *Coef;      // b0,b1,b2,a1,a2 for each section, a0 is 1
+  float *State;           // s1,s2 for each section
+} fdsp_biquad_t;
+
+//------------FDSP_BiquadInit------------
+// Initialize a biquad cascade with zero state.
+// Input: bq      filter to initialize
+//        coef    5*stages coefficients
+//        state   array of 2*stages numbers, used only by this filter
+//        stages  number of sections
+// Output: none
+void FDSP_BiquadInit(fdsp_biquad_t *bq, const float *coef, float *state, uint32_t stages);
+
+//------------FDSP_Biquad------------
+// Filter n inputs.  Each section runs over the whole array before
+// the next, so its five coefficients and two states stay in
+// registers.  The filter state carries over to the next call.
+// Input: bq  initialized filter
+//        x   array of n inputs
+//        y   array of n outputs, may be the same array as x
+//        n   number of elements
+// Output: none
+void FDSP_Biquad(fdsp_biquad_t *bq, const float *x, float *y, uint32_t n);
+
+//------------FDSP_Sin------------
+// y[i] = sin(x[i]), error less than 2.5e-7 for |x| < 100
+// Input: x  array of n angles in radians
+//        y  array of n results, may be the same array as x
+//        n  number of elements
+// Output: none
+void FDSP_Sin(const float *x, float *y, uint32_t n);
+
+//------------FDSP_Cos------------
+// y[i] = cos(x[i]), error less than 2.5e-7 for |x| < 100
+// Input: x  array of n angles in radians
+//        y  array of n results, may be the same array as x
+//        n  number of elements
+// Output: none
+void FDSP_Cos(const float *x, float *y, uint32_t n);
+
+//------------FDSP_Exp------------
+// y[i] = exp(x[i]), relative error less than 1e-7,
+// x is limited to -87 to +88
+// Input: x  array of n numbers
+//        y  array of n results, may be the same array as x
+//        n  number of elements
+// Output: none
+void FDSP_Exp(const float *x, float *y, uint32_t n);
+
+//------------FDSP_Log------------
+// y[i] = natural log of x[i], error less than 1e-7 for 0.5 < x < 2,
+// otherwise relative error less than 2e-7,
+// x must be a positive normal number (at least 1.2e-38)
+// Input: x  array of n numbers
+//        y  array of n results, may be the same array as x
+//        n  number of elements
+// Output: none
+void FDSP_Log(const float *x, float *y, uint32_t n);
+
+#endif //  __FLOATDSP_H__
@@ -0,0 +1,257 @@
+// FloatDSPSim.c
+// Runs on a PC, not on the LaunchPad
+// Check FloatDSP.c against the C library in double precision, then
+// time it.
+//   functions  FDSP_Sin and FDSP_Cos on every 7th float with
+//              |x| < 100, FDSP_Exp on every 7th float from -87 to 88
+//              and FDSP_Log on every 7th positive normal float, each
+//              within the error in FloatDSP.h, none more than 2.5e-7
+//   kernels    FDSP_Dot, FDSP_Scale, FDSP_Add, FDSP_MulAdd, and
+//              FDSP_FIR and FDSP_Biquad fed in uneven pieces, against
+//              the same sums in double precision
+//   benchmark  ns per element for each function next to sinf, cosf,
+//              expf and logf, and for FDSP_Dot next to a loop with
+//              one sum
+// The sweep takes about a minute.  Math_4C123 has the Keil math.h,
+// so do not add -I. to the build; the C library math.h is used here.
+//   gcc -O2 FloatDSPSim.c FloatDSP.c -o FloatDSPSim -lm
+//   ./FloatDSPSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Introduction to Arm Cortex M Microcontrollers",
+   ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "FloatDSP.h"
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+float toFloat(uint32_t bits){ float f;
+  memcpy(&f, &bits, 4);
+  return f;
+}
+
+//************functions*************
+#define BLOCK 4096
+#define STEP 7               // every 7th float, so every low bit pattern
+float In[BLOCK],Out[BLOCK];
+// largest error of fn over every STEP float from bit pattern first to last,
+// absolute if relative is 0, else relative where |ref| >= 1e-3 and
+// absolute below that; *where is the x with the largest error
+typedef void (*fdsp_t)(const float *, float *, uint32_t);
+double sweep(fdsp_t fn, double (*ref)(double), uint32_t first, uint32_t last,
+             int relative, float *where){ uint64_t bits; uint32_t i,n; double r,e,most;
+  most = 0;
+  bits = first;
+  while(bits <= last){
+    for(n=0; (n < BLOCK)&&(bits <= last); n++){
+      In[n] = toFloat(bits);
+      bits = bits+STEP;
+    }
+    fn(In, Out, n);
+    for(i=0; i<n; i++){
+      r = ref(In[i]);
+      e = fabs(Out[i]-r);
+      if(relative&&(fabs(r) >= 1e-3)){
+        e = e/fabs(r);
+      }
+      if(e > most){
+        most = e;
+        *where = In[i];
+      }
+    }
+  }
+  return most;
+}
+void functions(void){ double e,e2; float x,x2;
+  printf("functions, every 7th float in range against double precision\n");
+  e = sweep(&FDSP_Sin, &sin, 0x00000000, 0x42C7FFFF, 0, &x);     // 0 to 100
+  e2 = sweep(&FDSP_Sin, &sin, 0x80000000, 0xC2C7FFFF, 0, &x2);   // 0 to -100
+  if(e2 > e){ e = e2; x = x2; }
+  printf("  FDSP_Sin  %.3g at %.7g\n", e, x);
+  check(e < 2.5e-7, "FDSP_Sin error less than 2.5e-7");
+  e = sweep(&FDSP_Cos, &cos, 0x00000000, 0x42C7FFFF, 0, &x);
+  e2 = sweep(&FDSP_Cos, &cos, 0x80000000, 0xC2C7FFFF, 0, &x2);
+  if(e2 > e){ e = e2; x = x2; }
+  printf("  FDSP_Cos  %.3g at %.7g\n", e, x);
+  check(e < 2.5e-7, "FDSP_Cos error less than 2.5e-7");
+  e = sweep(&FDSP_Exp, &exp, 0x00000000, 0x42B00000, 1, &x);     // 0 to 88
+  e2 = sweep(&FDSP_Exp, &exp, 0x80000000, 0xC2AE0000, 1, &x2);   // 0 to -87
+  if(e2 > e){ e = e2; x = x2; }
+  printf("  FDSP_Exp  %.3g relative at %.7g\n", e, x);
+  check(e < 1e-7, "FDSP_Exp relative error less than 1e-7");
+  e = sweep(&FDSP_Log, &log, 0x3F000001, 0x3FFFFFFF, 0, &x);     // 0.5 to 2
+  printf("  FDSP_Log  %.3g for 0.5 < x < 2 at %.7g\n", e, x);
+  check(e < 1e-7, "FDSP_Log error less than 1e-7 near 1");
+  e = sweep(&FDSP_Log, &log, 0x00800000, 0x3F000000, 1, &x);     // normal to 0.5
+  e2 = sweep(&FDSP_Log, &log, 0x40000000, 0x7F7FFFFF, 1, &x2);   // 2 to largest
+  if(e2 > e){ e = e2; x = x2; }
+  printf("  FDSP_Log  %.3g relative elsewhere at %.7g\n", e, x);
+  check(e < 2e-7, "FDSP_Log relative error less than 2e-7");
+}
+
+//************kernels*************
+#define N 4096
+#define TAPS 37
+float X[N],Y[N],Z[N],H[TAPS],State[2*TAPS],BQState[4];
+const float BQCoef[10] = {    // two low pass sections
+  0.0675f, 0.1349f, 0.0675f, -1.1430f, 0.4128f,
+  0.0675f, 0.1349f, 0.0675f, -1.1430f, 0.4128f};
+void kernels(void){ uint32_t i,k,n; double s,most,s1[2],s2[2],u,v; const float *c;
+  fdsp_fir_t fir; fdsp_biquad_t bq;
+  static const uint32_t pieces[6] = {1000, 3, 1, 0, 2000, 1092};
+  printf("kernels, against double precision\n");
+  srand(15);
+  for(i=0; i<N; i++){
+    X[i] = (float)(rand()%2001-1000)/1000;
+  }
+  for(k=0; k<TAPS; k++){
+    H[k] = (float)(rand()%201-100)/100;
+  }
+  for(n=0; n<=7; n++){        // every remainder of the unrolled loop
+    s = 0;
+    for(i=0; i<n; i++){
+      s = s+(double)X[i]*X[i+1];
+    }
+    check(fabs(FDSP_Dot(X, &X[1], n)-s) < 1e-5, "FDSP_Dot short");
+    Y[n] = Z[n] = 7.0f;
+    FDSP_Scale(X, 3.0f, Y, n);
+    FDSP_Add(X, Y, Z, n);
+    FDSP_MulAdd(X, -4.0f, Z, n);  // 3x+x-4x
+    for(i=0; i<n; i++){
+      check(fabs(Y[i]-3.0*X[i]) < 1e-6, "FDSP_Scale");
+      check(fabs(Z[i]) < 1e-6, "FDSP_Add and FDSP_MulAdd");
+    }
+    check((Y[n] == 7.0f)&&(Z[n] == 7.0f), "nothing past n");
+  }
+  s = 0;
+  for(i=0; i<N; i++){
+    s = s+(double)X[i]*X[i];
+  }
+  printf("  FDSP_Dot  %.3g relative on %d\n", fabs(FDSP_Dot(X, X, N)-s)/s, N);
+  check(fabs(FDSP_Dot(X, X, N)-s)/s < 1e-6, "FDSP_Dot");
+  FDSP_FIRInit(&fir, H, State, TAPS);
+  for(i=k=0; k<6; k++){
+    FDSP_FIR(&fir, &X[i], &Y[i], pieces[k]);
+    i = i+pieces[k];
+  }
+  most = 0;
+  for(i=0; i<N; i++){
+    s = 0;
+    for(k=0; (k<TAPS)&&(k<=i); k++){
+      s = s+(double)H[k]*X[i-k];
+    }
+    if(fabs(s-Y[i]) > most) most = fabs(s-Y[i]);
+  }
+  printf("  FDSP_FIR  %.3g, %d taps\n", most, TAPS);
+  check(most < 1e-5, "FDSP_FIR across calls");
+  FDSP_BiquadInit(&bq, BQCoef, BQState, 2);
+  for(i=k=0; k<6; k++){
+    FDSP_Biquad(&bq, &X[i], &Y[i], pieces[k]);
+    i = i+pieces[k];
+  }
+  most = 0;
+  s1[0] = s1[1] = s2[0] = s2[1] = 0;
+  for(i=0; i<N; i++){
+    u = X[i];
+    for(k=0; k<2; k++){
+      c = &BQCoef[5*k];
+      v = c[0]*u+s1[k];
+      s1[k] = c[1]*u-c[3]*v+s2[k];
+      s2[k] = c[2]*u-c[4]*v;
+      u = v;
+    }
+    if(fabs(u-Y[i]) > most) most = fabs(u-Y[i]);
+  }
+  printf("  FDSP_Biquad %.3g, 2 sections\n", most);
+  check(most < 1e-5, "FDSP_Biquad across calls");
+}
+
+//************benchmark*************
+#define CALLS 1000000
+float A[CALLS],B[CALLS];
+volatile float Sink;
+// y[i] = f(x[i]) with the C library, the way a program without
+// FloatDSP.c would write it
+void libSin(const float *x, float *y, uint32_t n){ uint32_t i; for(i=0; i<n; i++) y[i] = sinf(x[i]); }
+void libCos(const float *x, float *y, uint32_t n){ uint32_t i; for(i=0; i<n; i++) y[i] = cosf(x[i]); }
+void libExp(const float *x, float *y, uint32_t n){ uint32_t i; for(i=0; i<n; i++) y[i] = expf(x[i]); }
+void libLog(const float *x, float *y, uint32_t n){ uint32_t i; for(i=0; i<n; i++) y[i] = logf(x[i]); }
+double ns(fdsp_t fn){ double t0;
+  t0 = seconds();
+  fn(A, B, CALLS);
+  Sink = B[5];
+  return 1e9*(seconds()-t0)/CALLS;
+}
+float dotOneSum(const float *a, const float *b, uint32_t n){ uint32_t i; float sum;
+  sum = 0;
+  for(i=0; i<n; i++){
+    sum = sum+a[i]*b[i];
+  }
+  return sum;
+}
+void benchmark(void){ uint32_t i,k; double t0,t1,t2,f,l;
+  static const char *name[4] = {"sin", "cos", "exp", "log"};
+  static const fdsp_t fdsp[4] = {&FDSP_Sin, &FDSP_Cos, &FDSP_Exp, &FDSP_Log};
+  static const fdsp_t lib[4] = {&libSin, &libCos, &libExp, &libLog};
+  printf("benchmark, ns per element\n");
+  printf("  %4s %8s %8s\n", "", "FDSP", "libm");
+  for(i=0; i<4; i++){
+    for(k=0; k<CALLS; k++){
+      if(i < 3){
+        A[k] = (float)(rand()%20001-10000)/1000;   // -10 to 10
+      } else{
+        A[k] = (float)(rand()%100000+1)/1000;      // 0.001 to 100
+      }
+    }
+    f = ns(fdsp[i]);
+    l = ns(lib[i]);
+    printf("  %4s %8.2f %8.2f\n", name[i], f, l);
+  }
+  t0 = seconds();
+  Sink = FDSP_Dot(A, B, CALLS);
+  t1 = seconds();
+  Sink = dotOneSum(A, B, CALLS);
+  t2 = seconds();
+  printf("  FDSP_Dot %.3f, one sum %.3f\n", 1e9*(t1-t0)/CALLS, 1e9*(t2-t1)/CALLS);
+}
+
+int main(void){
+  functions();
+  kernels();
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
@@ -0,0 +1,96 @@
+; floatdsp.s
+; Runs on LM4F120/TM4C123
+; Hand written versions of FDSP_Dot and FDSP_Scale from FloatDSP.c.
+; VLDM loads four numbers with one instruction, and four sums keep
+; each VMLA from waiting on the one before it.
+; agent
+; October 17, 2026
+
+;  This example accompanies the book
+;   "Embedded Systems: Introduction to ARM Cortex M Microcontrollers"
+;   ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+;
+;Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+;   You may use, edit, run or distribute this file
+;   as long as the above copyright notice remains
+;THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+;OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+;MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+;VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+;OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+;For more information about my classes, my research, and my books, see
+;http://users.ece.utexas.edu/~valvano/
+
+
+        AREA    |.text|, CODE, READONLY, ALIGN=2
+        THUMB
+        EXPORT  FDSP_DotAsm
+        EXPORT  FDSP_ScaleAsm
+; FPU already initialized in this start.s
+; only S0-S15 are used, so nothing needs to be saved
+
+; Dot product, a[0]*b[0]+a[1]*b[1]+...+a[n-1]*b[n-1]
+; Input: R0 points to a, R1 points to b, R2 is n
+; Output: S0 is the dot product
+FDSP_DotAsm
+     MOV  R3,#0
+     VMOV S0,R3         ; four sums S0-S3 are 0
+     VMOV.F32 S1,S0
+     VMOV.F32 S2,S0
+     VMOV.F32 S3,S0
+     LSRS R3,R2,#2      ; number of groups of four
+     BEQ  dotOne
+dotFour
+     VLDM R0!,{S4-S7}   ; a[i] to a[i+3]
+     VLDM R1!,{S8-S11}  ; b[i] to b[i+3]
+     VMLA.F32 S0,S4,S8
+     VMLA.F32 S1,S5,S9
+     VMLA.F32 S2,S6,S10
+     VMLA.F32 S3,S7,S11
+     SUBS R3,R3,#1
+     BNE  dotFour
+dotOne
+     ANDS R2,R2,#3      ; 0 to 3 left
+     BEQ  dotDone
+dotLoop
+     VLDM R0!,{S4}
+     VLDM R1!,{S8}
+     VMLA.F32 S0,S4,S8
+     SUBS R2,R2,#1
+     BNE  dotLoop
+dotDone
+     VADD.F32 S0,S0,S1  ; (S0+S1)+(S2+S3), same order as FDSP_Dot
+     VADD.F32 S2,S2,S3
+     VADD.F32 S0,S0,S2
+     BX   LR
+
+; y[i] = k*x[i]
+; Input: R0 points to x, S0 is k, R1 points to y, R2 is n
+; Output: none
+FDSP_ScaleAsm
+     LSRS R3,R2,#2      ; number of groups of four
+     BEQ  scaleOne
+scaleFour
+     VLDM R0!,{S4-S7}
+     VMUL.F32 S4,S4,S0
+     VMUL.F32 S5,S5,S0
+     VMUL.F32 S6,S6,S0
+     VMUL.F32 S7,S7,S0
+     VSTM R1!,{S4-S7}
+     SUBS R3,R3,#1
+     BNE  scaleFour
+scaleOne
+     ANDS R2,R2,#3      ; 0 to 3 left
+     BEQ  scaleDone
+scaleLoop
+     VLDM R0!,{S4}
+     VMUL.F32 S4,S4,S0
+     VSTM R1!,{S4}
+     SUBS R2,R2,#1
+     BNE  scaleLoop
+scaleDone
+     BX   LR
+
+    ALIGN                           ; make sure the end of this section is aligned
+    END                             ; end of file
@@ -39,6 +39,7 @@
 #include <stdint.h>
 #include <math.h>
 #include "SysTick.h"
+#include "FloatDSP.h"
 float CircleArea(float r);
 float CalcSqrt(float in);
 typedef float testVar;
@@ -49,6 +50,106 @@ uint32_t Sum,Ave0,Ave1,Ave2,Ave3,Ave4,Ave5;
 volatile testVar Out;
 #define SIZE 20000
 //uint32_t TimeData[SIZE];
+
+// array kernels in FloatDSP.c, cycles per element for 256 elements
+// and the largest difference from the C version or from math.h
+#define N 256
+float X[N],Y[N],Y2[N],H[32],FIRState[64],BQState[4];
+const float BQCoef[10] = {  // two low pass sections
+  0.0675f, 0.1349f, 0.0675f, -1.1430f, 0.4128f,
+  0.0675f, 0.1349f, 0.0675f, -1.1430f, 0.4128f};
+uint32_t CyclesDot,CyclesDotAsm,CyclesScale,CyclesScaleAsm;
+uint32_t CyclesAdd,CyclesMulAdd,CyclesFIR,CyclesBiquad;
+uint32_t CyclesSin,CyclesCos,CyclesExp,CyclesLog,CyclesLibSin;
+float ErrDotAsm,ErrScaleAsm;     // should be 0, same operations
+float ErrSin,ErrCos,ErrExp,ErrLog;
+fdsp_fir_t FIR;
+fdsp_biquad_t BQ;
+// largest |y[i]-y2[i]|, relative to |y2[i]| if relative is 1
+float MaxError(const float *y, const float *y2, uint32_t relative){
+  uint32_t i; float err,max;
+  max = 0;
+  for(i=0; i<N; i++){
+    err = y[i]-y2[i];
+    if(err < 0) err = -err;
+    if(relative) err = err/y2[i];
+    if(err > max) max = err;
+  }
+  return max;
+}
+void DSPTest(void){ uint32_t i; float dot,dot2;
+  for(i=0; i<N; i++){
+    X[i] = (float)i/N - 0.5f;
+  }
+  for(i=0; i<32; i++){
+    H[i] = 1.0f/32;
+  }
+  SysTick_Start();
+  dot = FDSP_Dot(X, X, N);
+  CyclesDot = SysTick_Stop()/N;
+  SysTick_Start();
+  dot2 = FDSP_DotAsm(X, X, N);
+  CyclesDotAsm = SysTick_Stop()/N;
+  ErrDotAsm = dot2-dot;
+  SysTick_Start();
+  FDSP_Scale(X, 3.0f, Y, N);
+  CyclesScale = SysTick_Stop()/N;
+  SysTick_Start();
+  FDSP_ScaleAsm(X, 3.0f, Y2, N);
+  CyclesScaleAsm = SysTick_Stop()/N;
+  ErrScaleAsm = MaxError(Y2, Y, 0);
+  SysTick_Start();
+  FDSP_Add(X, Y, Y2, N);
+  CyclesAdd = SysTick_Stop()/N;
+  SysTick_Start();
+  FDSP_MulAdd(X, 0.5f, Y2, N);
+  CyclesMulAdd = SysTick_Stop()/N;
+  FDSP_FIRInit(&FIR, H, FIRState, 32);
+  SysTick_Start();
+  FDSP_FIR(&FIR, X, Y, N);      // 32 taps
+  CyclesFIR = SysTick_Stop()/N;
+  FDSP_BiquadInit(&BQ, BQCoef, BQState, 2);
+  SysTick_Start();
+  FDSP_Biquad(&BQ, X, Y, N);    // 2 sections
+  CyclesBiquad = SysTick_Stop()/N;
+  for(i=0; i<N; i++){
+    X[i] = 0.05f*i - 6.4f;      // -6.4 to +6.35
+  }
+  SysTick_Start();
+  FDSP_Sin(X, Y, N);
+  CyclesSin = SysTick_Stop()/N;
+  SysTick_Start();
+  for(i=0; i<N; i++){
+    Y2[i] = sin(X[i]);
+  }
+  CyclesLibSin = SysTick_Stop()/N;
+  ErrSin = MaxError(Y, Y2, 0);
+  SysTick_Start();
+  FDSP_Cos(X, Y, N);
+  CyclesCos = SysTick_Stop()/N;
+  for(i=0; i<N; i++){
+    Y2[i] = cos(X[i]);
+  }
+  ErrCos = MaxError(Y, Y2, 0);
+  SysTick_Start();
+  FDSP_Exp(X, Y, N);
+  CyclesExp = SysTick_Stop()/N;
+  for(i=0; i<N; i++){
+    Y2[i] = exp(X[i]);
+  }
+  ErrExp = MaxError(Y, Y2, 1);
+  for(i=0; i<N; i++){
+    X[i] = 0.1f*i + 0.05f;      // 0.05 to 25.55
+  }
+  SysTick_Start();
+  FDSP_Log(X, Y, N);
+  CyclesLog = SysTick_Stop()/N;
+  for(i=0; i<N; i++){
+    Y2[i] = log(X[i]);
+  }
+  ErrLog = MaxError(Y, Y2, 0);
+}
+
 int main(void){ uint32_t time,i;
 testVar input,output;
   SysTick_Init();
@@ -129,5 +230,6 @@ testVar input,output;
     Out = output;
   }
   Ave5 = Sum/SIZE;
+  DSPTest();
   while(1);
 }
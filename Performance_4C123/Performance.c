@@ -27,36 +27,16 @@
 // oscilloscope connected to PF2
 
 #include <stdint.h>
-#include <math.h>
 #include "../inc/tm4c123gh6pm.h"
 #include "PLL.h"
+#include "Profiler.h"
+#include "IntMath.h"
 #define PF1       (*((volatile uint32_t *)0x40025008))
 #define PF2       (*((volatile uint32_t *)0x40025010))
 #define PF3       (*((volatile uint32_t *)0x40025020))
 
-volatile uint32_t before, elapsed, ss, tt;
-uint32_t offset;
-// Newton's method (this one not tested, one in math.h is tested
-// s is an integer
-// sqrt(s) is an integer
-/*unsigned long sqrt(unsigned long s){
-unsigned long t;         // t*t will become s
-int n;                   // loop counter to make sure it stops running
-  t = s/16+1;            // initial guess 
-  for(n = 16; n; --n){   // guaranteed to finish
-    t = ((t*t+s)/t)/2;  
-  }
-  return t; 
-}*/
-
-// Initialize SysTick with busy wait running at bus clock.
-void SysTick_Init(void){
-  NVIC_ST_CTRL_R = 0;               // disable SysTick during setup
-  NVIC_ST_RELOAD_R = 0x00FFFFFF;    // maximum reload value
-  NVIC_ST_CURRENT_R = 0;            // any write to current clears it
-  NVIC_ST_CTRL_R = 0x05;            // enable SysTick with core clock
-  
-}
+volatile uint32_t elapsed, ss, tt;
+#define ZONE_SQRT 0               // Profiler zone for sqrt
 //test code
 int main(void){ 
   PLL_Init(Bus80MHz);              // bus clock at 80 MHz
@@ -70,22 +50,20 @@ int main(void){
   GPIO_PORTF_AMSEL_R = 0;          // disable analog functionality on PF
 
 
-  SysTick_Init(); // initialize SysTick timer, see SysTick.c
-  before = NVIC_ST_CURRENT_R;
-  // nothing
-  offset = (before-NVIC_ST_CURRENT_R)&0x00FFFFFF;
-    
+  Profiler_Init();   // initialize SysTick timer and measure the offset
+  Profiler_Name(ZONE_SQRT, "sqrt");
+
   ss = 100;
-  before = NVIC_ST_CURRENT_R;
-  tt = sqrt(ss);
-  elapsed = ((before-NVIC_ST_CURRENT_R)&0x00FFFFFF)-offset;
+  Profiler_Begin(ZONE_SQRT);
+  tt = IntMath_Sqrt(ss);
+  elapsed = Profiler_End(ZONE_SQRT);
   while(1){
     PF2 = 0x04;                 // turn on LED
-    tt = sqrt(ss);
+    tt = IntMath_Sqrt(ss);
     PF2 = 0x00;                 // turn off LED
     // anything can go here, after the LED goes off before the repeat
     // use the oscilloscope/logic analyzer to measure high pulse time
     // this can be easier to see if there is also some low pulse time
-    tt = sqrt(ss);
+    tt = IntMath_Sqrt(ss);
   }
 }
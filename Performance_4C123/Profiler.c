@@ -0,0 +1 @@
+../ProfileSort_4C123/Profiler.c
\ No newline at end of file
@@ -27,6 +27,7 @@
  */
 #include <stdint.h>
 #include "..//inc//tm4c123gh6pm.h"
+#include "Latency.h"
 
 
 
@@ -63,6 +64,8 @@ void Timer0A_Init(void(*task)(void), uint32_t period){long sr;
 }
 
 void Timer0A_Handler(void){
+  LATENCY_ENTER(LATENCY_TIMER0A, TIMER0_TAILR_R-TIMER0_TAV_R);
   TIMER0_ICR_R = TIMER_ICR_TATOCINT;// acknowledge timer0A timeout
   (*PeriodicTask)();                // execute user task
+  LATENCY_EXIT(LATENCY_TIMER0A);
 }
@@ -22,6 +22,7 @@
  */
 #include <stdint.h>
 #include "../inc/tm4c123gh6pm.h"
+#include "Latency.h"
 
 void (*PeriodicTask)(void);   // user function
 
@@ -48,6 +49,8 @@ void Timer1_Init(void(*task)(void), uint32_t period){
 }
 
 void Timer1A_Handler(void){
+  LATENCY_ENTER(LATENCY_TIMER1A, TIMER1_TAILR_R-TIMER1_TAV_R);
   TIMER1_ICR_R = TIMER_ICR_TATOCINT;// acknowledge TIMER1A timeout
   (*PeriodicTask)();                // execute user task
+  LATENCY_EXIT(LATENCY_TIMER1A);
 }
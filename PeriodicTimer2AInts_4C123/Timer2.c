@@ -22,6 +22,7 @@
  */
 #include <stdint.h>
 #include "../inc/tm4c123gh6pm.h"
+#include "Latency.h"
 
 void (*PeriodicTask)(void);   // user function
 
@@ -48,6 +49,8 @@ void Timer2_Init(void(*task)(void), unsigned long period){
 }
 
 void Timer2A_Handler(void){
+  LATENCY_ENTER(LATENCY_TIMER2A, TIMER2_TAILR_R-TIMER2_TAV_R);
   TIMER2_ICR_R = TIMER_ICR_TATOCINT;// acknowledge TIMER2A timeout
   (*PeriodicTask)();                // execute user task
+  LATENCY_EXIT(LATENCY_TIMER2A);
 }
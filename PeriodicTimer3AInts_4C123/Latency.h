@@ -0,0 +1 @@
+../Latency_4C123/Latency.h
\ No newline at end of file
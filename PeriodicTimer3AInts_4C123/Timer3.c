@@ -21,7 +21,9 @@
  http://users.ece.utexas.edu/~valvano/
  */
 
+#include <stdint.h>
 #include "../inc/tm4c123gh6pm.h"
+#include "Latency.h"
 
 void (*PeriodicTask)(void);   // user function
 
@@ -48,6 +50,8 @@ void Timer3_Init(void(*task)(void), unsigned long period){
 }
 
 void Timer3A_Handler(void){
+  LATENCY_ENTER(LATENCY_TIMER3A, TIMER3_TAILR_R-TIMER3_TAV_R);
   TIMER3_ICR_R = TIMER_ICR_TATOCINT;// acknowledge TIMER3A timeout
   (*PeriodicTask)();                // execute user task
+  LATENCY_EXIT(LATENCY_TIMER3A);
 }
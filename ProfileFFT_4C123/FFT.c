@@ -0,0 +1,280 @@
+// FFT.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Fixed-point radix-4 FFT for any power of two size up to FFT_MAXN.
+// The input is put in bit reversed order, then each radix-4 stage
+// combines four transforms of size M into one of size 4M.  In bit
+// reversed order the four blocks of size M hold the samples 4n, 4n+2,
+// 4n+1 and 4n+3, so the second and third blocks trade places in the
+// butterfly.  If log2(N) is odd a radix-2 stage is done first.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "FFT.h"
+
+#define QUARTER (FFT_MAXN/4)
+// largest component allowed before a stage, so the stage cannot overflow
+// a radix-4 butterfly grows a component at most 1+3*sqrt(2) = 5.25 times
+// a radix-2 butterfly, or the real FFT split, at most 1+sqrt(2) = 2.41 times
+#define LIMIT4 4096
+#define LIMIT2 8192
+
+// 32767*sin(2*pi*i/1024), i = 0 to 256, the first quarter of a sine wave
+// computed once on a PC, cos(a) = sin(pi/2-a) gives the cosine
+const int16_t Sine[QUARTER+1] = {
+  0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210, 2410, 2611, 2811, 3012,
+  3212, 3412, 3612, 3811, 4011, 4210, 4410, 4609, 4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195,
+  6393, 6590, 6786, 6983, 7179, 7375, 7571, 7767, 7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319,
+  9512, 9704, 9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+  12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828, 14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+  15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673, 16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+  18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+  20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856, 22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+  23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+  25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198, 26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+  27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001, 28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+  28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+  30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783, 30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+  31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736, 31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+  32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+  32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+  32767};
+
+// twiddle factor exp(-j*2*pi*i/FFT_MAXN) = c - j*s, i = 0 to FFT_MAXN-1
+static void twiddle(uint32_t i, int32_t *c, int32_t *s){ uint32_t r;
+  r = i%QUARTER;
+  switch(i/QUARTER){
+    case 0:  *c = Sine[QUARTER-r];  *s = Sine[r];          break;
+    case 1:  *c = -Sine[r];         *s = Sine[QUARTER-r];  break;
+    case 2:  *c = -Sine[QUARTER-r]; *s = -Sine[r];         break;
+    default: *c = Sine[r];          *s = -Sine[QUARTER-r]; break;
+  }
+}
+
+// Q15 multiply with rounding
+#define MULQ15(a,b) (((a)*(b)+0x4000)>>15)
+
+// shift every component right until all are below limit
+// returns the number of bits shifted
+static int32_t scale(Complex_t *data, uint32_t n, int32_t limit){
+  uint32_t i; int32_t max,shift;
+  max = 0;
+  for(i=0; i<n; i++){
+    if(data[i].real > max) max = data[i].real;
+    if(-data[i].real > max) max = -data[i].real;
+    if(data[i].imag > max) max = data[i].imag;
+    if(-data[i].imag > max) max = -data[i].imag;
+  }
+  shift = 0;
+  while((max>>shift) >= limit){
+    shift++;
+  }
+  if(shift){
+    for(i=0; i<n; i++){
+      data[i].real = data[i].real>>shift;
+      data[i].imag = data[i].imag>>shift;
+    }
+  }
+  return shift;
+}
+
+// put the data in bit reversed order
+static void reverse(Complex_t *data, uint32_t n){
+  uint32_t i,j,bit; Complex_t temp;
+  j = 0;
+  for(i=0; i<n-1; i++){
+    if(i < j){
+      temp = data[i]; data[i] = data[j]; data[j] = temp;
+    }
+    bit = n>>1;                // add 1 to j in reverse
+    while(j&bit){
+      j = j^bit;
+      bit = bit>>1;
+    }
+    j = j|bit;
+  }
+}
+
+//------------FFT_Complex------------
+// In place complex FFT, X[k] = sum x[n]*exp(-j*2*pi*n*k/N)
+// Input: data  N complex Q15 numbers, replaced with the spectrum
+//        n     N, a power of two from 2 to FFT_MAXN
+// Output: exponent, the spectrum is data[k]*2^exponent
+//         -1 if n is not a supported size
+int32_t FFT_Complex(Complex_t *data, uint32_t n){
+  uint32_t m,k,base,step; int32_t exponent;
+  int32_t ar,ai,br,bi,cr,ci,dr,di,c,s,tr,ti;
+  Complex_t *p0,*p1,*p2,*p3;
+  if((n < 2) || (n > FFT_MAXN) || (n&(n-1))){
+    return -1;
+  }
+  reverse(data, n);
+  exponent = 0;
+  m = 1;                       // size of the transforms being combined
+  k = n;
+  while(k > 1){                // count bits in n
+    k = k>>2;
+  }
+  if(k == 0){                  // log2(n) is odd, one radix-2 stage
+    exponent += scale(data, n, LIMIT2);
+    for(base=0; base<n; base+=2){
+      ar = data[base].real;   ai = data[base].imag;
+      br = data[base+1].real; bi = data[base+1].imag;
+      data[base].real = ar+br;   data[base].imag = ai+bi;
+      data[base+1].real = ar-br; data[base+1].imag = ai-bi;
+    }
+    m = 2;
+  }
+  while(m < n){                // radix-4 stages
+    exponent += scale(data, n, LIMIT4);
+    step = FFT_MAXN/(4*m);     // twiddle table step for size 4m
+    for(base=0; base<n; base+=4*m){
+      p0 = &data[base];  p1 = p0+m;  p2 = p1+m;  p3 = p2+m;
+      for(k=0; k<m; k++){
+        ar = p0[k].real; ai = p0[k].imag;
+        twiddle(2*k*step, &c, &s);        // b = W^2k * x[4n+2] part
+        br = MULQ15(p1[k].real,c) + MULQ15(p1[k].imag,s);
+        bi = MULQ15(p1[k].imag,c) - MULQ15(p1[k].real,s);
+        twiddle(k*step, &c, &s);          // c = W^k * x[4n+1] part
+        cr = MULQ15(p2[k].real,c) + MULQ15(p2[k].imag,s);
+        ci = MULQ15(p2[k].imag,c) - MULQ15(p2[k].real,s);
+        twiddle(3*k*step, &c, &s);        // d = W^3k * x[4n+3] part
+        dr = MULQ15(p3[k].real,c) + MULQ15(p3[k].imag,s);
+        di = MULQ15(p3[k].imag,c) - MULQ15(p3[k].real,s);
+        tr = ci-di;                       // -j*(c-d)
+        ti = dr-cr;
+        p0[k].real = ar+br+cr+dr;  p0[k].imag = ai+bi+ci+di;  // X[k]
+        p1[k].real = ar-br+tr;     p1[k].imag = ai-bi+ti;     // X[k+m]
+        p2[k].real = ar+br-cr-dr;  p2[k].imag = ai+bi-ci-di;  // X[k+2m]
+        p3[k].real = ar-br-tr;     p3[k].imag = ai-bi-ti;     // X[k+3m]
+      }
+    }
+    m = 4*m;
+  }
+  return exponent;
+}
+
+//------------FFT_Real------------
+// In place FFT of N real numbers using an N/2 point complex FFT.
+// Bins 1 to N/2-1 are returned in data[1] to data[N/2-1].  The two
+// bins that are always real are packed into data[0]:
+// data[0].real is bin 0 (DC) and data[0].imag is bin N/2 (Nyquist).
+// Bins above N/2 are the complex conjugates of the ones below.
+// Input: data  N real Q15 numbers viewed as N/2 complex numbers,
+//              data[i].real is x[2i] and data[i].imag is x[2i+1]
+//        n     N, a power of two from 4 to FFT_MAXN
+// Output: exponent, the spectrum is data[k]*2^exponent
+//         -1 if n is not a supported size
+int32_t FFT_Real(Complex_t *data, uint32_t n){
+  uint32_t half,k,step; int32_t exponent;
+  int32_t evr,evi,odr,odi,tr,ti,c,s,zr,zi;
+  if((n < 4) || (n > FFT_MAXN) || (n&(n-1))){
+    return -1;
+  }
+  half = n/2;
+  exponent = FFT_Complex(data, half); // Z[k] = E[k] + j*O[k]
+  exponent += scale(data, half, LIMIT2);
+  step = FFT_MAXN/n;
+  // E[k] = (Z[k]+conj(Z[N/2-k]))/2, O[k] = (Z[k]-conj(Z[N/2-k]))/2j
+  // X[k] = E[k] + W^k*O[k] and X[N/2-k] = conj(E[k] - W^k*O[k])
+  for(k=1; k<half/2; k++){
+    evr = (data[k].real + data[half-k].real)/2;
+    evi = (data[k].imag - data[half-k].imag)/2;
+    odr = (data[k].imag + data[half-k].imag)/2;
+    odi = (data[half-k].real - data[k].real)/2;
+    twiddle(k*step, &c, &s);
+    tr = MULQ15(odr,c) + MULQ15(odi,s);
+    ti = MULQ15(odi,c) - MULQ15(odr,s);
+    data[k].real = evr+tr;       data[k].imag = evi+ti;
+    data[half-k].real = evr-tr;  data[half-k].imag = ti-evi;
+  }
+  data[half/2].imag = -data[half/2].imag; // X[N/4] = conj(Z[N/4])
+  zr = data[0].real; zi = data[0].imag;
+  data[0].real = zr+zi;        // bin 0
+  data[0].imag = zr-zi;        // bin N/2
+  return exponent;
+}
+
+//------------FFT_SpectrumInit------------
+// Prepare to compute the spectrum of the most recent N samples
+// every hop samples.  hop less than N gives overlapped spectra.
+// Input: s        state for this spectrum
+//        history  array of N int16_t samples
+//        work     array of N/2 Complex_t
+//        n        N, a power of two from 4 to FFT_MAXN
+//        hop      1 to N
+// Output: 1 if successful, 0 if n or hop is not supported
+int FFT_SpectrumInit(fft_spectrum_t *s, int16_t *history, Complex_t *work,
+                     uint32_t n, uint32_t hop){
+  if((n < 4) || (n > FFT_MAXN) || (n&(n-1)) || (hop == 0) || (hop > n)){
+    return 0;
+  }
+  s->History = history;
+  s->Work = work;
+  s->N = n;
+  s->Hop = hop;
+  s->Put = 0;
+  s->Count = 0;
+  s->Filled = 0;
+  return 1;
+}
+
+//------------FFT_SpectrumPut------------
+// Add one sample, short enough to call from the ADC interrupt.
+// Once N samples have arrived, and every hop samples after that,
+// it reports that a new spectrum is due.
+// Input: s       state for this spectrum
+//        sample  next Q15 sample
+// Output: 1 if FFT_SpectrumCompute should be called, 0 if not
+int FFT_SpectrumPut(fft_spectrum_t *s, int16_t sample){
+  s->History[s->Put] = sample;
+  s->Put = (s->Put+1)&(s->N-1);
+  if(s->Filled < s->N){
+    s->Filled++;
+    if(s->Filled < s->N){
+      return 0;                // not a full window yet
+    }
+    s->Count = 0;
+    return 1;                  // first spectrum
+  }
+  s->Count++;
+  if(s->Count >= s->Hop){
+    s->Count = 0;
+    return 1;
+  }
+  return 0;
+}
+
+//------------FFT_SpectrumCompute------------
+// Copy the last N samples into work, oldest first, and compute
+// their FFT in place, packed as in FFT_Real.  Call from the
+// foreground after FFT_SpectrumPut returns 1.  The copy has to
+// finish before hop more samples arrive; the FFT does not.
+// Input: s  state for this spectrum
+// Output: exponent, the spectrum is work[k]*2^exponent
+int32_t FFT_SpectrumCompute(fft_spectrum_t *s){
+  uint32_t i,j;
+  j = s->Put;                  // oldest sample
+  for(i=0; i<s->N/2; i++){
+    s->Work[i].real = s->History[j];
+    j = (j+1)&(s->N-1);
+    s->Work[i].imag = s->History[j];
+    j = (j+1)&(s->N-1);
+  }
+  return FFT_Real(s->Work, s->N);
+}
@@ -0,0 +1,99 @@
+// FFT.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Fixed-point radix-4 FFT for any power of two size up to FFT_MAXN.
+// Data are Q15 complex numbers, two 16-bit signed numbers per entry,
+// the same layout used by cr4_fft_1024_stm32.  Block floating point:
+// before each stage the data are shifted right only as much as needed
+// to prevent overflow, and the total shift is returned, so
+// true result = returned result * 2^exponent.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __FFT_H__
+#define __FFT_H__
+
+#define FFT_MAXN 1024   // largest size, the twiddle table is built for it
+
+typedef struct{
+  int16_t real,imag;
+}Complex_t;
+
+//------------FFT_Complex------------
+// In place complex FFT, X[k] = sum x[n]*exp(-j*2*pi*n*k/N)
+// Input: data  N complex Q15 numbers, replaced with the spectrum
+//        n     N, a power of two from 2 to FFT_MAXN
+// Output: exponent, the spectrum is data[k]*2^exponent
+//         -1 if n is not a supported size
+int32_t FFT_Complex(Complex_t *data, uint32_t n);
+
+//------------FFT_Real------------
+// In place FFT of N real numbers using an N/2 point complex FFT.
+// Bins 1 to N/2-1 are returned in data[1] to data[N/2-1].  The two
+// bins that are always real are packed into data[0]:
+// data[0].real is bin 0 (DC) and data[0].imag is bin N/2 (Nyquist).
+// Bins above N/2 are the complex conjugates of the ones below.
+// Input: data  N real Q15 numbers viewed as N/2 complex numbers,
+//              data[i].real is x[2i] and data[i].imag is x[2i+1]
+//        n     N, a power of two from 4 to FFT_MAXN
+// Output: exponent, the spectrum is data[k]*2^exponent
+//         -1 if n is not a supported size
+int32_t FFT_Real(Complex_t *data, uint32_t n);
+
+// state of one streaming spectrum
+typedef struct fft_spectrum {
+  int16_t *History;       // last N samples, circular
+  Complex_t *Work;        // N/2 entries, holds the spectrum when ready
+  uint32_t N;             // FFT size
+  uint32_t Hop;           // samples between spectra
+  uint32_t Put;           // index in History for the next sample
+  uint32_t Count;         // samples since the last spectrum
+  uint32_t Filled;        // samples in History, up to N
+} fft_spectrum_t;
+
+//------------FFT_SpectrumInit------------
+// Prepare to compute the spectrum of the most recent N samples
+// every hop samples.  hop less than N gives overlapped spectra.
+// Input: s        state for this spectrum
+//        history  array of N int16_t samples
+//        work     array of N/2 Complex_t
+//        n        N, a power of two from 4 to FFT_MAXN
+//        hop      1 to N
+// Output: 1 if successful, 0 if n or hop is not supported
+int FFT_SpectrumInit(fft_spectrum_t *s, int16_t *history, Complex_t *work,
+                     uint32_t n, uint32_t hop);
+
+//------------FFT_SpectrumPut------------
+// Add one sample, short enough to call from the ADC interrupt.
+// Once N samples have arrived, and every hop samples after that,
+// it reports that a new spectrum is due.
+// Input: s       state for this spectrum
+//        sample  next Q15 sample
+// Output: 1 if FFT_SpectrumCompute should be called, 0 if not
+int FFT_SpectrumPut(fft_spectrum_t *s, int16_t sample);
+
+//------------FFT_SpectrumCompute------------
+// Copy the last N samples into work, oldest first, and compute
+// their FFT in place, packed as in FFT_Real.  Call from the
+// foreground after FFT_SpectrumPut returns 1.  The copy has to
+// finish before hop more samples arrive; the FFT does not.
+// Input: s  state for this spectrum
+// Output: exponent, the spectrum is work[k]*2^exponent
+int32_t FFT_SpectrumCompute(fft_spectrum_t *s);
+
+#endif //  __FFT_H__
@@ -0,0 +1,231 @@
+// FFTSim.c
+// Runs on a PC, not on the LaunchPad
+// Check the accuracy of FFT.c against a double precision DFT, and
+// time it.
+//   accuracy   random Q15 data, complex and real, every size from 2
+//              (4 for FFT_Real) to FFT_MAXN, reporting the signal to
+//              noise ratio of the result, signal being the double
+//              precision DFT and noise its difference from
+//              data*2^exponent; sizes that are not powers of two fail
+//   spectrum   a tone at bin 16 through a 256 point streaming spectrum
+//              with a hop of 64 samples, every spectrum must peak at 16
+//   benchmark  ns per FFT_Complex and FFT_Real at 64, 256 and 1024
+//              points, next to a textbook double precision radix-2
+//              FFT of the same size
+//   gcc -O2 FFTSim.c FFT.c -o FFTSim -lm
+//   ./FFTSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "FFT.h"
+
+#define MINSNR 50.0           // dB, about 2.5 dB is lost each time N doubles
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+//************accuracy*************
+Complex_t Data[FFT_MAXN];
+double Xr[FFT_MAXN],Xi[FFT_MAXN];  // input as doubles
+// power of the DFT bin k, and of its difference from (re,im)*2^exponent
+void compare(uint32_t n, uint32_t k, int16_t re, int16_t im, int32_t exponent,
+             double *signal, double *noise){ uint32_t t; double r,i,a;
+  r = i = 0;
+  for(t=0; t<n; t++){
+    a = -2*M_PI*(double)((t*k)%n)/n;
+    r = r+Xr[t]*cos(a)-Xi[t]*sin(a);
+    i = i+Xr[t]*sin(a)+Xi[t]*cos(a);
+  }
+  *signal = *signal+r*r+i*i;
+  r = r-ldexp(re, exponent);
+  i = i-ldexp(im, exponent);
+  *noise = *noise+r*r+i*i;
+}
+double snrComplex(uint32_t n){ uint32_t t,k; int32_t exponent;
+  double signal,noise;
+  for(t=0; t<n; t++){
+    Xr[t] = rand()%65536-32768;
+    Xi[t] = rand()%65536-32768;
+    Data[t].real = Xr[t];
+    Data[t].imag = Xi[t];
+  }
+  exponent = FFT_Complex(Data, n);
+  signal = noise = 0;
+  for(k=0; k<n; k++){
+    compare(n, k, Data[k].real, Data[k].imag, exponent, &signal, &noise);
+  }
+  return 10*log10(signal/noise);
+}
+double snrReal(uint32_t n){ uint32_t t,k; int32_t exponent;
+  double signal,noise;
+  for(t=0; t<n; t++){
+    Xr[t] = rand()%65536-32768;
+    Xi[t] = 0;
+  }
+  for(t=0; t<n/2; t++){
+    Data[t].real = Xr[2*t];
+    Data[t].imag = Xr[2*t+1];
+  }
+  exponent = FFT_Real(Data, n);
+  signal = noise = 0;
+  compare(n, 0, Data[0].real, 0, exponent, &signal, &noise);   // DC
+  compare(n, n/2, Data[0].imag, 0, exponent, &signal, &noise); // Nyquist
+  for(k=1; k<n/2; k++){
+    compare(n, k, Data[k].real, Data[k].imag, exponent, &signal, &noise);
+  }
+  return 10*log10(signal/noise);
+}
+void accuracy(void){ uint32_t n; double c,r;
+  printf("accuracy, SNR against a double precision DFT\n");
+  srand(11);
+  for(n=2; n<=FFT_MAXN; n=2*n){
+    c = snrComplex(n);
+    r = (n >= 4) ? snrReal(n) : 0;
+    printf("  %4u points  FFT_Complex %5.1f dB", n, c);
+    if(n >= 4){
+      printf("  FFT_Real %5.1f dB", r);
+    }
+    printf("\n");
+    check(c >= MINSNR, "FFT_Complex SNR");
+    check((n < 4)||(r >= MINSNR), "FFT_Real SNR");
+  }
+  check(FFT_Complex(Data, 48) == -1, "48 points not supported");
+  check(FFT_Complex(Data, 2*FFT_MAXN) == -1, "bigger than FFT_MAXN");
+  check(FFT_Real(Data, 2) == -1, "FFT_Real needs 4 points");
+}
+
+//************spectrum*************
+void spectrum(void){ static int16_t history[256]; static Complex_t work[128];
+  fft_spectrum_t s; uint32_t t,k,best,spectra,wrong; double m,most;
+  printf("spectrum, 256 points every 64 samples\n");
+  check(FFT_SpectrumInit(&s, history, work, 256, 64) == 1, "init");
+  spectra = wrong = 0;
+  for(t=0; t<1000; t++){
+    if(FFT_SpectrumPut(&s, (int16_t)(10000*sin(2*M_PI*16*t/256.0)))){
+      FFT_SpectrumCompute(&s);
+      spectra++;
+      best = 0;
+      most = 0;
+      for(k=1; k<128; k++){
+        m = hypot(work[k].real, work[k].imag);
+        if(m > most){
+          most = m;
+          best = k;
+        }
+      }
+      wrong = wrong+(best != 16);
+    }
+  }
+  printf("  %u spectra, %u with the peak in the wrong bin\n", spectra, wrong);
+  check(spectra == 1+(1000-256)/64, "one spectrum every hop after the first N");
+  check(wrong == 0, "peak at bin 16");
+  check(FFT_SpectrumInit(&s, history, work, 256, 257) == 0, "hop more than N");
+}
+
+//************benchmark*************
+double Fr[FFT_MAXN],Fi[FFT_MAXN];
+// in place radix-2 decimation in time, the way a textbook writes it
+void fftDouble(double *re, double *im, uint32_t n){ uint32_t i,j,k,len;
+  double t,wr,wi,ur,ui,vr,vi;
+  for(i=1,j=0; i<n; i++){     // bit reverse
+    k = n>>1;
+    while(j&k){
+      j = j^k;
+      k = k>>1;
+    }
+    j = j|k;
+    if(i < j){
+      t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+  for(len=2; len<=n; len=2*len){
+    for(i=0; i<n; i=i+len){
+      for(k=0; k<len/2; k++){
+        wr = cos(-2*M_PI*k/len);
+        wi = sin(-2*M_PI*k/len);
+        ur = re[i+k]; ui = im[i+k];
+        vr = re[i+k+len/2]*wr-im[i+k+len/2]*wi;
+        vi = re[i+k+len/2]*wi+im[i+k+len/2]*wr;
+        re[i+k] = ur+vr; im[i+k] = ui+vi;
+        re[i+k+len/2] = ur-vr; im[i+k+len/2] = ui-vi;
+      }
+    }
+  }
+}
+volatile int32_t Sink;
+void benchmark(void){ static const uint32_t size[3] = {64, 256, 1024};
+  uint32_t s,n,i,reps,r; double t0,t1,t2,t3;
+  printf("benchmark, ns per transform\n");
+  printf("  %6s %12s %10s %14s\n", "points", "FFT_Complex", "FFT_Real", "double radix-2");
+  for(s=0; s<3; s++){
+    n = size[s];
+    reps = 2000000/n;
+    for(i=0; i<n; i++){
+      Data[i].real = rand()%65536-32768;
+      Data[i].imag = rand()%65536-32768;
+    }
+    t0 = seconds();
+    for(r=0; r<reps; r++){
+      Sink = FFT_Complex(Data, n); // each result is the next input
+    }
+    t1 = seconds();
+    for(r=0; r<reps; r++){
+      Sink = FFT_Real(Data, n);
+    }
+    t2 = seconds();
+    for(r=0; r<reps; r++){
+      for(i=0; i<n; i++){
+        Fr[i] = Data[i].real;
+        Fi[i] = Data[i].imag;
+      }
+      fftDouble(Fr, Fi, n);
+      Sink = (int32_t)Fr[1];
+    }
+    t3 = seconds();
+    printf("  %6u %12.0f %10.0f %14.0f\n", n, 1e9*(t1-t0)/reps,
+           1e9*(t2-t1)/reps, 1e9*(t3-t2)/reps);
+  }
+}
+
+int main(void){
+  accuracy();
+  spectrum();
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
@@ -0,0 +1 @@
+../ProfileSqrt_4C123/IntMath.c
\ No newline at end of file
@@ -23,10 +23,10 @@
 // PF2 is an output for debugging
 #include <stdint.h>
 #include "../inc/tm4c123gh6pm.h"
+#include "Profiler.h"
+#include "FFT.h"
+#include "IntMath.h"
 
-typedef struct{
-  int16_t real,imag;
-}Complex_t;
 // data for FFT
 Complex_t x[1024],y[1024]; // input and output arrays for FFT
 // two 16-bit signed numbers are packed into each 32-bit entry
@@ -36,43 +36,25 @@ Complex_t x[1024],y[1024]; // input and output arrays for FFT
 //                         x[] bits15-0 contain the input signal
 // for the output,         y[] bits31-16 contain the imaginary part
 //                         y[] bits15-0 contain the real part
-int32_t mag[512];
+uint32_t mag[512];
 //*********Prototype for FFT in cr4_fft_1024_stm32.s, STMicroelectronics
 void cr4_fft_1024_stm32(Complex_t *pssOUT, Complex_t *pssIN, unsigned short Nbin);
 void cr4_fft_256_stm32(Complex_t *pssOUT, Complex_t *pssIN, unsigned short Nbin);
 void cr4_fft_64_stm32(Complex_t *pssOUT, Complex_t *pssIN, unsigned short Nbin);
 
 
-#define NVIC_ST_CTRL_COUNT      0x00010000  // Count flag
-#define NVIC_ST_CTRL_CLK_SRC    0x00000004  // Clock Source
-#define NVIC_ST_CTRL_INTEN      0x00000002  // Interrupt enable
-#define NVIC_ST_CTRL_ENABLE     0x00000001  // Counter mode
-#define NVIC_ST_RELOAD_M        0x00FFFFFF  // Counter load value
 #define PF2   (*((volatile uint32_t *)0x40025010))
 #define Debug_Set()   (PF2 = 0x04)
 #define Debug_Clear() (PF2 = 0x00)
 
-// Initialize SysTick with busy wait running at bus clock.
-void SysTick_Init(void){
-  NVIC_ST_CTRL_R = 0;                   // disable SysTick during setup
-  NVIC_ST_RELOAD_R = NVIC_ST_RELOAD_M;  // maximum reload value
-  NVIC_ST_CURRENT_R = 0;                // any write to current clears it
-                                        // enable SysTick with core clock
-  NVIC_ST_CTRL_R = NVIC_ST_CTRL_ENABLE+NVIC_ST_CTRL_CLK_SRC;
-}
-// Newton's method
-// s is an integer
-// Sqrt(s) is an integer
-uint32_t Sqrt(uint32_t s){
-uint32_t t;   // t*t will become s
-int n;             // loop counter
-  t = s/16+1;      // initial guess
-  for(n = 20; n; --n){ // will finish
-    t = ((t*t+s)/t)/2;
-  }
-  return t;
-}
-uint32_t before,elapsed64,elapsed256,elapsed1024;
+#define ZONE_FFT64   0      // Profiler zones
+#define ZONE_FFT256  1
+#define ZONE_FFT1024 2
+#define ZONE_Q15FFT1024  3
+#define ZONE_REALFFT1024 4
+
+uint32_t elapsed64,elapsed256,elapsed1024,elapsedQ15,elapsedReal;
+int32_t exponent;
 // 1024 + 1024*sin(2*pi*2*t); (2 waves per 1024 samples)
 const int16_t sinewave[1024] = {
   1024, 1037, 1049, 1062, 1074, 1087, 1099, 1112, 1124, 1137, 1149, 1162, 1174, 1187, 1199, 1211,
@@ -141,9 +123,14 @@ const int16_t sinewave[1024] = {
   824, 837, 849, 861, 874, 886, 899, 911, 924, 936, 949, 961, 974, 986, 999, 1011};
 
 int main(void){
-  int32_t t,k, real, imag;
+  int32_t t;
   SYSCTL_RCGCGPIO_R |= 0x20; // activate Port F
-  SysTick_Init();            // initialize SysTick timer, Program 4.7
+  Profiler_Init();           // initialize SysTick timer and measure offset
+  Profiler_Name(ZONE_FFT64, "fft64");
+  Profiler_Name(ZONE_FFT256, "fft256");
+  Profiler_Name(ZONE_FFT1024, "fft1024");
+  Profiler_Name(ZONE_Q15FFT1024, "FFT_Complex1024");
+  Profiler_Name(ZONE_REALFFT1024, "FFT_Real1024");
   GPIO_PORTF_DIR_R |= 0x04;  // make PF2 out (built-in blue LED)
   GPIO_PORTF_AFSEL_R &= ~0x04;// disable alt funct on PF2
   GPIO_PORTF_DEN_R |= 0x04;  // enable digital I/O on PF2
@@ -156,10 +143,10 @@ int main(void){
     x[t].imag = 0;           // imaginary part is zero
     x[t].real = sinewave[t*16]; // fill real part with data
   }
-  before = NVIC_ST_CURRENT_R;
+  Profiler_Begin(ZONE_FFT64);
   cr4_fft_64_stm32(y, x, 64);   // complex FFT of 64 values
-  elapsed64 = (before - NVIC_ST_CURRENT_R - 6)&0x00FFFFFF;
-  // the number 6 depends on the instructions before and after test
+  elapsed64 = Profiler_End(ZONE_FFT64);
+  // Profiler_Init measured the cost of Begin/End, so
   // if you remove the call to FFT, elapsed measures 0
 //*********************************************************
 
@@ -168,10 +155,10 @@ int main(void){
     x[t].imag = 0;           // imaginary part is zero
     x[t].real = sinewave[t*4]; // fill real part with data
   }
-  before = NVIC_ST_CURRENT_R;
+  Profiler_Begin(ZONE_FFT256);
   cr4_fft_256_stm32(y, x, 256);   // complex FFT of 256 values
-  elapsed256 = (before - NVIC_ST_CURRENT_R - 4)&0x00FFFFFF;
-  // the number 4 depends on the instructions before and after test
+  elapsed256 = Profiler_End(ZONE_FFT256);
+  // Profiler_Init measured the cost of Begin/End, so
   // if you remove the call to FFT, elapsed measures 0
 //*********************************************************
 
@@ -180,13 +167,30 @@ int main(void){
     x[t].imag = 0;           // imaginary part is zero
     x[t].real = sinewave[t]; // fill real part with data
   }
-  before = NVIC_ST_CURRENT_R;
+  Profiler_Begin(ZONE_FFT1024);
   cr4_fft_1024_stm32(y, x, 1024);   // complex FFT of 1024 values
-  elapsed1024 = (before - NVIC_ST_CURRENT_R - 4)&0x00FFFFFF;
-  // the number 4 depends on the instructions before and after test
+  elapsed1024 = Profiler_End(ZONE_FFT1024);
+  // Profiler_Init measured the cost of Begin/End, so
   // if you remove the call to FFT, elapsed measures 0
 //*********************************************************
 
+// ****************1024 element test, FFT.c****************
+  for(t=0; t<1024; t=t+1){   // t means 1/fs
+    y[t].imag = 0;           // imaginary part is zero
+    y[t].real = sinewave[t]; // fill real part with data
+  }
+  Profiler_Begin(ZONE_Q15FFT1024);
+  exponent = FFT_Complex(y, 1024); // in place, spectrum is y*2^exponent
+  elapsedQ15 = Profiler_End(ZONE_Q15FFT1024);
+  for(t=0; t<512; t=t+1){    // same 1024 real samples, packed in pairs
+    y[t].real = sinewave[2*t];
+    y[t].imag = sinewave[2*t+1];
+  }
+  Profiler_Begin(ZONE_REALFFT1024);
+  exponent = FFT_Real(y, 1024);   // bins 0 to 512 in y[0] to y[511]
+  elapsedReal = Profiler_End(ZONE_REALFFT1024);
+//*********************************************************
+
 
   while(1){
     for(t=0; t<1024; t=t+1){   // simulated ADC samples
@@ -196,11 +200,7 @@ int main(void){
     Debug_Set();                    // PF2=1
     cr4_fft_1024_stm32(y, x, 1024); // complex FFT of last 1024 ADC values
     Debug_Clear();                  // PF2=0
-    for(k=0; k<512; k=k+1){         // k means fs/1024
-      real = y[k].real;             // bottom 16 bits
-      imag = y[k].imag;             // top 16 bits
-      mag[k] = Sqrt(real*real+imag*imag);
-    }
+    IntMath_MagArray(&y[0].real, mag, 512); // mag[k] at k*fs/1024
   }
   /*
   while(1){
@@ -211,11 +211,7 @@ int main(void){
     Debug_Set();                    // PF2=1
     cr4_fft_64_stm32(y, x, 64); // complex FFT of last 64 ADC values
     Debug_Clear();                  // PF2=0
-    for(k=0; k<32; k=k+1){         // k means fs/64
-      real = y[k].real;             // bottom 16 bits
-      imag = y[k].imag;             // top 16 bits
-      mag[k] = Sqrt(real*real+imag*imag);
-    }
+    IntMath_MagArray(&y[0].real, mag, 32); // mag[k] at k*fs/64
   }
   while(1){
     for(t=0; t<256; t=t+1){   // simulated ADC samples
@@ -225,11 +221,7 @@ int main(void){
     Debug_Set();                    // PF2=1
     cr4_fft_256_stm32(y, x, 256); // complex FFT of last 256 ADC values
     Debug_Clear();                  // PF2=0
-    for(k=0; k<128; k=k+1){         // k means fs/256
-      real = y[k].real;             // bottom 16 bits
-      imag = y[k].imag;             // top 16 bits
-      mag[k] = Sqrt(real*real+imag*imag);
-    }
+    IntMath_MagArray(&y[0].real, mag, 128); // mag[k] at k*fs/256
   }
   */
 }
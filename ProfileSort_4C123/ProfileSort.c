@@ -23,42 +23,19 @@
 // PF2 is an output for debugging
 #include <stdint.h>
 #include "../inc/tm4c123gh6pm.h"
+#include "Profiler.h"
 
 #define NONE 0
 #define SWDUMP 1
 #define HWPORT 2
 #define DEBUGTYPE SWDUMP
 
-#define NVIC_ST_CTRL_COUNT      0x00010000  // Count flag
-#define NVIC_ST_CTRL_CLK_SRC    0x00000004  // Clock Source
-#define NVIC_ST_CTRL_INTEN      0x00000002  // Interrupt enable
-#define NVIC_ST_CTRL_ENABLE     0x00000001  // Counter mode
-#define NVIC_ST_RELOAD_M        0x00FFFFFF  // Counter load value
 #define PF2   (*((volatile uint32_t *)0x40025010))
 #define Debug_Set()   (PF2 = 0x04)
 #define Debug_Clear() (PF2 = 0x00)
 
-// Initialize SysTick with busy wait running at bus clock.
-void SysTick_Init(void){
-  NVIC_ST_CTRL_R = 0;                   // disable SysTick during setup
-  NVIC_ST_RELOAD_R = NVIC_ST_RELOAD_M;  // maximum reload value
-  NVIC_ST_CURRENT_R = 0;                // any write to current clears it
-                                        // enable SysTick with core clock
-  NVIC_ST_CTRL_R = NVIC_ST_CTRL_ENABLE+NVIC_ST_CTRL_CLK_SRC;
-}
-#if (DEBUGTYPE == SWDUMP)
-#define DEBUG_LENGTH 100
-uint32_t Debug_time[DEBUG_LENGTH];
-uint8_t Debug_place[DEBUG_LENGTH];
-uint32_t n;
-void Debug_Profile(uint8_t p){
-  if(n < DEBUG_LENGTH){
-    Debug_time[n] = NVIC_ST_CURRENT_R; // record current time
-    Debug_place[n] = p;
-    n++;
-  }
-}
-#endif
+#define ZONE_SORT 0         // Profiler zone for the whole sort
+
 #if (DEBUGTYPE == HWPORT)
 #define PROFILE (*((volatile uint32_t *)0x4000703C))
 #endif
@@ -76,7 +53,7 @@ void sort_insertion(uint32_t *input, uint32_t *output, uint32_t length){
   int i, j;
   output[0] = input[0];
 #if (DEBUGTYPE == SWDUMP)
-  Debug_Profile(0);
+  Profiler_Mark(0);
 #endif
 #if (DEBUGTYPE == HWPORT)
   PROFILE = 1;
@@ -84,7 +61,7 @@ void sort_insertion(uint32_t *input, uint32_t *output, uint32_t length){
   for(j=1; j<length; j=j+1){
     output[j] = input[j];
 #if (DEBUGTYPE == SWDUMP)
-    Debug_Profile(1);
+    Profiler_Mark(1);
 #endif
 #if (DEBUGTYPE == HWPORT)
     PROFILE = 2;
@@ -94,7 +71,7 @@ void sort_insertion(uint32_t *input, uint32_t *output, uint32_t length){
         // an entry is smaller than the one before it
         // swap them, causing it to sink toward the beginning
 #if (DEBUGTYPE == SWDUMP)
-        Debug_Profile(2);
+        Profiler_Mark(2);
 #endif
 #if (DEBUGTYPE == HWPORT)
         PROFILE = 4;
@@ -106,8 +83,8 @@ void sort_insertion(uint32_t *input, uint32_t *output, uint32_t length){
         // an entry is greater or equal to the one before it
         // it will be greater or equal to all before it
 #if (DEBUGTYPE == SWDUMP)
-        Debug_Profile(3);
-        // NOTE: The Debug_place array may skip 3 and go from 2
+        Profiler_Mark(3);
+        // NOTE: The Profiler log may skip 3 and go from 2
         // to 1 in the case where index 'i' counts to 0 and the
         // latest entry sinks to the beginning of the list.  In
         // other words, an entry is smaller than all of the
@@ -118,7 +95,7 @@ void sort_insertion(uint32_t *input, uint32_t *output, uint32_t length){
         // where,
         // N is the number of records sorted ('length')
         // A is the number of times 'i' decreases to 0 (number of 2's immediately followed by 1's without a 3 in between)
-        // B is the number of moves (number of 2's in Debug_place)
+        // B is the number of moves (number of 2's in the Profiler log)
 #endif
 #if (DEBUGTYPE == HWPORT)
         PROFILE = 8;
@@ -132,7 +109,7 @@ void sort_insertion(uint32_t *input, uint32_t *output, uint32_t length){
 #endif
 }
 
-uint32_t before,elapsed;
+uint32_t elapsed;
 // Numerical keys associated with data from "The Art of Computer Programming", Donald E. Knuth, Volume 3 Sorting and Searching, Second Edition, 1998, page 77.
 uint32_t keys[16] = {503, 87, 512, 61, 908, 170, 897, 275, 653, 426, 154, 509, 612, 677, 765, 703};
 uint32_t sorted[16];       // sorted array
@@ -140,9 +117,11 @@ uint32_t sorted[16];       // sorted array
 int main(void){
 #if (DEBUGTYPE == SWDUMP)
   volatile int KnuthN, KnuthA, KnuthB, KnuthRunTime, i;
+  uint8_t place, nextPlace;
 #endif
   SYSCTL_RCGCGPIO_R |= 0x20; // activate Port F
-  SysTick_Init();            // initialize SysTick timer, Program 4.7
+  Profiler_Init();           // initialize SysTick timer and measure offset
+  Profiler_Name(ZONE_SORT, "sort_insertion");
   GPIO_PORTF_DIR_R |= 0x04;  // make PF2 out (built-in blue LED)
   GPIO_PORTF_AFSEL_R &= ~0x04;// disable alt funct on PF2
   GPIO_PORTF_DEN_R |= 0x04;  // enable digital I/O on PF2
@@ -162,25 +141,25 @@ int main(void){
 #endif
 
 // ****************insertion sort************************
-  before = NVIC_ST_CURRENT_R;
+  Profiler_Begin(ZONE_SORT);
   sort_insertion(keys, sorted, 16); // insertion sort into array 'sorted'
-  elapsed = (before - NVIC_ST_CURRENT_R - 7)&0x00FFFFFF;
-  // the number 7 depends on the instructions before and after test
+  elapsed = Profiler_End(ZONE_SORT);
+  // Profiler_Init measured the cost of Begin/End, so
   // if you remove the call to sort, elapsed measures 0
 #if (DEBUGTYPE == SWDUMP)
   KnuthN = 16;               // number of items to be sorted
   KnuthA = 0;                // number of moves
   KnuthB = 0;                // number of changes in the left-to-right minimum
-  i = 1;
-  while((i < DEBUG_LENGTH) && (Debug_place[i] != 0)){
-    if(Debug_place[i] == 2){
+  i = 1;                     // entry 0 is the start of the sort
+  while(Profiler_LogGet(i, &place, 0)){
+    if(place == 2){
       KnuthB = KnuthB + 1;
-      if(Debug_place[i+1] == 1){ // possible array out-of-bounds error if DEBUG_LENGTH is too small
+      if(Profiler_LogGet(i+1, &nextPlace, 0) && (nextPlace == 1)){
         KnuthA = KnuthA + 1;
       }
     }
     i = i + 1;
-  }
+  }                          // valid if Profiler_Overflows() is 0
   KnuthRunTime = 9*KnuthB + 10*KnuthN - 3*KnuthA - 9; // expect 514 for his data
 #endif
 // *********************************************************
@@ -0,0 +1,353 @@
+// Profiler.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Measure execution time of named zones of code.
+// Profiler_Begin pushes the zone and the time on a small stack,
+// Profiler_End pops it, so zones may be nested.  The time of an
+// empty Begin/End pair is measured once in Profiler_Init and
+// subtracted, instead of the "- 7" each program used to hard code.
+// Profiler_Mark is Debug_Profile from ProfileSort.c, except the
+// array is a ring buffer that keeps the most recent entries.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "Profiler.h"
+
+#if (PROFILER_BACKEND == PROFILER_SYSTICK) && !defined(PROFILERSIM)
+#define NVIC_ST_CTRL_R          (*((volatile uint32_t *)0xE000E010))
+#define NVIC_ST_RELOAD_R        (*((volatile uint32_t *)0xE000E014))
+#define NVIC_ST_CURRENT_R       (*((volatile uint32_t *)0xE000E018))
+#endif
+#if PROFILER_BACKEND == PROFILER_SYSTICK   // ProfilerSim.c simulates the registers on a PC
+#define NVIC_ST_CTRL_CLK_SRC    0x00000004  // Clock Source
+#define NVIC_ST_CTRL_ENABLE     0x00000001  // Counter mode
+#define NVIC_ST_RELOAD_M        0x00FFFFFF  // Counter load value
+#endif
+#if PROFILER_BACKEND == PROFILER_DWT
+#define NVIC_DBG_DEMCR_R        (*((volatile uint32_t *)0xE000EDFC))
+#define DWT_CTRL_R              (*((volatile uint32_t *)0xE0001000))
+#define DWT_CYCCNT_R            (*((volatile uint32_t *)0xE0001004))
+#define NVIC_DBG_DEMCR_TRCENA   0x01000000  // enable DWT and ITM
+#define DWT_CTRL_CYCCNTENA      0x00000001  // enable cycle counter
+#endif
+#if PROFILER_BACKEND == PROFILER_HOST
+#if defined(PROFILER_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+#endif
+
+#define CALIBRATIONS 8          // empty Begin/End pairs measured by Init
+
+// static, so the names do not clash with the program being profiled
+static const char *Name[PROFILER_ZONES];
+static uint32_t Count[PROFILER_ZONES];
+static uint32_t Min[PROFILER_ZONES];
+static uint32_t Max[PROFILER_ZONES];
+static uint32_t Last[PROFILER_ZONES];
+static uint64_t Total[PROFILER_ZONES];
+static uint32_t Hist[PROFILER_ZONES][PROFILER_BINS];
+static uint32_t Offset;         // cost of an empty Begin/End pair
+
+static uint8_t StackZone[PROFILER_DEPTH];
+static uint32_t StackStart[PROFILER_DEPTH];
+static uint32_t Depth;          // number of zones begun and not ended
+
+static uint32_t Log_time[PROFILER_LOG];
+static uint8_t Log_place[PROFILER_LOG];
+static uint32_t LogPut;         // index of the next entry to write
+static uint32_t LogSize;        // number of valid entries
+static uint32_t LogLost;        // entries overwritten
+
+//------------Profiler_Now------------
+// Read the time base.  The value counts up and wraps, after
+// RELOAD for SysTick and after 0xFFFFFFFF for the others, so use
+// Profiler_Since to find the time from one reading to now.
+// Input: none
+// Output: current time
+uint32_t Profiler_Now(void){
+#if PROFILER_BACKEND == PROFILER_SYSTICK
+  return NVIC_ST_RELOAD_R - NVIC_ST_CURRENT_R; // SysTick counts down
+#elif PROFILER_BACKEND == PROFILER_DWT
+  return DWT_CYCCNT_R;
+#elif defined(PROFILER_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+  return (uint32_t)__rdtsc();
+#else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint32_t)t.tv_sec*1000000000 + (uint32_t)t.tv_nsec;
+#endif
+}
+
+// time from start to now, modulo the period of the time base
+// SysTick goes from RELOAD to 0, and RELOAD is whatever the owner of
+// SysTick chose, e.g. 79999 for a 1 ms OS tick, not always 0x00FFFFFF
+static uint32_t elapsed(uint32_t start, uint32_t now){
+#if PROFILER_BACKEND == PROFILER_SYSTICK
+  if(now < start){
+    return now + (NVIC_ST_RELOAD_R+1) - start; // wrapped once
+  }
+#endif
+  return now - start;          // 32-bit counters wrap by themselves
+}
+
+//------------Profiler_Since------------
+// Time from an earlier Profiler_Now to now, correct across one wrap.
+// Input: start  value returned by Profiler_Now
+// Output: elapsed time
+uint32_t Profiler_Since(uint32_t start){
+  return elapsed(start, Profiler_Now());
+}
+
+// clear the statistics and the log
+static void clear(void){ uint32_t z,b;
+  for(z=0; z<PROFILER_ZONES; z++){
+    Count[z] = 0;
+    Min[z] = 0xFFFFFFFF;
+    Max[z] = 0;
+    Last[z] = 0;
+    Total[z] = 0;
+    for(b=0; b<PROFILER_BINS; b++){
+      Hist[z][b] = 0;
+    }
+  }
+  Depth = 0;
+  LogPut = 0;
+  LogSize = 0;
+  LogLost = 0;
+}
+
+//------------Profiler_Init------------
+// Start the time base, clear every zone and the mark log, and
+// measure the cost of an empty Begin/End pair.  That offset is
+// subtracted from every measurement, so an empty zone measures 0.
+// With the SysTick time base, SysTick is set to count down from
+// 0x00FFFFFF unless it is already running (for example as an OS tick).
+// A running SysTick keeps its reload value, and times are taken
+// modulo RELOAD+1, so a zone must be shorter than one SysTick period.
+// Input: none
+// Output: none
+void Profiler_Init(void){ uint32_t i,z,best;
+#if PROFILER_BACKEND == PROFILER_SYSTICK
+  if((NVIC_ST_CTRL_R&NVIC_ST_CTRL_ENABLE) == 0){
+    NVIC_ST_RELOAD_R = NVIC_ST_RELOAD_M;  // maximum reload value
+    NVIC_ST_CURRENT_R = 0;                // any write to current clears it
+                                          // enable SysTick with core clock
+    NVIC_ST_CTRL_R = NVIC_ST_CTRL_ENABLE+NVIC_ST_CTRL_CLK_SRC;
+  }
+#endif
+#if PROFILER_BACKEND == PROFILER_DWT
+  NVIC_DBG_DEMCR_R |= NVIC_DBG_DEMCR_TRCENA;
+  DWT_CYCCNT_R = 0;
+  DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;
+#endif
+  for(z=0; z<PROFILER_ZONES; z++){
+    Name[z] = 0;
+  }
+  clear();
+  Offset = 0;
+  best = 0xFFFFFFFF;
+  for(i=0; i<CALIBRATIONS; i++){
+    Profiler_Begin(0);
+    if(Profiler_End(0) < best){
+      best = Last[0];          // an interrupt can only make it longer
+    }
+  }
+  Offset = best;
+  clear();
+}
+
+//------------Profiler_Name------------
+// Give a zone a name for Profiler_Report.
+// Input: zone  0 to PROFILER_ZONES-1
+//        name  string that stays valid, not copied
+// Output: none
+void Profiler_Name(uint32_t zone, const char *name){
+  if(zone < PROFILER_ZONES){
+    Name[zone] = name;
+  }
+}
+
+//------------Profiler_Begin------------
+// Start timing a zone.  Zones may be nested up to PROFILER_DEPTH deep.
+// Input: zone  0 to PROFILER_ZONES-1
+// Output: none
+void Profiler_Begin(uint32_t zone){
+  if(Depth < PROFILER_DEPTH){
+    StackZone[Depth] = zone;
+    Depth++;
+    StackStart[Depth-1] = Profiler_Now(); // last, so the set up is not timed
+  }
+}
+
+//------------Profiler_End------------
+// Stop timing the innermost zone and add its time to the statistics.
+// The time of a zone includes the time of the zones nested in it.
+// Input: zone  must match the most recent unmatched Profiler_Begin
+// Output: elapsed time, 0 if zone does not match
+uint32_t Profiler_End(uint32_t zone){ uint32_t now,time,bin;
+  now = Profiler_Now();        // first, so the book keeping is not timed
+  if((Depth == 0) || (StackZone[Depth-1] != zone) || (zone >= PROFILER_ZONES)){
+    return 0;                  // Begin and End do not match
+  }
+  Depth--;
+  time = elapsed(StackStart[Depth], now);
+  if(time > Offset){
+    time = time - Offset;
+  } else{
+    time = 0;
+  }
+  Count[zone]++;
+  Total[zone] += time;
+  Last[zone] = time;
+  if(time < Min[zone]) Min[zone] = time;
+  if(time > Max[zone]) Max[zone] = time;
+  bin = 0;                     // number of bits needed to hold time
+  while((bin < PROFILER_BINS-1) && (time>>bin)){
+    bin++;
+  }
+  Hist[zone][bin]++;
+  return time;
+}
+
+//------------Profiler_Stats------------
+// Report the statistics of one zone.
+// Input: zone  0 to PROFILER_ZONES-1
+// Output: statistics for that zone
+profiler_stats_t Profiler_Stats(uint32_t zone){ profiler_stats_t stats; uint32_t b;
+  stats.name = Name[zone];
+  stats.count = Count[zone];
+  stats.min = Count[zone] ? Min[zone] : 0;
+  stats.max = Max[zone];
+  stats.mean = Count[zone] ? (uint32_t)(Total[zone]/Count[zone]) : 0;
+  stats.last = Last[zone];
+  for(b=0; b<PROFILER_BINS; b++){
+    stats.hist[b] = Hist[zone][b];
+  }
+  return stats;
+}
+
+//------------Profiler_Mark------------
+// Record a place number and the time in the log.  When the log is
+// full the oldest entry is overwritten.  Not reentrant: if an
+// interrupt service routine also marks, disable interrupts around it.
+// Input: place  number that identifies the place in the program
+// Output: none
+void Profiler_Mark(uint8_t place){
+  Log_time[LogPut] = Profiler_Now(); // record current time
+  Log_place[LogPut] = place;
+  LogPut++;
+  if(LogPut == PROFILER_LOG){
+    LogPut = 0;
+  }
+  if(LogSize < PROFILER_LOG){
+    LogSize++;
+  } else{
+    LogLost++;                 // oldest entry was overwritten
+  }
+}
+
+//------------Profiler_LogSize------------
+// Input: none
+// Output: number of entries in the log, at most PROFILER_LOG
+uint32_t Profiler_LogSize(void){
+  return LogSize;
+}
+
+//------------Profiler_LogGet------------
+// Read one entry from the log, oldest first.
+// Input: i      0 is the oldest entry
+//        place  where the place number is returned
+//        time   where the time is returned, may be 0
+// Output: 1 if successful, 0 if i is past the end of the log
+int Profiler_LogGet(uint32_t i, uint8_t *place, uint32_t *time){
+  if(i >= LogSize){
+    return 0;
+  }
+  i = (LogPut + PROFILER_LOG - LogSize + i)%PROFILER_LOG;
+  *place = Log_place[i];
+  if(time){
+    *time = Log_time[i];
+  }
+  return 1;
+}
+
+//------------Profiler_Overflows------------
+// Input: none
+// Output: number of log entries lost because the log was full
+uint32_t Profiler_Overflows(void){
+  return LogLost;
+}
+
+// convert an unsigned number to decimal, followed by a space
+// returns pointer to the next free character
+static char *udec(char *pt, uint32_t n){ char digits[10]; int i;
+  i = 0;
+  do{
+    digits[i] = '0' + n%10;
+    n = n/10;
+    i++;
+  }while(n);
+  while(i){
+    i--;
+    *pt = digits[i];
+    pt++;
+  }
+  *pt = ' ';
+  return pt+1;
+}
+
+//------------Profiler_Report------------
+// Output one line per zone that has been used: name, count, min,
+// max, mean, followed by a line with the nonzero histogram bins.
+// Input: outString  function that outputs a string, e.g. UART_OutString
+// Output: none
+void Profiler_Report(void (*outString)(char *)){
+  char line[16+4*11+3]; char *pt; const char *name;
+  uint32_t z,b; profiler_stats_t stats;
+  for(z=0; z<PROFILER_ZONES; z++){
+    stats = Profiler_Stats(z);
+    if(stats.count == 0) continue;
+    pt = line;
+    name = stats.name ? stats.name : "zone";
+    while(*name && (pt < &line[15])){
+      *pt = *name;
+      pt++; name++;
+    }
+    *pt = ' '; pt++;
+    pt = udec(pt, stats.count);
+    pt = udec(pt, stats.min);
+    pt = udec(pt, stats.max);
+    pt = udec(pt, stats.mean);
+    pt[0] = '\r'; pt[1] = '\n'; pt[2] = 0;
+    outString(line);
+    for(b=0; b<PROFILER_BINS; b++){
+      if(stats.hist[b]){       // bin b holds times below 2^b
+        pt = line;
+        pt[0] = '2'; pt[1] = '^'; pt = pt+2;
+        pt = udec(pt, b);
+        pt[-1] = ':';          // "2^b:count "
+        pt = udec(pt, stats.hist[b]);
+        *pt = 0;
+        outString(line);
+      }
+    }
+    outString("\r\n");
+  }
+}
@@ -0,0 +1,145 @@
+// Profiler.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Measure execution time of named zones of code.
+// Each zone keeps the minimum, maximum, mean and a histogram of its
+// elapsed times.  Zones may be nested.  Profiler_Mark records a place
+// number and a time stamp in a ring buffer, like Debug_Profile used to.
+// Three time bases are available:
+//   PROFILER_SYSTICK  24-bit SysTick at the core clock, wraps every RELOAD+1 cycles
+//   PROFILER_DWT      32-bit DWT cycle counter, Cortex M3/M4 only
+//   PROFILER_HOST     nanoseconds from clock_gettime (or rdtsc) on a PC
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#define PROFILER_SYSTICK 0
+#define PROFILER_DWT     1
+#define PROFILER_HOST    2
+#ifndef PROFILER_BACKEND
+#if defined(__ARMCC_VERSION) || defined(__TI_COMPILER_VERSION__) || defined(__arm__)
+#define PROFILER_BACKEND PROFILER_SYSTICK
+#else
+#define PROFILER_BACKEND PROFILER_HOST
+#endif
+#endif
+
+#define PROFILER_ZONES 8    // number of named zones
+#define PROFILER_DEPTH 8    // deepest nesting of Begin/End
+#define PROFILER_BINS  25   // histogram bin b counts times from 2^(b-1) to 2^b-1
+#define PROFILER_LOG   100  // number of Profiler_Mark entries kept
+
+// statistics for one zone, times are in cycles (ns on the host)
+typedef struct profiler_stats {
+  const char *name;       // set by Profiler_Name, 0 if never named
+  uint32_t count;         // number of Begin/End pairs
+  uint32_t min;           // shortest time
+  uint32_t max;           // longest time
+  uint32_t mean;          // average time
+  uint32_t last;          // most recent time
+  uint32_t hist[PROFILER_BINS];
+} profiler_stats_t;
+
+//------------Profiler_Init------------
+// Start the time base, clear every zone and the mark log, and
+// measure the cost of an empty Begin/End pair.  That offset is
+// subtracted from every measurement, so an empty zone measures 0.
+// With the SysTick time base, SysTick is set to count down from
+// 0x00FFFFFF unless it is already running (for example as an OS tick).
+// A running SysTick keeps its reload value, and times are taken
+// modulo RELOAD+1, so a zone must be shorter than one SysTick period.
+// Input: none
+// Output: none
+void Profiler_Init(void);
+
+//------------Profiler_Now------------
+// Read the time base.  The value counts up and wraps, after
+// RELOAD for SysTick and after 0xFFFFFFFF for the others, so use
+// Profiler_Since to find the time from one reading to now.
+// Input: none
+// Output: current time
+uint32_t Profiler_Now(void);
+
+//------------Profiler_Since------------
+// Time from an earlier Profiler_Now to now, correct across one wrap.
+// Input: start  value returned by Profiler_Now
+// Output: elapsed time
+uint32_t Profiler_Since(uint32_t start);
+
+//------------Profiler_Name------------
+// Give a zone a name for Profiler_Report.
+// Input: zone  0 to PROFILER_ZONES-1
+//        name  string that stays valid, not copied
+// Output: none
+void Profiler_Name(uint32_t zone, const char *name);
+
+//------------Profiler_Begin------------
+// Start timing a zone.  Zones may be nested up to PROFILER_DEPTH deep.
+// Input: zone  0 to PROFILER_ZONES-1
+// Output: none
+void Profiler_Begin(uint32_t zone);
+
+//------------Profiler_End------------
+// Stop timing the innermost zone and add its time to the statistics.
+// The time of a zone includes the time of the zones nested in it.
+// Input: zone  must match the most recent unmatched Profiler_Begin
+// Output: elapsed time, 0 if zone does not match
+uint32_t Profiler_End(uint32_t zone);
+
+//------------Profiler_Stats------------
+// Report the statistics of one zone.
+// Input: zone  0 to PROFILER_ZONES-1
+// Output: statistics for that zone
+profiler_stats_t Profiler_Stats(uint32_t zone);
+
+//------------Profiler_Mark------------
+// Record a place number and the time in the log.  When the log is
+// full the oldest entry is overwritten.  Not reentrant: if an
+// interrupt service routine also marks, disable interrupts around it.
+// Input: place  number that identifies the place in the program
+// Output: none
+void Profiler_Mark(uint8_t place);
+
+//------------Profiler_LogSize------------
+// Input: none
+// Output: number of entries in the log, at most PROFILER_LOG
+uint32_t Profiler_LogSize(void);
+
+//------------Profiler_LogGet------------
+// Read one entry from the log, oldest first.
+// Input: i      0 is the oldest entry
+//        place  where the place number is returned
+//        time   where the time is returned, may be 0
+// Output: 1 if successful, 0 if i is past the end of the log
+int Profiler_LogGet(uint32_t i, uint8_t *place, uint32_t *time);
+
+//------------Profiler_Overflows------------
+// Input: none
+// Output: number of log entries lost because the log was full
+uint32_t Profiler_Overflows(void);
+
+//------------Profiler_Report------------
+// Output one line per zone that has been used: name, count, min,
+// max, mean, followed by a line with the nonzero histogram bins.
+// Input: outString  function that outputs a string, e.g. UART_OutString
+// Output: none
+void Profiler_Report(void (*outString)(char *));
+
+#endif //  __PROFILER_H__
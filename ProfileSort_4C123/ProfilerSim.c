@@ -0,0 +1,200 @@
+// ProfilerSim.c
+// Runs on a PC, not on the LaunchPad
+// Run Profiler.c with the SysTick time base on a PC.  Profiler.c is
+// included here with PROFILERSIM defined, so the SysTick registers
+// are variables and the bus clock is a counter.  Each access to a
+// SysTick register takes one bus cycle, and a zone takes exactly the
+// cycles the test gives it, so every time can be checked exactly.
+//   free      SysTick not running, Profiler_Init starts it from
+//             0x00FFFFFF, zones placed across the wrap
+//   os tick   SysTick already running as a 1 ms OS tick at 80 MHz
+//             (RELOAD 79999) before Profiler_Init, which must leave
+//             it alone, zones of 1 to 79000 cycles started at every
+//             place in the period
+//   zones     nesting, statistics, histogram and the mark log
+//   gcc ProfilerSim.c -o ProfilerSim
+//   ./ProfilerSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+
+// the simulated SysTick
+uint64_t SimNow;              // bus cycles since reset
+uint32_t SimCtrl;             // NVIC_ST_CTRL_R
+uint32_t SimReload;           // NVIC_ST_RELOAD_R
+uint32_t SimCurrent;          // NVIC_ST_CURRENT_R
+uint32_t SimWraps;            // times SysTick loaded RELOAD
+uint32_t *SimReg(uint32_t *reg);
+
+// Profiler.c uses these instead of the LaunchPad registers
+#define PROFILERSIM
+#define PROFILER_BACKEND PROFILER_SYSTICK
+#define NVIC_ST_CTRL_R          (*SimReg(&SimCtrl))
+#define NVIC_ST_RELOAD_R        (*SimReg(&SimReload))
+#define NVIC_ST_CURRENT_R       (*SimReg(&SimCurrent))
+#include "Profiler.c"
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+
+// n bus cycles go by
+void elapse(uint64_t n){
+  SimNow = SimNow + n;
+  if((SimCtrl&NVIC_ST_CTRL_ENABLE) == 0){
+    return;
+  }
+  while(n){
+    if(SimCurrent == 0){      // loads RELOAD on the next cycle
+      SimCurrent = SimReload;
+      SimWraps++;
+      n--;
+    } else if(n >= SimCurrent){
+      n = n-SimCurrent;
+      SimCurrent = 0;
+    } else{
+      SimCurrent = SimCurrent-n;
+      n = 0;
+    }
+  }
+}
+uint32_t *SimReg(uint32_t *reg){
+  elapse(1);                  // the access takes a bus cycle
+  return reg;
+}
+
+// time a zone that takes exactly cycles, return what Profiler_End says
+uint32_t zone(uint32_t cycles){
+  Profiler_Begin(1);
+  elapse(cycles);
+  return Profiler_End(1);
+}
+
+//************free*************
+void testFree(void){ uint32_t i,d,bad,wrapped,wraps;
+  printf("free, SysTick started by Profiler_Init\n");
+  SimNow = 0;
+  SimCtrl = SimReload = SimCurrent = 0;
+  Profiler_Init();
+  check(SimReload == 0x00FFFFFF, "reload set to the maximum");
+  check((SimCtrl&NVIC_ST_CTRL_ENABLE) != 0, "SysTick enabled");
+  printf("  offset %u cycles\n", Offset);
+  bad = wrapped = 0;
+  for(i=0; i<1000; i++){
+    d = 1+i*997;
+    elapse((SimCurrent+0x01000000-d/2)%0x01000000); // 0 in the middle
+    wraps = SimWraps;
+    bad = bad+(zone(d) != d);
+    wrapped = wrapped+(SimWraps != wraps);
+  }
+  printf("  1000 zones, %u crossed 0, %u wrong\n", wrapped, bad);
+  check(bad == 0, "zones across the wrap");
+}
+
+//************os tick*************
+#define OSRELOAD 79999        // 1 ms at 80 MHz
+void testOSTick(void){ static const uint32_t d[4] = {1, 100, 5000, 79000};
+  uint32_t phase,i,bad,wrapped,zones,wraps;
+  printf("os tick, RELOAD %u set before Profiler_Init\n", OSRELOAD);
+  SimNow = 0;
+  SimCtrl = 7;                // enabled with interrupts, like OS_Launch
+  SimReload = OSRELOAD;
+  SimCurrent = 0;
+  elapse(12345);
+  Profiler_Init();
+  check(SimReload == OSRELOAD, "reload left alone");
+  check(SimCtrl == 7, "control left alone");
+  bad = wrapped = zones = 0;
+  for(phase=0; phase<=OSRELOAD; phase=phase+101){
+    for(i=0; i<4; i++){
+      elapse(phase);
+      wraps = SimWraps;
+      bad = bad+(zone(d[i]) != d[i]);
+      wrapped = wrapped+(SimWraps != wraps);
+      zones++;
+    }
+  }
+  printf("  %u zones, %u crossed a reload, %u wrong\n", zones, wrapped, bad);
+  printf("  masking with 0x00FFFFFF would add %u cycles to each one that crossed\n",
+         0x01000000-(OSRELOAD+1));
+  check(wrapped > 0, "some zones cross the reload");
+  check(bad == 0, "zones taken modulo RELOAD+1");
+}
+
+//************zones*************
+char Report[2000];
+void out(char *s){ char *pt;
+  pt = Report;
+  while(*pt) pt++;
+  while((*s)&&(pt < &Report[sizeof(Report)-1])){
+    *pt = *s;
+    pt++; s++;
+  }
+  *pt = 0;
+}
+void testZones(void){ profiler_stats_t s; uint32_t i,time; uint8_t place;
+  printf("zones\n");
+  SimNow = 0;
+  SimCtrl = SimReload = SimCurrent = 0;
+  Profiler_Init();
+  Profiler_Name(2, "outer");
+  Profiler_Name(3, "inner");
+  for(i=1; i<=10; i++){
+    Profiler_Begin(2);
+    elapse(1000);
+    Profiler_Begin(3);
+    elapse(100*i);
+    check(Profiler_End(3) == 100*i, "inner zone");
+    Profiler_End(2);
+  }
+  check(Profiler_End(2) == 0, "End without Begin returns 0");
+  s = Profiler_Stats(3);
+  check((s.count == 10)&&(s.min == 100)&&(s.max == 1000)&&(s.mean == 550), "inner statistics");
+  check((s.hist[7] == 1)&&(s.hist[8] == 1)&&(s.hist[9] == 3)&&(s.hist[10] == 5), "inner histogram");
+  s = Profiler_Stats(2);
+  check((s.count == 10)&&(s.min > 1100)&&(s.max > 2000), "outer includes inner");
+  for(i=0; i<PROFILER_LOG+50; i++){
+    Profiler_Mark(i);
+  }
+  check(Profiler_LogSize() == PROFILER_LOG, "log full");
+  check(Profiler_Overflows() == 50, "oldest 50 lost");
+  check(Profiler_LogGet(0, &place, &time)&&(place == 50), "oldest entry");
+  check(Profiler_LogGet(PROFILER_LOG-1, &place, 0)&&(place == PROFILER_LOG+49), "newest entry");
+  check(Profiler_LogGet(PROFILER_LOG, &place, 0) == 0, "past the end");
+  Profiler_Report(&out);
+  printf("%s", Report);
+}
+
+int main(void){
+  testFree();
+  testOSTick();
+  testZones();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
@@ -0,0 +1,283 @@
+// Sort.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Sort arrays of 32-bit unsigned numbers in place, and find medians.
+// Quicksort partitions around the median of the first, middle and
+// last elements.  Those three also act as sentinels, so the inner
+// scans need no bounds checks.  The larger piece is handled by the
+// loop and the smaller by recursion, so the stack depth is at most
+// log2(n).  After 2*log2(n) levels the piece is heapsorted instead.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "Sort.h"
+
+#if SORT_STATS
+uint32_t Compares,Moves;
+#define LESS(a,b) (Compares++, (a) < (b))
+#define MOVED(m)  (Moves += (m))
+#else
+#define LESS(a,b) ((a) < (b))
+#define MOVED(m)
+#endif
+#define SWAP(a,b) {uint32_t t_ = (a); (a) = (b); (b) = t_; MOVED(2);}
+
+//------------Sort_Insertion------------
+// Straight insertion sort, Knuth Volume 3, pages 80-82.
+// Fast for small or nearly sorted arrays, n*n/4 moves on average.
+// Input: data  array of n numbers, sorted in place
+//        n     number of elements
+// Output: none
+void Sort_Insertion(uint32_t *data, uint32_t n){
+  uint32_t i,j,key;
+  for(j=1; j<n; j++){
+    key = data[j];
+    i = j;
+    while((i > 0) && LESS(key, data[i-1])){
+      data[i] = data[i-1];     // larger one moves up
+      MOVED(1);
+      i--;
+    }
+    if(i != j){
+      data[i] = key;
+      MOVED(1);
+    }
+  }
+}
+
+// move data[root] down the heap until both children are smaller
+static void siftDown(uint32_t *data, uint32_t root, uint32_t n){
+  uint32_t child;
+  while((child = 2*root+1) < n){
+    if((child+1 < n) && LESS(data[child], data[child+1])){
+      child++;                 // larger child
+    }
+    if(!LESS(data[root], data[child])){
+      return;
+    }
+    SWAP(data[root], data[child]);
+    root = child;
+  }
+}
+
+static void heapSort(uint32_t *data, uint32_t n){
+  uint32_t i;
+  for(i=n/2; i>0; i--){        // build a heap, largest on top
+    siftDown(data, i-1, n);
+  }
+  for(i=n-1; i>0; i--){        // move the top to the end
+    SWAP(data[0], data[i]);
+    siftDown(data, 0, i);
+  }
+}
+
+// partition an array of at least 3 elements
+// returns p, 0<p<n, with data[0..p-1] <= pivot <= data[p..n-1]
+static uint32_t partition(uint32_t *data, uint32_t n){
+  uint32_t i,j,mid,pivot;
+  mid = n/2;                   // sort first, middle, last
+  if(LESS(data[mid], data[0])) SWAP(data[mid], data[0]);
+  if(LESS(data[n-1], data[mid])){
+    SWAP(data[n-1], data[mid]);
+    if(LESS(data[mid], data[0])) SWAP(data[mid], data[0]);
+  }
+  pivot = data[mid];
+  i = 0;                       // data[0] <= pivot stops the j scan
+  j = n-1;                     // data[n-1] >= pivot stops the i scan
+  while(1){
+    do{ i++; }while(LESS(data[i], pivot));
+    do{ j--; }while(LESS(pivot, data[j]));
+    if(i >= j){
+      return i;
+    }
+    SWAP(data[i], data[j]);
+  }
+}
+
+// introsort, depth is the number of partitions allowed before heapsort
+static void intro(uint32_t *data, uint32_t n, uint32_t depth){
+  uint32_t p;
+  while(n > SORT_SMALL){
+    if(depth == 0){
+      heapSort(data, n);       // partitions have been unbalanced
+      return;
+    }
+    depth--;
+    p = partition(data, n);
+    if(p < n-p){               // recursion on the smaller piece
+      intro(data, p, depth);
+      data = data+p;
+      n = n-p;
+    } else{
+      intro(data+p, n-p, depth);
+      n = p;
+    }
+  }
+  Sort_Insertion(data, n);
+}
+
+// 2*log2(n)
+static uint32_t depthLimit(uint32_t n){
+  uint32_t depth;
+  depth = 0;
+  while(n > 1){
+    n = n>>1;
+    depth = depth+2;
+  }
+  return depth;
+}
+
+//------------Sort_Intro------------
+// Introsort: quicksort with median of three pivots and insertion sort
+// for small pieces.  If the partitions become unbalanced it switches
+// to heapsort, so the worst case is n*log(n).  Not stable.
+// Input: data  array of n numbers, sorted in place
+//        n     number of elements
+// Output: none
+void Sort_Intro(uint32_t *data, uint32_t n){
+  intro(data, n, depthLimit(n));
+}
+
+//------------Sort------------
+// Sort an array into increasing order, choosing the method by size.
+// An array that is already sorted is detected in one pass.
+// Input: data  array of n numbers, sorted in place
+//        n     number of elements
+// Output: none
+void Sort(uint32_t *data, uint32_t n){
+  uint32_t i;
+  if(n <= SORT_SMALL){
+    Sort_Insertion(data, n);   // already sorted costs n-1 compares
+    return;
+  }
+  for(i=1; i<n; i++){
+    if(LESS(data[i], data[i-1])) break;
+  }
+  if(i < n){                   // not sorted yet
+    intro(data, n, depthLimit(n));
+  }
+}
+
+//------------Sort_Radix------------
+// Least significant digit radix sort, 8 bits per pass.  A pass where
+// every key has the same digit is skipped.  Stable.
+// Input: data  array of n numbers, sorted in place
+//        temp  array of n numbers used as work space
+//        n     number of elements
+//        bits  16 if every key is below 65536, otherwise 32
+// Output: none
+void Sort_Radix(uint32_t *data, uint32_t *temp, uint32_t n, uint32_t bits){
+  uint32_t count[256];
+  uint32_t i,shift,digit,sum,c;
+  uint32_t *src,*dst,*swap;
+  if(n < 2){
+    return;
+  }
+  src = data;
+  dst = temp;
+  for(shift=0; shift<bits; shift+=8){
+    for(i=0; i<256; i++){
+      count[i] = 0;
+    }
+    for(i=0; i<n; i++){
+      count[(src[i]>>shift)&0xFF]++;
+    }
+    if(count[(src[0]>>shift)&0xFF] == n){
+      continue;                // every key has this digit, nothing moves
+    }
+    sum = 0;                   // count[d] becomes where digit d goes
+    for(i=0; i<256; i++){
+      c = count[i];
+      count[i] = sum;
+      sum = sum+c;
+    }
+    for(i=0; i<n; i++){
+      digit = (src[i]>>shift)&0xFF;
+      dst[count[digit]] = src[i];
+      count[digit]++;
+    }
+    MOVED(n);
+    swap = src; src = dst; dst = swap;
+  }
+  if(src != data){             // odd number of passes
+    for(i=0; i<n; i++){
+      data[i] = src[i];
+    }
+    MOVED(n);
+  }
+}
+
+//------------Sort_Select------------
+// Rearrange the array so data[k] is the value it would have if the
+// array were sorted, with smaller or equal values before it and
+// larger or equal values after it (nth_element).  Average time is
+// proportional to n.
+// Input: data  array of n numbers, rearranged in place
+//        n     number of elements
+//        k     0 to n-1
+// Output: data[k]
+uint32_t Sort_Select(uint32_t *data, uint32_t n, uint32_t k){
+  uint32_t *pt,p,depth;
+  pt = data;                   // piece that holds element k
+  depth = depthLimit(n);
+  while(n > SORT_SMALL){
+    if(depth == 0){
+      heapSort(pt, n);         // partitions have been unbalanced
+      return pt[k];
+    }
+    depth--;
+    p = partition(pt, n);
+    if(k < p){                 // only the piece with k is kept
+      n = p;
+    } else{
+      pt = pt+p;
+      n = n-p;
+      k = k-p;
+    }
+  }
+  Sort_Insertion(pt, n);
+  return pt[k];
+}
+
+//------------Sort_Median------------
+// Median of an array, for a median filter.  The array is rearranged.
+// Input: data  array of n numbers, n at least 1
+//        n     number of elements
+// Output: the upper median, data[n/2] of the sorted array
+uint32_t Sort_Median(uint32_t *data, uint32_t n){
+  return Sort_Select(data, n, n/2);
+}
+
+#if SORT_STATS
+//------------Sort_StatsClear------------
+// Input: none
+// Output: none
+void Sort_StatsClear(void){
+  Compares = 0;
+  Moves = 0;
+}
+
+//------------Sort_Stats------------
+// Input: none
+// Output: compares and moves since the last Sort_StatsClear
+sort_stats_t Sort_Stats(void){ sort_stats_t stats;
+  stats.compares = Compares;
+  stats.moves = Moves;
+  return stats;
+}
+#endif
@@ -0,0 +1,106 @@
+// Sort.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Sort arrays of 32-bit unsigned numbers in place, and find medians.
+// Sort picks the method from the size of the array:
+//   insertion sort for small arrays, Knuth's Algorithm S,
+//   introsort (quicksort that falls back to heapsort) otherwise.
+// Sort_Radix is faster for large arrays but needs a second array.
+// Set SORT_STATS to 1 to count compares and moves, like the
+// Knuth A and B counts in ProfileSort.c.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __SORT_H__
+#define __SORT_H__
+
+#define SORT_STATS 0      // 1 to count compares and moves
+#define SORT_SMALL 16     // arrays this size or smaller use insertion sort
+
+//------------Sort------------
+// Sort an array into increasing order, choosing the method by size.
+// An array that is already sorted is detected in one pass.
+// Input: data  array of n numbers, sorted in place
+//        n     number of elements
+// Output: none
+void Sort(uint32_t *data, uint32_t n);
+
+//------------Sort_Insertion------------
+// Straight insertion sort, Knuth Volume 3, pages 80-82.
+// Fast for small or nearly sorted arrays, n*n/4 moves on average.
+// Input: data  array of n numbers, sorted in place
+//        n     number of elements
+// Output: none
+void Sort_Insertion(uint32_t *data, uint32_t n);
+
+//------------Sort_Intro------------
+// Introsort: quicksort with median of three pivots and insertion sort
+// for small pieces.  If the partitions become unbalanced it switches
+// to heapsort, so the worst case is n*log(n).  Not stable.
+// Input: data  array of n numbers, sorted in place
+//        n     number of elements
+// Output: none
+void Sort_Intro(uint32_t *data, uint32_t n);
+
+//------------Sort_Radix------------
+// Least significant digit radix sort, 8 bits per pass.  A pass where
+// every key has the same digit is skipped.  Stable.
+// Input: data  array of n numbers, sorted in place
+//        temp  array of n numbers used as work space
+//        n     number of elements
+//        bits  16 if every key is below 65536, otherwise 32
+// Output: none
+void Sort_Radix(uint32_t *data, uint32_t *temp, uint32_t n, uint32_t bits);
+
+//------------Sort_Select------------
+// Rearrange the array so data[k] is the value it would have if the
+// array were sorted, with smaller or equal values before it and
+// larger or equal values after it (nth_element).  Average time is
+// proportional to n.
+// Input: data  array of n numbers, rearranged in place
+//        n     number of elements
+//        k     0 to n-1
+// Output: data[k]
+uint32_t Sort_Select(uint32_t *data, uint32_t n, uint32_t k);
+
+//------------Sort_Median------------
+// Median of an array, for a median filter.  The array is rearranged.
+// Input: data  array of n numbers, n at least 1
+//        n     number of elements
+// Output: the upper median, data[n/2] of the sorted array
+uint32_t Sort_Median(uint32_t *data, uint32_t n);
+
+#if SORT_STATS
+// statistics since the last Sort_StatsClear
+typedef struct sort_stats {
+  uint32_t compares;      // comparisons between two elements
+  uint32_t moves;         // elements written to the arrays
+} sort_stats_t;
+
+//------------Sort_StatsClear------------
+// Input: none
+// Output: none
+void Sort_StatsClear(void);
+
+//------------Sort_Stats------------
+// Input: none
+// Output: compares and moves since the last Sort_StatsClear
+sort_stats_t Sort_Stats(void);
+#endif
+
+#endif //  __SORT_H__
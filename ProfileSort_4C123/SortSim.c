@@ -0,0 +1,174 @@
+// SortSim.c
+// Runs on a PC, not on the LaunchPad
+// Check Sort.c against the C library qsort, then time it.
+//   test       20,000 arrays of 0 to 4100 numbers in six
+//              distributions through Sort, Sort_Insertion (up to 300
+//              numbers), Sort_Intro and Sort_Radix, each compared with
+//              qsort, and Sort_Select and Sort_Median checked against
+//              the sorted array
+//   benchmark  ns per element for each method on 16 to 4096 numbers
+//              that are random, already sorted, reversed, organ pipe
+//              (up then down) and only four different values
+// Sort_Insertion is only timed up to 1024 numbers, it takes n*n/4
+// moves.
+//   gcc -O2 SortSim.c Sort.c -o SortSim
+//   ./SortSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Sort.h"
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+int compare(const void *a, const void *b){ uint32_t x,y;
+  x = *(const uint32_t *)a;
+  y = *(const uint32_t *)b;
+  return (x < y) ? -1 : (x > y);
+}
+
+#define MAXN 4100
+uint32_t In[MAXN],Sorted[MAXN],Data[MAXN],Temp[MAXN];
+#define DISTRIBUTIONS 6
+const char *Name[DISTRIBUTIONS] = {"random", "sorted", "reversed",
+  "organ pipe", "4 values", "16-bit"};
+void make(uint32_t n, int d){ uint32_t i;
+  for(i=0; i<n; i++){
+    switch(d){
+      case 0: In[i] = ((uint32_t)rand()<<16)^rand(); break;
+      case 1: In[i] = i; break;
+      case 2: In[i] = n-i; break;
+      case 3: In[i] = (i < n/2) ? i : n-i; break;
+      case 4: In[i] = rand()%4; break;
+      default: In[i] = rand()&0xFFFF;
+    }
+  }
+}
+
+//************test*************
+void test(void){ uint32_t i,n,k,v,bad,tries; int d;
+  printf("test, against qsort\n");
+  srand(13);
+  bad = 0;
+  for(tries=0; tries<20000; tries++){
+    n = rand()%MAXN;
+    d = rand()%DISTRIBUTIONS;
+    make(n, d);
+    memcpy(Sorted, In, 4*n);
+    qsort(Sorted, n, 4, &compare);
+    memcpy(Data, In, 4*n);
+    Sort(Data, n);
+    bad = bad+(memcmp(Data, Sorted, 4*n) != 0);
+    memcpy(Data, In, 4*n);
+    Sort_Intro(Data, n);
+    bad = bad+(memcmp(Data, Sorted, 4*n) != 0);
+    memcpy(Data, In, 4*n);
+    Sort_Radix(Data, Temp, n, ((d == 4)||(d == 5)) ? 16 : 32);
+    bad = bad+(memcmp(Data, Sorted, 4*n) != 0);
+    if(n <= 300){
+      memcpy(Data, In, 4*n);
+      Sort_Insertion(Data, n);
+      bad = bad+(memcmp(Data, Sorted, 4*n) != 0);
+    }
+    if(n){
+      k = rand()%n;
+      memcpy(Data, In, 4*n);
+      v = Sort_Select(Data, n, k);
+      bad = bad+(v != Sorted[k])+(Data[k] != v);
+      for(i=0; i<n; i++){
+        if(((i < k)&&(Data[i] > v))||((i > k)&&(Data[i] < v))){
+          bad++;              // not partitioned around data[k]
+          break;
+        }
+      }
+      memcpy(Data, In, 4*n);
+      bad = bad+(Sort_Median(Data, n) != Sorted[n/2]);
+    }
+  }
+  printf("  %u wrong\n", bad);
+  check(bad == 0, "same as qsort");
+}
+
+//************benchmark*************
+#define WORK 4000000          // elements sorted for each entry
+// ns per element to sort n numbers of distribution d with method m
+double measure(int m, uint32_t n, int d){ uint32_t r,reps; double t0,t;
+  reps = WORK/n;
+  srand(5);
+  t = 0;
+  for(r=0; r<reps; r++){
+    make(n, d);               // new numbers each time, so the branch
+    memcpy(Data, In, 4*n);    // predictor cannot learn one array
+    t0 = seconds();
+    switch(m){
+      case 0: Sort(Data, n); break;
+      case 1: Sort_Insertion(Data, n); break;
+      case 2: Sort_Intro(Data, n); break;
+      case 3: Sort_Radix(Data, Temp, n, 32); break;
+      default: qsort(Data, n, 4, &compare);
+    }
+    t = t+seconds()-t0;
+  }
+  return 1e9*t/(reps*n);
+}
+void benchmark(void){ static const uint32_t size[5] = {16, 64, 256, 1024, 4096};
+  static const int dist[5] = {0, 1, 2, 3, 4};
+  uint32_t s; int d,m;
+  printf("benchmark, ns per element\n");
+  for(d=0; d<5; d++){
+    printf("  %-10s %6s %8s %10s %11s %11s %6s\n", Name[dist[d]], "n", "Sort",
+           "Insertion", "Sort_Intro", "Sort_Radix", "qsort");
+    for(s=0; s<5; s++){
+      printf("  %10s %6u", "", size[s]);
+      for(m=0; m<5; m++){
+        if((m == 1)&&(size[s] > 1024)&&(dist[d] != 1)){
+          printf(" %10s", "-");
+        } else{
+          printf(" %*.1f", (m == 0) ? 8 : (m == 4) ? 6 : (m == 1) ? 10 : 11,
+                 measure(m, size[s], dist[d]));
+        }
+      }
+      printf("\n");
+    }
+  }
+}
+
+int main(void){
+  test();
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
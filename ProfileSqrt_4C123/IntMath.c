@@ -0,0 +1,154 @@
+// IntMath.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Integer square root and magnitude of complex numbers.
+// The Newton's method sqrt in Profilesqrt.c does a divide in each of
+// 16 iterations whether it has converged or not.  Here the result is
+// built one bit at a time from the top, using only shifts, adds and
+// compares.  The count leading zeros instruction finds the first bit,
+// so an input below 2^2k takes only k steps.  Each step chooses with a
+// mask instead of a branch, because which way it goes is different
+// for every input and a wrong guess costs a processor with branch
+// prediction more than the step itself.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "IntMath.h"
+
+// count leading zeros, x is not 0
+#if defined(__ARMCC_VERSION)
+#define CLZ(x) __clz(x)
+#elif defined(__TI_COMPILER_VERSION__)
+#define CLZ(x) _norm(x)
+#elif defined(__GNUC__)
+#define CLZ(x) __builtin_clz(x)
+#else
+static uint32_t CLZ(uint32_t x){ uint32_t n;
+  n = 0;
+  while((x&0x80000000) == 0){
+    n++;
+    x = x<<1;
+  }
+  return n;
+}
+#endif
+
+//------------IntMath_Sqrt------------
+// Square root, rounded down
+// Input: s  0 to 4294967295
+// Output: largest t with t*t <= s, 0 to 65535
+uint32_t IntMath_Sqrt(uint32_t s){ uint32_t t,bit,trial,one;
+  if(s == 0){
+    return 0;
+  }
+  bit = 1u<<((31-CLZ(s))&~1u); // highest power of 4 <= s
+  t = 0;
+  while(bit){
+    trial = t+bit;
+    one = -(uint32_t)(s >= trial); // all ones if this bit of the root is 1
+    s = s-(trial&one);
+    t = (t>>1)+(bit&one);
+    bit = bit>>2;
+  }
+  return t;
+}
+
+//------------IntMath_Sqrt64------------
+// Square root of a 64-bit number, rounded down
+// Input: s  0 to 2^64-1
+// Output: largest t with t*t <= s, 0 to 4294967295
+uint32_t IntMath_Sqrt64(uint64_t s){ uint64_t t,bit,trial,one; uint32_t high;
+  high = (uint32_t)(s>>32);
+  if(high == 0){
+    return IntMath_Sqrt((uint32_t)s);
+  }
+  bit = (uint64_t)1<<((63-CLZ(high))&~1u);
+  t = 0;
+  while(bit){
+    trial = t+bit;
+    one = -(uint64_t)(s >= trial);
+    s = s-(trial&one);
+    t = (t>>1)+(bit&one);
+    bit = bit>>2;
+  }
+  return (uint32_t)t;
+}
+
+//------------IntMath_Mag------------
+// Magnitude of a complex number, rounded down
+// Input: a  real part
+//        b  imaginary part
+// Output: sqrt(a*a+b*b)
+uint32_t IntMath_Mag(int32_t a, int32_t b){ uint64_t sum;
+  sum = (uint64_t)((int64_t)a*a) + (uint64_t)((int64_t)b*b);
+  return IntMath_Sqrt64(sum);
+}
+
+//------------IntMath_MagApprox------------
+// Alpha max plus beta min estimate of the magnitude of a complex
+// number, 0.9609*max(|a|,|b|) + 0.3984*min(|a|,|b|).
+// The error is within -4% to +4.1%, less 1 for rounding down,
+// and there is no square root.
+// Input: a  real part
+//        b  imaginary part, |a| and |b| below 2^24
+// Output: estimate of sqrt(a*a+b*b)
+uint32_t IntMath_MagApprox(int32_t a, int32_t b){ uint32_t max,min;
+  if(a < 0) a = -a;
+  if(b < 0) b = -b;
+  if(a > b){
+    max = a; min = b;
+  } else{
+    max = b; min = a;
+  }
+  return (123*max + 51*min)>>7;  // alpha = 123/128, beta = 51/128
+}
+
+//------------IntMath_MagArray------------
+// Exact magnitude of an array of complex numbers, such as the
+// output of an FFT.  Each number is two 16-bit signed numbers,
+// real part first, the layout of Complex_t in FFT.h.
+// Input: data  2*n 16-bit numbers, real and imaginary parts
+//        mag   array of n results
+//        n     number of complex numbers
+// Output: none
+void IntMath_MagArray(const int16_t *data, uint32_t *mag, uint32_t n){
+  int32_t a,b;
+  while(n){
+    a = data[0];
+    b = data[1];
+    mag[0] = IntMath_Sqrt((uint32_t)(a*a)+(uint32_t)(b*b)); // at most 2^31
+    data = data+2;
+    mag++;
+    n--;
+  }
+}
+
+//------------IntMath_MagApproxArray------------
+// Same as IntMath_MagArray using IntMath_MagApprox
+// Input: data  2*n 16-bit numbers, real and imaginary parts
+//        mag   array of n results
+//        n     number of complex numbers
+// Output: none
+void IntMath_MagApproxArray(const int16_t *data, uint32_t *mag, uint32_t n){
+  while(n){
+    mag[0] = IntMath_MagApprox(data[0], data[1]);
+    data = data+2;
+    mag++;
+    n--;
+  }
+}
@@ -0,0 +1,76 @@
+// IntMath.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Integer square root and magnitude of complex numbers.
+// The square roots find one bit of the result per step, starting
+// at the highest bit the input can need, so there are no divides
+// and a small input takes only a few steps.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __INTMATH_H__
+#define __INTMATH_H__
+
+//------------IntMath_Sqrt------------
+// Square root, rounded down
+// Input: s  0 to 4294967295
+// Output: largest t with t*t <= s, 0 to 65535
+uint32_t IntMath_Sqrt(uint32_t s);
+
+//------------IntMath_Sqrt64------------
+// Square root of a 64-bit number, rounded down
+// Input: s  0 to 2^64-1
+// Output: largest t with t*t <= s, 0 to 4294967295
+uint32_t IntMath_Sqrt64(uint64_t s);
+
+//------------IntMath_Mag------------
+// Magnitude of a complex number, rounded down
+// Input: a  real part
+//        b  imaginary part
+// Output: sqrt(a*a+b*b)
+uint32_t IntMath_Mag(int32_t a, int32_t b);
+
+//------------IntMath_MagApprox------------
+// Alpha max plus beta min estimate of the magnitude of a complex
+// number, 0.9609*max(|a|,|b|) + 0.3984*min(|a|,|b|).
+// The error is within -4% to +4.1%, less 1 for rounding down,
+// and there is no square root.
+// Input: a  real part
+//        b  imaginary part, |a| and |b| below 2^24
+// Output: estimate of sqrt(a*a+b*b)
+uint32_t IntMath_MagApprox(int32_t a, int32_t b);
+
+//------------IntMath_MagArray------------
+// Exact magnitude of an array of complex numbers, such as the
+// output of an FFT.  Each number is two 16-bit signed numbers,
+// real part first, the layout of Complex_t in FFT.h.
+// Input: data  2*n 16-bit numbers, real and imaginary parts
+//        mag   array of n results
+//        n     number of complex numbers
+// Output: none
+void IntMath_MagArray(const int16_t *data, uint32_t *mag, uint32_t n);
+
+//------------IntMath_MagApproxArray------------
+// Same as IntMath_MagArray using IntMath_MagApprox
+// Input: data  2*n 16-bit numbers, real and imaginary parts
+//        mag   array of n results
+//        n     number of complex numbers
+// Output: none
+void IntMath_MagApproxArray(const int16_t *data, uint32_t *mag, uint32_t n);
+
+#endif //  __INTMATH_H__
@@ -0,0 +1,212 @@
+// IntMathSim.c
+// Runs on a PC, not on the LaunchPad
+// Check IntMath.c and compare its speed with the Newton's method
+// sqrt in Profilesqrt.c.
+//   sweep      IntMath_Sqrt for every one of the 2^32 inputs, the
+//              result t must have t*t <= s < (t+1)*(t+1); the Newton
+//              sqrt is checked the same way on every 4099th input
+//   sqrt64     IntMath_Sqrt64 on 5,000,000 random inputs of every
+//              size and at the ends of the range
+//   magnitude  IntMath_Mag against the double precision hypot, and
+//              the -4% to +4.1% bound of IntMath_MagApprox, on a grid
+//              over every pair of 16-bit numbers
+//   benchmark  ns per call for 1,000,000 random inputs below 2^8,
+//              2^16, 2^24 and 2^32, and ns per element for
+//              IntMath_MagArray and IntMath_MagApproxArray
+// The sweep takes two or three minutes.
+//   gcc -O2 IntMathSim.c IntMath.c -o IntMathSim -lm
+//   ./IntMathSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "IntMath.h"
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+// UDIV on the M4 gives 0 for a divide by 0 unless DIV_0_TRP is set
+uint32_t udiv(uint32_t a, uint32_t b){
+  return b ? a/b : 0;
+}
+
+// Newton's method, sqrt in Profilesqrt.c
+uint32_t newtonSqrt(uint32_t s){
+uint32_t t;   // t*t will become s
+int n;             // loop counter
+  t = s/16+1;      // initial guess
+  for(n = 16; n; --n){ // will finish
+    t = udiv(t*t+s, t)/2;
+  }
+  return t;
+}
+
+// 1 if t is the square root of s rounded down
+int isRoot(uint64_t s, uint64_t t){
+  return (t*t <= s)&&((t+1)*(t+1) > s);
+}
+
+//************sweep*************
+void sweep(void){ uint64_t s,bad,newtonBad,newtonTried; double t0;
+  printf("sweep, all 2^32 inputs\n");
+  bad = newtonBad = newtonTried = 0;
+  t0 = seconds();
+  for(s=0; s<=0xFFFFFFFF; s++){
+    if(!isRoot(s, IntMath_Sqrt(s))){
+      if(bad < 5){
+        printf("  IntMath_Sqrt(%llu) = %u\n", (unsigned long long)s, IntMath_Sqrt(s));
+      }
+      bad++;
+    }
+  }
+  printf("  IntMath_Sqrt %llu wrong, %.0f s\n", (unsigned long long)bad, seconds()-t0);
+  check(bad == 0, "IntMath_Sqrt rounded down for every input");
+  for(s=0; s<=0xFFFFFFFF; s=s+4099){
+    newtonTried++;
+    newtonBad = newtonBad+!isRoot(s, newtonSqrt(s));
+  }
+  printf("  Newton sqrt %llu wrong of %llu, t*t+s overflows\n",
+         (unsigned long long)newtonBad, (unsigned long long)newtonTried);
+}
+
+//************sqrt64*************
+uint64_t Seed = 0x9E3779B97F4A7C15;
+uint64_t random64(void){      // xorshift
+  Seed ^= Seed<<13;
+  Seed ^= Seed>>7;
+  Seed ^= Seed<<17;
+  return Seed;
+}
+void sqrt64(void){ static const uint64_t edge[6] = {0, 1, 0xFFFFFFFF, 0x100000000,
+  0xFFFFFFFE00000001, 0xFFFFFFFFFFFFFFFF};
+  uint32_t i,bad; uint64_t s,t;
+  printf("sqrt64\n");
+  bad = 0;
+  for(i=0; i<5000000; i++){
+    s = random64()>>(i%64);   // every size
+    t = IntMath_Sqrt64(s);
+    bad = bad+!((t*t <= s)&&((t == 0xFFFFFFFF)||((t+1)*(t+1) > s)));
+  }
+  for(i=0; i<6; i++){
+    s = edge[i];
+    t = IntMath_Sqrt64(s);
+    bad = bad+!((t*t <= s)&&((t == 0xFFFFFFFF)||((t+1)*(t+1) > s)));
+  }
+  printf("  %u wrong\n", bad);
+  check(bad == 0, "IntMath_Sqrt64 rounded down");
+  check(IntMath_Sqrt64(0xFFFFFFFFFFFFFFFF) == 0xFFFFFFFF, "largest input");
+}
+
+//************magnitude*************
+void magnitude(void){ int32_t a,b; uint32_t bad; double m,r,lo,hi;
+  int16_t data[4] = {-32768, -32768, 3, 4}; uint32_t mag[2];
+  printf("magnitude\n");
+  bad = 0;
+  lo = hi = 1;
+  for(a=-32768; a<32768; a=a+7){
+    for(b=-32768; b<32768; b=b+13){
+      m = hypot(a, b);
+      bad = bad+(IntMath_Mag(a, b) != (uint32_t)m);
+      if(m > 0){
+        r = IntMath_MagApprox(a, b)/m;
+        if(r > hi) hi = r;
+        r = (IntMath_MagApprox(a, b)+1)/m; // before rounding down
+        if(r < lo) lo = r;
+      }
+    }
+  }
+  printf("  IntMath_Mag %u wrong, IntMath_MagApprox/hypot %.4f to %.4f\n", bad, lo, hi);
+  check(bad == 0, "IntMath_Mag rounded down");
+  check((lo >= 0.96)&&(hi <= 1.041), "IntMath_MagApprox within -4% to +4.1%");
+  check(IntMath_Mag(-2147483647-1, -2147483647-1) == 3037000499, "largest magnitude");
+  IntMath_MagArray(data, mag, 2);
+  check((mag[0] == 46340)&&(mag[1] == 5), "IntMath_MagArray");
+}
+
+//************benchmark*************
+#define CALLS 1000000
+uint32_t In[CALLS];
+int16_t Pairs[2*CALLS];
+uint32_t Out[CALLS];
+volatile uint32_t Sink;
+void benchmark(void){ static const int bits[4] = {8, 16, 24, 32};
+  uint32_t i,b,sum; double t0,t1,t2,t3;
+  printf("benchmark, ns per call\n");
+  printf("  %6s %13s %12s %12s\n", "input", "IntMath_Sqrt", "Newton sqrt", "libm sqrt");
+  for(b=0; b<4; b++){
+    for(i=0; i<CALLS; i++){
+      In[i] = (uint32_t)(random64()>>(64-bits[b]));
+    }
+    sum = 0;
+    t0 = seconds();
+    for(i=0; i<CALLS; i++){
+      sum = sum+IntMath_Sqrt(In[i]);
+    }
+    t1 = seconds();
+    for(i=0; i<CALLS; i++){
+      sum = sum+newtonSqrt(In[i]);
+    }
+    t2 = seconds();
+    for(i=0; i<CALLS; i++){
+      sum = sum+(uint32_t)sqrt(In[i]);
+    }
+    t3 = seconds();
+    Sink = sum;
+    printf("  < 2^%-2d %13.2f %12.2f %12.2f\n", bits[b], 1e9*(t1-t0)/CALLS,
+           1e9*(t2-t1)/CALLS, 1e9*(t3-t2)/CALLS);
+  }
+  for(i=0; i<2*CALLS; i++){
+    Pairs[i] = (int16_t)random64();
+  }
+  t0 = seconds();
+  IntMath_MagArray(Pairs, Out, CALLS);
+  t1 = seconds();
+  Sink = Out[5];
+  IntMath_MagApproxArray(Pairs, Out, CALLS);
+  t2 = seconds();
+  Sink = Out[5];
+  printf("  IntMath_MagArray %.2f, IntMath_MagApproxArray %.2f ns per element\n",
+         1e9*(t1-t0)/CALLS, 1e9*(t2-t1)/CALLS);
+}
+
+int main(void){
+  sweep();
+  sqrt64();
+  magnitude();
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
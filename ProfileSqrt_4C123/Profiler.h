@@ -0,0 +1 @@
+../ProfileSort_4C123/Profiler.h
\ No newline at end of file
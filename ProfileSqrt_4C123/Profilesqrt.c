@@ -23,21 +23,12 @@
 // PF2 is an output for debugging
 #include <stdint.h>
 #include "../inc/tm4c123gh6pm.h"
+#include "Profiler.h"
+#include "IntMath.h"
 
-#define NVIC_ST_CTRL_COUNT      0x00010000  // Count flag
-#define NVIC_ST_CTRL_CLK_SRC    0x00000004  // Clock Source
-#define NVIC_ST_CTRL_INTEN      0x00000002  // Interrupt enable
-#define NVIC_ST_CTRL_ENABLE     0x00000001  // Counter mode
-#define NVIC_ST_RELOAD_M        0x00FFFFFF  // Counter load value
+#define ZONE_SQRT 0         // Profiler zone for sqrt
+#define ZONE_INTSQRT 1      // Profiler zone for IntMath_Sqrt
 
-// Initialize SysTick with busy wait running at bus clock.
-void SysTick_Init(void){
-  NVIC_ST_CTRL_R = 0;                   // disable SysTick during setup
-  NVIC_ST_RELOAD_R = NVIC_ST_RELOAD_M;  // maximum reload value
-  NVIC_ST_CURRENT_R = 0;                // any write to current clears it
-                                        // enable SysTick with core clock
-  NVIC_ST_CTRL_R = NVIC_ST_CTRL_ENABLE+NVIC_ST_CTRL_CLK_SRC;
-}
 // Newton's method
 // s is an integer
 // sqrt(s) is an integer
@@ -50,10 +41,12 @@ int n;             // loop counter
   }
   return t;
 }
-uint32_t before,elapsed,ss,tt;
+uint32_t elapsed,elapsedInt,ss,tt,tt2;
 int main(void){
   SYSCTL_RCGCGPIO_R |= 0x20; // activate Port F
-  SysTick_Init();            // initialize SysTick timer, Program 4.7
+  Profiler_Init();           // initialize SysTick timer and measure offset
+  Profiler_Name(ZONE_SQRT, "sqrt");
+  Profiler_Name(ZONE_INTSQRT, "IntMath_Sqrt");
   GPIO_PORTF_DIR_R |= 0x04;  // make PF2 out (built-in blue LED)
   GPIO_PORTF_AFSEL_R &= ~0x04;// disable alt funct on PF2
   GPIO_PORTF_DEN_R |= 0x04;  // enable digital I/O on PF2
@@ -61,11 +54,14 @@ int main(void){
   GPIO_PORTF_PCTL_R = (GPIO_PORTF_PCTL_R&0xFFFFF0FF)+0x00000000;
   GPIO_PORTF_AMSEL_R = 0;    // disable analog functionality on PF
   ss = 230400;
-  before = NVIC_ST_CURRENT_R;
+  Profiler_Begin(ZONE_SQRT);
   tt = sqrt(ss);
-  elapsed = (before - NVIC_ST_CURRENT_R - 4)&0x00FFFFFF;
-  // the number 4 depends on the instructions before and after test
+  elapsed = Profiler_End(ZONE_SQRT);
+  // Profiler_Init measured the cost of Begin/End, so
   // if you remove the call to sqrt, elapsed measures 0
+  Profiler_Begin(ZONE_INTSQRT);
+  tt2 = IntMath_Sqrt(ss);    // same answer, no divides, no wasted iterations
+  elapsedInt = Profiler_End(ZONE_INTSQRT);
 
   while(1){
     ss = 230400;
@@ -94,7 +90,7 @@ int n;            // loop counter
 int main2(void){
   SYSCTL_RCGCGPIO_R |= 0x08; // activate Port D
   while((SYSCTL_PRGPIO_R&0x08) ==0){};
-  SysTick_Init();            // initialize SysTick timer, Program 4.7
+  Profiler_Init();           // initialize SysTick timer
   GPIO_PORTD_DIR_R |= 0x0F;  // make PD3-0 out (logic analyzer)
   GPIO_PORTD_DEN_R |= 0x0F;  // enable digital I/O on PD3-0 out
   while(1){
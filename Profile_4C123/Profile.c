@@ -25,9 +25,15 @@
  */
 
 // oscilloscope connected to PA5,PA4,PA3 for profiling
+// Sampler.c also counts where the time goes, without the scope:
+// look at Hist[] in the debugger, or send Sampler_Report out a UART
+// and run SamplerMap.c on a PC.  Timer0A_Handler, SysTick_Handler
+// and main should share the samples about like PA3, PA4 and PA5
+// share the time on the scope.
 
 #include <stdint.h>
 #include "../inc/tm4c123gh6pm.h"
+#include "Sampler.h"
  
 #define PA5   (*((volatile uint32_t *)0x40004080))
 #define PA4   (*((volatile uint32_t *)0x40004040))
@@ -131,6 +137,8 @@ int main(void){
                              // configure PA5-3 as GPIO
   Timer0A_Init(5);           // 200 kHz
   SysTick_Init(304);         // 164 kHz
+  Sampler_Init(4999);        // about 10 kHz, priority 0
+  Sampler_Start();
   EnableInterrupts();
   while(1){
     PA5 = PA5^0x20;  
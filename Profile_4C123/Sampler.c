@@ -0,0 +1,191 @@
+// Sampler.c
+// Runs on LM4F120/TM4C123
+// Statistical profiler using Wide Timer 5A.
+// On an interrupt the processor pushes R0-R3, R12, LR, PC and PSR
+// onto the stack that was in use.  The handler in sampler.s finds
+// that stack from bit 2 of LR and passes it here, so the PC of the
+// interrupted code is frame[6].  Each sample costs about 30 cycles.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "../inc/tm4c123gh6pm.h"
+#include "Sampler.h"
+
+// private, so they do not clash with Profiler.c or the user program
+static uint16_t Hist[SAMPLER_BUCKETS]; // counts stop at 65535
+static uint32_t Samples;               // total samples
+static uint32_t Outside;               // samples not in any bucket
+static uint32_t Period;                // bus cycles between samples
+static uint32_t Jitter;                // random number for the period
+
+//------------Sampler_Clear------------
+// Set every count to zero.
+// Input: none
+// Output: none
+void Sampler_Clear(void){ uint32_t i;
+  for(i=0; i<SAMPLER_BUCKETS; i++){
+    Hist[i] = 0;
+  }
+  Samples = 0;
+  Outside = 0;
+}
+
+//------------Sampler_Init------------
+// Initialize Wide Timer 5A for periodic sampling at priority 0 and
+// clear the histogram.  Sampling does not begin until Sampler_Start.
+// The period is varied a little on each sample so sampling does not
+// lock onto other periodic interrupts.
+// Input: period  bus cycles between samples, e.g. 8000 for 10 kHz at 80 MHz
+// Output: none
+void Sampler_Init(uint32_t period){ volatile uint32_t delay;
+  Sampler_Clear();
+  Period = period;
+  Jitter = 1;
+  SYSCTL_RCGCWTIMER_R |= 0x20;  // 0) activate WTIMER5
+  delay = SYSCTL_RCGCWTIMER_R;  // allow time to finish activating
+  WTIMER5_CTL_R = 0x00000000;   // 1) disable WTIMER5A during setup
+  WTIMER5_CFG_R = 0x00000004;   // 2) configure for 32-bit timer mode
+  WTIMER5_TAMR_R = 0x00000002;  // 3) configure for periodic mode, default down-count settings
+  WTIMER5_TAILR_R = period-1;   // 4) reload value
+  WTIMER5_TAPR_R = 0;           // 5) bus clock resolution
+  WTIMER5_ICR_R = 0x00000001;   // 6) clear WTIMER5A timeout flag
+  WTIMER5_IMR_R = 0x00000001;   // 7) arm timeout interrupt
+  NVIC_PRI26_R = NVIC_PRI26_R&0xFFFFFF00; // 8) priority 0, the highest
+// vector number 120, interrupt number 104
+  NVIC_EN3_R = 1<<(104-96);     // 9) enable IRQ 104 in NVIC
+}
+
+//------------Sampler_Start------------
+// Begin or continue sampling.
+// Input: none
+// Output: none
+void Sampler_Start(void){
+  WTIMER5_CTL_R = 0x00000001;   // enable WTIMER5A
+}
+
+//------------Sampler_Stop------------
+// Stop sampling, the histogram is kept.
+// Input: none
+// Output: none
+void Sampler_Stop(void){
+  WTIMER5_CTL_R = 0x00000000;   // disable WTIMER5A
+}
+
+//------------Sampler_Samples------------
+// Input: none
+// Output: number of samples since Sampler_Clear
+uint32_t Sampler_Samples(void){
+  return Samples;
+}
+
+//------------Sampler_Count------------
+// Input: bucket  0 to SAMPLER_BUCKETS-1, holds addresses from
+//                SAMPLER_BASE+(bucket<<SAMPLER_SHIFT)
+// Output: number of samples in that bucket
+uint32_t Sampler_Count(uint32_t bucket){
+  return Hist[bucket];
+}
+
+//------------Sampler_Outside------------
+// Input: none
+// Output: number of samples outside every bucket, e.g. code in RAM
+uint32_t Sampler_Outside(void){
+  return Outside;
+}
+
+//------------Sampler_Sample------------
+// Count one sample.  Called by the interrupt handler in sampler.s
+// or sampler.asm, not by the user.
+// Input: frame  stack frame pushed by the interrupt, PC is frame[6]
+// Output: none
+void Sampler_Sample(uint32_t *frame){ uint32_t bucket;
+  WTIMER5_ICR_R = TIMER_ICR_TATOCINT;// acknowledge WTIMER5A timeout
+  Jitter = 1664525*Jitter + 1013904223;
+  WTIMER5_TAILR_R = Period-1 + ((Jitter>>26)&SAMPLER_JITTER); // restarts the count
+  bucket = (frame[6]-SAMPLER_BASE)>>SAMPLER_SHIFT;
+  if(bucket < SAMPLER_BUCKETS){
+    if(Hist[bucket] < 65535){
+      Hist[bucket]++;
+    }
+  } else{
+    Outside++;
+  }
+  Samples++;
+}
+
+// copy a string, returns pointer to the next free character
+static char *str(char *pt, const char *s){
+  while(*s){
+    *pt = *s;
+    pt++; s++;
+  }
+  return pt;
+}
+
+// convert a number to 8 hex digits, followed by a space
+// returns pointer to the next free character
+static char *hex(char *pt, uint32_t n){ int i;
+  for(i=28; i>=0; i=i-4){
+    *pt = "0123456789abcdef"[(n>>i)&0x0F];
+    pt++;
+  }
+  *pt = ' ';
+  return pt+1;
+}
+
+// convert an unsigned number to decimal, followed by CR LF
+// returns pointer to the next free character
+static char *udec(char *pt, uint32_t n){ char digits[10]; int i;
+  i = 0;
+  do{
+    digits[i] = '0' + n%10;
+    n = n/10;
+    i++;
+  }while(n);
+  while(i){
+    i--;
+    *pt = digits[i];
+    pt++;
+  }
+  pt[0] = '\r'; pt[1] = '\n';
+  return pt+2;
+}
+
+//------------Sampler_Report------------
+// Output "address count" for every nonzero bucket, address in hex,
+// then "outside count" and "total count".  SamplerMap.c reads it.
+// Input: outString  function that outputs a string, e.g. UART_OutString
+// Output: none
+void Sampler_Report(void (*outString)(char *)){
+  char line[24]; char *pt; uint32_t i;
+  for(i=0; i<SAMPLER_BUCKETS; i++){
+    if(Hist[i]){
+      pt = hex(line, SAMPLER_BASE+(i<<SAMPLER_SHIFT));
+      pt = udec(pt, Hist[i]);
+      *pt = 0;
+      outString(line);
+    }
+  }
+  pt = udec(str(line, "outside "), Outside);
+  *pt = 0;
+  outString(line);
+  pt = udec(str(line, "total "), Samples);
+  *pt = 0;
+  outString(line);
+}
@@ -0,0 +1,95 @@
+// Sampler.h
+// Runs on LM4F120/TM4C123
+// Statistical profiler.  A periodic Wide Timer 5A interrupt at the
+// highest priority reads the program counter of whatever it
+// interrupted and counts it in a histogram of address buckets.
+// Where the program spends its time shows up as the buckets with
+// the most counts, without a scope or a logic analyzer.
+// Code running with interrupts disabled, or in another priority 0
+// interrupt, is counted at the instruction after it re-enables.
+// SamplerMap.c runs on a PC and turns the report into function names.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __SAMPLER_H__
+#define __SAMPLER_H__
+
+#define SAMPLER_BASE    0x00000000 // first address counted, start of flash
+#define SAMPLER_SHIFT   5          // bucket size is 2^5 = 32 bytes
+#define SAMPLER_BUCKETS 2048       // 2048*32 = 64 kbytes of code
+#define SAMPLER_JITTER  0x3F       // period varies by 0 to 63 cycles
+
+//------------Sampler_Init------------
+// Initialize Wide Timer 5A for periodic sampling at priority 0 and
+// clear the histogram.  Sampling does not begin until Sampler_Start.
+// The period is varied a little on each sample so sampling does not
+// lock onto other periodic interrupts.
+// Input: period  bus cycles between samples, e.g. 8000 for 10 kHz at 80 MHz
+// Output: none
+void Sampler_Init(uint32_t period);
+
+//------------Sampler_Start------------
+// Begin or continue sampling.
+// Input: none
+// Output: none
+void Sampler_Start(void);
+
+//------------Sampler_Stop------------
+// Stop sampling, the histogram is kept.
+// Input: none
+// Output: none
+void Sampler_Stop(void);
+
+//------------Sampler_Clear------------
+// Set every count to zero.
+// Input: none
+// Output: none
+void Sampler_Clear(void);
+
+//------------Sampler_Samples------------
+// Input: none
+// Output: number of samples since Sampler_Clear
+uint32_t Sampler_Samples(void);
+
+//------------Sampler_Count------------
+// Input: bucket  0 to SAMPLER_BUCKETS-1, holds addresses from
+//                SAMPLER_BASE+(bucket<<SAMPLER_SHIFT)
+// Output: number of samples in that bucket
+uint32_t Sampler_Count(uint32_t bucket);
+
+//------------Sampler_Outside------------
+// Input: none
+// Output: number of samples outside every bucket, e.g. code in RAM
+uint32_t Sampler_Outside(void);
+
+//------------Sampler_Sample------------
+// Count one sample.  Called by the interrupt handler in sampler.s
+// or sampler.asm, not by the user.
+// Input: frame  stack frame pushed by the interrupt, PC is frame[6]
+// Output: none
+void Sampler_Sample(uint32_t *frame);
+
+//------------Sampler_Report------------
+// Output "address count" for every nonzero bucket, address in hex,
+// then "outside count" and "total count".  SamplerMap.c reads it.
+// Input: outString  function that outputs a string, e.g. UART_OutString
+// Output: none
+void Sampler_Report(void (*outString)(char *));
+
+#endif //  __SAMPLER_H__
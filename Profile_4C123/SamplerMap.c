@@ -0,0 +1,153 @@
+// SamplerMap.c
+// Runs on a PC, not on the LaunchPad
+// Turn the output of Sampler_Report into a list of functions, the
+// one with the most samples first.
+//   gcc SamplerMap.c -o SamplerMap
+//   ./SamplerMap report.txt symbols.txt
+// report.txt is the Sampler_Report output captured from the UART.
+// symbols.txt is either the Keil linker map (the "Image Symbol
+// Table" lines like "  main  0x000002a9  Thumb Code  60  main.o")
+// or the output of "arm-none-eabi-nm -n program.axf" (lines like
+// "000002a8 T main").  A bucket is charged to the function that
+// holds the address in the middle of the bucket, so a function
+// smaller than a bucket may have its samples given to its neighbor.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Sampler.h"
+
+#define MAXSYMBOLS 10000
+#define MAXLINE    512
+
+typedef struct symbol {
+  uint32_t address;       // Thumb bit cleared
+  char name[64];
+  uint32_t count;         // samples charged to this function
+} symbol_t;
+
+symbol_t Symbols[MAXSYMBOLS];
+uint32_t NumSymbols;
+
+// add one function, Thumb addresses are odd so bit 0 is cleared
+void addSymbol(const char *name, uint32_t address){
+  if(NumSymbols < MAXSYMBOLS){
+    Symbols[NumSymbols].address = address&~1;
+    snprintf(Symbols[NumSymbols].name, sizeof(Symbols[0].name), "%.63s", name);
+    Symbols[NumSymbols].count = 0;
+    NumSymbols++;
+  }
+}
+
+// read either a Keil map file or nm output, keeping code symbols
+int readSymbols(const char *file){
+  FILE *f; char line[MAXLINE],name[MAXLINE],type[MAXLINE],kind[MAXLINE];
+  unsigned int address;
+  f = fopen(file, "r");
+  if(f == 0){
+    return 0;
+  }
+  while(fgets(line, MAXLINE, f)){
+    // Keil:  name  0x000002a9  Thumb Code  60  main.o(.text)
+    if((sscanf(line, " %s 0x%x %s %s", name, &address, type, kind) == 4)
+       && (strcmp(kind, "Code") == 0)){
+      addSymbol(name, address);
+    // nm:  000002a8 T main
+    } else if((sscanf(line, "%x %s %s", &address, type, name) == 3)
+       && ((strcmp(type, "T") == 0) || (strcmp(type, "t") == 0))){
+      addSymbol(name, address);
+    }
+  }
+  fclose(f);
+  return 1;
+}
+
+int byAddress(const void *a, const void *b){
+  uint32_t x = ((const symbol_t *)a)->address;
+  uint32_t y = ((const symbol_t *)b)->address;
+  return (x > y) - (x < y);
+}
+
+int byCount(const void *a, const void *b){
+  uint32_t x = ((const symbol_t *)a)->count;
+  uint32_t y = ((const symbol_t *)b)->count;
+  return (x < y) - (x > y);
+}
+
+// last function that starts at or below address, -1 if none
+int find(uint32_t address){
+  int lo,hi,mid;
+  lo = -1;                     // Symbols[lo].address <= address
+  hi = NumSymbols;             // Symbols[hi].address > address
+  while(hi-lo > 1){
+    mid = (lo+hi)/2;
+    if(Symbols[mid].address <= address){
+      lo = mid;
+    } else{
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+int main(int argc, char **argv){
+  FILE *f; char line[MAXLINE]; unsigned int address,count;
+  uint32_t total,unknown,outside,i; int s;
+  if((argc < 3) || !readSymbols(argv[2]) || ((f = fopen(argv[1], "r")) == 0)){
+    fprintf(stderr, "usage: %s report.txt symbols.txt\n", argv[0]);
+    return 1;
+  }
+  qsort(Symbols, NumSymbols, sizeof(symbol_t), &byAddress);
+  total = 0;
+  unknown = 0;
+  outside = 0;
+  while(fgets(line, MAXLINE, f)){
+    if(sscanf(line, "outside %u", &count) == 1){
+      outside = count;
+    } else if(sscanf(line, "%x %u", &address, &count) == 2){
+      s = find(address + (1<<SAMPLER_SHIFT)/2);
+      if(s >= 0){
+        Symbols[s].count += count;
+      } else{
+        unknown += count;
+      }
+      total += count;
+    }
+  }
+  fclose(f);
+  total += outside;
+  if(total == 0){
+    printf("no samples\n");
+    return 0;
+  }
+  qsort(Symbols, NumSymbols, sizeof(symbol_t), &byCount);
+  printf("%%time  samples  function\n");
+  for(i=0; (i<NumSymbols) && Symbols[i].count; i++){
+    printf("%5.1f %8u  %s\n", 100.0*Symbols[i].count/total, Symbols[i].count, Symbols[i].name);
+  }
+  if(unknown){
+    printf("%5.1f %8u  (below the first symbol)\n", 100.0*unknown/total, unknown);
+  }
+  if(outside){
+    printf("%5.1f %8u  (outside the buckets)\n", 100.0*outside/total, outside);
+  }
+  return 0;
+}
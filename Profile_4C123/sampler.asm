@@ -0,0 +1,42 @@
+; sampler.asm
+; Runs on LM4F120/TM4C123
+; Wide Timer 5A interrupt handler for the sampling profiler in Sampler.c.
+; The interrupted PC is in the stack frame pushed by the processor.
+; Bit 2 of LR (EXC_RETURN) tells which stack holds the frame:
+; 0 means MSP (main program without an OS, or another interrupt),
+; 1 means PSP (a thread in an OS that uses the process stack).
+; agent
+; October 17, 2026
+
+;  This example accompanies the books
+;   "Embedded Systems: Real-Time Operating Systems for ARM Cortex M Microcontrollers",
+;   ISBN: 978-1466468863, Jonathan Valvano, copyright (c) 2015
+;
+;Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+;   You may use, edit, run or distribute this file
+;   as long as the above copyright notice remains
+;THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+;OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+;MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+;VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+;OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+;For more information about my classes, my research, and my books, see
+;http://users.ece.utexas.edu/~valvano/
+
+        .thumb
+        .text
+        .align 2
+
+     .global WideTimer5A_Handler
+     .ref    Sampler_Sample
+
+; Input: LR is EXC_RETURN
+; Output: none, Sampler_Sample(frame) returns from the interrupt
+WideTimer5A_Handler:  .asmfunc
+     TST   LR,#4         ; which stack has the frame?
+     ITE   EQ
+     MRSEQ R0,MSP        ; R0 points to R0,R1,R2,R3,R12,LR,PC,PSR
+     MRSNE R0,PSP
+     B     Sampler_Sample ; LR is still EXC_RETURN
+    .endasmfunc
+    .end                             ; end of file
@@ -29,6 +29,7 @@
 
 
         .global  RunPt            ; currently running thread
+        .global  Scheduler        ; choose next thread, in os.c
         .global  OS_DisableInterrupts
         .global  OS_EnableInterrupts
         .global  StartOS
@@ -51,8 +52,10 @@ SysTick_Handler:  .asmfunc     ; 1) Saves R0-R3,R12,LR,PC,PSR
     LDR     R0, RunPtAddr      ; 4) R0=pointer to RunPt, old thread
     LDR     R1, [R0]           ;    R1 = RunPt
     STR     SP, [R1]           ; 5) Save SP into TCB
-    LDR     R1, [R1,#4]        ; 6) R1 = RunPt->next
-    STR     R1, [R0]           ;    RunPt = R1
+    PUSH    {R0,LR}            ; 6) save R0 and EXC_RETURN
+    BL      Scheduler          ;    RunPt = highest priority ready thread
+    POP     {R0,LR}
+    LDR     R1, [R0]           ;    R1 = RunPt, new thread
     LDR     SP, [R1]           ; 7) new thread SP; SP = RunPt->sp;
     POP     {R4-R11}           ; 8) restore regs r4-11
     CPSIE   I                  ; 9) tasks run with interrupts enabled
@@ -0,0 +1,798 @@
+// RTOSSim.c
+// Runs on a PC, not on the LaunchPad
+// Run the RTOS in os.c and sched.c on a PC.  os.c is included here
+// with OSSIM defined, so the SysTick, NVIC and Timer5A registers are
+// variables, and the bus clock is a counter.  Each thread runs on
+// its own PC stack with ucontext.  When the simulated SysTick_Handler
+// runs, it saves a stack pointer for the old thread, calls Scheduler
+// and changes PC stacks if RunPt changed, the way osasm.s changes SP.
+// Threads use bus cycles by calling SimRun, and interrupts are taken
+// between cycles whenever PRIMASK is 0.
+// The tests check
+//   sched.c    priority order, round robin, blocked and sleeping
+//              lists, wake times that wrap around
+//   switching  a thread added while running preempts when it is
+//              higher priority, equal priorities share the processor,
+//              lower priorities wait
+//   wasted     user.c's threads at one priority, with an interrupt
+//              that brings data every 2 ms and a thread that runs
+//              every 10 ms, spinning, spinning with OS_Suspend, and
+//              blocking on a semaphore and OS_Sleep.  Reports the
+//              time slices spent polling and what the CPU-bound
+//              thread gets back.
+//   tickless   a battery node that samples every 100 ms and gets a
+//              radio message every second, with Idle running
+//              TicklessSleep and then with WaitForInterrupt only, as
+//              when TICKLESS is 0.  Reports the SysTick interrupts
+//              avoided and checks that both keep the same time.  Then
+//              an interrupt is placed on each bus cycle around the end
+//              of a long SysTick period, the race where SysTick
+//              reaches 0 between reading COUNT and stopping it.
+//   stacks     Idle interrupted as deep as the budget in os.c, once
+//              on IDLESTACKSIZE and once on a MINSTACKSIZE stack,
+//              which overflows; a thread that runs past its stack and
+//              one that overwrites only its guard word; the most words
+//              used and the processor load in OS_Stats
+// Each access to a SysTick register takes one bus cycle.  os.c is
+// built with STACKHALT 0, so an overflow is reported, not a hang.
+// The benchmark times the choice of the next thread, Sched_Next
+// against a linear search of the thread table, for 1 to 32 ready
+// priority levels.
+//   gcc RTOSSim.c sched.c -o RTOSSim
+//   ./RTOSSim
+// Exits with 1 if a test fails.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <ucontext.h>
+
+// the simulated processor
+uint64_t SimNow;              // bus cycles since reset
+uint64_t SimEnd;              // the run stops here
+int32_t SimPrimask;           // 1 means interrupts are disabled
+uint32_t SimCtrl;             // NVIC_ST_CTRL_R
+uint32_t SimReload;           // NVIC_ST_RELOAD_R
+uint32_t SimCurrent;          // NVIC_ST_CURRENT_R
+uint32_t SimIntCtrl;          // NVIC_INT_CTRL_R
+uint32_t SimOther;            // registers that only get written
+int SimCountRead;             // COUNT was read, clear it on the next access
+uint32_t SimTicks;            // SysTick interrupts from reaching 0
+uint32_t SimHandlers;         // times SysTick_Handler ran
+uint32_t SimSwitches;         // times RunPt changed
+int SimInISR;                 // 1 while SimEvent runs, SysTick waits for it
+void (*SimEvent)(void);       // a higher priority interrupt, 0 for none
+uint64_t SimEventTime;        // bus cycle it is requested, the ISR sets the next
+uint64_t SimAsleep;           // bus cycles in WaitForInterrupt
+uint32_t *SimCtrlReg(void);
+uint32_t *SimReg(uint32_t *reg);
+
+// os.c uses these instead of the LaunchPad registers
+#define OSSIM
+#define STACKHALT 0           // report overflows in OS_Stats
+#define NVIC_ST_CTRL_R          (*SimCtrlReg())
+#define NVIC_ST_RELOAD_R        (*SimReg(&SimReload))
+#define NVIC_ST_CURRENT_R       (*SimReg(&SimCurrent))
+#define NVIC_INT_CTRL_R         SimIntCtrl
+#define NVIC_SYS_PRI3_R         SimOther
+#define SYSCTL_RCGCTIMER_R      SimOther
+#define SYSCTL_PRTIMER_R        0xFFFFFFFF
+#define TIMER5_CFG_R            SimOther
+#define TIMER5_TAMR_R           SimOther
+#define TIMER5_CTL_R            SimOther
+#define TIMER5_TAILR_R          SimOther
+#define TIMER5_TAPR_R           SimOther
+#define TIMER5_TAV_R            ((uint32_t)(0xFFFFFFFF - (uint32_t)SimNow))
+#pragma GCC diagnostic ignored "-Wpointer-to-int-cast" // the PC in the initial stack
+#include "os.c"
+
+#define HOSTSTACK 65536       // bytes of PC stack for each thread
+ucontext_t Context[NUMTHREADS+1]; // the last one is main
+char HostStack[NUMTHREADS][HOSTSTACK];
+int Made[NUMTHREADS];         // 1 once the context for the tcb is made
+void (*Task[NUMTHREADS])(void);
+uint32_t Depth[NUMTHREADS];   // words a thread has on its stack when interrupted
+uint32_t Current;             // index of the context that is running
+#define IDLEDEPTH 62          // Idle's budget in os.c less the 16 words the handler saves
+
+int Errors;
+void check(int ok, const char *what){
+  if(!ok){
+    printf("  FAIL %s\n", what);
+    Errors++;
+  }
+}
+
+// COUNT clears when CTRL is read, so clear it on the access after the
+// one that saw it, unless SysTick reached 0 again in between.  Writing
+// CURRENT also clears COUNT, but os.c always writes CTRL first.
+void elapse(uint64_t n);
+uint32_t *SimCtrlReg(void){
+  if(SimCountRead){
+    SimCtrl &= ~NVIC_ST_CTRL_COUNT;
+    SimCountRead = 0;
+  }
+  elapse(1);                  // the access takes a bus cycle
+  if(SimCtrl&NVIC_ST_CTRL_COUNT){
+    SimCountRead = 1;
+  }
+  return &SimCtrl;
+}
+uint32_t *SimReg(uint32_t *reg){
+  elapse(1);
+  return reg;
+}
+
+// bus cycles until SysTick reaches 0
+uint64_t sysTickLeft(void){
+  if((SimCtrl&NVIC_ST_CTRL_ENABLE) == 0){
+    return UINT64_MAX;
+  }
+  if(SimCurrent == 0){
+    return (uint64_t)SimReload+1; // loads RELOAD on the next cycle
+  }
+  return SimCurrent;
+}
+
+// n bus cycles go by, n is at most sysTickLeft()
+void elapse(uint64_t n){
+  SimNow = SimNow + n;
+  if((n == 0)||((SimCtrl&NVIC_ST_CTRL_ENABLE) == 0)){
+    return;
+  }
+  if(SimCurrent == 0){
+    SimCurrent = SimReload;
+    n--;
+    if(n == 0){
+      return;
+    }
+  }
+  SimCurrent = SimCurrent - n;
+  if(SimCurrent == 0){
+    SimCtrl |= NVIC_ST_CTRL_COUNT;
+    SimCountRead = 0;
+    if(SimCtrl&NVIC_ST_CTRL_INTEN){
+      SimIntCtrl |= NVIC_INT_CTRL_PENDSTSET;
+      SimTicks++;
+    }
+  }
+}
+
+// bus cycles until something happens, at most n
+uint64_t quiet(uint64_t n){ uint64_t t;
+  t = sysTickLeft();
+  if(t < n){
+    n = t;
+  }
+  if(SimEvent && (SimEventTime > SimNow) && (SimEventTime-SimNow < n)){
+    n = SimEventTime-SimNow;
+  }
+  return n;
+}
+
+int pending(void){
+  return (SimIntCtrl&NVIC_INT_CTRL_PENDSTSET) ||
+         (SimEvent && (SimEventTime <= SimNow));
+}
+
+// back to main, the run is over
+void stop(void){
+  swapcontext(&Context[Current], &Context[NUMTHREADS]);
+}
+
+// change PC stacks, the way osasm.s loads SP from RunPt
+void switchTo(tcbType *thread){ uint32_t old,new;
+  old = Current;
+  new = thread-tcbs;
+  Current = new;
+  if(!Made[new]){
+    getcontext(&Context[new]);
+    Context[new].uc_stack.ss_sp = HostStack[new];
+    Context[new].uc_stack.ss_size = HOSTSTACK;
+    Context[new].uc_link = &Context[NUMTHREADS];
+    makecontext(&Context[new], Task[new], 0);
+    Made[new] = 1;
+  }
+  swapcontext(&Context[old], &Context[new]);
+}
+
+// SysTick_Handler in osasm.s: the processor pushes R0-R3,R12,LR,PC,PSR
+// and the handler pushes R4-R11 below what the thread was using, then
+// saves SP.  Those words are marked used, so OS_Stats sees them.
+void sysTickHandler(void){ tcbType *old; int32_t *top,*pt;
+  SimIntCtrl &= ~NVIC_INT_CTRL_PENDSTSET;
+  SimHandlers++;
+  old = RunPt;
+  top = &old->stack[old->stackWords];
+  old->sp = top-Depth[old-tcbs]-16;
+  for(pt=old->sp; pt<top; pt++){
+    if(pt >= StackPool){
+      *pt = 0;
+    }
+  }
+  Scheduler();
+  if(RunPt != old){
+    SimSwitches++;
+    switchTo(RunPt);
+  }
+}
+
+// take the interrupts that are pending, if PRIMASK allows
+void interrupts(void){
+  while((SimPrimask == 0)&&(SimInISR == 0)){
+    if(SimEvent && (SimEventTime <= SimNow)){
+      SimInISR = 1;
+      (*SimEvent)();          // higher priority than SysTick
+      SimInISR = 0;
+    } else if(SimIntCtrl&NVIC_INT_CTRL_PENDSTSET){
+      sysTickHandler();
+    } else{
+      return;
+    }
+  }
+}
+
+//------------SimRun------------
+// the running thread uses bus cycles, interrupts are taken as they
+// come, if PRIMASK is 0
+// Input: n  number of bus cycles
+// Output: none
+void SimRun(uint64_t n){ uint64_t step;
+  interrupts();               // pended by the last register write
+  while(n){
+    if(SimNow >= SimEnd){
+      stop();
+    }
+    step = quiet(n);
+    elapse(step);
+    n = n-step;
+    interrupts();
+  }
+}
+
+// what osasm.s and startup.s do on the LaunchPad
+void OS_DisableInterrupts(void){
+  SimPrimask = 1;
+}
+void OS_EnableInterrupts(void){
+  SimPrimask = 0;
+  interrupts();
+}
+int32_t StartCritical(void){ int32_t primask;
+  primask = SimPrimask;
+  SimPrimask = 1;
+  return primask;
+}
+void EndCritical(int32_t primask){
+  SimPrimask = primask;
+  interrupts();
+}
+void WaitForInterrupt(void){  // sleeps until an interrupt is pending
+  uint64_t step;
+  while(!pending()){
+    if(SimNow >= SimEnd){
+      stop();
+    }
+    step = quiet(SimEnd-SimNow);
+    elapse(step);
+    SimAsleep = SimAsleep + step;
+  }
+  interrupts();
+}
+void StartOS(void){           // first thread, interrupts enabled
+  SimPrimask = 0;
+  Current = NUMTHREADS;
+  switchTo(RunPt);
+}
+void PLL_Init(uint32_t freq){
+  (void)freq;
+}
+
+//------------SimStart------------
+// reset the processor and call OS_Init, the run ends at OS_Launch
+// plus the given number of bus cycles, and OS_Launch returns then
+// Input: cycles  length of the run
+//        idle    words on the Idle stack when it is interrupted
+// Output: none
+void SimStart(uint64_t cycles, uint32_t idle){ int i;
+  SimNow = 0;
+  SimEnd = cycles;
+  SimPrimask = 1;
+  SimCtrl = SimReload = SimCurrent = SimIntCtrl = 0;
+  SimCountRead = 0;
+  SimTicks = SimHandlers = SimSwitches = 0;
+  SimEvent = 0;
+  SimInISR = 0;
+  SimAsleep = 0;
+  for(i=0; i<NUMTHREADS; i++){
+    Made[i] = 0;
+  }
+  OS_Init();
+  Task[0] = &Idle;
+  Depth[0] = idle;
+}
+
+//------------SimAddThread------------
+// OS_AddThread, remembering the task so its context can be made
+// Input: task, stackWords, priority  as for OS_AddThread
+//        depth  words on its stack when it is interrupted
+// Output: 1 if successful, 0 if not
+int SimAddThread(void(*task)(void), uint32_t stackWords, uint32_t priority,
+                 uint32_t depth){
+  if(NumThreads < NUMTHREADS){
+    Task[NumThreads] = task;
+    Depth[NumThreads] = depth;
+    Made[NumThreads] = 0;
+  }
+  return OS_AddThread(task, stackWords, priority);
+}
+
+//************sched.c by itself*************
+tcbType T[8];
+void testSched(void){ tcbType *list,*pt; uint32_t wake,now; int i;
+  printf("sched.c\n");
+  Sched_Init();
+  check(Sched_Highest() == NUMPRIORITIES, "empty ready list");
+  check(Sched_Next(0) == 0, "nothing to run");
+  for(i=0; i<8; i++){
+    T[i].priority = 5;
+  }
+  T[1].priority = 3;
+  T[3].priority = NUMPRIORITIES-1;
+  T[4].priority = 0;
+  Sched_Insert(&T[0]);
+  Sched_Insert(&T[1]);
+  Sched_Insert(&T[2]);
+  Sched_Insert(&T[3]);
+  check(Sched_Highest() == 3, "highest priority");
+  check(Sched_Next(0) == &T[1], "highest runs first");
+  check(Sched_Next(&T[1]) == &T[1], "only thread at its level runs again");
+  Sched_Insert(&T[4]);
+  check(Sched_Next(&T[1]) == &T[4], "priority 0 preempts");
+  check(Sched_OnlyReady(&T[4]) == 0, "others are ready");
+  Sched_Remove(&T[4]);
+  Sched_Remove(&T[1]);
+  check(Sched_Highest() == 5, "next level down");
+  pt = Sched_Next(0);
+  check(pt == &T[0], "front of level 5");
+  pt = Sched_Next(pt);
+  check(pt == &T[2], "round robin");
+  pt = Sched_Next(pt);
+  check(pt == &T[0], "round robin wraps");
+  Sched_Insert(&T[5]);
+  pt = Sched_Next(pt);
+  check(pt == &T[2], "added at the back");
+  pt = Sched_Next(pt);
+  check(pt == &T[5], "added at the back");
+  Sched_Remove(&T[5]);
+  check(Sched_Preempts(&T[1], &T[0]) == 1, "higher priority preempts");
+  check(Sched_Preempts(&T[2], &T[0]) == 0, "equal priority waits");
+  check(Sched_Preempts(&T[3], &T[0]) == 0, "lower priority waits");
+
+  list = 0;                   // blocked list
+  Sched_BlockOn(&list, &T[3]);
+  Sched_BlockOn(&list, &T[0]);
+  Sched_BlockOn(&list, &T[2]);
+  Sched_Insert(&T[1]);
+  Sched_BlockOn(&list, &T[1]);
+  check(Sched_Highest() == NUMPRIORITIES, "all blocked");
+  check(Sched_Unblock(&list) == &T[1], "highest priority unblocks first");
+  check(Sched_Unblock(&list) == &T[0], "then first come first served");
+  check(Sched_Unblock(&list) == &T[2], "then first come first served");
+  check(Sched_Unblock(&list) == &T[3], "lowest last");
+  check(Sched_Unblock(&list) == 0, "blocked list empty");
+  check(Sched_Highest() == 3, "unblocked threads are ready");
+
+  now = 0xFFFFFFF0;           // wake times wrap around to 4
+  Sched_Sleep(&T[2], now+5);
+  Sched_Sleep(&T[0], now+20);
+  Sched_Sleep(&T[1], now+10);
+  check(Sched_NextWake(&wake) && (wake == now+5), "soonest wake time");
+  check(Sched_Wake(now+4) == 0, "nobody wakes early");
+  check(Sched_Wake(now+5) == &T[2], "first sleeper wakes");
+  check(Sched_NextWake(&wake) && (wake == now+10), "sorted past the wrap");
+  check(Sched_Wake(now+20) == &T[1], "highest priority of two woken");
+  check(Sched_NextWake(&wake) == 0, "sleeping list empty");
+  Sched_Remove(&T[0]);
+  Sched_Remove(&T[1]);
+  Sched_Remove(&T[2]);
+  check(Sched_OnlyReady(&T[3]) == 1, "only one ready");
+}
+
+//************switching through os.c*************
+#define SLICE  TIME_1MS
+Sema4Type Never;              // nobody signals it
+uint32_t LowCount,HighCount,LowAtHigh,HighDone,HighAdded;
+void High(void){
+  LowAtHigh = LowCount;
+  HighCount = 0;
+  while(HighCount < 300){     // 3 time slices
+    SimRun(SLICE/100);
+    HighCount++;
+  }
+  HighDone = (LowCount == LowAtHigh);
+  OS_Wait(&Never);            // blocks for good
+}
+void Low(void){
+  for(;;){
+    SimRun(SLICE/100);
+    LowCount++;
+    if(LowCount == 150){
+      HighAdded = SimAddThread(&High, STACKSIZE, 2, 8);
+      check(HighCount == 300, "OS_AddThread switches before it returns");
+    }
+  }
+}
+uint32_t Share[3];
+void Even0(void){ for(;;){ SimRun(100); Share[0]++; } }
+void Even1(void){ for(;;){ SimRun(100); Share[1]++; } }
+void Lower(void){ for(;;){ SimRun(100); Share[2]++; } }
+void testSwitch(void){
+  printf("switching\n");
+  SimStart(10*SLICE, IDLEDEPTH);
+  OS_InitSemaphore(&Never, 0);
+  LowCount = HighCount = HighDone = HighAdded = 0;
+  SimAddThread(&Low, STACKSIZE, 10, 8);
+  OS_Launch(SLICE);
+  check(HighAdded, "thread added while running");
+  check(HighDone, "lower priority waits while High runs");
+  check(LowCount > 150+400, "Low runs again once High blocks");
+  printf("  add and preempt: High ran %u steps, Low ran %u, %u switches\n",
+         HighCount, LowCount, SimSwitches);
+
+  SimStart(100*SLICE, IDLEDEPTH);
+  Share[0] = Share[1] = Share[2] = 0;
+  SimAddThread(&Even0, STACKSIZE, 5, 8);
+  SimAddThread(&Even1, STACKSIZE, 5, 8);
+  SimAddThread(&Lower, STACKSIZE, 6, 8);
+  OS_Launch(SLICE);
+  check((Share[0] > 24000)&&(Share[1] > 24000), "equal priorities share");
+  check(Share[2] == 0, "lower priority never runs");
+  check(tcbs[0].cycles == 0, "Idle never runs");
+  check((SimTicks == 100)&&(SimSwitches >= 99), "one switch per slice");
+  printf("  round robin: %u and %u steps, lower %u, %u ticks, %u switches\n",
+         Share[0], Share[1], Share[2], SimTicks, SimSwitches);
+}
+
+//************wasted time slices*************
+// Consumer handles data from an interrupt every 2 ms, Periodic runs
+// every 10 ms and Worker always has something to do, all three at
+// DEFAULTPRIORITY like user.c.  Cycles spent checking for something
+// to do are wasted, and Worker could have had them.
+#define SLICE2  (TIME_2MS)
+#define SPIN    50            // bus cycles to check once
+#define RUNTIME (500*(uint64_t)SLICE2) // one second
+#define SEMA    1             // Consumer blocks on a semaphore
+#define SLEEP   2             // Periodic sleeps
+#define SUSPEND 4             // spinning threads give up the slice
+uint32_t Mode;
+Sema4Type DataReady;
+volatile uint32_t DataWaiting;// spinning version of DataReady
+uint32_t Events,Handled,PeriodicRuns,WorkDone;
+uint64_t Spun;                // wasted bus cycles
+void DataISR(void){
+  SimEventTime = SimEventTime + SLICE2;
+  Events++;
+  DataWaiting++;
+  OS_Signal(&DataReady);
+}
+void spin(void){
+  SimRun(SPIN);
+  Spun = Spun + SPIN;
+  if(Mode&SUSPEND){
+    OS_Suspend();
+  }
+}
+void Consumer(void){
+  for(;;){
+    if(Mode&SEMA){
+      OS_Wait(&DataReady);
+    } else{
+      while(DataWaiting == 0){
+        spin();
+      }
+      DataWaiting--;          // only Consumer decrements
+    }
+    SimRun(20000);            // 400 us of work on the data
+    Handled++;
+  }
+}
+void Periodic(void){ uint32_t next;
+  next = OS_Time();
+  for(;;){
+    next = next + 5;          // 10 ms
+    if(Mode&SLEEP){
+      if((int32_t)(next-OS_Time()) > 0){
+        OS_Sleep(2*(next-OS_Time()));  // the rest of the 10 ms
+      }
+    } else{
+      while((int32_t)(OS_Time()-next) < 0){
+        spin();
+      }
+    }
+    SimRun(50000);            // 1 ms of work
+    PeriodicRuns++;
+  }
+}
+void Worker(void){
+  for(;;){
+    SimRun(100);
+    WorkDone++;
+  }
+}
+void testWasted(void){ uint32_t modes[5]={0,SUSPEND,SEMA,SLEEP,SEMA|SLEEP};
+  const char *names[5]={"spin","spin, OS_Suspend","semaphore","OS_Sleep","semaphore, OS_Sleep"};
+  double slices[5],work[5]; int i;
+  printf("wasted time slices, one second, %u slices\n", (uint32_t)(RUNTIME/SLICE2));
+  printf("  %-20s %8s %7s %9s %8s\n", "Consumer, Periodic", "wasted", "Worker", "handled", "periodic");
+  for(i=0; i<5; i++){
+    Mode = modes[i];
+    SimStart(RUNTIME, IDLEDEPTH);
+    OS_InitSemaphore(&DataReady, 0);
+    DataWaiting = 0;
+    Events = Handled = PeriodicRuns = WorkDone = 0;
+    Spun = 0;
+    SimAddThread(&Consumer, STACKSIZE, DEFAULTPRIORITY, 8);
+    SimAddThread(&Periodic, STACKSIZE, DEFAULTPRIORITY, 8);
+    SimAddThread(&Worker, STACKSIZE, DEFAULTPRIORITY, 8);
+    SimEvent = &DataISR;
+    SimEventTime = SLICE2/2;
+    OS_Launch(SLICE2);
+    slices[i] = (double)Spun/SLICE2;
+    work[i] = 100.0*WorkDone*100/RUNTIME;
+    printf("  %-20s %8.1f %6.1f%% %4u/%-4u %8u\n", names[i], slices[i],
+           work[i], Handled, Events, PeriodicRuns);
+    check(Handled+2 >= Events, "every event handled");
+    check(PeriodicRuns >= 95, "Periodic every 10 ms");
+  }
+  check(slices[4] == 0, "no polling when blocking");
+  check(work[4] > work[0], "Worker gets the wasted time");
+  for(i=1; i<5; i++){
+    printf("  %s saves %.1f slices a second over spinning\n", names[i], slices[0]-slices[i]);
+  }
+}
+
+//************tickless idle*************
+// Sensor samples every 100 ms, Radio handles a message that comes
+// every second, the processor sleeps the rest of the time
+#define TICK   (TIME_1MS)
+Sema4Type Message;
+uint32_t Samples,Messages,Received,Late;
+uint64_t WokeAt;              // when Sensor last woke up
+void RadioISR(void){
+  SimEventTime = SimEventTime + 1000*(uint64_t)TICK + 12345;
+  Messages++;
+  OS_Signal(&Message);
+}
+void Sensor(void){
+  for(;;){
+    OS_Sleep(100);
+    WokeAt = SimNow;
+    if(OS_Time() != 100*(Samples+1)){
+      Late++;                 // woke at the wrong system time
+    }
+    SimRun(25000);            // 500 us
+    Samples++;
+  }
+}
+void Radio(void){
+  for(;;){
+    OS_Wait(&Message);
+    SimRun(100000);           // 2 ms
+    Received++;
+  }
+}
+void TickIdle(void){          // Idle when TICKLESS is 0
+  for(;;){
+    WaitForInterrupt();
+  }
+}
+void node(int tickless, uint64_t cycles){
+  SimStart(cycles, IDLEDEPTH);
+  if(!tickless){
+    Task[0] = &TickIdle;
+  }
+  OS_InitSemaphore(&Message, 0);
+  Samples = Messages = Received = Late = 0;
+  SimAddThread(&Sensor, STACKSIZE, 1, 8);
+  SimAddThread(&Radio, STACKSIZE, 2, 8);
+  SimEvent = &RadioISR;
+  SimEventTime = 1000*(uint64_t)TICK + 12345;
+}
+void testTickless(void){ uint32_t ticks,samples,received; int d,bad;
+  uint64_t run,wake;
+  printf("tickless idle, 10 seconds of 1 ms slices\n");
+  run = 10000*(uint64_t)TICK;
+  node(0, run);
+  OS_Launch(TICK);
+  ticks = SimTicks;
+  samples = Samples;
+  received = Received;
+  printf("  WaitForInterrupt  %5u SysTick interrupts, time %u, %u samples, %u messages, asleep %.2f%%\n",
+         SimTicks, OS_Time(), Samples, Received, 100.0*SimAsleep/SimNow);
+  node(1, run);
+  OS_Launch(TICK);
+  printf("  TicklessSleep     %5u SysTick interrupts, time %u, %u samples, %u messages, asleep %.2f%%\n",
+         SimTicks, OS_Time(), Samples, Received, 100.0*SimAsleep/SimNow);
+  printf("  %u interrupts avoided, OS_SlicesSkipped %u\n", ticks-SimTicks, OS_SlicesSkipped());
+  check((Samples == samples)&&(Received == received), "same wake ups");
+  check((Samples == 99)&&(Late == 0), "Sensor wakes on time");
+  check(SimTicks+OS_SlicesSkipped() == OS_Time(), "every slice counted once");
+  check(SimTicks < ticks/20, "most ticks avoided");
+
+  node(1, 150*(uint64_t)TICK);  // when Sensor wakes with no radio
+  OS_Launch(TICK);
+  wake = WokeAt;
+  bad = 0;
+  for(d=-16; d<=4; d++){      // the radio interrupt near that time
+    node(1, 250*(uint64_t)TICK);
+    SimEventTime = wake+d;
+    OS_Launch(TICK);
+    if((Samples != 2)||(Late != 0)||(Received != 1)){
+      printf("  radio at %+d: time %u, %u samples, %u messages\n", d,
+             OS_Time(), Samples, Received);
+      bad++;
+    }
+  }
+  check(bad == 0, "interrupt at the end of a long period");
+}
+
+//************stacks*************
+// Half is busy half of each slice, Deep runs past its stack, Guard
+// writes over only its guard word, as a large local array would
+uint32_t HalfRuns;
+void Half(void){
+  for(;;){
+    SimRun(TIME_1MS/2);
+    HalfRuns++;
+    OS_Sleep(1);
+  }
+}
+void Deep(void){
+  for(;;){
+    SimRun(1000);
+    OS_Sleep(1);
+  }
+}
+void Guard(void){
+  RunPt->stack[0] = 0;
+  for(;;){
+    SimRun(1000);
+    OS_Sleep(1);
+  }
+}
+void testStacks(void){ ThreadStatsType stats[NUMTHREADS]; uint32_t n,i,load; int added;
+  printf("stacks, Idle %d words deep when interrupted\n", IDLEDEPTH+16);
+  SimStart(200*(uint64_t)TIME_1MS, IDLEDEPTH);
+  SimAddThread(&Half, STACKSIZE, 5, 30);
+  OS_Launch(TIME_1MS);
+  n = OS_Stats(stats, NUMTHREADS);
+  load = 0;
+  for(i=0; i<n; i++){
+    load = load+stats[i].load;
+  }
+  printf("  Idle %u of %u words, Half %u of %u, loads %u + %u\n", stats[0].stackUsed,
+         stats[0].stackWords, stats[1].stackUsed, stats[1].stackWords, stats[0].load, stats[1].load);
+  check((n == 2)&&(stats[0].stackWords == IDLESTACKSIZE), "Idle gets IDLESTACKSIZE");
+  check((stats[0].stackUsed == IDLEDEPTH+16)&&(stats[0].overflow == 0), "Idle within its stack");
+  check(stats[1].stackUsed == 30+16, "most words used");
+  check((StackFault == 0)&&(HalfRuns > 150), "no overflow");
+  check((load >= 999)&&(load <= 1001), "loads add to 1000");
+  check((stats[0].load > 450)&&(stats[0].load < 550), "Idle half the time");
+
+  SimStart(50*(uint64_t)TIME_1MS, IDLEDEPTH); // Idle as it was, on MINSTACKSIZE,
+  SimAddThread(&TickIdle, MINSTACKSIZE, NUMPRIORITIES-2, IDLEDEPTH); // runs in its place
+  SimAddThread(&Half, STACKSIZE, 5, 30);
+  OS_Launch(TIME_1MS);
+  OS_Stats(stats, NUMTHREADS);
+  printf("  Idle on %d words: overflow %u\n", MINSTACKSIZE, stats[1].overflow);
+  check((stats[1].overflow == 1)&&(StackFault == &tcbs[1]), "MINSTACKSIZE is too small for Idle");
+  check(stats[0].overflow == 0, "the real Idle does not overflow");
+
+  SimStart(50*(uint64_t)TIME_1MS, IDLEDEPTH);
+  SimAddThread(&Deep, STACKSIZE, 5, STACKSIZE-16);
+  SimAddThread(&Guard, STACKSIZE, 6, 20);
+  OS_Launch(TIME_1MS);
+  OS_Stats(stats, NUMTHREADS);
+  check((stats[1].overflow == 1)&&(StackFault == &tcbs[1]), "saved SP below the stack");
+  check(stats[2].overflow == 1, "guard word overwritten");
+  check(stats[0].overflow == 0, "Idle not blamed");
+
+  SimStart(0, IDLEDEPTH);
+  added = 0;
+  while(SimAddThread(&Deep, STACKSIZE, 5, 8)){
+    added++;
+  }
+  printf("  %d threads of %d words fit with Idle, %u of %d words used\n", added,
+         STACKSIZE, StackUsed, STACKPOOLSIZE);
+  check(added == NUMTHREADS-1, "every tcb can have a STACKSIZE stack");
+  for(i=0; i<NumThreads; i++){
+    if(((uintptr_t)&tcbs[i].stack[tcbs[i].stackWords])&7){
+      break;
+    }
+  }
+  check(i == NumThreads, "the top of every stack is 8-byte aligned");
+}
+
+//************benchmark*************
+// the choice of the next thread with n priority levels ready, one
+// thread readied, chosen and removed each time, the way OS_Signal
+// then OS_Wait would
+tcbType B[NUMPRIORITIES+1];
+int BReady[NUMPRIORITIES+1];
+volatile uintptr_t Sink;
+tcbType *linearNext(uint32_t n){ tcbType *best; uint32_t i; // n+1 threads
+  best = 0;
+  for(i=0; i<=n; i++){
+    if(BReady[i] && ((best == 0)||(B[i].priority < best->priority))){
+      best = &B[i];
+    }
+  }
+  return best;
+}
+double seconds(void){ struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9*t.tv_nsec;
+}
+#define REPS 10000000
+void benchmark(void){ uint32_t n,i,k; double t0,t1,t2; tcbType *moved;
+  printf("benchmark, ns to ready, choose and remove one thread\n");
+  printf("  ready levels  Sched_Next  linear search\n");
+  for(n=1; n<=NUMPRIORITIES; n=n*2){
+    Sched_Init();
+    for(i=0; i<n; i++){
+      B[i].priority = NUMPRIORITIES-1-i;
+      BReady[i] = 1;
+      Sched_Insert(&B[i]);
+    }
+    moved = &B[n];            // readied at a middle priority
+    moved->priority = NUMPRIORITIES/2;
+    t0 = seconds();
+    for(k=0; k<REPS; k++){
+      Sched_Insert(moved);
+      Sink = (uintptr_t)Sched_Next(0);
+      Sched_Remove(moved);
+    }
+    t1 = seconds();
+    for(k=0; k<REPS; k++){
+      BReady[n] = 1;
+      Sink = (uintptr_t)linearNext(n);
+      BReady[n] = 0;
+    }
+    t2 = seconds();
+    printf("  %12u  %10.2f  %13.2f\n", n, 1e9*(t1-t0)/REPS, 1e9*(t2-t1)/REPS);
+  }
+}
+
+int main(void){
+  testSched();
+  testSwitch();
+  testWasted();
+  testTickless();
+  testStacks();
+  benchmark();
+  if(Errors){
+    printf("%d failed\n", Errors);
+    return 1;
+  }
+  printf("all passed\n");
+  return 0;
+}
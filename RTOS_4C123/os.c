@@ -24,17 +24,32 @@
 
 #include <stdint.h>
 #include "os.h"
+#include "sched.h"
 #include "PLL.h"
 
-#define NVIC_ST_CTRL_R          (*((volatile uint32_t *)0xE000E010))
+#define NVIC_ST_CTRL_COUNT      0x00010000  // Count flag
 #define NVIC_ST_CTRL_CLK_SRC    0x00000004  // Clock Source
 #define NVIC_ST_CTRL_INTEN      0x00000002  // Interrupt enable
 #define NVIC_ST_CTRL_ENABLE     0x00000001  // Counter mode
+#define NVIC_INT_CTRL_PENDSTSET 0x04000000  // Set pending SysTick interrupt
+#ifndef OSSIM                 // RTOSSim.c simulates these on a PC
+#define NVIC_ST_CTRL_R          (*((volatile uint32_t *)0xE000E010))
 #define NVIC_ST_RELOAD_R        (*((volatile uint32_t *)0xE000E014))
 #define NVIC_ST_CURRENT_R       (*((volatile uint32_t *)0xE000E018))
 #define NVIC_INT_CTRL_R         (*((volatile uint32_t *)0xE000ED04))
-#define NVIC_INT_CTRL_PENDSTSET 0x04000000  // Set pending SysTick interrupt
 #define NVIC_SYS_PRI3_R         (*((volatile uint32_t *)0xE000ED20))  // Sys. Handlers 12 to 15 Priority
+#define SYSCTL_RCGCTIMER_R      (*((volatile uint32_t *)0x400FE604))
+#define SYSCTL_PRTIMER_R        (*((volatile uint32_t *)0x400FEA04))
+#define TIMER5_CFG_R            (*((volatile uint32_t *)0x40035000))
+#define TIMER5_TAMR_R           (*((volatile uint32_t *)0x40035004))
+#define TIMER5_CTL_R            (*((volatile uint32_t *)0x4003500C))
+#define TIMER5_TAILR_R          (*((volatile uint32_t *)0x40035028))
+#define TIMER5_TAPR_R           (*((volatile uint32_t *)0x40035038))
+#define TIMER5_TAV_R            (*((volatile uint32_t *)0x40035050))
+#endif
+// Timer5A counts down from 0xFFFFFFFF at the bus clock and keeps
+// counting while the processor sleeps, CPUTIME counts up
+#define CPUTIME                 (0xFFFFFFFF - TIMER5_TAV_R)
 
 // function definitions in osasm.s
 void OS_DisableInterrupts(void); // Disable interrupts
@@ -42,21 +57,123 @@ void OS_EnableInterrupts(void);  // Enable interrupts
 int32_t StartCritical(void);
 void EndCritical(int32_t primask);
 void StartOS(void);
+// function definition in startup.s
+void WaitForInterrupt(void);  // low power mode
 
-#define NUMTHREADS  3        // maximum number of threads
-#define STACKSIZE   100      // number of 32-bit words in stack
-struct tcb{
-  int32_t *sp;       // pointer to stack (valid for threads not running
-  struct tcb *next;  // linked-list pointer
-};
-typedef struct tcb tcbType;
+#define NUMTHREADS  8        // maximum number of threads
+#define STACKPOOLSIZE 832    // total 32-bit words available for all stacks
+#define MINSTACKSIZE  32     // smallest stack, 16 words are the initial frame
+#define IDLESTACKSIZE 128    // stack for Idle, see the budget above Idle
+#define STACKGUARD  0xDEADBEEF // lowest word of every stack
+#define STACKPAINT  0x5A5A5A5A // rest of the stack before it is used
 tcbType tcbs[NUMTHREADS];
 tcbType *RunPt;
-int32_t Stacks[NUMTHREADS][STACKSIZE];
+int32_t StackPool[STACKPOOLSIZE] __attribute__ ((aligned(8))); // AAPCS wants SP 8-byte aligned
+uint32_t NumThreads;         // number of tcbs in use
+uint32_t StackUsed;          // number of StackPool words given out
+uint32_t TimeSlice;          // number of bus cycles in each time slice
+uint32_t SystemTime;         // number of time slices since OS_Launch
+uint32_t SlicesSkipped;      // time slices that passed with no SysTick interrupt
+uint32_t SwitchTime;         // CPUTIME when RunPt started running
+tcbType *StackFault;         // first thread whose stack overflowed
+
+#if TICKLESS
+// ******** TicklessSleep ************
+// called by Idle when no other thread is ready
+// stretch the SysTick period to reach the next sleeping thread's wake
+// time, sleep, then add the slices that went by to SystemTime
+// SysTick is 24 bits, so one sleep lasts at most 0x1000000 bus cycles
+// SystemTime stays correct to within a few bus cycles per sleep
+// input:  none
+// output: none
+void TicklessSleep(void){ int32_t status;
+  uint32_t slices,wake,remaining,left,done;
+  status = StartCritical();
+  if((Sched_OnlyReady(RunPt) == 0) ||                  // a thread woke up
+     (NVIC_INT_CTRL_R&NVIC_INT_CTRL_PENDSTSET)){       // or a tick is due
+    EndCritical(status);
+    return;
+  }
+  slices = 0x01000000/TimeSlice;                       // longest possible
+  if(Sched_NextWake(&wake) && (wake - SystemTime < slices)){
+    slices = wake - SystemTime;
+  }
+  remaining = NVIC_ST_CURRENT_R;      // bus cycles left in this slice
+  if((slices < 2)||(remaining == 0)){
+    WaitForInterrupt();               // next tick is soon enough
+    EndCritical(status);
+    return;
+  }
+  NVIC_ST_CTRL_R = 0;                 // stop, and clear the count flag
+  NVIC_ST_RELOAD_R = remaining + (slices-1)*TimeSlice - 1;
+  NVIC_ST_CURRENT_R = 0;              // load the long period
+  NVIC_ST_CTRL_R = 0x00000007;
+  while(NVIC_ST_CURRENT_R == 0){};    // wait for the long period to load
+  NVIC_ST_RELOAD_R = TimeSlice - 1;   // used after the long period ends
+  WaitForInterrupt();                 // wakes up even though I=1
+  if(NVIC_ST_CTRL_R&NVIC_ST_CTRL_COUNT){ // the long period ended
+    done = slices;                    // the pending SysTick will not count
+    SlicesSkipped = SlicesSkipped + slices - 1;
+  } else{                             // some other interrupt woke us up
+    NVIC_ST_CTRL_R = 0;
+    left = NVIC_ST_CURRENT_R;         // bus cycles left of the long period
+    if(left == 0){                    // it ended just after COUNT was read
+      done = slices;
+      SlicesSkipped = SlicesSkipped + slices - 1;
+      NVIC_ST_RELOAD_R = TimeSlice - 1;
+      NVIC_ST_CURRENT_R = 0;          // clears COUNT, so the pending SysTick
+      NVIC_ST_CTRL_R = 0x00000007;    // will not count
+    } else{
+      done = slices - 1 - (left-1)/TimeSlice;
+      left = (left-1)%TimeSlice;      // rest of the current slice
+      if(left == 0){
+        left = 1;                     // reload of 0 would never interrupt
+      }
+      NVIC_ST_RELOAD_R = left;
+      NVIC_ST_CURRENT_R = 0;
+      NVIC_ST_CTRL_R = 0x00000007;
+      while(NVIC_ST_CURRENT_R == 0){};
+      NVIC_ST_RELOAD_R = TimeSlice - 1;
+      SlicesSkipped = SlicesSkipped + done;
+    }
+  }
+  if(done){
+    SystemTime = SystemTime + done;
+    if(Sched_Wake(SystemTime)){
+      NVIC_INT_CTRL_R = NVIC_INT_CTRL_PENDSTSET; // switch to it
+    }
+  }
+  EndCritical(status);                // the waking interrupt runs now
+}
+#endif
+
+// runs at the lowest priority when every other thread is blocked
+// Threads run on the main stack, so each interrupt and the context
+// switch itself use the stack of whichever thread was running.
+// Idle is interrupted more than any other thread, so its stack is
+// sized for the worst case, in 32-bit words:
+//   Idle and TicklessSleep, with the calls it makes      12
+//   exception frame of SysTick_Handler or another ISR     8
+//   R4-R11 and {R0,LR} pushed by SysTick_Handler         10
+//   Scheduler, StackCheck and Sched_Wake                 12
+//   two nested ISRs that call OS_Signal                  36
+//   total                                                78
+// An exception frame is 26 words instead of 8 when the interrupted
+// code has live floating point registers; 128 leaves room for two.
+// OS_Stats shows how much of it has been used.
+void Idle(void){
+  for(;;){
+#if TICKLESS
+    TicklessSleep();
+#else
+    WaitForInterrupt();
+#endif
+  }
+}
 
 // ******** OS_Init ************
 // initialize operating system, disable interrupts until OS_Launch
-// initialize OS controlled I/O: systick, 50 MHz PLL
+// initialize OS controlled I/O: systick, 50 MHz PLL, Timer5A for CPU time
 // input:  none
 // output: none
 void OS_Init(void){
@@ -65,44 +182,309 @@ void OS_Init(void){
   NVIC_ST_CTRL_R = 0;         // disable SysTick during setup
   NVIC_ST_CURRENT_R = 0;      // any write to current clears it
   NVIC_SYS_PRI3_R =(NVIC_SYS_PRI3_R&0x00FFFFFF)|0xE0000000; // priority 7
+  SYSCTL_RCGCTIMER_R |= 0x20; // activate Timer5 for CPUTIME
+  while((SYSCTL_PRTIMER_R&0x20) == 0){};
+  TIMER5_CTL_R = 0;           // disable Timer5A during setup
+  TIMER5_CFG_R = 0;           // 32-bit mode
+  TIMER5_TAMR_R = 0x00000002; // periodic, down-count, no interrupts
+  TIMER5_TAILR_R = 0xFFFFFFFF;// full 32-bit range
+  TIMER5_TAPR_R = 0;          // bus clock resolution
+  TIMER5_CTL_R = 0x00000001;  // enable Timer5A
+  Sched_Init();               // no threads are ready
+  RunPt = 0;                  // not running until OS_Launch
+  NumThreads = 0;
+  StackUsed = 0;
+  SystemTime = 0;
+  SlicesSkipped = 0;
+  StackFault = 0;
+  OS_AddThread(&Idle, IDLESTACKSIZE, NUMPRIORITIES-1);
 }
 
-void SetInitialStack(int i){
-  tcbs[i].sp = &Stacks[i][STACKSIZE-16]; // thread stack pointer
-  Stacks[i][STACKSIZE-1] = 0x01000000;   // thumb bit
-  Stacks[i][STACKSIZE-3] = 0x14141414;   // R14
-  Stacks[i][STACKSIZE-4] = 0x12121212;   // R12
-  Stacks[i][STACKSIZE-5] = 0x03030303;   // R3
-  Stacks[i][STACKSIZE-6] = 0x02020202;   // R2
-  Stacks[i][STACKSIZE-7] = 0x01010101;   // R1
-  Stacks[i][STACKSIZE-8] = 0x00000000;   // R0
-  Stacks[i][STACKSIZE-9] = 0x11111111;   // R11
-  Stacks[i][STACKSIZE-10] = 0x10101010;  // R10
-  Stacks[i][STACKSIZE-11] = 0x09090909;  // R9
-  Stacks[i][STACKSIZE-12] = 0x08080808;  // R8
-  Stacks[i][STACKSIZE-13] = 0x07070707;  // R7
-  Stacks[i][STACKSIZE-14] = 0x06060606;  // R6
-  Stacks[i][STACKSIZE-15] = 0x05050505;  // R5
-  Stacks[i][STACKSIZE-16] = 0x04040404;  // R4
+void SetInitialStack(tcbType *thread){ int32_t *top; uint32_t i;
+  thread->stack[0] = STACKGUARD; // overwritten only if the stack overflows
+  for(i=1; i<thread->stackWords; i++){
+    thread->stack[i] = STACKPAINT; // OS_Stats looks for the highest change
+  }
+  top = &thread->stack[thread->stackWords]; // one past the highest word
+  thread->sp = top-16;      // thread stack pointer
+  top[-1] = 0x01000000;     // thumb bit
+  top[-3] = 0x14141414;     // R14
+  top[-4] = 0x12121212;     // R12
+  top[-5] = 0x03030303;     // R3
+  top[-6] = 0x02020202;     // R2
+  top[-7] = 0x01010101;     // R1
+  top[-8] = 0x00000000;     // R0
+  top[-9] = 0x11111111;     // R11
+  top[-10] = 0x10101010;    // R10
+  top[-11] = 0x09090909;    // R9
+  top[-12] = 0x08080808;    // R8
+  top[-13] = 0x07070707;    // R7
+  top[-14] = 0x06060606;    // R6
+  top[-15] = 0x05050505;    // R5
+  top[-16] = 0x04040404;    // R4
 }
 
 //******** OS_AddThread ***************
+// add one foreground thread to the scheduler
+// may be called before or after OS_Launch
+// Inputs: pointer to a void/void foreground task
+//         number of 32-bit words to allocate for its stack
+//         priority, 0 is highest, NUMPRIORITIES-1 is lowest
+// Outputs: 1 if successful, 0 if this thread can not be added
+int OS_AddThread(void(*task)(void), uint32_t stackWords, uint32_t priority){
+  int32_t status; tcbType *thread;
+  if(priority >= NUMPRIORITIES){
+    return 0;                 // invalid priority
+  }
+  if(stackWords < MINSTACKSIZE){
+    stackWords = MINSTACKSIZE;
+  }
+  stackWords = (stackWords+1)&~1; // keep stacks 8-byte aligned
+  status = StartCritical();
+  if((NumThreads == NUMTHREADS)||(StackUsed+stackWords > STACKPOOLSIZE)){
+    EndCritical(status);
+    return 0;                 // out of tcbs or out of stack space
+  }
+  thread = &tcbs[NumThreads];
+  NumThreads = NumThreads + 1;
+  thread->stack = &StackPool[StackUsed];
+  thread->stackWords = stackWords;
+  StackUsed = StackUsed + stackWords;
+  thread->priority = priority;
+  thread->overflow = 0;
+  thread->cycles = 0;
+  thread->lastCycles = 0;
+  SetInitialStack(thread);
+  thread->stack[stackWords-2] = (int32_t)(task); // PC
+  Sched_Insert(thread);
+  if(RunPt && Sched_Preempts(thread, RunPt)){
+    NVIC_INT_CTRL_R = NVIC_INT_CTRL_PENDSTSET; // switch to it now
+  }
+  EndCritical(status);
+  return 1;                   // successful
+}
+
+//******** OS_AddThreads ***************
 // add three foregound threads to the scheduler
+// all three run round robin at the same priority
 // Inputs: three pointers to a void/void foreground tasks
 // Outputs: 1 if successful, 0 if this thread can not be added
 int OS_AddThreads(void(*task0)(void),
                  void(*task1)(void),
-                 void(*task2)(void)){ int32_t status;
+                 void(*task2)(void)){
+  if(OS_AddThread(task0, STACKSIZE, DEFAULTPRIORITY) == 0) return 0;
+  if(OS_AddThread(task1, STACKSIZE, DEFAULTPRIORITY) == 0) return 0;
+  return OS_AddThread(task2, STACKSIZE, DEFAULTPRIORITY);
+}
+
+// ******** StackCheck ************
+// the saved context must be above the guard word, and the guard
+// word must not have changed
+// with STACKHALT the system stops here, look at StackFault in the
+// debugger; the stack below this one has been overwritten
+// input:  thread that just stopped running, with its SP saved
+// output: none
+void StackCheck(tcbType *thread){
+  if(((uint32_t)thread->stack[0] != STACKGUARD)||(thread->sp < &thread->stack[1])){
+    thread->overflow = 1;
+    if(StackFault == 0){
+      StackFault = thread;
+    }
+#if STACKHALT
+    for(;;){}
+#endif
+  }
+}
+
+//******** Scheduler ***************
+// called from SysTick_Handler in osasm.s after the old SP is saved
+// the handler also runs when a switch is pended by OS_Suspend, OS_Wait,
+// OS_Signal or OS_Sleep, so only count time if SysTick reached zero
+// charges the time since the last switch to the old thread, and
+// checks its stack
+// round robin among the highest priority ready threads
+// Inputs: none
+// Outputs: none, RunPt is the thread to run
+void Scheduler(void){ uint32_t now;
+  now = CPUTIME;
+  RunPt->cycles = RunPt->cycles + (now - SwitchTime);
+  SwitchTime = now;
+  StackCheck(RunPt);
+  if(NVIC_ST_CTRL_R&NVIC_ST_CTRL_COUNT){ // reading clears the flag
+    SystemTime = SystemTime + 1;
+    Sched_Wake(SystemTime);   // sleeping threads whose time has come
+  }
+  RunPt = Sched_Next(RunPt);
+}
+
+//******** OS_Suspend ***************
+// give up the rest of this time slice, run the next ready thread now
+// the next thread gets what is left of the slice, SysTick is not
+// cleared so that SystemTime stays correct
+// Inputs: none
+// Outputs: none
+void OS_Suspend(void){
+  NVIC_INT_CTRL_R = NVIC_INT_CTRL_PENDSTSET; // trigger SysTick
+}
+
+// ******** OS_InitSemaphore ************
+// initialize counting semaphore
+// Inputs:  pointer to a semaphore
+//          initial value of semaphore
+// Outputs: none
+void OS_InitSemaphore(Sema4Type *semaPt, int32_t value){
+  semaPt->Value = value;
+  semaPt->BlockPt = 0;        // nobody is waiting
+}
+
+// ******** OS_Wait ************
+// decrement semaphore, block this thread if less than zero
+// the blocked thread uses no processor time until OS_Signal
+// called from a thread, never from an interrupt
+// Inputs:  pointer to a counting semaphore
+// Outputs: none
+void OS_Wait(Sema4Type *semaPt){ int32_t status;
+  status = StartCritical();
+  semaPt->Value = semaPt->Value - 1;
+  if(semaPt->Value < 0){
+    Sched_BlockOn(&semaPt->BlockPt, RunPt);
+    NVIC_INT_CTRL_R = NVIC_INT_CTRL_PENDSTSET; // switch when enabled
+  }
+  EndCritical(status);
+}
+
+// ******** OS_Signal ************
+// increment semaphore, wake up the highest priority blocked thread
+// switch to it immediately if it is higher priority than this thread
+// may be called from a thread or from an interrupt
+// Inputs:  pointer to a counting semaphore
+// Outputs: none
+void OS_Signal(Sema4Type *semaPt){ int32_t status; tcbType *thread;
+  status = StartCritical();
+  semaPt->Value = semaPt->Value + 1;
+  if(semaPt->Value <= 0){
+    thread = Sched_Unblock(&semaPt->BlockPt);
+    if(Sched_Preempts(thread, RunPt)){
+      NVIC_INT_CTRL_R = NVIC_INT_CTRL_PENDSTSET;
+    }
+  }
+  EndCritical(status);
+}
+
+//******** OS_Sleep ***************
+// put this thread to sleep, it uses no processor time while sleeping
+// it wakes up at the time slice boundary on or after ms milliseconds,
+// so the resolution is one time slice
+// called from a thread, never from an interrupt
+// Inputs: number of milliseconds to sleep, 0 is the same as OS_Suspend
+// Outputs: none
+void OS_Sleep(uint32_t ms){ int32_t status; uint32_t slices;
+  slices = (uint32_t)(((uint64_t)ms*TIME_1MS + TimeSlice - 1)/TimeSlice);
+  if(slices == 0){
+    OS_Suspend();
+    return;
+  }
+  status = StartCritical();
+  Sched_Sleep(RunPt, SystemTime + slices);
+  NVIC_INT_CTRL_R = NVIC_INT_CTRL_PENDSTSET; // run someone else
+  EndCritical(status);
+}
+
+//******** OS_Time ***************
+// number of time slices since OS_Launch
+// Inputs: none
+// Outputs: system time in time slice units
+uint32_t OS_Time(void){
+  return SystemTime;
+}
+
+//******** OS_SlicesSkipped ***************
+// number of time slice interrupts avoided by tickless idle
+// Inputs: none
+// Outputs: number of slices that passed with no SysTick interrupt
+uint32_t OS_SlicesSkipped(void){
+  return SlicesSkipped;
+}
+
+// ******** OS_MailBox_Init ************
+// initialize communication channel
+// Inputs:  pointer to a mailbox
+// Outputs: none
+void OS_MailBox_Init(MailBoxType *boxPt){
+  OS_InitSemaphore(&boxPt->Full, 0);  // no data yet
+  OS_InitSemaphore(&boxPt->Empty, 1); // room for one
+}
+
+// ******** OS_MailBox_Send ************
+// enter mail into the mailbox, block while the mailbox is full
+// called from a thread, never from an interrupt
+// Inputs:  pointer to a mailbox, data to be sent
+// Outputs: none
+void OS_MailBox_Send(MailBoxType *boxPt, uint32_t data){
+  OS_Wait(&boxPt->Empty);
+  boxPt->Data = data;
+  OS_Signal(&boxPt->Full);
+}
+
+// ******** OS_MailBox_Recv ************
+// remove mail from the mailbox, block while the mailbox is empty
+// called from a thread, never from an interrupt
+// Inputs:  pointer to a mailbox
+// Outputs: data received
+uint32_t OS_MailBox_Recv(MailBoxType *boxPt){ uint32_t data;
+  OS_Wait(&boxPt->Full);
+  data = boxPt->Data;
+  OS_Signal(&boxPt->Empty);
+  return data;
+}
+
+//******** OS_Stats ***************
+// stack use and processor time of each thread, in the order the
+// threads were added, so entry 0 is the idle thread and 1000 minus
+// its load is the processor utilization in tenths of a percent
+// time spent in interrupts is charged to the thread they interrupted
+// stackUsed is found by scanning for the fill pattern, so it takes
+// time proportional to the size of the stacks
+// Inputs:  array to fill, maximum number of entries
+// Outputs: number of threads, may be more than max
+uint32_t OS_Stats(ThreadStatsType stats[], uint32_t max){
+  int32_t status; uint32_t i,n,free,now; uint64_t total; tcbType *thread;
   status = StartCritical();
-  tcbs[0].next = &tcbs[1]; // 0 points to 1
-  tcbs[1].next = &tcbs[2]; // 1 points to 2
-  tcbs[2].next = &tcbs[0]; // 2 points to 0
-  SetInitialStack(0); Stacks[0][STACKSIZE-2] = (int32_t)(task0); // PC
-  SetInitialStack(1); Stacks[1][STACKSIZE-2] = (int32_t)(task1); // PC
-  SetInitialStack(2); Stacks[2][STACKSIZE-2] = (int32_t)(task2); // PC
-  RunPt = &tcbs[0];       // thread 0 will run first
+  if(RunPt){                  // charge the caller up to now
+    now = CPUTIME;
+    RunPt->cycles = RunPt->cycles + (now - SwitchTime);
+    SwitchTime = now;
+  }
+  n = NumThreads;
+  total = 0;                  // every cycle belongs to some thread
+  for(i=0; i<n; i++){
+    total = total + tcbs[i].cycles - tcbs[i].lastCycles;
+  }
+  for(i=0; i<n; i++){
+    thread = &tcbs[i];
+    if(i < max){
+      stats[i].priority = thread->priority;
+      stats[i].stackWords = thread->stackWords;
+      stats[i].overflow = thread->overflow;
+      stats[i].cycles = thread->cycles;
+      if(total){
+        stats[i].load = (uint32_t)(((thread->cycles - thread->lastCycles)*1000 + total/2)/total);
+      } else{
+        stats[i].load = 0;
+      }
+    }
+    thread->lastCycles = thread->cycles;
+  }
   EndCritical(status);
-  return 1;               // successful
+  for(i=0; (i<n)&&(i<max); i++){ // scan with interrupts enabled
+    thread = &tcbs[i];
+    free = 0;
+    while((free+1 < thread->stackWords)&&(thread->stack[free+1] == STACKPAINT)){
+      free++;
+    }
+    stats[i].stackUsed = thread->stackWords - 1 - free;
+  }
+  return n;
 }
 
 ///******** OS_Launch ***************
@@ -111,7 +493,10 @@ int OS_AddThreads(void(*task0)(void),
 //         (maximum of 24 bits)
 // Outputs: none (does not return)
 void OS_Launch(uint32_t theTimeSlice){
+  TimeSlice = theTimeSlice;
+  RunPt = Sched_Next(0);       // highest priority thread will run first
   NVIC_ST_RELOAD_R = theTimeSlice - 1; // reload value
   NVIC_ST_CTRL_R = 0x00000007; // enable, core clock and interrupt arm
+  SwitchTime = CPUTIME;        // first thread is charged from now
   StartOS();                   // start on the first task
 }
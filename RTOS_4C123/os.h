@@ -30,16 +30,60 @@
 #define TIME_1MS  50000
 #define TIME_2MS  2*TIME_1MS
 
+#define STACKSIZE   100      // default number of 32-bit words in stack
+#define DEFAULTPRIORITY 16   // priority used by OS_AddThreads
+#ifndef TICKLESS
+#define TICKLESS    1        // 1 to stop the time slice interrupts when idle
+#endif
+#ifndef STACKHALT
+#define STACKHALT   1        // 1 to stop when a stack overflows, 0 to report it in OS_Stats
+#endif
+
+struct tcb;                  // thread control block, see sched.h
+struct Sema4{
+  int32_t Value;             // >0 means free, <0 means -Value threads wait
+  struct tcb *BlockPt;       // threads blocked on this semaphore
+};
+typedef struct Sema4 Sema4Type;
+
+struct MailBox{
+  uint32_t Data;             // the mail
+  Sema4Type Full;            // 1 when Data holds unread mail
+  Sema4Type Empty;           // 1 when Data may be written
+};
+typedef struct MailBox MailBoxType;
+
+struct ThreadStats{
+  uint32_t priority;         // 0 is highest
+  uint32_t stackWords;       // size of the stack, in 32-bit words
+  uint32_t stackUsed;        // most 32-bit words ever used
+  uint32_t overflow;         // 1 if the stack guard word was overwritten
+  uint64_t cycles;           // bus cycles run since OS_Launch
+  uint32_t load;             // tenths of a percent since the previous OS_Stats
+};
+typedef struct ThreadStats ThreadStatsType;
+
 
 // ******** OS_Init ************
 // initialize operating system, disable interrupts until OS_Launch
-// initialize OS controlled I/O: systick, 50 MHz PLL
+// initialize OS controlled I/O: systick, 50 MHz PLL, Timer5A for CPU time
 // input:  none
 // output: none
 void OS_Init(void);
 
 //******** OS_AddThread ***************
+// add one foreground thread to the scheduler
+// may be called before or after OS_Launch
+// a thread that is higher priority than the running one runs immediately
+// Inputs: pointer to a void/void foreground task
+//         number of 32-bit words to allocate for its stack
+//         priority, 0 is highest, 31 is lowest
+// Outputs: 1 if successful, 0 if this thread can not be added
+int OS_AddThread(void(*task)(void), uint32_t stackWords, uint32_t priority);
+
+//******** OS_AddThreads ***************
 // add three foregound threads to the scheduler
+// all three run round robin at DEFAULTPRIORITY
 // Inputs: three pointers to a void/void foreground tasks
 // Outputs: 1 if successful, 0 if this thread can not be added
 int OS_AddThreads(void(*task0)(void),
@@ -48,6 +92,84 @@ int OS_AddThreads(void(*task0)(void),
 
 
 
+//******** OS_Suspend ***************
+// give up the rest of this time slice, run the next ready thread now
+// Inputs: none
+// Outputs: none
+void OS_Suspend(void);
+
+// ******** OS_InitSemaphore ************
+// initialize counting semaphore
+// Inputs:  pointer to a semaphore
+//          initial value of semaphore
+// Outputs: none
+void OS_InitSemaphore(Sema4Type *semaPt, int32_t value);
+
+// ******** OS_Wait ************
+// decrement semaphore, block this thread if less than zero
+// called from a thread, never from an interrupt
+// Inputs:  pointer to a counting semaphore
+// Outputs: none
+void OS_Wait(Sema4Type *semaPt);
+
+// ******** OS_Signal ************
+// increment semaphore, wake up the highest priority blocked thread
+// may be called from a thread or from an interrupt
+// Inputs:  pointer to a counting semaphore
+// Outputs: none
+void OS_Signal(Sema4Type *semaPt);
+
+//******** OS_Sleep ***************
+// put this thread to sleep, it uses no processor time while sleeping
+// resolution is one time slice
+// called from a thread, never from an interrupt
+// Inputs: number of milliseconds to sleep
+// Outputs: none
+void OS_Sleep(uint32_t ms);
+
+//******** OS_Time ***************
+// number of time slices since OS_Launch
+// Inputs: none
+// Outputs: system time in time slice units
+uint32_t OS_Time(void);
+
+//******** OS_SlicesSkipped ***************
+// number of time slice interrupts avoided by tickless idle
+// Inputs: none
+// Outputs: number of slices that passed with no SysTick interrupt
+uint32_t OS_SlicesSkipped(void);
+
+// ******** OS_MailBox_Init ************
+// initialize communication channel
+// Inputs:  pointer to a mailbox
+// Outputs: none
+void OS_MailBox_Init(MailBoxType *boxPt);
+
+// ******** OS_MailBox_Send ************
+// enter mail into the mailbox, block while the mailbox is full
+// called from a thread, never from an interrupt
+// Inputs:  pointer to a mailbox, data to be sent
+// Outputs: none
+void OS_MailBox_Send(MailBoxType *boxPt, uint32_t data);
+
+// ******** OS_MailBox_Recv ************
+// remove mail from the mailbox, block while the mailbox is empty
+// called from a thread, never from an interrupt
+// Inputs:  pointer to a mailbox
+// Outputs: data received
+uint32_t OS_MailBox_Recv(MailBoxType *boxPt);
+
+//******** OS_Stats ***************
+// stack use and processor time of each thread, in the order the
+// threads were added, so entry 0 is the idle thread and 1000 minus
+// its load is the processor utilization in tenths of a percent
+// time spent in interrupts is charged to the thread they interrupted
+// stackUsed is found by scanning for the fill pattern, so it takes
+// time proportional to the size of the stacks
+// Inputs:  array to fill, maximum number of entries
+// Outputs: number of threads, may be more than max
+uint32_t OS_Stats(ThreadStatsType stats[], uint32_t max);
+
 //******** OS_Launch ***************
 // start the scheduler, enable interrupts
 // Inputs: number of 20ns clock cycles for each time slice
@@ -0,0 +1,217 @@
+// sched.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Priority ready list for the simple real time operating system.
+// Bit 31-p of ReadyBits is set when ReadyList[p] has at least one thread,
+// so the highest ready priority is the number of leading zeros.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#include <stdint.h>
+#include "sched.h"
+
+uint32_t ReadyBits;                  // bit 31-p set if level p not empty
+tcbType *ReadyList[NUMPRIORITIES];   // front of each circular list
+tcbType *SleepList;                  // sleeping threads, soonest first
+
+#if !defined(__ARMCC_VERSION) && !defined(__TI_COMPILER_VERSION__) && !defined(__GNUC__)
+// binary search version for compilers without a CLZ intrinsic
+uint32_t Sched_CLZ(uint32_t x){ uint32_t n;
+  if(x == 0) return 32;
+  n = 0;
+  if((x&0xFFFF0000) == 0){ n = n + 16; x = x<<16;}
+  if((x&0xFF000000) == 0){ n = n + 8;  x = x<<8;}
+  if((x&0xF0000000) == 0){ n = n + 4;  x = x<<4;}
+  if((x&0xC0000000) == 0){ n = n + 2;  x = x<<2;}
+  if((x&0x80000000) == 0){ n = n + 1;}
+  return n;
+}
+#endif
+
+// ******** Sched_Init ************
+// empty the ready list
+// input:  none
+// output: none
+void Sched_Init(void){ int i;
+  ReadyBits = 0;
+  for(i=0; i<NUMPRIORITIES; i=i+1){
+    ReadyList[i] = 0;
+  }
+  SleepList = 0;
+}
+
+// ******** Sched_Insert ************
+// place a thread at the end of the ready list for its priority
+// round robin order is preserved among threads of equal priority
+// input:  pointer to a thread that is not already in the ready list
+// output: none
+void Sched_Insert(tcbType *thread){ tcbType *front;
+  front = ReadyList[thread->priority];
+  if(front == 0){              // first one at this level
+    thread->next = thread;
+    thread->prev = thread;
+    ReadyList[thread->priority] = thread;
+    ReadyBits |= 0x80000000>>thread->priority;
+  } else{                      // in front of front is the back
+    thread->next = front;
+    thread->prev = front->prev;
+    front->prev->next = thread;
+    front->prev = thread;
+  }
+}
+
+// ******** Sched_Remove ************
+// take a thread out of the ready list
+// input:  pointer to a thread that is in the ready list
+// output: none
+void Sched_Remove(tcbType *thread){
+  if(thread->next == thread){  // last one at this level
+    ReadyList[thread->priority] = 0;
+    ReadyBits &= ~(0x80000000>>thread->priority);
+  } else{
+    thread->prev->next = thread->next;
+    thread->next->prev = thread->prev;
+    if(ReadyList[thread->priority] == thread){
+      ReadyList[thread->priority] = thread->next;
+    }
+  }
+}
+
+// ******** Sched_Highest ************
+// find the highest priority level with at least one ready thread
+// input:  none
+// output: 0 to NUMPRIORITIES-1, or NUMPRIORITIES if nothing is ready
+uint32_t Sched_Highest(void){
+  if(ReadyBits == 0){
+    return NUMPRIORITIES;
+  }
+  return Sched_CLZ(ReadyBits);
+}
+
+// ******** Sched_Next ************
+// choose the thread to run next
+// the running thread goes to the back of its level if it is still
+// ready and at the highest ready priority (round robin time slicing),
+// otherwise the thread at the front of the highest ready level runs
+// input:  thread that was running
+// output: thread to run, 0 if nothing is ready
+tcbType *Sched_Next(tcbType *run){ uint32_t pri;
+  pri = Sched_Highest();
+  if(pri == NUMPRIORITIES){
+    return 0;                  // nothing ready
+  }
+  if(ReadyList[pri] == run){   // running thread is still at the front
+    ReadyList[pri] = run->next;
+  }
+  return ReadyList[pri];
+}
+
+// ******** Sched_Preempts ************
+// decide if a thread that just became ready should preempt
+// input:  thread that just became ready, thread currently running
+// output: 1 if a context switch is needed now, 0 if not
+int Sched_Preempts(tcbType *thread, tcbType *run){
+  if(thread->priority < run->priority){
+    return 1;                  // smaller number is higher priority
+  }
+  return 0;
+}
+
+// ******** Sched_BlockOn ************
+// take a thread out of the ready list and add it to a blocked list
+// the list is kept highest priority first, first come first served
+// among threads with equal priority
+// input:  pointer to the list head, thread in the ready list
+// output: none
+void Sched_BlockOn(tcbType **list, tcbType *thread){
+  Sched_Remove(thread);
+  while((*list) && ((*list)->priority <= thread->priority)){
+    list = &(*list)->next;     // skip threads of higher or equal priority
+  }
+  thread->next = *list;
+  *list = thread;
+}
+
+// ******** Sched_Unblock ************
+// take the first thread off a blocked list and make it ready
+// input:  pointer to the list head
+// output: thread that became ready, 0 if the list was empty
+tcbType *Sched_Unblock(tcbType **list){ tcbType *thread;
+  thread = *list;
+  if(thread){
+    *list = thread->next;
+    Sched_Insert(thread);
+  }
+  return thread;
+}
+
+// ******** Sched_Sleep ************
+// take a thread out of the ready list until a given system time
+// the sleeping list is kept sorted, soonest wake time first
+// input:  thread in the ready list, system time to wake up
+// output: none
+void Sched_Sleep(tcbType *thread, uint32_t wake){ tcbType **list;
+  Sched_Remove(thread);
+  thread->wake = wake;
+  list = &SleepList;
+  while((*list) && ((int32_t)((*list)->wake - wake) <= 0)){
+    list = &(*list)->next;     // signed difference handles wrap around
+  }
+  thread->next = *list;
+  *list = thread;
+}
+
+// ******** Sched_Wake ************
+// make ready every sleeping thread whose wake time has come
+// input:  current system time
+// output: highest priority thread that woke up, 0 if none did
+tcbType *Sched_Wake(uint32_t now){ tcbType *thread,*best;
+  best = 0;
+  while(SleepList && ((int32_t)(SleepList->wake - now) <= 0)){
+    thread = SleepList;
+    SleepList = thread->next;
+    Sched_Insert(thread);
+    if((best == 0)||(thread->priority < best->priority)){
+      best = thread;
+    }
+  }
+  return best;
+}
+
+// ******** Sched_NextWake ************
+// find when the next sleeping thread has to wake up
+// input:  pointer to where the wake time is returned
+// output: 1 if there is a sleeping thread, 0 if not
+int Sched_NextWake(uint32_t *wake){
+  if(SleepList == 0){
+    return 0;
+  }
+  *wake = SleepList->wake;
+  return 1;
+}
+
+// ******** Sched_OnlyReady ************
+// check if one thread is the only one in the ready list
+// input:  thread to check
+// output: 1 if no other thread is ready, 0 if not
+int Sched_OnlyReady(tcbType *thread){
+  if((ReadyBits == (0x80000000>>thread->priority)) && (thread->next == thread)){
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,144 @@
+// sched.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Priority ready list for the simple real time operating system.
+// There is one circular list of ready threads per priority level and
+// a 32-bit bitmap with one bit per level.  The highest priority ready
+// thread is found with a single count-leading-zeros instruction, so
+// selection time does not depend on how many threads exist.
+// Threads that are not ready are on a semaphore's blocked list or on
+// the sleeping list, which is sorted by wake up time.
+// This file does not touch any I/O registers, so the scheduling
+// decisions can be compiled and stepped through on a PC.
+// agent
+// October 17, 2026
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __SCHED_H
+#define __SCHED_H  1
+
+#include <stdint.h>
+
+#define NUMPRIORITIES 32     // 0 is the highest, 31 is the lowest
+
+// sp must be the first entry, the context switch in osasm.s uses it
+struct tcb{
+  int32_t *sp;       // pointer to stack (valid for threads not running
+  struct tcb *next;  // linked-list pointer, next thread at this priority
+                     // or next in a blocked or sleeping list
+  struct tcb *prev;  // linked-list pointer, previous thread at this priority
+  uint32_t priority; // 0 is highest, NUMPRIORITIES-1 is lowest
+  int32_t *stack;    // lowest address of this thread's stack
+  uint32_t stackWords; // size of this thread's stack, in 32-bit words
+  uint32_t wake;     // system time to wake up, valid while sleeping
+  uint32_t overflow; // 1 if the stack guard word was overwritten
+  uint64_t cycles;   // bus cycles this thread has run since OS_Launch
+  uint64_t lastCycles; // cycles at the previous OS_Stats
+};
+typedef struct tcb tcbType;
+
+// count leading zeros, a single CLZ instruction on the Cortex M4
+#if defined(__ARMCC_VERSION)
+#define Sched_CLZ(x) __clz(x)
+#elif defined(__TI_COMPILER_VERSION__)
+#define Sched_CLZ(x) ((uint32_t)_norm(x))
+#elif defined(__GNUC__)
+#define Sched_CLZ(x) ((uint32_t)__builtin_clz(x))
+#else
+uint32_t Sched_CLZ(uint32_t x);
+#endif
+
+// ******** Sched_Init ************
+// empty the ready list
+// input:  none
+// output: none
+void Sched_Init(void);
+
+// ******** Sched_Insert ************
+// place a thread at the end of the ready list for its priority
+// round robin order is preserved among threads of equal priority
+// input:  pointer to a thread that is not already in the ready list
+// output: none
+void Sched_Insert(tcbType *thread);
+
+// ******** Sched_Remove ************
+// take a thread out of the ready list
+// input:  pointer to a thread that is in the ready list
+// output: none
+void Sched_Remove(tcbType *thread);
+
+// ******** Sched_Highest ************
+// find the highest priority level with at least one ready thread
+// input:  none
+// output: 0 to NUMPRIORITIES-1, or NUMPRIORITIES if nothing is ready
+uint32_t Sched_Highest(void);
+
+// ******** Sched_Next ************
+// choose the thread to run next
+// the running thread goes to the back of its level if it is still
+// ready and at the highest ready priority (round robin time slicing),
+// otherwise the thread at the front of the highest ready level runs
+// input:  thread that was running
+// output: thread to run, 0 if nothing is ready
+tcbType *Sched_Next(tcbType *run);
+
+// ******** Sched_Preempts ************
+// decide if a thread that just became ready should preempt
+// input:  thread that just became ready, thread currently running
+// output: 1 if a context switch is needed now, 0 if not
+int Sched_Preempts(tcbType *thread, tcbType *run);
+
+// ******** Sched_BlockOn ************
+// take a thread out of the ready list and add it to a blocked list
+// the list is kept highest priority first, first come first served
+// among threads with equal priority
+// input:  pointer to the list head, thread in the ready list
+// output: none
+void Sched_BlockOn(tcbType **list, tcbType *thread);
+
+// ******** Sched_Unblock ************
+// take the first thread off a blocked list and make it ready
+// input:  pointer to the list head
+// output: thread that became ready, 0 if the list was empty
+tcbType *Sched_Unblock(tcbType **list);
+
+// ******** Sched_Sleep ************
+// take a thread out of the ready list until a given system time
+// the sleeping list is kept sorted, soonest wake time first
+// input:  thread in the ready list, system time to wake up
+// output: none
+void Sched_Sleep(tcbType *thread, uint32_t wake);
+
+// ******** Sched_Wake ************
+// make ready every sleeping thread whose wake time has come
+// input:  current system time
+// output: highest priority thread that woke up, 0 if none did
+tcbType *Sched_Wake(uint32_t now);
+
+// ******** Sched_NextWake ************
+// find when the next sleeping thread has to wake up
+// input:  pointer to where the wake time is returned
+// output: 1 if there is a sleeping thread, 0 if not
+int Sched_NextWake(uint32_t *wake);
+
+// ******** Sched_OnlyReady ************
+// check if one thread is the only one in the ready list
+// input:  thread to check
+// output: 1 if no other thread is ready, 0 if not
+int Sched_OnlyReady(tcbType *thread);
+
+#endif
@@ -2,8 +2,13 @@
 // user.c
 // Runs on LM4F120/TM4C123
 // An example user program that initializes the simple operating system
-//   Schedule three independent threads using preemptive round robin  
-//   Each thread rapidly toggles a pin on Port D and increments its counter 
+//   Schedule three threads using preemptive priority scheduling
+//   Task1 sleeps, then wakes every 10 ms and signals Task2
+//   Task2 blocks on a semaphore until Task1 signals it
+//   Task3 is a low priority background thread that gets every cycle
+//   Task1 and Task2 do not use
+//   Each thread toggles a pin on Port D and increments its counter
+//   Task3 also fills Stats with the stack use and load of each thread
 //   TIMESLICE is how long each thread runs
 
 // Daniel Valvano
@@ -35,6 +40,8 @@
 uint32_t Count1;   // number of times thread1 loops
 uint32_t Count2;   // number of times thread2 loops
 uint32_t Count3;   // number of times thread3 loops
+Sema4Type Ready;   // signaled by Task1, waited on by Task2
+ThreadStatsType Stats[4]; // Idle, Task1, Task2, Task3, view in the debugger
 #define GPIO_PORTD1             (*((volatile uint32_t *)0x40007008))
 #define GPIO_PORTD2             (*((volatile uint32_t *)0x40007010))
 #define GPIO_PORTD3             (*((volatile uint32_t *)0x40007020))
@@ -52,13 +59,16 @@ uint32_t Count3;   // number of times thread3 loops
 void Task1(void){
   Count1 = 0;
   for(;;){
+    OS_Sleep(10);             // runs every 10 ms
     Count1++;
     GPIO_PORTD1 ^= 0x02;      // toggle PD1
+    OS_Signal(&Ready);        // Task2 runs as soon as Task1 sleeps
   }
 }
 void Task2(void){
   Count2 = 0;
   for(;;){
+    OS_Wait(&Ready);          // blocked until Task1 signals
     Count2++;
     GPIO_PORTD2 ^= 0x04;      // toggle PD2
   }
@@ -68,6 +78,9 @@ void Task3(void){
   for(;;){
     Count3++;
     GPIO_PORTD3 ^= 0x08;      // toggle PD3
+    if((Count3&0xFFFFF) == 0){
+      OS_Stats(Stats, 4);     // stack use and load about once a second
+    }
   }
 }
 int main(void){
@@ -80,7 +93,10 @@ int main(void){
                                         // configure PD3-1 as GPIO
   GPIO_PORTD_PCTL_R = (GPIO_PORTD_PCTL_R&0xFFFF000F)+0x00000000;
   GPIO_PORTD_AMSEL_R &= ~0x0E;          // disable analog functionality on PD3-1
-  OS_AddThreads(&Task1, &Task2, &Task3);
+  OS_InitSemaphore(&Ready, 0);
+  OS_AddThread(&Task1, STACKSIZE, 1);   // highest priority
+  OS_AddThread(&Task2, STACKSIZE, 2);
+  OS_AddThread(&Task3, STACKSIZE, DEFAULTPRIORITY);
   OS_Launch(TIMESLICE); // doesn't return, interrupts enabled in here
   return 0;             // this never executes
 }
@@ -91,6 +91,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "ST7735.h"
+#include "Format.h"
 #include "../inc/tm4c123gh6pm.h"
 
 // 16 rows (0 to 15) and 21 characters (0 to 20)
@@ -1148,24 +1149,9 @@ uint32_t ST7735_DrawString(uint16_t x, uint16_t y, char *pt, int16_t textColor){
   return count;  // number of characters printed
 }
 
-//-----------------------fillmessage-----------------------
-// Output a 32-bit number in unsigned decimal format
-// Input: 32-bit number to be transferred
-// Output: none
-// Variable format 1-10 digits with no space before or after
-char Message[12];
+// number for ST7735_OutUDec, and its length
+char Message[FORMAT_SIZE];
 uint32_t Messageindex;
-
-void fillmessage(uint32_t n){
-// This function uses recursion to convert decimal number
-//   of unspecified length as an ASCII string
-  if(n >= 10){
-    fillmessage(n/10);
-    n = n%10;
-  }
-  Message[Messageindex] = (n+'0'); /* n is between 0 and 9 */
-  if(Messageindex<11)Messageindex++;
-}
 //********ST7735_SetCursor*****************
 // Move the cursor to the desired X- and Y-position.  The
 // next character will be printed here.  X=0 is the leftmost
@@ -1188,9 +1174,7 @@ void ST7735_SetCursor(uint32_t newX, uint32_t newY){
 // Output: none
 // Variable format 1-10 digits with no space before or after
 void ST7735_OutUDec(uint32_t n){
-  Messageindex = 0;
-  fillmessage(n);
-  Message[Messageindex] = 0; // terminate
+  Messageindex = Format_UDec(Message, n);
   ST7735_DrawString(StX,StY,Message,StTextColor);
   StX = StX+Messageindex;
   if(StX>20){
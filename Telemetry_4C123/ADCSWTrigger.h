@@ -0,0 +1 @@
+../ADCSWTrigger_4C123/ADCSWTrigger.h
\ No newline at end of file
@@ -0,0 +1 @@
+../PeriodicTimer1AInts_4C123/Latency.h
\ No newline at end of file
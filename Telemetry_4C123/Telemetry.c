@@ -0,0 +1,318 @@
+// Telemetry.c
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Binary telemetry frames, see Telemetry.h for the format.  Each
+// channel collects samples in its own buffer with the header already
+// in place, so sending a frame is one CRC pass, one COBS pass and one
+// call to out, which for UART_OutChars is one group put into the
+// TxFifo.  COBS (consistent overhead byte stuffing) replaces each 0
+// with the distance to the next 0, adding one byte per 254, so
+// unlike SLIP the frame length does not depend on the data.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+  "Embedded Systems: Introduction to ARM Cortex M Microcontrollers",
+  ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+"Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "Telemetry.h"
+
+#define HEADER 4              // channel type sequence count
+
+// bytes per sample for each type, 0 means channel off
+const uint8_t TelemetrySize[7] = {0,1,1,2,2,4,4};
+
+// CRC-16-CCITT of each 4-bit value, two lookups per byte
+const uint16_t CrcTable[16]={
+  0x0000,0x1021,0x2042,0x3063,0x4084,0x50A5,0x60C6,0x70E7,
+  0x8108,0x9129,0xA14A,0xB16B,0xC18C,0xD1AD,0xE1CE,0xF1EF
+};
+
+void (*TelemetryOut)(const char *pt, uint32_t len);
+uint8_t TelemetryRaw[TELEMETRY_CHANNELS][TELEMETRY_RAW];
+uint32_t TelemetryCount[TELEMETRY_CHANNELS];  // samples waiting
+uint8_t TelemetrySeq[TELEMETRY_CHANNELS];     // next sequence number
+uint8_t TelemetryWire[TELEMETRY_WIRE];        // frame being sent
+uint32_t TelemetrySent;                       // bytes
+
+//------------Telemetry_CRC------------
+// CRC-16-CCITT, polynomial 0x1021, starting at 0xFFFF,
+// 0x29B1 for the nine bytes "123456789"
+// Input: pt   first byte
+//        len  number of bytes
+// Output: CRC
+uint16_t Telemetry_CRC(const uint8_t *pt, uint32_t len){ uint32_t crc;
+  crc = 0xFFFF;
+  while(len){
+    crc = ((crc<<4)&0xFFFF)^CrcTable[(crc>>12)^(*pt>>4)];
+    crc = ((crc<<4)&0xFFFF)^CrcTable[(crc>>12)^(*pt&0x0F)];
+    pt++;
+    len--;
+  }
+  return (uint16_t)crc;
+}
+
+// COBS encode len bytes from src into dst and end with a 0
+// dst needs len+len/254+2 bytes, returns the number used
+static uint32_t cobsEncode(const uint8_t *src, uint32_t len, uint8_t *dst){
+  uint8_t *code,*out; uint8_t n;
+  code = dst;                 // where the distance to the next 0 goes
+  out = dst+1;
+  n = 1;
+  while(len){
+    if(*src == 0){
+      *code = n;
+      code = out;
+      out++;
+      n = 1;
+    } else{
+      *out = *src;
+      out++;
+      n++;
+      if(n == 0xFF){          // 254 bytes with no 0
+        *code = n;
+        code = out;
+        out++;
+        n = 1;
+      }
+    }
+    src++;
+    len--;
+  }
+  *code = n;
+  *out = 0;                   // delimiter
+  out++;
+  return out-dst;
+}
+
+//------------Telemetry_Init------------
+// Start with every channel off.  Frames are sent with out, for
+// example UART_OutChars, which puts them in the TxFifo.
+// Input: out  sends len bytes
+// Output: none
+void Telemetry_Init(void (*out)(const char *pt, uint32_t len)){ uint32_t ch;
+  TelemetryOut = out;
+  TelemetrySent = 0;
+  for(ch=0; ch<TELEMETRY_CHANNELS; ch++){
+    TelemetryRaw[ch][0] = ch;
+    TelemetryRaw[ch][1] = 0;  // off
+    TelemetryCount[ch] = 0;
+    TelemetrySeq[ch] = 0;
+  }
+}
+
+//------------Telemetry_Channel------------
+// Turn on a channel, and set the type of its samples
+// Input: ch    channel number
+//        type  TELEMETRY_U8 to TELEMETRY_S32
+// Output: number of samples in a full frame, 0 if ch or type is bad
+uint32_t Telemetry_Channel(uint32_t ch, uint32_t type){
+  if((ch >= TELEMETRY_CHANNELS) || (type < TELEMETRY_U8) || (type > TELEMETRY_S32)){
+    return 0;
+  }
+  Telemetry_Flush(ch);        // samples of the old type
+  TelemetryRaw[ch][1] = type;
+  return TELEMETRY_PAYLOAD/TelemetrySize[type];
+}
+
+//------------Telemetry_Flush------------
+// Send the samples waiting on a channel, if any
+// Input: ch  channel number
+// Output: none
+void Telemetry_Flush(uint32_t ch){ uint8_t *raw; uint32_t len; uint16_t crc;
+  if((ch >= TELEMETRY_CHANNELS) || (TelemetryCount[ch] == 0)){
+    return;
+  }
+  raw = TelemetryRaw[ch];
+  raw[2] = TelemetrySeq[ch];
+  raw[3] = TelemetryCount[ch];
+  len = HEADER+TelemetryCount[ch]*TelemetrySize[raw[1]];
+  crc = Telemetry_CRC(raw, len);
+  raw[len] = crc>>8;
+  raw[len+1] = crc&0xFF;
+  len = cobsEncode(raw, len+2, TelemetryWire);
+  (*TelemetryOut)((const char *)TelemetryWire, len);
+  TelemetrySent = TelemetrySent+len;
+  TelemetrySeq[ch]++;
+  TelemetryCount[ch] = 0;
+}
+
+//------------Telemetry_Put------------
+// Add one sample, and send the frame if it is full.  Call from one
+// thread only, not from several interrupts.
+// Input: ch     channel number
+//        value  sample, the low bits are used for 8 and 16-bit types
+// Output: 1 if a frame was sent, 0 if not
+int Telemetry_Put(uint32_t ch, uint32_t value){ uint32_t size; uint8_t *pt;
+  if(ch >= TELEMETRY_CHANNELS){
+    return 0;
+  }
+  size = TelemetrySize[TelemetryRaw[ch][1]];
+  if(size == 0){
+    return 0;                 // channel off
+  }
+  pt = &TelemetryRaw[ch][HEADER+TelemetryCount[ch]*size];
+  pt[0] = value;              // little endian
+  if(size > 1){
+    pt[1] = value>>8;
+    if(size > 2){
+      pt[2] = value>>16;
+      pt[3] = value>>24;
+    }
+  }
+  TelemetryCount[ch]++;
+  if((TelemetryCount[ch]+1)*size > TELEMETRY_PAYLOAD){
+    Telemetry_Flush(ch);      // no room for another
+    return 1;
+  }
+  return 0;
+}
+
+//------------Telemetry_Bytes------------
+// Input: none
+// Output: bytes sent since Telemetry_Init, including 0 delimiters
+uint32_t Telemetry_Bytes(void){
+  return TelemetrySent;
+}
+
+//************receiver*************
+//------------Telemetry_DecodeInit------------
+// Input: d      decoder state
+//        frame  called with each good frame
+// Output: none
+void Telemetry_DecodeInit(telemetry_decoder_t *d,
+                          void (*frame)(const telemetry_frame_t *f)){
+  uint32_t ch;
+  d->len = 0;
+  d->skip = 1;                // the first bytes may be half a frame
+  for(ch=0; ch<TELEMETRY_CHANNELS; ch++){
+    d->next[ch] = 0;
+    d->seen[ch] = 0;
+  }
+  d->frames = 0;
+  d->errors = 0;
+  d->lost = 0;
+  d->frame = frame;
+}
+
+// COBS decode in place, the 0 delimiter is not included
+// returns the number of bytes, 0 if the encoding is bad
+static uint32_t cobsDecode(uint8_t *buf, uint32_t len){
+  uint32_t in,out,code,k;
+  in = out = 0;
+  while(in < len){
+    code = buf[in];
+    in++;
+    if(in+code-1 > len){
+      return 0;               // distance past the end
+    }
+    for(k=1; k<code; k++){
+      buf[out] = buf[in];     // out never passes in
+      out++;
+      in++;
+    }
+    if((code < 0xFF) && (in < len)){
+      buf[out] = 0;
+      out++;
+    }
+  }
+  return out;
+}
+
+// check one frame between two 0s, and give it to the frame function
+static void frameDone(telemetry_decoder_t *d){
+  uint32_t len,size,ch; telemetry_frame_t f; uint8_t gap;
+  len = cobsDecode(d->buf, d->len);
+  if(len < HEADER+2){
+    d->errors++;
+    return;
+  }
+  if(Telemetry_CRC(d->buf, len-2) != ((d->buf[len-2]<<8)|d->buf[len-1])){
+    d->errors++;
+    return;
+  }
+  f.channel = d->buf[0];
+  f.type = d->buf[1];
+  f.sequence = d->buf[2];
+  f.count = d->buf[3];
+  f.data = &d->buf[HEADER];
+  ch = f.channel;
+  size = (f.type <= TELEMETRY_S32) ? TelemetrySize[f.type] : 0;
+  if((ch >= TELEMETRY_CHANNELS) || (size == 0) || (f.count == 0) ||
+     (HEADER+f.count*size+2 != len)){
+    d->errors++;              // good CRC but not a frame we know
+    return;
+  }
+  if(d->seen[ch]){
+    gap = f.sequence-d->next[ch];   // modulo 256
+    d->lost = d->lost+gap;
+  }
+  d->seen[ch] = 1;
+  d->next[ch] = f.sequence+1;
+  d->frames++;
+  if(d->frame){
+    (*d->frame)(&f);
+  }
+}
+
+//------------Telemetry_Decode------------
+// Give received bytes to the decoder, in pieces of any size
+// Input: d    decoder state
+//        pt   received bytes
+//        len  number of bytes
+// Output: none
+void Telemetry_Decode(telemetry_decoder_t *d, const uint8_t *pt, uint32_t len){
+  while(len){
+    if(*pt == 0){
+      if(d->skip){
+        d->skip = 0;          // in step with the sender now
+      } else if(d->len){
+        frameDone(d);
+      }
+      d->len = 0;
+    } else if(!d->skip){
+      if(d->len < TELEMETRY_WIRE){
+        d->buf[d->len] = *pt;
+        d->len++;
+      } else{
+        d->errors++;          // too long, lost a 0
+        d->skip = 1;
+      }
+    }
+    pt++;
+    len--;
+  }
+}
+
+//------------Telemetry_Value------------
+// One sample from a frame, signed types are sign extended
+// Input: f  frame given to the frame function
+//        i  sample number, 0 to f->count-1
+// Output: the sample
+uint32_t Telemetry_Value(const telemetry_frame_t *f, uint32_t i){
+  const uint8_t *pt;
+  switch(f->type){
+    case TELEMETRY_U8:  return f->data[i];
+    case TELEMETRY_S8:  return (uint32_t)(int32_t)(int8_t)f->data[i];
+    case TELEMETRY_U16: pt = &f->data[2*i];
+                        return pt[0]|(pt[1]<<8);
+    case TELEMETRY_S16: pt = &f->data[2*i];
+                        return (uint32_t)(int32_t)(int16_t)(pt[0]|(pt[1]<<8));
+    default:            pt = &f->data[4*i];
+                        return pt[0]|(pt[1]<<8)|((uint32_t)pt[2]<<16)|((uint32_t)pt[3]<<24);
+  }
+}
@@ -0,0 +1,136 @@
+// Telemetry.h
+// Runs on LM4F120/TM4C123, also compiles on a host PC
+// Binary telemetry frames for streaming samples out the UART much
+// faster than ASCII.  Samples are batched by channel, and each frame
+// is
+//   channel type sequence count  samples...  CRC high CRC low
+// then COBS encoded, so the frame has no 0 bytes, and ended with a
+// 0 byte.  Samples are little endian.  The CRC is CRC-16-CCITT
+// (polynomial 0x1021, starting at 0xFFFF) of the bytes before it.
+// The sequence number counts frames on each channel, so the
+// receiver can count lost frames.  A receiver that starts in the
+// middle, or sees a bad frame, finds the next 0 and starts again.
+// The decoder is the same code on the LaunchPad and on a PC.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+  "Embedded Systems: Introduction to ARM Cortex M Microcontrollers",
+  ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+"Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#define TELEMETRY_CHANNELS 4  // channels 0 to 3
+#define TELEMETRY_PAYLOAD  64 // most sample bytes in one frame
+#define TELEMETRY_RAW      (TELEMETRY_PAYLOAD+6)  // header, samples, CRC
+#define TELEMETRY_WIRE     (TELEMETRY_RAW+2)      // after COBS, with the 0
+
+// sample types
+#define TELEMETRY_U8  1
+#define TELEMETRY_S8  2
+#define TELEMETRY_U16 3
+#define TELEMETRY_S16 4
+#define TELEMETRY_U32 5
+#define TELEMETRY_S32 6
+
+//------------Telemetry_Init------------
+// Start with every channel off.  Frames are sent with out, for
+// example UART_OutChars, which puts them in the TxFifo.
+// Input: out  sends len bytes
+// Output: none
+void Telemetry_Init(void (*out)(const char *pt, uint32_t len));
+
+//------------Telemetry_Channel------------
+// Turn on a channel, and set the type of its samples
+// Input: ch    channel number
+//        type  TELEMETRY_U8 to TELEMETRY_S32
+// Output: number of samples in a full frame, 0 if ch or type is bad
+uint32_t Telemetry_Channel(uint32_t ch, uint32_t type);
+
+//------------Telemetry_Put------------
+// Add one sample, and send the frame if it is full.  Call from one
+// thread only, not from several interrupts.
+// Input: ch     channel number
+//        value  sample, the low bits are used for 8 and 16-bit types
+// Output: 1 if a frame was sent, 0 if not
+int Telemetry_Put(uint32_t ch, uint32_t value);
+
+//------------Telemetry_Flush------------
+// Send the samples waiting on a channel, if any
+// Input: ch  channel number
+// Output: none
+void Telemetry_Flush(uint32_t ch);
+
+//------------Telemetry_Bytes------------
+// Input: none
+// Output: bytes sent since Telemetry_Init, including 0 delimiters
+uint32_t Telemetry_Bytes(void);
+
+//------------Telemetry_CRC------------
+// CRC-16-CCITT, polynomial 0x1021, starting at 0xFFFF,
+// 0x29B1 for the nine bytes "123456789"
+// Input: pt   first byte
+//        len  number of bytes
+// Output: CRC
+uint16_t Telemetry_CRC(const uint8_t *pt, uint32_t len);
+
+//************receiver*************
+typedef struct telemetry_frame{
+  uint8_t channel;
+  uint8_t type;      // TELEMETRY_U8 to TELEMETRY_S32
+  uint8_t sequence;  // counts frames on this channel
+  uint8_t count;     // number of samples
+  const uint8_t *data; // count samples, little endian
+} telemetry_frame_t;
+
+typedef struct telemetry_decoder{
+  uint8_t buf[TELEMETRY_WIRE];
+  uint32_t len;      // bytes since the last 0
+  int skip;          // 1 if too long, wait for the next 0
+  uint8_t next[TELEMETRY_CHANNELS];  // expected sequence number
+  uint8_t seen[TELEMETRY_CHANNELS];  // 1 after the first frame
+  uint32_t frames;   // good frames
+  uint32_t errors;   // bad CRC, bad COBS, bad length or too long
+  uint32_t lost;     // frames missing from the sequence numbers
+  void (*frame)(const telemetry_frame_t *f);
+} telemetry_decoder_t;
+
+//------------Telemetry_DecodeInit------------
+// Input: d      decoder state
+//        frame  called with each good frame
+// Output: none
+void Telemetry_DecodeInit(telemetry_decoder_t *d,
+                          void (*frame)(const telemetry_frame_t *f));
+
+//------------Telemetry_Decode------------
+// Give received bytes to the decoder, in pieces of any size
+// Input: d    decoder state
+//        pt   received bytes
+//        len  number of bytes
+// Output: none
+void Telemetry_Decode(telemetry_decoder_t *d, const uint8_t *pt, uint32_t len);
+
+//------------Telemetry_Value------------
+// One sample from a frame, signed types are sign extended
+// Input: f  frame given to the frame function
+//        i  sample number, 0 to f->count-1
+// Output: the sample
+uint32_t Telemetry_Value(const telemetry_frame_t *f, uint32_t i);
+
+#endif //  __TELEMETRY_H__
@@ -0,0 +1,192 @@
+// TelemetryHost.c
+// Runs on a PC, not on the LaunchPad
+// Command line decoder for the telemetry frames sent by Telemetry.c,
+// using the same Telemetry.c as the LaunchPad.
+//   gcc TelemetryHost.c Telemetry.c -o TelemetryHost -lm
+//   ./TelemetryHost decode [file]
+//     reads the bytes captured from the serial port, from the file
+//     or standard input, and prints one line per sample
+//       channel,sequence,index,value
+//     then the number of frames, bad frames and lost frames
+//   ./TelemetryHost loopback
+//     encodes a simulated ADC signal on three channels, damages the
+//     stream (starts in the middle of a frame, changes one byte,
+//     drops one frame), decodes it in pieces of random size, checks
+//     every sample that arrived, and compares the bytes on the wire
+//     with printing the same samples in ASCII.
+//     Exits with 1 if anything is wrong.
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+  "Embedded Systems: Introduction to ARM Cortex M Microcontrollers",
+  ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+"Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Telemetry.h"
+
+#define SAMPLES 4096          // per channel in the loopback
+#define WIRESIZE 65536        // bytes on the wire in the loopback
+
+telemetry_decoder_t Decoder;
+
+//**************decode**************
+void printFrame(const telemetry_frame_t *f){ uint32_t i,value;
+  for(i=0; i<f->count; i++){
+    value = Telemetry_Value(f, i);
+    if((f->type == TELEMETRY_S8) || (f->type == TELEMETRY_S16) || (f->type == TELEMETRY_S32)){
+      printf("%u,%u,%u,%d\n", f->channel, f->sequence, i, (int32_t)value);
+    } else{
+      printf("%u,%u,%u,%u\n", f->channel, f->sequence, i, value);
+    }
+  }
+}
+
+int decode(const char *name){ FILE *in; uint8_t buf[512]; size_t n;
+  in = stdin;
+  if(name){
+    in = fopen(name, "rb");
+    if(in == 0){
+      perror(name);
+      return 1;
+    }
+  }
+  Telemetry_DecodeInit(&Decoder, &printFrame);
+  Decoder.skip = 0;           // a capture file starts at a frame
+  while((n = fread(buf, 1, sizeof(buf), in)) > 0){
+    Telemetry_Decode(&Decoder, buf, n);
+  }
+  fprintf(stderr, "%u frames, %u bad, %u lost\n",
+          Decoder.frames, Decoder.errors, Decoder.lost);
+  return 0;
+}
+
+//**************loopback**************
+uint8_t Wire[WIRESIZE];
+uint32_t WireLen;
+uint32_t FrameEnd[1024];      // index after the 0 at the end of each frame
+uint32_t NumFrames;
+uint16_t Adc[SAMPLES];        // channel 0, 12-bit ADC
+int16_t Diff[SAMPLES];        // channel 1, difference of two samples
+uint32_t Time[SAMPLES/8];     // channel 2, time every 8 samples
+uint32_t Checked,Wrong;
+
+void toWire(const char *pt, uint32_t len){
+  memcpy(&Wire[WireLen], pt, len);
+  WireLen = WireLen+len;
+  FrameEnd[NumFrames] = WireLen;
+  NumFrames++;
+}
+
+// compare each sample with what was sent, every frame sent was full
+void checkFrame(const telemetry_frame_t *f){ uint32_t i,first,expect;
+  first = f->sequence*f->count;
+  for(i=0; i<f->count; i++){
+    switch(f->channel){
+      case 0:  expect = Adc[first+i]; break;
+      case 1:  expect = (uint32_t)(int32_t)Diff[first+i]; break;
+      default: expect = Time[first+i]; break;
+    }
+    if(Telemetry_Value(f, i) != expect){
+      Wrong++;
+    }
+    Checked++;
+  }
+}
+
+// remove bytes [start,end) from the wire
+void cut(uint32_t start, uint32_t end){
+  memmove(&Wire[start], &Wire[end], WireLen-end);
+  WireLen = WireLen-(end-start);
+}
+
+int loopback(void){ uint32_t i,n,asciiBytes,csvBytes,binBytes; char buf[32];
+  int ok;
+  WireLen = NumFrames = 0;
+  Telemetry_Init(&toWire);
+  Telemetry_Channel(0, TELEMETRY_U16);
+  Telemetry_Channel(1, TELEMETRY_S16);
+  Telemetry_Channel(2, TELEMETRY_U32);
+  srand(1);
+  asciiBytes = csvBytes = 0;
+  for(i=0; i<SAMPLES; i++){
+    Adc[i] = (uint16_t)(2048+1500*sin(i*0.05)+(rand()%64)-32)&0x0FFF;
+    Diff[i] = i ? (int16_t)(Adc[i]-Adc[i-1]) : 0;
+    if(i%8 == 0){
+      Time[i/8] = 0xFFFF0000u+i*20000;   // bus cycles, wraps
+    }
+  }
+  for(i=0; i<SAMPLES; i++){
+    Telemetry_Put(0, Adc[i]);
+    asciiBytes = asciiBytes+sprintf(buf, "\n\rADC data =%u", Adc[i]);
+    csvBytes = csvBytes+sprintf(buf, "%u\r\n", Adc[i]);
+  }
+  binBytes = Telemetry_Bytes();
+  for(i=0; i<SAMPLES; i++){
+    Telemetry_Put(1, (uint32_t)(int32_t)Diff[i]);
+    if(i%8 == 0){
+      Telemetry_Put(2, Time[i/8]);
+    }
+  }
+  n = NumFrames;
+  printf("%u samples of channel 0 (12-bit ADC)\n", SAMPLES);
+  printf("  ASCII \"\\n\\rADC data =%%u\"  %6u bytes  %5.2f bytes/sample\n",
+         asciiBytes, (double)asciiBytes/SAMPLES);
+  printf("  ASCII \"%%u\\r\\n\"             %6u bytes  %5.2f bytes/sample\n",
+         csvBytes, (double)csvBytes/SAMPLES);
+  printf("  binary frames             %6u bytes  %5.2f bytes/sample\n",
+         binBytes, (double)binBytes/SAMPLES);
+  printf("  at 115,200 bps: %.0f, %.0f and %.0f samples/s\n",
+         11520.0*SAMPLES/asciiBytes, 11520.0*SAMPLES/csvBytes, 11520.0*SAMPLES/binBytes);
+  // damage: start in the middle of frame 0, change a byte in frame 10,
+  // drop frame 20; frames 0, 10 and 20 are all channel 0
+  Wire[FrameEnd[9]+30] ^= 0x04;
+  cut(FrameEnd[19], FrameEnd[20]);
+  cut(0, 17);
+  printf("%u frames, %u bytes sent, damaged to %u bytes\n", n, Telemetry_Bytes(), WireLen);
+  Telemetry_DecodeInit(&Decoder, &checkFrame);
+  for(i=0; i<WireLen; i=i+n){
+    n = 1+rand()%100;
+    if(i+n > WireLen){
+      n = WireLen-i;
+    }
+    Telemetry_Decode(&Decoder, &Wire[i], n);
+  }
+  printf("decoded %u frames, %u bad, %u lost, %u samples checked, %u wrong\n",
+         Decoder.frames, Decoder.errors, Decoder.lost, Checked, Wrong);
+  ok = (Telemetry_CRC((const uint8_t *)"123456789", 9) == 0x29B1) &&
+       (Decoder.errors == 1) && (Decoder.lost == 2) &&
+       (Decoder.frames == NumFrames-3) && (Wrong == 0) &&
+       (Checked == 2*SAMPLES+SAMPLES/8-3*(TELEMETRY_PAYLOAD/2));
+  printf("loopback %s\n", ok ? "correct" : "WRONG");
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char *argv[]){
+  if((argc >= 2) && (strcmp(argv[1], "decode") == 0)){
+    return decode(argc >= 3 ? argv[2] : 0);
+  }
+  if((argc >= 2) && (strcmp(argv[1], "loopback") == 0)){
+    return loopback();
+  }
+  fprintf(stderr, "usage: %s decode [file]\n       %s loopback\n", argv[0], argv[0]);
+  return 2;
+}
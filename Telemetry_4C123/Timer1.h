@@ -0,0 +1 @@
+../PeriodicTimer1AInts_4C123/Timer1.h
\ No newline at end of file
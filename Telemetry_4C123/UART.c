@@ -0,0 +1 @@
+../ESP8266_4C123/UART.c
\ No newline at end of file
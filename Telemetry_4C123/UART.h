@@ -0,0 +1 @@
+../ESP8266_4C123/UART.h
\ No newline at end of file
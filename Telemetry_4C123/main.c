@@ -0,0 +1,74 @@
+// main.c
+// Runs on LM4F120/TM4C123
+// Stream ADC samples out UART0 as binary telemetry frames.  Timer1
+// samples ADC channel 9 (PE4) at 4 kHz and puts the samples in a
+// FIFO; the main loop gives them to Telemetry_Put on channel 0, which
+// sends a frame of 32 samples at a time through UART_OutChars into
+// the interrupt-driven TxFifo.  A frame is 72 bytes on the wire, 2.25
+// bytes per sample, so 115,200 bps carries about 5,100 samples/s.
+// Printing "\n\rADC data =" and the number, as ADCPrintResults does,
+// takes about 16 bytes per sample, about 730 samples/s.
+// On the PC, decode the stream with TelemetryHost:
+//   TelemetryHost decode < capture.bin > samples.csv
+// agent
+// October 17, 2026
+
+/* This example accompanies the books
+  "Embedded Systems: Introduction to ARM Cortex M Microcontrollers",
+  ISBN: 978-1469998749, Jonathan Valvano, copyright (c) 2015
+
+"Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2015
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include <stdint.h>
+#include "PLL.h"
+#include "UART.h"
+#include "FIFO.h"
+#include "ADCSWTrigger.h"
+#include "Timer1.h"
+#include "Telemetry.h"
+
+#define SAMPLEFIFOSIZE 64     // must be a power of 2
+#define FIFOSUCCESS 1
+#define FIFOFAIL    0
+
+void EnableInterrupts(void);  // Enable interrupts
+long StartCritical(void);    // previous I bit, disable interrupts
+void EndCritical(long sr);    // restore I bit to previous value
+
+AddIndexFifo(Sample, SAMPLEFIFOSIZE, uint16_t, FIFOSUCCESS, FIFOFAIL)
+uint32_t SampleLost;          // samples dropped because the FIFO was full
+
+// runs at 4 kHz in the Timer1 ISR
+void SampleADC(void){
+  if(SampleFifo_Put(ADC0_InSeq3()) == FIFOFAIL){
+    SampleLost++;
+  }
+}
+
+int main(void){ uint16_t data;
+  PLL_Init(Bus80MHz);         // 80 MHz
+  UART_Init();                // 115,200 bps
+  ADC0_InitSWTriggerSeq3_Ch9();
+  SampleFifo_Init();
+  Telemetry_Init(&UART_OutChars);
+  Telemetry_Channel(0, TELEMETRY_U16);
+  Timer1_Init(&SampleADC, 20000);// 80 MHz/20000 = 4 kHz
+  EnableInterrupts();
+  while(1){
+    if(SampleFifo_Get(&data) == FIFOSUCCESS){
+      Telemetry_Put(0, data);
+    }
+  }
+}
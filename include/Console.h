@@ -0,0 +1 @@
+../Console_4C123/Console.h
\ No newline at end of file
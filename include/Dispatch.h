@@ -0,0 +1 @@
+../FixedScheduler_4C123/Dispatch.h
\ No newline at end of file
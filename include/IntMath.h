@@ -0,0 +1 @@
+../ProfileSqrt_4C123/IntMath.h
\ No newline at end of file
@@ -0,0 +1 @@
+../LinearInterpolation_4C123/Interp.h
\ No newline at end of file
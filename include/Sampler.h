@@ -0,0 +1 @@
+../Profile_4C123/Sampler.h
\ No newline at end of file
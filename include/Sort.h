@@ -0,0 +1 @@
+../ProfileSort_4C123/Sort.h
\ No newline at end of file
@@ -0,0 +1 @@
+../Telemetry_4C123/Telemetry.h
\ No newline at end of file
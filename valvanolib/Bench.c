@@ -0,0 +1 @@
+../Benchmark_4C123/Bench.c
\ No newline at end of file
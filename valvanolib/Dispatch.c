@@ -0,0 +1 @@
+../FixedScheduler_4C123/Dispatch.c
\ No newline at end of file
@@ -0,0 +1 @@
+../Math_4C123/FloatDSP.c
\ No newline at end of file
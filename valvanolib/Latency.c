@@ -0,0 +1 @@
+../Latency_4C123/Latency.c
\ No newline at end of file
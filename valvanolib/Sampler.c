@@ -0,0 +1 @@
+../Profile_4C123/Sampler.c
\ No newline at end of file
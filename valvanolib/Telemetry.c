@@ -0,0 +1 @@
+../Telemetry_4C123/Telemetry.c
\ No newline at end of file